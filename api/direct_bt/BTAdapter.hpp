@@ -33,6 +33,8 @@
 
 #include <mutex>
 #include <atomic>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <jau/darray.hpp>
 #include <jau/cow_darray.hpp>
@@ -43,6 +45,8 @@
 
 #include "HCIHandler.hpp"
 
+#include "RPAResolver.hpp"
+
 #include "DBGattServer.hpp"
 
 #include "SMPKeyBin.hpp"
@@ -58,6 +62,9 @@ namespace direct_bt {
 
     class BTAdapter; // forward
     class BTManager; // forward
+    template<typename T> class BDAddressIndex; // forward
+    template<typename T> class DiscoveryLRU; // forward
+    class DeferredUnpair; // forward
     typedef std::shared_ptr<BTManager> BTManagerRef;
 
     /**
@@ -174,7 +181,8 @@ namespace direct_bt {
              * the device will be made persistent, is ready to connect and BTDevice::remove() shall be called after usage.
              * </p>
              *
-             * BTDevice::unpair() has been called already.
+             * BTDevice::unpair() has been scheduled already, i.e. the device's SMP state is cleared
+             * and stale kernel keys are removed asynchronously, at the latest before connecting or uploading keys.
              *
              * @param device the found remote device
              * @param timestamp the time in monotonic milliseconds when this event occurred. See BasicTypes::getCurrentMilliseconds().
@@ -313,6 +321,9 @@ namespace direct_bt {
      *
      * Controlling Environment variables:
      * - 'direct_bt.debug.adapter.event': Debug messages about events, see debug_events
+     * - 'direct_bt.adapter.update.window': Initial per-device deviceUpdated(..) coalescing window in milliseconds, see setDeviceUpdateWindow(), default 0 (disabled)
+     * - 'direct_bt.adapter.discovered.capacity': Initial maximum number of discovered devices, see setDiscoveredDeviceCapacity(), default 0 (unbounded)
+     * - 'direct_bt.adapter.discovered.ttl': Initial idle time-to-live of discovered devices in milliseconds, see setDiscoveredDeviceTTL(), default 0 (disabled)
      *
      * @see BTDevice
      * @see @ref BTDeviceRoles
@@ -372,6 +383,17 @@ namespace direct_bt {
 
             jau::relaxed_atomic_bool scan_filter_dup; //  = true;
 
+            jau::relaxed_atomic_uint32 device_update_window; // [ms], 0 disables coalescing
+            jau::relaxed_atomic_uint64 device_updates_sent;
+            jau::relaxed_atomic_uint64 device_updates_suppressed;
+            jau::relaxed_atomic_uint64 device_updates_flushed;
+
+            jau::relaxed_atomic_uint32 discovered_capacity; // 0 unbounded
+            jau::relaxed_atomic_uint32 discovered_ttl; // [ms], 0 disables expiry
+            jau::relaxed_atomic_uint64 discovered_evicted_lru;
+            jau::relaxed_atomic_uint64 discovered_evicted_ttl;
+            jau::relaxed_atomic_uint64 ts_discovered_expiry; // [ms], last expiry sweep
+
             SMPIOCapability  iocap_defaultval = SMPIOCapability::UNSET;
             const BTDevice* single_conn_device_ptr = nullptr;
             std::mutex mtx_single_conn_device;
@@ -382,16 +404,89 @@ namespace direct_bt {
 
             /** All discovered devices: Transient until removeDiscoveredDevices(), startDiscovery(). */
             device_list_t discoveredDevices;
+            /** Least recently discovered order of discoveredDevices, see setDiscoveredDeviceCapacity() and setDiscoveredDeviceTTL() */
+            std::unique_ptr<DiscoveryLRU<BTDevice>> discoveredLRU;
             /** All connected devices: Transient until disconnect or removal. */
             device_list_t connectedDevices;
             /** All active shared devices: Persistent until removal. Final holder of BTDevice lifecycle! */
             device_list_t sharedDevices;
             /** All connected devices for which discovery has been paused. */
             weak_device_list_t pausing_discovery_devices;
+
+            /** BTDevice::device_lists bit: Member of discoveredDevices */
+            static constexpr const uint8_t DEVLIST_DISCOVERED = 0x01;
+            /** BTDevice::device_lists bit: Member of sharedDevices */
+            static constexpr const uint8_t DEVLIST_SHARED     = 0x02;
+            /** BTDevice::device_lists bit: Member of connectedDevices */
+            static constexpr const uint8_t DEVLIST_CONNECTED  = 0x04;
+            /** BTDevice::device_lists bit: Member of pausing_discovery_devices */
+            static constexpr const uint8_t DEVLIST_PAUSING    = 0x08;
+            /** BTDevice::device_lists bits of the strong device lists, i.e. those being indexed in device_index */
+            static constexpr const uint8_t DEVLIST_INDEXED    = DEVLIST_DISCOVERED | DEVLIST_SHARED | DEVLIST_CONNECTED;
+            /** BTDevice::device_lists bits protecting a discovered device from eviction, see setDiscoveredDeviceCapacity() */
+            static constexpr const uint8_t DEVLIST_PINNED     = DEVLIST_SHARED | DEVLIST_CONNECTED | DEVLIST_PAUSING;
+
+            /** Minimum interval between two idle discovered device expiry sweeps in milliseconds, see setDiscoveredDeviceTTL() */
+            static constexpr const uint64_t DISCOVERED_EXPIRY_INTERVAL = 1000;
+
+            typedef BDAddressIndex<BTDevice> device_index_t;
+            /**
+             * Index of all devices within discoveredDevices, sharedDevices or connectedDevices,
+             * keyed by their identity and visible BDAddressAndType.
+             * <p>
+             * Colliding addresses of different devices, e.g. a resolved identity address of an already known device,
+             * keep all devices indexed, see indexAddressLocked().
+             * </p>
+             * <p>
+             * Together with the BTDevice::device_lists membership bits, a single lookup answers
+             * the membership of all lists, see findIndexedDevice().
+             * The lists are kept as ordered views for iteration and snapshots.
+             * </p>
+             */
+            std::unique_ptr<device_index_t> device_index;
+            /** Resolver of random private addresses against the IRKs of all devices, see updateRPAResolver() */
+            RPAResolver rpa_resolver;
             /** An SMP event watchdog for each device in pairing state */
             jau::simple_timer smp_watchdog;
             jau::fraction_i64 smp_timeoutfunc(jau::simple_timer& timer);
 
+            /**
+             * Flushing pending coalesced device updates past their window, see setDeviceUpdateWindow().
+             * Only armed while updatePendingDevices is not empty, see update_timer_armed.
+             */
+            jau::simple_timer update_timer;
+            jau::fraction_i64 update_timeoutfunc(jau::simple_timer& timer);
+            /** Guards updatePendingDevices and update_timer_armed */
+            std::mutex mtx_updatePending;
+            /** Devices with a pending coalesced update, may contain flushed or duplicate entries dropped by flushDeviceUpdates() */
+            device_list_t updatePendingDevices;
+            /** True if update_timer is armed, stopping itself once updatePendingDevices is drained. Also set by close() to inhibit re-arming. */
+            bool update_timer_armed = false;
+
+            /**
+             * Starts the given on demand timer with the given member function.
+             * <p>
+             * Waits for a previous run to end which already stopped itself by returning a zero period.
+             * </p>
+             */
+            void armTimer(jau::simple_timer& timer, const jau::fraction_i64& period, jau::fraction_i64 (BTAdapter::*func)(jau::simple_timer&)) noexcept;
+
+            /** Maximum number of clean addresses kept in unpair_sched */
+            static constexpr const size_type UNPAIR_CLEAN_MAX = 1024;
+
+            /**
+             * Issuing deferred unpair commands of unpair_sched off the HCI event path, see scheduleUnpair().
+             * Only armed while unpair_sched has pending addresses, see unpair_timer_armed.
+             */
+            jau::simple_timer unpair_timer;
+            jau::fraction_i64 unpair_timeoutfunc(jau::simple_timer& timer);
+            /** Guards unpair_timer_armed */
+            std::mutex mtx_unpairTimer;
+            /** True if unpair_timer is armed, stopping itself once unpair_sched is drained. Also set by close() to inhibit re-arming. */
+            bool unpair_timer_armed = false;
+            /** Pending and clean identity addresses of deferred unpair commands */
+            std::unique_ptr<DeferredUnpair> unpair_sched;
+
             struct StatusListenerPair {
                 /** The actual listener */
                 AdapterStatusListenerRef listener;
@@ -426,6 +521,7 @@ namespace direct_bt {
             mutable std::mutex mtx_pausingDiscoveryDevices;
             mutable std::mutex mtx_discovery;
             mutable std::mutex mtx_sharedDevices; // final mutex of all BTDevice lifecycle
+            mutable std::mutex mtx_deviceIndex; // innermost, guards device_index and updates of BTDevice::device_lists
             mutable std::mutex mtx_keys;
             mutable jau::sc_atomic_bool sync_data;
 
@@ -434,7 +530,43 @@ namespace direct_bt {
             bool initialSetup() noexcept;
             bool enableListening(const bool enable) noexcept;
 
-            static BTDeviceRef findDevice(HCIHandler& hci, device_list_t & devices, const EUI48 & address, const BDAddressType addressType) noexcept;
+            /** Sets the given device_lists bit of the device and adds the device's addresses to device_index. */
+            void indexDevice(const BTDeviceRef& device, const uint8_t list) noexcept;
+            /** Clears the given device_lists bit of the device and removes the device's addresses from device_index if no longer listed. */
+            void unindexDevice(const BTDevice& device, const uint8_t list) noexcept;
+            /** Clears the given device_lists bit of all indexed devices, see unindexDevice(). */
+            void unindexDevices(const uint8_t list) noexcept;
+            /** Updates device_index after the device's identity or visible address has changed from `old_address`. */
+            void reindexDevice(const BTDevice& device, const BDAddressAndType& old_address) noexcept;
+            void indexAddressLocked(const BTDeviceRef& device, const BDAddressAndType& address) noexcept;
+            void unindexAddressLocked(const BTDevice& device, const BDAddressAndType& address) noexcept;
+            /** Adds the remote device's IRK, if available, to rpa_resolver using its current identity address. */
+            void updateRPAResolver(const BTDevice& device) noexcept;
+            /**
+             * Returns the indexed device matching the given address and being a member of any of the given device_lists bits,
+             * resolving a random private address via the devices' IRK if required.
+             * @param lists one or more DEVLIST_ bits
+             * @param lists_res set to the found device's device_lists bits, zero if none found
+             */
+            BTDeviceRef findIndexedDevice(const EUI48 & address, const BDAddressType addressType, const uint8_t lists, uint8_t& lists_res) noexcept;
+            BTDeviceRef findIndexedDevice(const EUI48 & address, const BDAddressType addressType, const uint8_t lists) noexcept {
+                uint8_t lists_res;
+                return findIndexedDevice(address, addressType, lists, lists_res);
+            }
+            /**
+             * Returns the first indexed device matching the given address per DEVLIST_INDEXED list in one index lookup,
+             * resolving a random private address via the devices' IRK if no device matches.
+             * <p>
+             * Unlike findIndexedDevice(), a device of one list is not masked by another device of another list
+             * sharing the same address, e.g. a connected device colliding with a discovered one.
+             * </p>
+             * @param discovered set to the first matching device of DEVLIST_DISCOVERED, otherwise nullptr
+             * @param shared set to the first matching device of DEVLIST_SHARED, otherwise nullptr
+             * @param connected set to the first matching device of DEVLIST_CONNECTED, otherwise nullptr
+             */
+            void findIndexedDevices(const EUI48 & address, const BDAddressType addressType,
+                                    BTDeviceRef& discovered, BTDeviceRef& shared, BTDeviceRef& connected) noexcept;
+
             static BTDeviceRef findDevice(device_list_t & devices, BTDevice const & device) noexcept;
             static BTDeviceRef findWeakDevice(weak_device_list_t & devices, const EUI48 & address, const BDAddressType addressType) noexcept;
             static BTDeviceRef findWeakDevice(weak_device_list_t & devices, BTDevice const & device) noexcept;
@@ -475,6 +607,8 @@ namespace direct_bt {
             friend HCIStatusCode BTDevice::connectBREDR(const uint16_t pkt_type, const uint16_t clock_offset, const uint8_t role_switch) noexcept;
             friend void BTDevice::processL2CAPSetup(BTDeviceRef sthis);
             friend bool BTDevice::updateIdentityAddress(BDAddressAndType const & identityAddress, bool sendEvent) noexcept;
+            friend void BTDevice::setIdentityResolvingKey(const SMPIdentityResolvingKey& irk) noexcept;
+            friend HCIStatusCode BTDevice::uploadKeys() noexcept;
             friend bool BTDevice::updatePairingState(const BTDeviceRef& sthis, const MgmtEvent& evt, const HCIStatusCode evtStatus, SMPPairingState claimed_state) noexcept;
             friend void BTDevice::hciSMPMsgCallback(const BTDeviceRef& sthis, const SMPPDUMsg& msg, const HCIACLData::l2cap_frame& source) noexcept;
             friend void BTDevice::processDeviceReady(BTDeviceRef sthis, const uint64_t timestamp);
@@ -497,6 +631,30 @@ namespace direct_bt {
             jau::nsize_t getConnectedDeviceCount() const noexcept;
 
             bool addDiscoveredDevice(BTDeviceRef const &device) noexcept;
+            void eraseDiscoveredDeviceLocked(device_list_t::iterator it) noexcept;
+            void eraseDiscoveredDeviceLocked(const BTDevice& device) noexcept;
+            /** Sets the device's last discovery timestamp and marks it most recently discovered in discoveredLRU, if discovered. */
+            void touchDiscoveredDevice(BTDevice& device, const uint64_t timestamp) noexcept;
+            /** Evicts the least recently discovered unpinned devices exceeding discovered_capacity, except `keep`. */
+            void evictDiscoveredDevicesLocked(const BTDevice* keep) noexcept;
+            /** Evicts unpinned discovered devices idle longer than discovered_ttl, at most once per DISCOVERED_EXPIRY_INTERVAL. */
+            void expireDiscoveredDevices(const uint64_t now) noexcept;
+
+            /**
+             * Schedules removal of potentially stale kernel keys of the given device address via a deferred unpair command.
+             * <p>
+             * Addresses which can't hold kernel keys, i.e. non identity addresses and those w/o stored SMPKeyBin,
+             * and addresses already unpaired and not connected since are skipped. Pending addresses are de-duplicated.
+             * </p>
+             */
+            void scheduleUnpair(const BDAddressAndType& address) noexcept;
+            /**
+             * Issues a pending deferred unpair of the given address immediately and marks it as potentially holding keys,
+             * to be called before connecting or uploading keys.
+             */
+            void flushUnpair(const BDAddressAndType& address) noexcept;
+            /** Issues the unpair command of a deferred unpair, returns true if the address holds no kernel keys. */
+            bool unpairDeferred(const BDAddressAndType& address) noexcept;
 
             void removeDevice(BTDevice & device) noexcept;
 
@@ -579,6 +737,14 @@ namespace direct_bt {
             void sendAdapterSettingsInitial(AdapterStatusListener & asl, const uint64_t timestampMS) noexcept;
 
             void sendDeviceUpdated(std::string cause, BTDeviceRef device, uint64_t timestamp, EIRDataType updateMask) noexcept;
+            /** Advertising driven sendDeviceUpdated(), coalesced per device within the device_update_window. */
+            void sendDeviceUpdatedCoalesced(std::string cause, const BTDeviceRef& device, uint64_t timestamp, EIRDataType updateMask) noexcept;
+            /**
+             * Dispatches pending coalesced device updates past their window or all if `force`.
+             * @param device the device to flush, or nullptr for all devices
+             * @param force if true, flush regardless of the window
+             */
+            void flushDeviceUpdates(const BTDevice* device, const bool force) noexcept;
 
             size_type removeAllStatusListener(const BTDevice& d) noexcept;
 
@@ -1109,6 +1275,166 @@ namespace direct_bt {
              */
             DiscoveryPolicy getCurrentDiscoveryPolicy() const noexcept { return discovery_policy; }
 
+            /**
+             * Sets the scan pre-filter, dropping non-matching advertising reports on their raw AD data
+             * before any BTDevice gets created or updated and any AdapterStatusListener gets notified.
+             * <p>
+             * The filter may be set before or while discovering, an empty ScanFilter disables filtering.
+             * </p>
+             * <pre>
+             *   adapter->setScanFilter( ScanFilter().add( ScanFilterRule().service(jau::uuid16_t(0x181a)).minRSSI(-80) )
+             *                                       .add( ScanFilterRule().namePrefix("TI Sensor") ) );
+             * </pre>
+             * @see ScanFilter
+             * @see HCIHandler::setScanFilter()
+             */
+            void setScanFilter(const ScanFilter& filter) noexcept { hci.setScanFilter(filter); }
+
+            /** Returns the current scan pre-filter, nullptr if none is set. */
+            std::shared_ptr<const ScanFilter> getScanFilter() const noexcept { return hci.getScanFilter(); }
+
+            /**
+             * Returns the resolver of random private addresses (RPA) used to recognize advertising devices,
+             * holding the IRKs of all devices distributed via SMP pairing or set via BTDevice::setIdentityResolvingKey().
+             * <p>
+             * Further IRKs may be added, e.g. of bonded devices not yet discovered.
+             * </p>
+             */
+            RPAResolver& getRPAResolver() noexcept { return rpa_resolver; }
+
+            /**
+             * Sets the per-device coalescing window of AdapterStatusListener::deviceUpdated() caused by advertising reports.
+             * <p>
+             * Within the window at most one deviceUpdated() is dispatched per BTDevice.
+             * Suppressed updates are merged, i.e. the next dispatched deviceUpdated() carries the union of their EIRDataType masks
+             * and the BTDevice holds the latest received values.
+             * A pending update is dispatched with the device's next advertising report after the window has passed,
+             * by a flush past the window at latest, as well as on stopDiscovery() and removal of the device.
+             * The flush timer only runs while updates are pending.
+             * </p>
+             * <p>
+             * AdapterStatusListener::deviceFound() as well as deviceUpdated() not caused by advertising, e.g. address resolution,
+             * are never delayed.
+             * </p>
+             * <p>
+             * The initial value is read from environment variable 'direct_bt.adapter.update.window'.
+             * </p>
+             * @param window_ms coalescing window in milliseconds, 0 disables coalescing
+             * @see getDeviceUpdatesSuppressed()
+             */
+            void setDeviceUpdateWindow(const uint32_t window_ms) noexcept { device_update_window = window_ms; }
+
+            /** Returns the per-device deviceUpdated() coalescing window in milliseconds, see setDeviceUpdateWindow(). */
+            uint32_t getDeviceUpdateWindow() const noexcept { return device_update_window; }
+
+            /** Returns the number of dispatched advertising caused deviceUpdated() events, see setDeviceUpdateWindow(). */
+            uint64_t getDeviceUpdatesSent() const noexcept { return device_updates_sent; }
+
+            /** Returns the number of advertising caused deviceUpdated() events merged into a later one, see setDeviceUpdateWindow(). */
+            uint64_t getDeviceUpdatesSuppressed() const noexcept { return device_updates_suppressed; }
+
+            /** Returns the number of pending deviceUpdated() events dispatched w/o a further advertising report, see setDeviceUpdateWindow(). */
+            uint64_t getDeviceUpdatesFlushed() const noexcept { return device_updates_flushed; }
+
+            /**
+             * Sets the maximum number of discovered devices, bounding memory usage of long running discovery.
+             * <p>
+             * Exceeding devices are evicted from the discovered devices in order of their BTDevice::getLastDiscoveryTimestamp(),
+             * i.e. least recently discovered first.
+             * Shared, connected and discovery pausing devices are never evicted and may exceed the capacity.
+             * </p>
+             * <p>
+             * An evicted device is treated as new once discovered again, i.e. AdapterStatusListener::deviceFound() is issued.
+             * </p>
+             * <p>
+             * The initial value is read from environment variable 'direct_bt.adapter.discovered.capacity'.
+             * </p>
+             * @param capacity maximum number of discovered devices, 0 for unbounded
+             * @see getDiscoveredDevicesEvictedLRU()
+             * @see setDiscoveredDeviceTTL()
+             */
+            void setDiscoveredDeviceCapacity(const uint32_t capacity) noexcept;
+
+            /** Returns the maximum number of discovered devices, see setDiscoveredDeviceCapacity(). */
+            uint32_t getDiscoveredDeviceCapacity() const noexcept { return discovered_capacity; }
+
+            /**
+             * Sets the idle time-to-live of discovered devices.
+             * <p>
+             * Discovered devices not seen for longer than the given time are evicted,
+             * checked at most once per second while advertising reports are received.
+             * Shared, connected and discovery pausing devices are never evicted, see setDiscoveredDeviceCapacity().
+             * </p>
+             * <p>
+             * The initial value is read from environment variable 'direct_bt.adapter.discovered.ttl'.
+             * </p>
+             * @param ttl_ms idle time-to-live in milliseconds, 0 disables expiry
+             * @see getDiscoveredDevicesEvictedTTL()
+             */
+            void setDiscoveredDeviceTTL(const uint32_t ttl_ms) noexcept { discovered_ttl = ttl_ms; }
+
+            /** Returns the idle time-to-live of discovered devices in milliseconds, see setDiscoveredDeviceTTL(). */
+            uint32_t getDiscoveredDeviceTTL() const noexcept { return discovered_ttl; }
+
+            /** Returns the number of discovered devices evicted by capacity, see setDiscoveredDeviceCapacity(). */
+            uint64_t getDiscoveredDevicesEvictedLRU() const noexcept { return discovered_evicted_lru; }
+
+            /** Returns the number of discovered devices evicted by idle time-to-live, see setDiscoveredDeviceTTL(). */
+            uint64_t getDiscoveredDevicesEvictedTTL() const noexcept { return discovered_evicted_ttl; }
+
+            /**
+             * Returns the number of deferred unpair commands scheduled for discovered devices.
+             * <p>
+             * Stale kernel keys of newly discovered devices are removed off the HCI event path,
+             * batched and de-duplicated, while connecting or uploading keys issues a pending unpair immediately.
+             * </p>
+             * @see getUnpairsSkipped()
+             */
+            uint64_t getUnpairsDeferred() const noexcept;
+
+            /** Returns the number of unpair commands skipped for discovered devices, i.e. non identity, w/o stored keys, pending or already unpaired addresses. */
+            uint64_t getUnpairsSkipped() const noexcept;
+
+            /**
+             * Synchronizes to the periodic advertising train of the given advertiser, see HCIHandler::le_create_periodic_adv_sync().
+             * <p>
+             * Discovery must be active to establish the sync, its outcome is passed to the HCIPeriodicAdvSyncCallback
+             * and all subsequent periodic advertising reports to the HCIPeriodicAdvReportCallback.
+             * </p>
+             * <p>
+             * Periodic advertising reports bypass BTDevice discovery bookkeeping and AdapterStatusListener,
+             * i.e. are delivered on the HCI reader thread with their raw AD data.
+             * </p>
+             * <pre>
+             *   adapter->addPeriodicAdvReportCallback( [&](const PeriodicAdvReport& r) { ... } );
+             *   adapter->startPeriodicAdvSync( eir.getAddressAndType(), adv_sid );
+             * </pre>
+             * @param address the advertiser's LE address
+             * @param adv_sid the advertiser's Advertising_SID, see EInfoReportView::getAdvSID()
+             * @param skip number of periodic advertising events which may be skipped, default 0
+             * @param sync_timeout in units of 10ms, default value 1000 for 10s
+             * @return HCIStatusCode::SUCCESS if the sync has been initiated, otherwise the HCIStatusCode error state
+             */
+            HCIStatusCode startPeriodicAdvSync(const BDAddressAndType& address, const uint8_t adv_sid,
+                                               const uint16_t skip=0, const uint16_t sync_timeout=1000) noexcept {
+                return hci.le_create_periodic_adv_sync(address, adv_sid, skip, sync_timeout);
+            }
+
+            /** Cancels a pending startPeriodicAdvSync(), see HCIHandler::le_cancel_periodic_adv_sync(). */
+            HCIStatusCode cancelPeriodicAdvSync() noexcept { return hci.le_cancel_periodic_adv_sync(); }
+
+            /** Terminates the given established periodic advertising sync, see HCIHandler::le_terminate_periodic_adv_sync(). */
+            HCIStatusCode stopPeriodicAdvSync(const uint16_t sync_handle) noexcept { return hci.le_terminate_periodic_adv_sync(sync_handle); }
+
+            /** Returns a snapshot of all established periodic advertising syncs. */
+            jau::darray<PeriodicAdvSync> getPeriodicAdvSyncs() noexcept { return hci.getPeriodicAdvSyncs(); }
+
+            void addPeriodicAdvSyncCallback(const HCIPeriodicAdvSyncCallback & l) { hci.addPeriodicAdvSyncCallback(l); }
+            size_type removePeriodicAdvSyncCallback(const HCIPeriodicAdvSyncCallback & l) { return hci.removePeriodicAdvSyncCallback(l); }
+
+            void addPeriodicAdvReportCallback(const HCIPeriodicAdvReportCallback & l) { hci.addPeriodicAdvReportCallback(l); }
+            size_type removePeriodicAdvReportCallback(const HCIPeriodicAdvReportCallback & l) { return hci.removePeriodicAdvReportCallback(l); }
+
             /**
              * Manual DiscoveryPolicy intervention point, allowing user to remove the ready device from
              * the queue of pausing-discovery devices.
@@ -1183,6 +1509,15 @@ namespace direct_bt {
             /** Returns shared BTDevice if found, otherwise nullptr */
             BTDeviceRef findSharedDevice (const EUI48 & address, const BDAddressType addressType) noexcept;
 
+        private:
+            /** Validates the adapter state for advertising and starts the L2CAP ATT server. */
+            HCIStatusCode startAdvertisingPrologue(const DBGattServerRef& gattServerData_) noexcept;
+            /** Adds the minimum GAPFlags::LE_Gen_Disc flags, NAME and FLAGS masks, and the adapter's name if none is set. */
+            void setAdvertisingMinimum(EInfoReport& eir, EIRDataType& adv_mask, EIRDataType& scanrsp_mask) noexcept;
+            /** Adopts the given DBGattServer and BTRole::Slave if successful, otherwise stops the L2CAP ATT server. */
+            HCIStatusCode startAdvertisingEpilogue(const DBGattServerRef& gattServerData_, const HCIStatusCode status) noexcept;
+
+        public:
             /**
              * Starts advertising
              * - BT Core Spec v5.2: Vol 4 HCI, Part E HCI Functional: 7.8.53 LE Set Extended Advertising Parameters command (Bluetooth 5.0)
@@ -1288,6 +1623,45 @@ namespace direct_bt {
                                            const uint8_t adv_chan_map=0x07,
                                            const uint8_t filter_policy=0x00) noexcept;
 
+            /**
+             * Starts advertising of multiple concurrent BT5 extended advertising sets, see HCIHandler::le_start_ext_adv(),
+             * e.g. advertising several identities of one DBGattServer, large payloads or using LE_PHYs::LE_2M or LE_PHYs::LE_CODED.
+             *
+             * Falls back to legacy advertising of the first set if the adapter doesn't support extended advertising,
+             * see HCIHandler::use_ext_adv().
+             *
+             * Method fails if isDiscovering() or has any open or pending connected remote {@link BTDevice}s.
+             *
+             * If successful, method also changes [this adapter's role](@ref BTAdapterRoles) to ::BTRole::Slave
+             * and treat connected BTDevice as ::BTRole::Master while service ::GATTRole::Server.
+             *
+             * Advertising is active until either disabled via stopAdvertising() or a connection has been made, see isAdvertising().
+             * A connection ends advertising of its set only, all other sets continue to advertise until stopAdvertising().
+             *
+             * Each set's EInfoReport will be updated with at least GAPFlags::LE_Gen_Disc set and getName() if it has no name,
+             * its adv_mask and scanrsp_mask will be updated to have at least EIRDataType::FLAGS and EIRDataType::NAME set in total.
+             *
+             * <pre>
+             *   jau::darray<ExtAdvSet> sets(2);
+             *   sets.push_back( ExtAdvSet() ); // legacy PDU, handle 0
+             *   ExtAdvSet s1;
+             *   s1.handle = 1; s1.sid = 1; s1.legacy_pdu = false; s1.secondary_phy = LE_PHYs::LE_2M;
+             *   s1.eir.setName("Identity1"); s1.random_address = ...;
+             *   sets.push_back( s1 );
+             *   adapter->startAdvertising(gattServer, sets);
+             * </pre>
+             *
+             * @param gattServerData_ the DBGattServer data to be advertised and offered via GattHandler as ::GATTRole::Server.
+             *        Its handles will be setup via DBGattServer::setServicesHandles().
+             *        Reference is held until next disconnect.
+             * @param sets the advertising sets, at most HCIHandler::getExtAdvMaxSets(), will be updated as described
+             * @return HCIStatusCode::SUCCESS if successful, otherwise the HCIStatusCode error state
+             * @see ExtAdvSet
+             * @see stopAdvertising()
+             * @see isAdvertising()
+             */
+            HCIStatusCode startAdvertising(const DBGattServerRef& gattServerData_, jau::darray<ExtAdvSet>& sets) noexcept;
+
             /**
              * Ends advertising.
              * - BT Core Spec v5.2: Vol 4 HCI, Part E HCI Functional: 7.8.56 LE Set Extended Advertising Enable command (Bluetooth 5.0)
@@ -57,6 +57,7 @@ namespace direct_bt {
      */
 
     class BTAdapter; // forward
+    class DeviceUpdateCoalescer; // forward
     class AdapterStatusListener; // forward
     typedef std::shared_ptr<AdapterStatusListener> AdapterStatusListenerRef; // forward
 
@@ -86,7 +87,7 @@ namespace direct_bt {
             BTAdapter & adapter;
             BTRole btRole;
             std::unique_ptr<L2CAPClient> l2cap_att;
-            uint64_t ts_last_discovery;
+            jau::relaxed_atomic_uint64 ts_last_discovery; // updated under BTAdapter::mtx_discoveredDevices, see BTAdapter::touchDiscoveredDevice()
             uint64_t ts_last_update;
             std::string name;
             int8_t rssi = 127; // The core spec defines 127 as the "not available" value
@@ -94,6 +95,9 @@ namespace direct_bt {
             std::shared_ptr<EInfoReport> eir; // Merged EIR (using shared_ptr to allow CoW style update)
             std::shared_ptr<EInfoReport> eir_ind; // AD_IND EIR
             std::shared_ptr<EInfoReport> eir_scan_rsp; // AD_SCAN_RSP EIR
+            ADFingerprint ad_fingerprint; // of last AD_IND and AD_SCAN_RSP
+            std::unique_ptr<DeviceUpdateCoalescer> update_coalescer; // of advertising caused deviceUpdated(..), see BTAdapter::setDeviceUpdateWindow()
+            mutable std::atomic<uint8_t> device_lists { 0 }; // BTAdapter device list membership bits, updated under BTAdapter::mtx_deviceIndex
             jau::relaxed_atomic_uint16 hciConnHandle;
             jau::ordered_atomic<LE_Features, std::memory_order_relaxed> le_features;
             jau::ordered_atomic<LE_PHYs, std::memory_order_relaxed> le_phy_tx;
@@ -171,7 +175,29 @@ namespace direct_bt {
 
             bool updateIdentityAddress(BDAddressAndType const & identityAddress, bool sendEvent) noexcept;
             bool updateVisibleAddress(BDAddressAndType const & randomPrivateAddress) noexcept;
+            /** Retrieves this remote device's IRK if available, see matches_irk(). */
+            bool getRemoteIRK(SMPIdentityResolvingKey& irk) const noexcept;
             EIRDataType update(EInfoReport const & data) noexcept;
+            /**
+             * Stores the raw AD payload fingerprint of `view` for updateUnchanged(),
+             * to be called after update(EInfoReport const &) with the EInfoReport materialized from `view`.
+             */
+            void setADFingerprint(EInfoReportView const & view) noexcept;
+            /**
+             * Fast path for an advertising report whose raw AD payload equals the last one of the same source,
+             * only updating the role, RSSI, TX power and the update timestamp without copying any EInfoReport,
+             * see ADFingerprint::updateUnchanged().
+             * <p>
+             * As with update(EInfoReport const &), the discovery timestamp is maintained by the caller.
+             * </p>
+             * <p>
+             * The EInfoReport instances, see getEIR(), retain the RSSI of the last payload change.
+             * </p>
+             * @param view the advertising report
+             * @param res set to the changed EIRDataType fields, if returning true
+             * @return true if the payload is unchanged and the fast update performed, otherwise false and nothing updated.
+             */
+            bool updateUnchanged(EInfoReportView const & view, EIRDataType& res) noexcept;
             EIRDataType update(GattGenericAccessSvc const &data, const uint64_t timestamp) noexcept;
 
             void notifyDisconnected() noexcept;
@@ -362,7 +388,7 @@ namespace direct_bt {
              * discovered or connected directly the last time.
              * @see BasicTypes::getCurrentMilliseconds()
              */
-            uint64_t getLastDiscoveryTimestamp() const noexcept { return ts_last_discovery; }
+            uint64_t getLastDiscoveryTimestamp() const noexcept { return ts_last_discovery.load(); }
 
             /**
              * Returns the timestamp in monotonic milliseconds when this device instance underlying data
@@ -1253,6 +1279,20 @@ namespace direct_bt {
              */
             bool sendNotification(const uint16_t char_value_handle, const jau::TROOctets & value) noexcept;
 
+            /**
+             * Send `count` notification events consisting out of the given `values` representing the given characteristic value handle
+             * in order to the connected BTRole::Master, submitted via one batched l2cap write.
+             *
+             * This command is only valid if this BTGattHandler is in role GATTRole::Server.
+             *
+             * @param char_value_handle valid characteristic value handle, must be sourced from referenced DBGattServer
+             * @param values the values to be send, zero sized values are skipped
+             * @param count number of values
+             * @return true if successful, otherwise false
+             * @see sendNotification()
+             */
+            bool sendNotifications(const uint16_t char_value_handle, const jau::TROOctets* const* values, const jau::nsize_t count) noexcept;
+
             /**
              * Send an indication event consisting out of the given `value` representing the given characteristic value handle
              * to the connected BTRole::Master.
@@ -46,6 +46,7 @@
 #include "ATTPDUTypes.hpp"
 #include "GattNumbers.hpp"
 #include "DBGattServer.hpp"
+#include "IOReactor.hpp"
 #include "jau/int_types.hpp"
 
 /**
@@ -462,6 +463,9 @@ namespace direct_bt {
             jau::relaxed_atomic_bool has_ioerror;  // reflects state
 
             jau::service_runner l2cap_reader_service;
+            /** True if the reader is dispatched by the shared IOReactor instead of l2cap_reader_service, see IOReactorEnv::REACTOR_ENABLED. */
+            jau::sc_atomic_bool use_reactor;
+            jau::relaxed_atomic_uint64 reactor_id;
             jau::ringbuffer<std::unique_ptr<const AttPDUMsg>, jau::nsize_t> attPDURing;
 
             jau::relaxed_atomic_uint16 serverMTU; // set in initClientGatt()
@@ -512,7 +516,14 @@ namespace direct_bt {
              */
             bool replyAttPDUReq(std::unique_ptr<const AttPDUMsg> && pdu) noexcept;
 
+            /**
+             * Reads and processes one ATT PDU.
+             * @return false if the reader shall stop, otherwise true
+             */
+            bool l2capReaderProcess() noexcept;
             void l2capReaderWork(jau::service_runner& sr) noexcept;
+            /** IOReactor::ReadyCallback */
+            bool l2capReaderReady() noexcept;
             void l2capReaderEndLocked(jau::service_runner& sr) noexcept;
 
             bool l2capReaderInterrupted(int dummy=0) /* const */ noexcept;
@@ -690,6 +701,19 @@ namespace direct_bt {
              */
             bool send(const AttPDUMsg & msg) noexcept;
 
+            /**
+             * Sends the given `count` AttPDUMsg in order to the connected device via one batched l2cap write,
+             * see L2CAPClient::write_batch().
+             *
+             * Implementation disconnect() and returns false if an unexpected l2cap write errors occurs.
+             *
+             * @param msgs the messages to be send
+             * @param count number of messages
+             * @return true if all have been sent, otherwise false if write error, not connected or if a message size exceeds usedMTU-1.
+             * @see send()
+             */
+            bool send(const AttPDUMsg* const* msgs, const jau::nsize_t count) noexcept;
+
             /**
              * Sends the given AttPDUMsg to the connected device via l2cap using {@link #send()}.
              *
@@ -816,6 +840,22 @@ namespace direct_bt {
              */
             bool sendNotification(const uint16_t char_value_handle, const jau::TROOctets & value) noexcept;
 
+            /**
+             * Send `count` notification events consisting out of the given `values` representing the given characteristic value handle
+             * in order to the connected BTRole::Master, submitted via one batched l2cap write.
+             *
+             * This command is only valid if this BTGattHandler is in role GATTRole::Server.
+             *
+             * Implementation is not receiving any reply after sending out the notifications and returns immediately.
+             *
+             * @param char_value_handle valid characteristic value handle, must be sourced from referenced DBGattServer
+             * @param values the values to be send, zero sized values are skipped
+             * @param count number of values
+             * @return true if successful, otherwise false
+             * @see sendNotification()
+             */
+            bool sendNotifications(const uint16_t char_value_handle, const jau::TROOctets* const* values, const jau::nsize_t count) noexcept;
+
             /**
              * Send an indication event consisting out of the given `value` representing the given characteristic value handle
              * to the connected BTRole::Master.
@@ -28,6 +28,7 @@
 
 #include <cstring>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <cstdint>
 
@@ -465,6 +466,29 @@ namespace direct_bt {
     constexpr void set(EAD_Event_Type &mask, const EAD_Event_Type bit) noexcept { mask = mask | bit; }
     std::string to_string(const EAD_Event_Type v) noexcept;
 
+    /**
+     * LE Extended Advertising Report data status, bits 5-6 of EAD_Event_Type.
+     * <pre>
+     * BT Core Spec v5.2: Vol 4, Part E, 7.7.65.13 LE Extended Advertising Report event
+     * </pre>
+     */
+    enum class EAD_DataStatus : uint8_t {
+        /** Complete data, or the last fragment of a chain */
+        COMPLETE             = 0,
+        /** Incomplete data, more fragments to come */
+        INCOMPLETE_MORE      = 1,
+        /** Incomplete data, truncated with no more fragments to come */
+        INCOMPLETE_TRUNCATED = 2,
+        RESERVED             = 3
+    };
+    constexpr uint8_t number(const EAD_DataStatus rhs) noexcept {
+        return static_cast<uint8_t>(rhs);
+    }
+    /** Returns the EAD_DataStatus of the given EAD_Event_Type. */
+    constexpr EAD_DataStatus getDataStatus(const EAD_Event_Type v) noexcept {
+        return static_cast<EAD_DataStatus>( ( number(v) >> 5 ) & 0x03 );
+    }
+
     /**
      * HCI Whitelist connection type.
      */
@@ -760,12 +784,24 @@ namespace direct_bt {
     // *************************************************
     // *************************************************
 
+    /**
+     * Manufacturer Specific Data (MSD), i.e. a company identifier and its opaque data.
+     * <p>
+     * Data up to INLINE_DATA_SIZE bytes, i.e. all legacy advertising MSD, is stored inline without heap allocation.
+     * The company name is only looked up on demand via getCompanyName().
+     * </p>
+     */
     class ManufactureSpecificData
     {
+        public:
+            /** Inline data capacity, i.e. legacy advertising's 31 bytes less AD structure header and company identifier. */
+            static constexpr const jau::nsize_t INLINE_DATA_SIZE = 31 - 2 - 2;
+
         private:
             uint16_t company;
-            std::string companyName;
-            jau::POctets data;
+            jau::nsize_t data_len;
+            uint8_t data_inline[INLINE_DATA_SIZE] = { 0 };
+            jau::POctets data_heap; // only used if data_len > INLINE_DATA_SIZE
 
         public:
             ManufactureSpecificData(uint16_t const company);
@@ -777,17 +813,20 @@ namespace direct_bt {
             ManufactureSpecificData& operator=(ManufactureSpecificData &&o) noexcept = default;
 
             constexpr uint16_t getCompany() const noexcept { return company; }
-            const std::string& getCompanyName() const noexcept { return companyName; }
+            std::string getCompanyName() const noexcept;
 
-            const jau::TROOctets& getData() const noexcept { return data; }
+            /** Returns a non-owning view of the data, valid as long as this instance. */
+            jau::TROOctets getData() const noexcept {
+                return jau::TROOctets(data_len > INLINE_DATA_SIZE ? data_heap.get_ptr() : data_inline, data_len, jau::lb_endian_t::little);
+            }
 
             std::string toString() const noexcept;
     };
 
-    constexpr bool operator==(const ManufactureSpecificData& lhs, const ManufactureSpecificData& rhs) noexcept
+    inline bool operator==(const ManufactureSpecificData& lhs, const ManufactureSpecificData& rhs) noexcept
     { return lhs.getCompany() == rhs.getCompany() && lhs.getData() == rhs.getData(); }
 
-    constexpr bool operator!=(const ManufactureSpecificData& lhs, const ManufactureSpecificData& rhs) noexcept
+    inline bool operator!=(const ManufactureSpecificData& lhs, const ManufactureSpecificData& rhs) noexcept
     { return !(lhs == rhs); }
 
     // *************************************************
@@ -881,6 +920,109 @@ namespace direct_bt {
     inline constexpr const EIRDataType EIR_DATA_TYPE_MASK = ~( EIRDataType::EVT_TYPE | EIRDataType::EXT_EVT_TYPE |
                                                                EIRDataType::BDADDR_TYPE | EIRDataType::BDADDR | EIRDataType::RSSI );
 
+    /**
+     * Index of the AD structures of raw 'Advertising Data' (AD) or 'Extended Inquiry Response' (EIR) data,
+     * locating all structure boundaries and their GAP_T types in a single pass without decoding any of them.
+     * <p>
+     * The index allows O(1) type presence tests via has() and decoding only selected types,
+     * see EInfoReport::read_data(const ADStructIndex&, const EIRDataType).
+     * Each EInfoReportView holds the index of its AD data, used by its accessors and the ScanFilter.
+     * </p>
+     * <p>
+     * Each boundary depends on the preceding length octet, hence the pass is a tight scalar walk
+     * w/o per element dispatch, recording a 256-bit type presence set.
+     * Up to MAX_ELEMS structures are indexed, find() continues walking the data beyond, see isTruncated().
+     * </p>
+     * <p>
+     * The index only references the given data, i.e. it is only valid as long as the referenced buffer.
+     * </p>
+     */
+    class ADStructIndex {
+        public:
+            /** Maximum number of indexed AD structures, legacy AD holds up to 15. */
+            static constexpr const jau::nsize_t MAX_ELEMS = 32;
+
+            /** One indexed AD structure */
+            struct Elem {
+                /** Offset of the net data within the referenced AD data */
+                uint16_t offset;
+                /** The GAP_T type */
+                uint8_t type;
+                /** Net data length, i.e. less the type octet */
+                uint8_t len;
+            };
+
+        private:
+            uint8_t const * data = nullptr;
+            jau::nsize_t data_len = 0;
+            jau::nsize_t end_offset = 0; // offset past the last indexed AD structure
+            jau::nsize_t count = 0;
+            bool truncated = false;
+            uint64_t type_set[4] = { 0, 0, 0, 0 };
+            Elem elems[MAX_ELEMS];
+
+            friend class EInfoReport;
+
+        public:
+            ADStructIndex() noexcept = default;
+
+            ADStructIndex(uint8_t const * data_, jau::nsize_t const data_length) noexcept { scan(data_, data_length); }
+
+            /**
+             * Indexes the given AD data, replacing a previous index.
+             * <p>
+             * Scanning stops at the first zero length octet, i.e. the end of the significant part,
+             * or at a malformed AD structure exceeding the data.
+             * </p>
+             * @return number of indexed AD structures
+             */
+            jau::nsize_t scan(uint8_t const * data_, jau::nsize_t const data_length) noexcept;
+
+            uint8_t const * getData() const noexcept { return data; }
+            jau::nsize_t getDataSize() const noexcept { return data_len; }
+
+            /** Returns the number of indexed AD structures. */
+            jau::nsize_t size() const noexcept { return count; }
+
+            /** Returns true if more than MAX_ELEMS AD structures exist, the remainder is not indexed. */
+            bool isTruncated() const noexcept { return truncated; }
+
+            const Elem& operator[](jau::nsize_t i) const noexcept { return elems[i]; }
+
+            /** Returns true if an AD structure of given type exists, including those beyond MAX_ELEMS. */
+            bool has(const GAP_T type) const noexcept {
+                const uint8_t t = number(type);
+                return 0 != ( type_set[t >> 6] & ( 1ULL << ( t & 63 ) ) );
+            }
+
+            /** Returns the type presence bits of GAP_T values [64*i .. 64*i+63], with `i` in [0..3]. */
+            uint64_t getTypeSet(const jau::nsize_t i) const noexcept { return type_set[i]; }
+
+            /**
+             * Visits all AD structures in order, including those beyond MAX_ELEMS, until `f` returns false.
+             * @param f `bool f(const uint8_t type, uint8_t const * elem_data, const uint8_t elem_len)`
+             */
+            template<typename Func>
+            void for_each(Func f) const noexcept;
+
+            /**
+             * Finds the first AD structure of given type.
+             * @param type the GAP_T to find
+             * @param elem_data set to the AD structure's net data if found
+             * @param elem_len set to the AD structure's net data length if found
+             * @return true if found, otherwise false
+             */
+            bool find(const GAP_T type, uint8_t const ** elem_data, uint8_t * elem_len) const noexcept;
+
+            /**
+             * Returns the EIRDataType mask of the indexed AD structures as EInfoReport::read_data() would set,
+             * i.e. excluding report header fields like EIRDataType::RSSI.
+             */
+            EIRDataType getEIRDataMask() const noexcept;
+
+            std::string toString() const noexcept;
+    };
+
     /**
      * Collection of 'Extended Advertising Data' (EAD), 'Advertising Data' (AD)
      * or 'Extended Inquiry Response' (EIR) information.
@@ -916,7 +1058,42 @@ namespace direct_bt {
             typedef jau::nsize_t size_type;
             typedef jau::snsize_t ssize_type;
 
+            /** Inline name capacity, i.e. the maximum name length decoded from AD or EIR data. */
+            static constexpr const jau::nsize_t NAME_INLINE_SIZE = 30;
+
         private:
+            /**
+             * Name storage, inline up to NAME_INLINE_SIZE bytes.
+             * Only longer names, which can only be set explicitly, use heap storage.
+             */
+            class InlineName {
+                private:
+                    char buf[NAME_INLINE_SIZE] = { 0 };
+                    uint8_t len = 0;
+                    std::string heap;
+
+                public:
+                    void assign(const char* s, const jau::nsize_t n) noexcept {
+                        if( n <= NAME_INLINE_SIZE ) {
+                            memcpy(buf, s, n);
+                            len = static_cast<uint8_t>(n);
+                            heap.clear();
+                        } else {
+                            heap.assign(s, n);
+                            len = 0;
+                        }
+                    }
+                    jau::nsize_t size() const noexcept { return heap.empty() ? len : heap.size(); }
+                    const char* data() const noexcept { return heap.empty() ? buf : heap.data(); }
+                    std::string str() const noexcept { return std::string(data(), size()); }
+                    std::string_view view() const noexcept { return std::string_view(data(), size()); }
+
+                    bool operator==(const InlineName& o) const noexcept {
+                        return size() == o.size() && 0 == memcmp(data(), o.data(), size());
+                    }
+                    bool operator!=(const InlineName& o) const noexcept { return !( *this == o ); }
+            };
+
             /** Source */
             Source source = Source::NA;
             /** Flag whether source originated from an extended BT5 data set, i.e. EAD */
@@ -931,8 +1108,8 @@ namespace direct_bt {
             jau::EUI48 address;
 
             GAPFlags flags = GAPFlags::NONE;
-            std::string name;
-            std::string name_short;
+            InlineName name;
+            InlineName name_short;
             int8_t rssi = 127; // The core spec defines 127 as the "not available" value
             int8_t tx_power = 127; // The core spec defines 127 as the "not available" value
             std::shared_ptr<ManufactureSpecificData> msd = nullptr;
@@ -940,8 +1117,8 @@ namespace direct_bt {
             bool services_complete = false;
             uint32_t device_class = 0;
             AppearanceCat appearance = AppearanceCat::UNKNOWN;
-            jau::POctets hash;
-            jau::POctets randomizer;
+            uint8_t hash[16] = { 0 };
+            uint8_t randomizer[16] = { 0 };
             uint16_t did_source = 0;
             uint16_t did_vendor = 0;
             uint16_t did_product = 0;
@@ -958,11 +1135,21 @@ namespace direct_bt {
             void setShortName(const uint8_t *buffer, int buffer_len) noexcept;
             void setManufactureSpecificData(uint16_t const company, uint8_t const * const data, int const data_len);
 
-            int next_data_elem(uint8_t *eir_elem_len, uint8_t *eir_elem_type, uint8_t const **eir_elem_data,
-                               uint8_t const * data, int offset, int const size) noexcept;
+            static int next_data_elem(uint8_t *eir_elem_len, uint8_t *eir_elem_type, uint8_t const **eir_elem_data,
+                                      uint8_t const * data, int offset, int const size) noexcept;
+
+            friend class ADStructIndex;
+
+            /** Decodes one AD structure of given type and net data. */
+            void read_elem(const uint8_t elem_type, uint8_t const * elem_data, const uint8_t elem_len) noexcept;
+
+            friend class EInfoReportView;
 
         public:
-            EInfoReport() noexcept : hash(16, 0, jau::lb_endian_t::little), randomizer(16, 0, jau::lb_endian_t::little) {}
+            /** Returns the BDAddressType of the given HCI advertising report address type. */
+            static BDAddressType toAddressType(const uint8_t adAddressType) noexcept;
+
+            EInfoReport() noexcept = default;
 
             EInfoReport(const EInfoReport&) = default;
             EInfoReport& operator=(const EInfoReport &o) = default;
@@ -999,8 +1186,8 @@ namespace direct_bt {
             void setServicesComplete(const bool v) noexcept { services_complete = v; }
             void setDeviceClass(uint32_t c) noexcept { device_class= c; set(EIRDataType::DEVICE_CLASS); }
             void setAppearance(AppearanceCat a) noexcept { appearance= a; set(EIRDataType::APPEARANCE); }
-            void setHash(const uint8_t * h) noexcept { hash.resize(16); memcpy(hash.get_wptr(), h, 16); set(EIRDataType::HASH); }
-            void setRandomizer(const uint8_t * r) noexcept { randomizer.resize(16); memcpy(randomizer.get_wptr(), r, 16); set(EIRDataType::RANDOMIZER); }
+            void setHash(const uint8_t * h) noexcept { memcpy(hash, h, 16); set(EIRDataType::HASH); }
+            void setRandomizer(const uint8_t * r) noexcept { memcpy(randomizer, r, 16); set(EIRDataType::RANDOMIZER); }
             void setDeviceID(const uint16_t source, const uint16_t vendor, const uint16_t product, const uint16_t version) noexcept;
 
             /**
@@ -1035,6 +1222,10 @@ namespace direct_bt {
              * BT Core Spec v5.2: Vol 3, Part C, 8  EXTENDED INQUIRY RESPONSE DATA FORMAT
              * </pre>
              * <p>
+             * Each report is read as is, i.e. fragments of a chained payload are not reassembled,
+             * see EInfoReportView::getDataStatus() and EADReassembly as used by HCIHandler.
+             * </p>
+             * <p>
              * https://www.bluetooth.com/specifications/archived-specifications/
              * </p>
              */
@@ -1069,7 +1260,20 @@ namespace direct_bt {
              * https://www.bluetooth.com/specifications/archived-specifications/
              * </p>
              */
-            int read_data(uint8_t const * data, uint8_t const data_length) noexcept;
+            int read_data(uint8_t const * data, jau::nsize_t const data_length) noexcept;
+
+            /**
+             * Decodes only those AD structures of the given ADStructIndex contributing to the selected EIRDataType bits,
+             * skipping all others w/o inspection.
+             * <p>
+             * Using EIRDataType::ALL results in the same EInfoReport as read_data(uint8_t const *, jau::nsize_t const)
+             * of the indexed well-formed data.
+             * </p>
+             * @param index the index of the AD data to decode
+             * @param select the EIRDataType bits to decode
+             * @return number of decoded AD structures
+             */
+            int read_data(const ADStructIndex& index, const EIRDataType select) noexcept;
 
             /**
              * Writes the Extended Inquiry Response (EIR) or (Extended) Advertising Data (EAD or AD) segments
@@ -1116,8 +1320,10 @@ namespace direct_bt {
             uint8_t getADAddressType() const noexcept { return ad_address_type; }
             BDAddressType getAddressType() const noexcept { return addressType; }
             jau::EUI48 const & getAddress() const noexcept { return address; }
-            std::string const & getName() const noexcept { return name; }
-            std::string const & getShortName() const noexcept{ return name_short; }
+            /** Returns a non-owning view of the complete local name, valid until this instance's name is modified or destructed. */
+            std::string_view getName() const noexcept { return name.view(); }
+            /** Returns a non-owning view of the shortened local name, valid until this instance's name is modified or destructed. */
+            std::string_view getShortName() const noexcept{ return name_short.view(); }
             int8_t getRSSI() const noexcept { return rssi; }
             int8_t getTxPower() const noexcept { return tx_power; }
 
@@ -1129,8 +1335,10 @@ namespace direct_bt {
 
             uint32_t getDeviceClass() const noexcept { return device_class; }
             AppearanceCat getAppearance() const noexcept { return appearance; }
-            const jau::TROOctets & getHash() const noexcept { return hash; }
-            const jau::TROOctets & getRandomizer() const noexcept { return randomizer; }
+            /** Returns a non-owning view of the hash, valid as long as this instance. */
+            jau::TROOctets getHash() const noexcept { return jau::TROOctets(hash, sizeof(hash), jau::lb_endian_t::little); }
+            /** Returns a non-owning view of the randomizer, valid as long as this instance. */
+            jau::TROOctets getRandomizer() const noexcept { return jau::TROOctets(randomizer, sizeof(randomizer), jau::lb_endian_t::little); }
             void getDeviceID(uint16_t& source_, uint16_t& vendor_, uint16_t& product_, uint16_t& version_) const noexcept {
                 source_ = did_source; vendor_ = did_vendor; product_ = did_product; version_ = did_version;
             }
@@ -1161,8 +1369,210 @@ namespace direct_bt {
     std::string to_string(EInfoReport::Source source) noexcept;
     inline std::string to_string(const EInfoReport& eir, const bool includeServices=true) noexcept { return eir.toString(includeServices); }
 
+    template<typename Func>
+    void ADStructIndex::for_each(Func f) const noexcept {
+        for(jau::nsize_t i=0; i<count; ++i) {
+            if( !f(elems[i].type, data + elems[i].offset, elems[i].len) ) {
+                return;
+            }
+        }
+        if( truncated ) {
+            int offset = static_cast<int>( end_offset );
+            uint8_t len, t;
+            uint8_t const *d;
+            while( 0 < ( offset = EInfoReport::next_data_elem( &len, &t, &d, data, offset, data_len ) ) ) {
+                if( !f(t, d, len) ) {
+                    return;
+                }
+            }
+        }
+    }
+
     typedef std::shared_ptr<EInfoReport> EInfoReportRef;
 
+    /**
+     * Non-owning view of one (Extended) Advertising Data (AD or EAD) report,
+     * referencing the raw AD data within the HCI event buffer.
+     * <p>
+     * Only the fixed report header is read and the AD structures are indexed when the view is created,
+     * all AD structure fields are decoded on demand by their GAP_T, see find() and getADIndex().
+     * This allows dropping reports of ignored devices without any heap allocation,
+     * while materialize() produces the owning EInfoReport once a BTDevice gets created or updated.
+     * </p>
+     * <p>
+     * The view is only valid as long as the referenced buffer, i.e. during the HCI event's dispatch.
+     * </p>
+     *
+     * @see EInfoReport::read_ad_reports()
+     * @see EInfoReport::read_ext_ad_reports()
+     */
+    class EInfoReportView {
+        public:
+            typedef EInfoReport::Source Source;
+
+        private:
+            Source source = Source::NA;
+            bool source_ext = false;
+            uint64_t timestamp = 0;
+            AD_PDU_Type evt_type = AD_PDU_Type::UNDEFINED;
+            EAD_Event_Type ead_type = EAD_Event_Type::NONE;
+            uint8_t ad_address_type = 0;
+            jau::EUI48 address;
+            int8_t rssi = 127; // The core spec defines 127 as the "not available" value
+            int8_t tx_power = 127; // EAD header only
+            uint8_t adv_sid = 0xff; // EAD header only, 0xff: not available
+            uint8_t const * data = nullptr;
+            uint16_t data_len = 0; // exceeds 255 if reassembled, see EADReassembly
+            ADStructIndex ad_index; // of data
+
+            friend class EADReassembly;
+
+            /** Sets the referenced raw AD data and indexes its AD structures. */
+            void setData(uint8_t const * data_, const uint16_t data_len_) noexcept {
+                data = data_;
+                data_len = data_len_;
+                ad_index.scan(data_, data_len_);
+            }
+
+        public:
+            EInfoReportView() noexcept = default;
+
+            void setTimestamp(uint64_t ts) noexcept { timestamp = ts; }
+
+            Source getSource() const noexcept { return source; }
+            bool getSourceExt() const noexcept { return source_ext; }
+            uint64_t getTimestamp() const noexcept { return timestamp; }
+
+            AD_PDU_Type getEvtType() const noexcept { return evt_type; }
+            EAD_Event_Type getExtEvtType() const noexcept { return ead_type; }
+            /** Returns the EAD data status, EAD_DataStatus::COMPLETE for legacy reports. */
+            EAD_DataStatus getDataStatus() const noexcept { return source_ext ? direct_bt::getDataStatus(ead_type) : EAD_DataStatus::COMPLETE; }
+            /** Returns the EAD Advertising_SID, 0xff if not available or a legacy report. */
+            uint8_t getAdvSID() const noexcept { return adv_sid; }
+            uint8_t getADAddressType() const noexcept { return ad_address_type; }
+            BDAddressType getAddressType() const noexcept { return EInfoReport::toAddressType(ad_address_type); }
+            jau::EUI48 const & getAddress() const noexcept { return address; }
+            int8_t getRSSI() const noexcept { return rssi; }
+
+            /** Returns the referenced raw AD data of this report. */
+            uint8_t const * getData() const noexcept { return data; }
+            /** Returns the size of the referenced raw AD data of this report. */
+            jau::nsize_t getDataSize() const noexcept { return data_len; }
+            /** Returns the ADStructIndex of the referenced raw AD data. */
+            const ADStructIndex& getADIndex() const noexcept { return ad_index; }
+
+            /**
+             * Finds the first AD structure of given type.
+             * @param type the GAP_T to find
+             * @param elem_data set to the AD structure's net data if found
+             * @param elem_len set to the AD structure's net data length if found
+             * @return true if found, otherwise false
+             */
+            bool find(const GAP_T type, uint8_t const ** elem_data, uint8_t * elem_len) const noexcept;
+
+            /**
+             * Returns the EIRDataType mask of this report as EInfoReport::getEIRDataMask() would after materialize(),
+             * computed from the indexed AD structures.
+             */
+            EIRDataType getEIRDataMask() const noexcept;
+
+            bool isSet(EIRDataType bit) const noexcept { return EIRDataType::NONE != (getEIRDataMask() & bit); }
+
+            GAPFlags getFlags() const noexcept;
+            /** Returns a non-owning view of the complete local name within the referenced AD data, or an empty view if not included. */
+            std::string_view getName() const noexcept;
+            /** Returns a non-owning view of the shortened local name within the referenced AD data, or an empty view if not included. */
+            std::string_view getShortName() const noexcept;
+            /** Returns the TX power level of the AD data, or of the EAD report header. 127 if not available. */
+            int8_t getTxPower() const noexcept;
+
+            /**
+             * Returns true if given service UUID is included in any of the 16, 32 or 128 bit service UUID lists.
+             */
+            bool hasService(const jau::uuid_t& uuid) const noexcept;
+
+            /**
+             * Retrieves the first manufacturer specific data.
+             * @param company set to the company identifier if found
+             * @param msd_data set to the net data following the company identifier if found, may be nullptr if msd_len is zero
+             * @param msd_len set to the net data length if found
+             * @return true if found, otherwise false
+             */
+            bool getManufactureSpecificData(uint16_t& company, uint8_t const ** msd_data, jau::nsize_t& msd_len) const noexcept;
+
+            /**
+             * Returns a 64-bit FNV-1a hash over the event type and the raw AD data, never zero.
+             * <p>
+             * Equal fingerprints of the same device and Source denote an unchanged advertising payload.
+             * </p>
+             */
+            uint64_t getFingerprint() const noexcept;
+
+            /**
+             * Returns a newly created owning EInfoReport, fully decoding the referenced AD data.
+             */
+            std::unique_ptr<EInfoReport> materialize() const noexcept;
+
+            /**
+             * Reads a complete Advertising Data (AD) Report into views of its reports appended to `dest`,
+             * not decoding any AD structure.
+             * <pre>
+             * BT Core Spec v5.2: Vol 4, Part E, 7.7.65.2 LE Advertising Report event
+             * </pre>
+             * @return number of appended views
+             * @see EInfoReport::read_ad_reports()
+             */
+            static jau::nsize_t read_ad_reports(uint8_t const * data, jau::nsize_t const data_length, jau::darray<EInfoReportView>& dest) noexcept;
+
+            /**
+             * Reads a complete Extended Advertising Data (AD) Report into views of its reports appended to `dest`,
+             * not decoding any AD structure.
+             * <pre>
+             * BT Core Spec v5.2: Vol 4, Part E, 7.7.65.13 LE Extended Advertising Report event
+             * </pre>
+             * <p>
+             * Each report is read as is, i.e. fragments of a chained payload are not reassembled,
+             * see getDataStatus() and EADReassembly.
+             * </p>
+             * @return number of appended views
+             * @see EInfoReport::read_ext_ad_reports()
+             */
+            static jau::nsize_t read_ext_ad_reports(uint8_t const * data, jau::nsize_t const data_length, jau::darray<EInfoReportView>& dest) noexcept;
+
+            std::string toString() const noexcept;
+    };
+
+    /**
+     * Raw AD payload fingerprints of a remote device's last EInfoReport::Source::AD_IND and EInfoReport::Source::AD_SCAN_RSP report,
+     * detecting an unchanged advertising payload via EInfoReportView::getFingerprint() without materializing an EInfoReport.
+     * <p>
+     * Not thread safe, used by BTDevice under its EIR lock.
+     * </p>
+     */
+    class ADFingerprint {
+        private:
+            uint64_t fingerprint[2] = { 0, 0 }; // of last AD_IND and AD_SCAN_RSP, zero if none
+
+            static int index(const EInfoReport::Source source) noexcept;
+
+        public:
+            /** Clears the fingerprint of the given source, i.e. its next report is considered changed. */
+            void reset(const EInfoReport::Source source) noexcept;
+
+            /** Stores the fingerprint of the given report for its source, if EInfoReport::Source::AD_IND or EInfoReport::Source::AD_SCAN_RSP. */
+            void set(EInfoReportView const & view) noexcept;
+
+            /**
+             * Returns true if the raw AD payload of `view` equals the last stored one of its source.
+             * <p>
+             * If true, `rssi` and `tx_power` are updated from `view` and their EIRDataType set in `res` if changed,
+             * the latter only for an extended report as its TX power is not part of the AD payload.
+             * Otherwise nothing is updated.
+             * </p>
+             */
+            bool updateUnchanged(EInfoReportView const & view, int8_t& rssi, int8_t& tx_power, EIRDataType& res) const noexcept;
+    };
+
     // *************************************************
     // *************************************************
     // *************************************************
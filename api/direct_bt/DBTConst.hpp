@@ -82,6 +82,11 @@ namespace direct_bt {
      */
     inline constexpr const jau::fraction_i64 L2CAP_CLIENT_CONNECT_TIMEOUT_MS = 1_s;
 
+    /**
+     * Period in fractions of seconds to issue deferred unpair commands, removing stale keys of newly discovered devices.
+     */
+    inline constexpr const jau::fraction_i64 DEFERRED_UNPAIR_PERIOD_MS = 250_ms;
+
     /**
      * Maximum number of enabling discovery in background in case of failure
      */
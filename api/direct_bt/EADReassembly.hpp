@@ -0,0 +1,181 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef EAD_REASSEMBLY_HPP_
+#define EAD_REASSEMBLY_HPP_
+
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <jau/basic_types.hpp>
+#include <jau/darray.hpp>
+#include <jau/eui48.hpp>
+#include <jau/ordered_atomic.hpp>
+
+#include "BTTypes0.hpp"
+
+/**
+ * - - - - - - - - - - - - - - -
+ *
+ * Module EADReassembly:
+ *
+ * - Reassembly of chained LE Extended Advertising Report fragments
+ */
+namespace direct_bt {
+
+    /** \addtogroup DBTSystemAPI
+     *
+     *  @{
+     */
+
+    /**
+     * Reassembles chained LE Extended Advertising Report fragments per address and Advertising_SID,
+     * emitting one EInfoReportView of the complete payload once its chain finishes.
+     * <p>
+     * A chain starts with a fragment of EAD_DataStatus::INCOMPLETE_MORE and ends with a fragment of
+     * - EAD_DataStatus::COMPLETE, emitting the reassembled payload with a cleared data status, or
+     * - EAD_DataStatus::INCOMPLETE_TRUNCATED, emitting the truncated payload with its data status kept.
+     * </p>
+     * <p>
+     * Unchained reports, i.e. legacy and complete reports without pending chain, pass as is without copy.
+     * </p>
+     * <p>
+     * Pending chains are dropped if not continued within their timeout, exceeding MAX_DATA_SIZE
+     * or being the oldest pending chain while the memory budget is exhausted.
+     * A dropped chain leaves a tombstone discarding its remaining fragments up to and including its finishing fragment,
+     * which otherwise would be emitted as a bogus partial payload or start a new chain.
+     * A tombstone expires if not continued within the timeout, at most MAX_TOMBSTONES are kept.
+     * </p>
+     * <p>
+     * Not thread safe, used by the single thread processing advertising reports, see HCIHandler.
+     * The statistic counters may be read by any thread.
+     * </p>
+     * <pre>
+     * BT Core Spec v5.2: Vol 4, Part E, 7.7.65.13 LE Extended Advertising Report event
+     * BT Core Spec v5.2: Vol 6, Part B, 2.3.4.9 Host Advertising Data
+     * </pre>
+     */
+    class EADReassembly {
+        public:
+            /** Maximum extended advertising payload size, i.e. the maximum reassembled data size. */
+            static constexpr const jau::nsize_t MAX_DATA_SIZE = 1650;
+
+            /** Maximum number of tombstones of dropped chains, the oldest is released if exceeded. */
+            static constexpr const jau::nsize_t MAX_TOMBSTONES = 64;
+
+        private:
+            struct Chain {
+                jau::EUI48 address;
+                uint8_t ad_address_type;
+                uint8_t sid;
+                bool scan_rsp;
+                uint64_t ts_last;
+                std::vector<uint8_t> data;
+
+                bool matches(const EInfoReportView& v) const noexcept {
+                    return address == v.getAddress() && ad_address_type == v.getADAddressType() && sid == v.getAdvSID() &&
+                           scan_rsp == is_set(v.getExtEvtType(), EAD_Event_Type::SCAN_RSP);
+                }
+            };
+
+            const uint64_t timeout_ms;
+            const jau::nsize_t budget;
+
+            jau::darray<Chain> pending; // oldest first
+            jau::darray<Chain> completed; // referenced by emitted views until next process()
+            jau::darray<Chain> tombstones; // of dropped chains without data, oldest first
+            jau::nsize_t pending_bytes;
+
+            jau::relaxed_atomic_uint64 count_fragments;
+            jau::relaxed_atomic_uint64 count_completed;
+            jau::relaxed_atomic_uint64 count_truncated;
+            jau::relaxed_atomic_uint64 count_dropped;
+            jau::relaxed_atomic_uint64 count_discarded;
+
+            /** Drops the pending chain at `idx`, leaving its tombstone. */
+            void drop(const jau::nsize_t idx, const uint64_t now) noexcept;
+            void expire(const uint64_t now) noexcept;
+            /** Appends the fragment's data to the pending chain at `idx`, returns false if the chain got dropped. */
+            bool append(const jau::nsize_t idx, const EInfoReportView& v, const uint64_t now) noexcept;
+
+        public:
+            /**
+             * @param timeout maximum time between two fragments of a chain
+             * @param budget memory budget of all pending chains in bytes, at least MAX_DATA_SIZE
+             */
+            EADReassembly(const jau::fraction_i64& timeout, const jau::nsize_t budget) noexcept;
+
+            EADReassembly(const EADReassembly&) = delete;
+            void operator=(const EADReassembly&) = delete;
+
+            /**
+             * Reassembles the extended report views in `views` starting at index `begin` in place.
+             * <p>
+             * Fragments of a continued chain are removed, the finishing fragment is replaced with a view of the
+             * reassembled payload, valid until the next call of process() or clear().
+             * </p>
+             * @param views the report views, as read by EInfoReportView::read_ext_ad_reports()
+             * @param begin the index of the first view to process
+             * @param now current monotonic time in milliseconds, used to expire pending chains
+             */
+            void process(jau::darray<EInfoReportView>& views, const jau::nsize_t begin, const uint64_t now) noexcept;
+
+            /** Drops all pending and completed chains as well as all tombstones. */
+            void clear() noexcept;
+
+            /** Returns the number of pending chains. */
+            jau::nsize_t getPendingCount() const noexcept { return pending.size(); }
+
+            /** Returns the number of bytes buffered by pending chains. */
+            jau::nsize_t getPendingBytes() const noexcept { return pending_bytes; }
+
+            /** Returns the number of fragments buffered into chains. */
+            uint64_t getFragmentCount() const noexcept { return count_fragments; }
+
+            /** Returns the number of emitted complete chains. */
+            uint64_t getCompletedCount() const noexcept { return count_completed; }
+
+            /** Returns the number of emitted truncated chains. */
+            uint64_t getTruncatedCount() const noexcept { return count_truncated; }
+
+            /** Returns the number of dropped chains due to timeout, size or memory budget. */
+            uint64_t getDroppedCount() const noexcept { return count_dropped; }
+
+            /** Returns the number of tombstones of dropped chains. */
+            jau::nsize_t getTombstoneCount() const noexcept { return tombstones.size(); }
+
+            /** Returns the number of fragments discarded by a tombstone, i.e. belonging to a dropped chain. */
+            uint64_t getDiscardedCount() const noexcept { return count_discarded; }
+
+            std::string toString() const noexcept;
+    };
+
+    /**@}*/
+
+} // namespace direct_bt
+
+#endif /* EAD_REASSEMBLY_HPP_ */
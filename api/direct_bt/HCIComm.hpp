@@ -29,12 +29,15 @@
 #include <cstring>
 #include <cstdint>
 #include <mutex>
+#include <memory>
 
 #include <jau/basic_types.hpp>
 #include <jau/functional.hpp> 
 #include <jau/secmem.hpp>
 
 #include "HCIIoctl.hpp"
+#include "HCISnoop.hpp"
+#include "IOUring.hpp"
 
 extern "C" {
     #include <pthread.h>
@@ -65,8 +68,10 @@ namespace direct_bt {
             const uint16_t dev_id;
             const uint16_t channel;
 
-        private:
+            /** Opens and binds a raw HCI socket to the given device and channel, returns the socket descriptor or -1 on error. */
             static int hci_open_dev(const uint16_t dev_id, const uint16_t channel) noexcept;
+
+        private:
             static int hci_close_dev(int dd) noexcept;
 
             std::recursive_mutex mtx_write;
@@ -74,11 +79,27 @@ namespace direct_bt {
             jau::sc_atomic_bool interrupted_intern; // for forced disconnect and read interruption via close()
             get_boolean_callback_t is_interrupted_extern; // for forced disconnect and read interruption via external event
             std::atomic<::pthread_t> tid_read;
+            std::shared_ptr<BTSnoopWriter> snoop; // optional capture of all read and written packets
+            std::mutex mtx_uring;
+            std::shared_ptr<IOUringChannel> uring; // optional io_uring backend of read() and read_batch(), created lazily
+            bool uring_failed;
+
+            /** Returns the io_uring backend if IOUringChannel::isEnabled(), lazily created with the given slot size, otherwise nullptr. */
+            std::shared_ptr<IOUringChannel> getUring(const jau::nsize_t slot_size) noexcept;
 
         public:
             /** Constructing a newly opened HCI communication channel instance */
             HCIComm(const uint16_t dev_id, const uint16_t channel) noexcept;
 
+            /**
+             * Constructing an HCI communication channel instance adopting the given opened socket descriptor,
+             * e.g. the host end of a HCIVirtualController.
+             * <p>
+             * Ownership of the socket descriptor is passed to this instance.
+             * </p>
+             */
+            HCIComm(const uint16_t dev_id, const uint16_t channel, const int socket_descriptor) noexcept;
+
             HCIComm(const HCIComm&) = delete;
             void operator=(const HCIComm&) = delete;
 
@@ -92,6 +113,17 @@ namespace direct_bt {
             /** The external `is interrupted` callback is used until close(), thereafter it is removed. */
             void set_interrupted_query(get_boolean_callback_t is_interrupted_cb) { is_interrupted_extern = std::move(is_interrupted_cb); }
 
+            /**
+             * Sets the optional btsnoop capture, receiving all subsequently read and written packets.
+             * <p>
+             * Shall be set before reading starts, passing nullptr disables capturing.
+             * </p>
+             */
+            void set_snoop(std::shared_ptr<BTSnoopWriter> snoop_) noexcept { snoop = std::move(snoop_); }
+
+            /** Returns the optional btsnoop capture, may be nullptr. */
+            const std::shared_ptr<BTSnoopWriter>& get_snoop() const noexcept { return snoop; }
+
             /** Returns true if interrupted by internal or external cause, hence shall stop connecting and reading. */
             bool interrupted() const noexcept { return interrupted_intern || ( !is_interrupted_extern.is_null() && is_interrupted_extern(0/*dummy*/) ); }
 
@@ -104,9 +136,44 @@ namespace direct_bt {
             /** Return the recursive write mutex for multithreading access. */
             inline std::recursive_mutex & mutex_write() noexcept { return mtx_write; }
 
-            /** Generic read w/ own timeout, w/o locking suitable for a unique ringbuffer sink. */
+            /**
+             * Generic read w/ own timeout, w/o locking suitable for a unique ringbuffer sink.
+             * <p>
+             * Uses the io_uring backend if IOUringChannel::isEnabled(), created with the first call's `capacity` as its slot size,
+             * otherwise `poll()` and `read()`.
+             * Hence read() and read_batch() shall not be mixed on the same instance.
+             * </p>
+             */
             jau::snsize_t read(uint8_t* buffer, const jau::nsize_t capacity, const jau::fraction_i64& timeout) noexcept;
 
+            /** Maximum number of packet slots read_batch() drains per call, see read_batch(). */
+            constexpr static const jau::nsize_t MAX_BATCH_SLOTS = 64;
+
+            /**
+             * Batched read w/ own timeout, w/o locking suitable for a unique ringbuffer sink.
+             * <p>
+             * Waits for the socket to become readable as read() does,
+             * then drains all queued packets up to `slot_count` via a single non-blocking `recvmmsg()`,
+             * i.e. at most two system calls for a whole burst of packets.
+             * </p>
+             * <p>
+             * Uses the io_uring backend if IOUringChannel::isEnabled(), created with the first call's `slot_capacity` as its slot size,
+             * taking all packets received by its multishot receive via IOUringChannel::read_batch().
+             * </p>
+             * <p>
+             * Packet `i` is stored at `buffer + i * slot_capacity` with its length in `lengths[i]`.
+             * `slot_count` is clamped to MAX_BATCH_SLOTS.
+             * </p>
+             * @param buffer destination of `slot_count * slot_capacity` bytes
+             * @param slot_capacity capacity of each packet slot, shall be at least the maximum packet size
+             * @param slot_count number of packet slots in `buffer` and `lengths`
+             * @param lengths destination of the received packet lengths
+             * @param timeout poll timeout, zero for no poll
+             * @return number of received packets, zero if none queued or the peer has shutdown, or -1 on error and timeout with `errno` set
+             */
+            jau::snsize_t read_batch(uint8_t* buffer, const jau::nsize_t slot_capacity, const jau::nsize_t slot_count,
+                                     jau::nsize_t* lengths, const jau::fraction_i64& timeout) noexcept;
+
             /** Generic write, locking {@link #mutex_write()}. */
             jau::snsize_t write(const uint8_t* buffer, const jau::nsize_t size) noexcept;
 
@@ -30,8 +30,11 @@
 #include <string>
 #include <cstdint>
 #include <array>
+#include <vector>
+#include <unordered_map>
 
 #include <mutex>
+#include <condition_variable>
 #include <atomic>
 #include <thread>
 
@@ -46,8 +49,11 @@
 #include "BTTypes0.hpp"
 #include "BTIoctl.hpp"
 #include "HCIComm.hpp"
+#include "HCIVirtualController.hpp"
 #include "HCITypes.hpp"
 #include "MgmtTypes.hpp"
+#include "ScanFilter.hpp"
+#include "EADReassembly.hpp"
 
 /**
  * - - - - - - - - - - - - - - -
@@ -88,6 +94,19 @@ namespace direct_bt {
              */
             const jau::fraction_i64 HCI_READER_THREAD_POLL_TIMEOUT;
 
+            /**
+             * Maximum number of HCI packets drained by the HCI reader thread per wakeup, defaults to 16.
+             * <p>
+             * All queued packets up to this number are received via one batched read
+             * and dispatched in one pass, see HCIComm::read_batch().
+             * A value of 1 resembles reading one packet per wakeup.
+             * </p>
+             * <p>
+             * Environment variable is 'direct_bt.hci.reader.batch', value range [1..64].
+             * </p>
+             */
+            const int32_t HCI_READER_BATCH_SIZE;
+
             /**
              * Timeout for HCI command status replies, excluding command complete, defaults to 3s.
              * <p>
@@ -119,7 +138,10 @@ namespace direct_bt {
             const jau::fraction_i64 HCI_COMMAND_POLL_PERIOD;
 
             /**
-             * Small ringbuffer capacity for synchronized commands, defaults to 64 messages.
+             * Maximum number of queued replies per outstanding HCI command, defaults to 64 messages.
+             * <p>
+             * Replies are routed to their outstanding command by opcode, see HCIHandler::getCommandCredits().
+             * </p>
              * <p>
              * Environment variable is 'direct_bt.hci.ringsize'.
              * </p>
@@ -142,6 +164,104 @@ namespace direct_bt {
              */
             const bool DEBUG_SCAN_AD_EIR;
 
+            /**
+             * Process LE (extended) advertising reports on a dedicated worker thread, defaults to false.
+             * <p>
+             * If enabled, the HCI reader thread merely copies raw advertising report events into a bounded ringbuffer,
+             * while the worker thread parses them and issues the MgmtEvtDeviceFound callbacks,
+             * i.e. BTAdapter's device lookup and user AdapterStatusListener::deviceFound() code.<br>
+             * This decouples HCI command replies from slow callbacks during heavy scanning.
+             * </p>
+             * <p>
+             * Environment variable is 'direct_bt.hci.adv.worker'.
+             * </p>
+             */
+            const bool HCI_ADV_WORKER;
+
+            /**
+             * Ringbuffer capacity of raw advertising report events for the worker thread, defaults to 256 events.
+             * <p>
+             * In case the ringbuffer is full, the oldest event is dropped in favor of the newest, see HCIHandler::getAdvReportsDropped().
+             * </p>
+             * <p>
+             * Only used if HCI_ADV_WORKER is enabled.
+             * </p>
+             * <p>
+             * Environment variable is 'direct_bt.hci.adv.ringsize', value range [64..8192].
+             * </p>
+             */
+            const int32_t HCI_ADV_RING_CAPACITY;
+
+            /**
+             * Coalesce queued advertising reports per address, defaults to true.
+             * <p>
+             * If enabled, the worker thread drains all queued advertising report events at once
+             * and merges multiple reports of the same address and PDU kind into one, see HCIHandler::getAdvReportsCoalesced().<br>
+             * Advertising indications and scan responses are never merged, preserving their EInfoReport::Source split.<br>
+             * Otherwise, each report is delivered and only the drop-oldest policy applies on overflow.
+             * </p>
+             * <p>
+             * Only used if HCI_ADV_WORKER is enabled.
+             * </p>
+             * <p>
+             * Environment variable is 'direct_bt.hci.adv.coalesce'.
+             * </p>
+             */
+            const bool HCI_ADV_COALESCE;
+
+            /**
+             * Maximum time between two fragments of a chained extended advertising report, defaults to 2s.
+             * <p>
+             * Pending chains not continued in time are dropped, see EADReassembly.
+             * </p>
+             * <p>
+             * Environment variable is 'direct_bt.hci.ead.timeout'.
+             * </p>
+             */
+            const jau::fraction_i64 HCI_EAD_REASSEMBLY_TIMEOUT;
+
+            /**
+             * Memory budget of all pending chained extended advertising reports in bytes, defaults to 16384 bytes.
+             * <p>
+             * The oldest pending chain is dropped if exceeded, see EADReassembly.
+             * </p>
+             * <p>
+             * Environment variable is 'direct_bt.hci.ead.budget', value range [1650..1048576].
+             * </p>
+             */
+            const int32_t HCI_EAD_REASSEMBLY_BUDGET;
+
+            /**
+             * File name prefix of an optional btsnoop capture of all HCI packets, defaults to empty, i.e. disabled.
+             * <p>
+             * If set, each opened HCIHandler writes all read and written HCI packets
+             * to `<prefix>-hci<dev_id>.btsnoop`, see BTSnoopWriter and HCIHandler::replay().
+             * </p>
+             * <p>
+             * Environment variable is 'direct_bt.hci.snoop'.
+             * </p>
+             */
+            const std::string HCI_SNOOP_FILE;
+
+            /**
+             * Derive the kernel socket filter from the actually consumed events, defaults to true.
+             * <p>
+             * If enabled, the kernel `hci_ufilter` event mask and an attached classic BPF socket filter for LE meta events
+             * only pass events with registered MgmtEvent callbacks and LE advertising reports only while scanning.<br>
+             * Connection related events pass regardless of the connection state,
+             * as they may follow a connection not initiated by this host, e.g. via the whitelist, ahead of its tracking.<br>
+             * The filter is updated whenever the registered callbacks, scan or periodic advertising sync state change,
+             * hence unwanted events never cross the kernel boundary.
+             * </p>
+             * <p>
+             * If disabled, all processed events pass the kernel filter.
+             * </p>
+             * <p>
+             * Environment variable is 'direct_bt.hci.kernel_filter'.
+             * </p>
+             */
+            const bool HCI_KERNEL_FILTER;
+
         private:
             /** Maximum number of packets to wait for until matching a sequential command. Won't block as timeout will limit. */
             const int32_t HCI_READ_PACKET_MAX_RETRY;
@@ -167,6 +287,135 @@ namespace direct_bt {
                                const SMPPDUMsg&, const HCIACLData::l2cap_frame& /* source */)> HCISMPMsgCallback;
     typedef jau::cow_darray<HCISMPMsgCallback> HCISMPMsgCallbackList;
 
+    /**
+     * LE periodic advertising sync state of one advertising train, see HCIHandler::le_create_periodic_adv_sync().
+     * <pre>
+     * BT Core Spec v5.2: Vol 4, Part E, 7.7.65.14 LE Periodic Advertising Sync Established event
+     * BT Core Spec v5.2: Vol 4, Part E, 7.7.65.16 LE Periodic Advertising Sync Lost event
+     * </pre>
+     */
+    struct PeriodicAdvSync {
+        /** HCIStatusCode::SUCCESS if established, otherwise the failure status, e.g. HCIStatusCode::OPERATION_CANCELLED_BY_HOST */
+        HCIStatusCode status;
+        /** Sync handle, valid if established */
+        uint16_t sync_handle;
+        /** Advertising_SID of the train */
+        uint8_t adv_sid;
+        BDAddressAndType address;
+        LE_PHYs phy;
+        /** Periodic advertising interval in units of 1.25ms */
+        uint16_t interval;
+        /** True if an established sync has been lost or terminated */
+        bool lost;
+
+        std::string toString() const noexcept;
+    };
+
+    /**
+     * Non-owning view of one LE Periodic Advertising Report, valid during HCIPeriodicAdvReportCallback only.
+     * <p>
+     * Chained payloads are delivered as is, each fragment with its EAD_DataStatus.
+     * </p>
+     * <pre>
+     * BT Core Spec v5.2: Vol 4, Part E, 7.7.65.15 LE Periodic Advertising Report event
+     * </pre>
+     */
+    struct PeriodicAdvReport {
+        uint16_t sync_handle;
+        int8_t tx_power;
+        int8_t rssi;
+        uint8_t cte_type;
+        EAD_DataStatus data_status;
+        /** Raw AD data, see EInfoReport::read_data() */
+        uint8_t const * data;
+        uint8_t data_len;
+    };
+
+    /** Callback on periodic advertising sync establishment, failure or loss. */
+    typedef jau::function<void(const PeriodicAdvSync&)> HCIPeriodicAdvSyncCallback;
+    typedef jau::cow_darray<HCIPeriodicAdvSyncCallback> HCIPeriodicAdvSyncCallbackList;
+
+    /** Callback on each periodic advertising report, issued on the HCI reader thread and hence shall return quickly. */
+    typedef jau::function<void(const PeriodicAdvReport&)> HCIPeriodicAdvReportCallback;
+    typedef jau::cow_darray<HCIPeriodicAdvReportCallback> HCIPeriodicAdvReportCallbackList;
+
+    /**
+     * One BT5 extended advertising set, see HCIHandler::le_start_ext_adv().
+     * <p>
+     * Using legacy PDUs (default), the set behaves like legacy advertising:
+     * Up to 31 bytes of advertising and scan response data each, primary PHY LE_PHYs::LE_1M only.
+     * </p>
+     * <p>
+     * Using extended PDUs, the advertising data is carried on the secondary PHY
+     * with up to HCIHandler::getExtAdvMaxDataLength() bytes, i.e. max 1650 bytes.
+     * Extended PDUs are either connectable (AD_PDU_Type::ADV_IND), scannable (AD_PDU_Type::ADV_SCAN_IND)
+     * or neither (AD_PDU_Type::ADV_NONCONN_IND), hence the data selected by adv_mask and scanrsp_mask
+     * is merged into the advertising data, or into the scan response data for a scannable set.
+     * </p>
+     * <pre>
+     * BT Core Spec v5.2: Vol 4 HCI, Part E HCI Functional: 7.8.53 LE Set Extended Advertising Parameters command (Bluetooth 5.0)
+     * </pre>
+     */
+    struct ExtAdvSet {
+        /** Maximum Advertising_Data_Length of all fragments, BT Core Spec v5.2: Vol 4, Part E, 7.8.57 */
+        constexpr static const jau::nsize_t MAX_DATA_SIZE = 1650;
+        /** Maximum Advertising_Handle value */
+        constexpr static const uint8_t MAX_HANDLE = 0xEF;
+
+        /** Advertising_Handle, unique per set; Value range [0x00 .. 0xEF] */
+        uint8_t handle = 0x00;
+        /** Advertising_SID, see EInfoReportView::getAdvSID(); Value range [0x00 .. 0x0F] */
+        uint8_t sid = 0x00;
+        /** Full ADV EIR of this set */
+        EInfoReport eir;
+        /** EIRDataType mask for the advertisement EIR PDU data */
+        EIRDataType adv_mask = EIRDataType::FLAGS | EIRDataType::SERVICE_UUID;
+        /** EIRDataType mask for the scan-response (active scanning) EIR PDU data */
+        EIRDataType scanrsp_mask = EIRDataType::NAME | EIRDataType::CONN_IVAL;
+        /** AD_PDU_Type::ADV_IND (default), AD_PDU_Type::ADV_SCAN_IND or AD_PDU_Type::ADV_NONCONN_IND */
+        AD_PDU_Type adv_type = AD_PDU_Type::ADV_IND;
+        /** Use legacy PDUs, default true */
+        bool legacy_pdu = true;
+        /** Primary advertising PHY, LE_PHYs::LE_1M (default) or LE_PHYs::LE_CODED for extended PDUs */
+        LE_PHYs primary_phy = LE_PHYs::LE_1M;
+        /** Secondary advertising PHY of extended PDUs, LE_PHYs::LE_1M (default), LE_PHYs::LE_2M or LE_PHYs::LE_CODED */
+        LE_PHYs secondary_phy = LE_PHYs::LE_1M;
+        /** In units of 0.625ms, default value 160 for 100ms; Value range [0x0020 .. 0x4000] for [20ms .. 10.24s] */
+        uint16_t adv_interval_min = 160;
+        /** In units of 0.625ms, default value 480 for 300ms; Value range [0x0020 .. 0x4000] for [20ms .. 10.24s] */
+        uint16_t adv_interval_max = 480;
+        /** Bit 0: chan 37, bit 1: chan 38, bit 2: chan 39, default is 0x07 (all 3 channels enabled) */
+        uint8_t adv_chan_map = 0x07;
+        /** 0x00 accepts all PDUs (default), 0x01 only of whitelisted, ... */
+        uint8_t filter_policy = 0x00;
+        /** Advertising_TX_Power in dBm, 0x7f for no host preference (default) */
+        int8_t tx_power = 0x7f;
+        /** Random address of this set, i.e. a separate identity, or EUI48::ANY_DEVICE (default) to use the given own address type */
+        EUI48 random_address = EUI48::ANY_DEVICE;
+
+        /** Returns true if this set is connectable, i.e. of AD_PDU_Type::ADV_IND. */
+        bool isConnectable() const noexcept { return AD_PDU_Type::ADV_IND == adv_type || AD_PDU_Type::ADV_IND2 == adv_type; }
+
+        /** Returns true if this set is scannable, i.e. AD_PDU_Type::ADV_SCAN_IND or a connectable set using legacy PDUs. */
+        bool isScannable() const noexcept {
+            return AD_PDU_Type::ADV_SCAN_IND == adv_type || AD_PDU_Type::SCAN_IND2 == adv_type || ( legacy_pdu && isConnectable() );
+        }
+
+        /**
+         * Returns the Advertising_Event_Properties of this set,
+         * i.e. an AD_PDU_Type::ADV_IND2 variant for legacy PDUs.
+         */
+        uint16_t getEventProperties() const noexcept;
+
+        /**
+         * Validates this set's parameter.
+         * @return HCIStatusCode::SUCCESS if valid, otherwise HCIStatusCode::INVALID_PARAMS
+         */
+        HCIStatusCode validate() const noexcept;
+
+        std::string toString() const noexcept;
+    };
+
     /**
      * A thread safe singleton handler of the HCI control channel to one controller (BT adapter)
      * <p>
@@ -191,16 +440,29 @@ namespace direct_bt {
                 private:
                     BDAddressAndType visibleAddressAndType; // immutable
                     BDAddressAndType addressAndType; // mutable
-                    uint16_t handle; // mutable
+                    /** Mutable under mtx_connectionList, read lock-free via the copy-on-write handle index. */
+                    jau::relaxed_atomic_uint16 handle;
 
                 public:
                     HCIConnection(const BDAddressAndType& addressAndType_, const uint16_t handle_)
                     : visibleAddressAndType(addressAndType_), addressAndType(addressAndType_), handle(handle_) {}
 
-                    HCIConnection(const HCIConnection &o) = default;
-                    HCIConnection(HCIConnection &&o) = default;
-                    HCIConnection& operator=(const HCIConnection &o) = default;
-                    HCIConnection& operator=(HCIConnection &&o) = default;
+                    HCIConnection(const HCIConnection &o) noexcept
+                    : visibleAddressAndType(o.visibleAddressAndType), addressAndType(o.addressAndType), handle(o.handle.load()) {}
+                    HCIConnection(HCIConnection &&o) noexcept
+                    : visibleAddressAndType(std::move(o.visibleAddressAndType)), addressAndType(std::move(o.addressAndType)), handle(o.handle.load()) {}
+                    HCIConnection& operator=(const HCIConnection &o) noexcept {
+                        visibleAddressAndType = o.visibleAddressAndType;
+                        addressAndType = o.addressAndType;
+                        handle = o.handle.load();
+                        return *this;
+                    }
+                    HCIConnection& operator=(HCIConnection &&o) noexcept {
+                        visibleAddressAndType = std::move(o.visibleAddressAndType);
+                        addressAndType = std::move(o.addressAndType);
+                        handle = o.handle.load();
+                        return *this;
+                    }
 
                     const BDAddressAndType & getVisibleAddressAndType() const { return visibleAddressAndType; }
                     const BDAddressAndType & getAddressAndType() const { return addressAndType; }
@@ -229,7 +491,7 @@ namespace direct_bt {
 
                     std::string toString() const {
                         std::string resaddr_s = visibleAddressAndType != addressAndType ? ", visible "+visibleAddressAndType.toString() : "";
-                        return "HCIConnection[handle "+jau::to_hexstring(handle)+
+                        return "HCIConnection[handle "+jau::to_hexstring(handle.load())+
                                ", address "+addressAndType.toString()+resaddr_s+"]";
                     }
             };
@@ -238,11 +500,63 @@ namespace direct_bt {
             typedef jau::darray<HCIConnectionRef, size_type> HCIConnectionRefList_t;
 
         private:
+            /**
+             * Tracked HCIConnection list, hash-indexed by visible and resolved BDAddressAndType as well as by non-zero connection handle.
+             * <p>
+             * All modifications and the address lookup require the caller to hold mtx_connectionList.
+             * </p>
+             * <p>
+             * The handle lookup findHandle() is lock-free using a copy-on-write snapshot of the handle index,
+             * allowing the HCI reader thread to resolve each received packet's handle without contention.
+             * </p>
+             */
+            class HCIConnectionList {
+                public:
+                    typedef std::unordered_map<uint16_t, HCIConnectionRef> handle_map_t;
+
+                private:
+                    HCIConnectionRefList_t list; // insertion order
+                    std::unordered_map<BDAddressAndType, HCIConnectionRef> byAddress; // visible and resolved address
+                    std::shared_ptr<handle_map_t> byHandle; // copy-on-write, published under sync_byHandle
+                    mutable jau::sc_atomic_bool sync_byHandle;
+
+                    void putHandle(const HCIConnectionRef& conn) noexcept;
+                    void removeHandle(const HCIConnectionRef& conn) noexcept;
+                    void removeAddress(const HCIConnectionRef& conn) noexcept;
+
+                public:
+                    HCIConnectionList() noexcept
+                    : byHandle( std::make_shared<handle_map_t>() ), sync_byHandle(false) {}
+
+                    HCIConnectionList(const HCIConnectionList&) = delete;
+                    void operator=(const HCIConnectionList&) = delete;
+
+                    size_type size() const noexcept { return list.size(); }
+                    const HCIConnectionRefList_t& entries() const noexcept { return list; }
+
+                    /** Returns the connection matching the given visible or resolved address, otherwise nullptr. */
+                    HCIConnectionRef findAddress(const BDAddressAndType& addressAndType) const noexcept;
+
+                    /** Returns the connection with the given non-zero handle, otherwise nullptr. Lock-free. */
+                    HCIConnectionRef findHandle(const uint16_t handle) const noexcept;
+
+                    HCIConnectionRef add(const BDAddressAndType& addressAndType, const uint16_t handle);
+                    void setHandle(const HCIConnectionRef& conn, const uint16_t handle) noexcept;
+                    void setResolvAddrAndType(const HCIConnectionRef& conn, const BDAddressAndType& addressAndType) noexcept;
+                    /** Removes the given connection, matched by identity. */
+                    bool remove(const HCIConnectionRef& conn) noexcept;
+                    void clear() noexcept;
+            };
 
             static MgmtEvent::Opcode translate(HCIEventType evt, HCIMetaEventType met) noexcept;
 
             const uint16_t dev_id;
+            /** True if connected to a HCIVirtualController instead of a kernel HCI device */
+            const bool virtual_ctrl;
+            /** Batched read buffer of HCIEnv::HCI_READER_BATCH_SIZE slots of HCI_MAX_MTU each */
             jau::POctets rbuffer;
+            /** Received packet length per rbuffer slot */
+            std::vector<jau::nsize_t> rbuffer_lens;
             HCIComm comm;
             hci_ufilter filter_mask;
             std::atomic<uint32_t> metaev_filter_mask;
@@ -262,10 +576,103 @@ namespace direct_bt {
             constexpr static void filter_all_opcbit(uint64_t &mask) noexcept { mask=0xffffffffffffffffUL; }
             inline static void filter_set_opcbit(HCIOpcodeBit opcbit, uint64_t &mask) noexcept { jau::set_bit_uint64(number(opcbit), mask); }
 
+            /** Guards the kernel socket filter, see updateEventFilter(). Acquired after mtx_connectionList. */
+            std::mutex mtx_filter;
+            /** LE meta event mask of the attached kernel BPF socket filter, zero if none */
+            uint32_t kfilter_metaev_mask;
+            /** LE scan enable in flight, passing advertising reports ahead of the command */
+            jau::sc_atomic_bool kfilter_scan_pending;
+            jau::relaxed_atomic_uint64 kfilter_updates;
+
+            /**
+             * Computes the minimal set of events from the registered callbacks, scan and periodic advertising sync state
+             * and installs it as kernel `hci_ufilter` and BPF socket filter if changed, see HCIEnv::HCI_KERNEL_FILTER.
+             * @return false if the mandatory `hci_ufilter` could not be set
+             */
+            bool updateEventFilter() noexcept;
+
             jau::service_runner hci_reader_service;
-            jau::ringbuffer<std::unique_ptr<HCIEvent>, jau::nsize_t> hciEventRing;
 
-            std::recursive_mutex mtx_sendReply; // for sendWith*Reply, process*Command, ..; Recurses from many..
+            /**
+             * Outstanding HCI command awaiting its CMD_STATUS and/or CMD_COMPLETE reply,
+             * registered via submitCommand() and retired latest at destruction.
+             */
+            class HCICmdWaiter {
+                public:
+                    HCIHandler& hci;
+                    const HCIOpcode opcode;
+                    /** Routed replies not yet consumed, guarded by mtx_cmdWaiters */
+                    jau::darray<std::unique_ptr<HCIEvent>> replies;
+                    /** True if sent and its command credit not yet returned by a routed reply, guarded by mtx_cmdWaiters */
+                    bool credit_pending;
+
+                    HCICmdWaiter(HCIHandler& hci_, const HCIOpcode opcode_) noexcept
+                    : hci(hci_), opcode(opcode_), credit_pending(false) {}
+
+                    HCICmdWaiter(const HCICmdWaiter&) = delete;
+                    void operator=(const HCICmdWaiter&) = delete;
+
+                    ~HCICmdWaiter() noexcept { hci.retireCommand(*this); }
+            };
+            std::mutex mtx_cmdWaiters;
+            std::condition_variable cv_cmdWaiters;
+            /** Outstanding commands in submission order, guarded by mtx_cmdWaiters */
+            jau::darray<HCICmdWaiter*> cmdWaiters;
+            /**
+             * Num_HCI_Command_Packets credits as last announced by the controller with a reply to an outstanding command
+             * or a NOP, modified under mtx_cmdWaiters.
+             */
+            jau::relaxed_atomic_int32 cmd_credits;
+            jau::relaxed_atomic_uint64 cmd_replies_unrouted;
+
+            /** Raw LE (extended) advertising report event parameter, passed from the reader to the advertising worker. */
+            struct HCIAdvReportSlot {
+                uint64_t timestamp;
+                HCIMetaEventType type;
+                uint8_t size;
+                uint8_t param[HCI_MAX_MTU];
+            };
+            jau::service_runner hci_adv_service;
+            jau::ringbuffer<HCIAdvReportSlot, jau::nsize_t> hciAdvRing;
+            jau::relaxed_atomic_uint64 adv_reports_enqueued;
+            jau::relaxed_atomic_uint64 adv_reports_dropped;
+            jau::relaxed_atomic_uint64 adv_reports_coalesced;
+            jau::relaxed_atomic_uint64 adv_reports_filtered;
+            /** Coalescing key of hciAdvWork(), merging only reports of the same address and EInfoReport::Source, i.e. PDU kind. */
+            struct HCIAdvCoalesceKey {
+                BDAddressAndType addressAndType;
+                EInfoReport::Source source;
+
+                bool operator==(const HCIAdvCoalesceKey& o) const noexcept {
+                    return source == o.source && addressAndType == o.addressAndType;
+                }
+            };
+            struct HCIAdvCoalesceKeyHash {
+                std::size_t operator()(const HCIAdvCoalesceKey& k) const noexcept {
+                    return ( k.addressAndType.hash_code() << 2 ) ^ static_cast<std::size_t>( EInfoReport::number(k.source) );
+                }
+            };
+            /** Coalescing key to latest report index, used by hciAdvWork() to coalesce reports only. */
+            std::unordered_map<HCIAdvCoalesceKey, jau::nsize_t, HCIAdvCoalesceKeyHash> hciAdvCoalesceIndex;
+
+            /** Chained extended advertising report reassembly, used by the thread processing advertising reports. */
+            EADReassembly eadReassembly;
+            /** Report views of one event, reused by the thread processing advertising reports and cleared per event w/o releasing its storage. */
+            jau::darray<EInfoReportView> advViews;
+            /** Materialized reports of one coalesced backlog, reused by hciAdvWork() and cleared per backlog w/o releasing its storage. */
+            jau::darray<std::unique_ptr<EInfoReport>> advReports;
+
+            /** Scan pre-filter, nullptr if none. Copy-on-write, published under sync_scanFilter. */
+            std::shared_ptr<const ScanFilter> scanFilter;
+            mutable jau::sc_atomic_bool sync_scanFilter;
+
+            /** Per address state of the scan pre-filter, used by the thread processing advertising reports. */
+            ScanFilterTracker scanFilterTracker;
+
+            /** Stage statistics of a running replay(), nullptr otherwise. */
+            HCIReplayStats* replay_stats;
+
+            std::recursive_mutex mtx_sendReply; // for multi-command sequences and their steps, e.g. scan, advertising and adapter state; Recurses from many..
 
             LE_Features le_ll_feats;
             /**
@@ -277,21 +684,38 @@ namespace direct_bt {
              */
             uint8_t sup_commands[64];
             jau::relaxed_atomic_bool sup_commands_set;
+            /** Cached number of supported extended advertising sets, zero if not yet queried, see getExtAdvMaxSets() */
+            uint8_t ext_adv_max_sets;
+            /** Cached maximum extended advertising data length, see getExtAdvMaxDataLength() */
+            uint16_t ext_adv_max_data_len;
 
             jau::sc_atomic_bool allowClose;
             std::atomic<BTMode> btMode;
 
             std::atomic<ScanType> currentScanType;
+            /** True if any advertising set is enabled, see advSetsEnabled */
             jau::sc_atomic_bool advertisingEnabled;
-
-            HCIConnectionRefList_t connectionList;
-            HCIConnectionRefList_t disconnectCmdList;
+            /** Enabled advertising set handles as a bitmask, handle 0 for legacy advertising. */
+            uint64_t advSetsEnabled[4];
+            /** Guards advSetsEnabled, also used by the reader thread and hence independent of mtx_sendReply. */
+            std::mutex mtx_advSets;
+
+            /** LE periodic advertising create sync in flight, passing its events through the kernel filter */
+            jau::sc_atomic_bool periodicAdvSyncPending;
+            jau::relaxed_atomic_uint64 periodic_reports;
+            /** Established LE periodic advertising syncs */
+            jau::darray<PeriodicAdvSync> periodicAdvSyncs;
+            /** Guards periodicAdvSyncs. Acquired after mtx_connectionList. */
+            std::mutex mtx_periodicAdvSync;
+
+            HCIConnectionList connectionList;
+            HCIConnectionList disconnectCmdList;
             std::recursive_mutex mtx_connectionList; // Recurses from disconnect -> findTrackerConnection, addOrUpdateTrackerConnection
 
             /** Exclusive [le] connection command (status + pending completed) one at a time */
             std::mutex mtx_connect_cmd;
 
-            HCIConnectionRef setResolvHCIConnectionAddr(jau::darray<HCIConnectionRef> &list,
+            HCIConnectionRef setResolvHCIConnectionAddr(HCIConnectionList &list,
                                                         const BDAddressAndType& visibleAddressAndType, const BDAddressAndType& addressAndType) noexcept;
 
         public:
@@ -313,7 +737,7 @@ namespace direct_bt {
              * @param addrType key to matching connection
              * @param handle ignored for existing tracker _if_ invalid, i.e. zero.
              */
-            HCIConnectionRef addOrUpdateHCIConnection(HCIConnectionRefList_t& list,
+            HCIConnectionRef addOrUpdateHCIConnection(HCIConnectionList& list,
                                                       const BDAddressAndType& addressAndType, const uint16_t handle) noexcept;
             HCIConnectionRef addOrUpdateTrackerConnection(const BDAddressAndType& addressAndType, const uint16_t handle) noexcept {
                 return addOrUpdateHCIConnection(connectionList, addressAndType, handle);
@@ -322,7 +746,7 @@ namespace direct_bt {
                 return addOrUpdateHCIConnection(disconnectCmdList, addressAndType, handle);
             }
 
-            HCIConnectionRef findHCIConnection(HCIConnectionRefList_t& list, const BDAddressAndType& addressAndType) noexcept;
+            HCIConnectionRef findHCIConnection(HCIConnectionList& list, const BDAddressAndType& addressAndType) noexcept;
             HCIConnectionRef findTrackerConnection(const BDAddressAndType& addressAndType) noexcept {
                 return findHCIConnection(connectionList, addressAndType);
             }
@@ -330,19 +754,20 @@ namespace direct_bt {
                 return findHCIConnection(disconnectCmdList, addressAndType);
             }
 
+            /** Lock-free for non-zero handles, see HCIConnectionList::findHandle(). */
             HCIConnectionRef findTrackerConnection(const uint16_t handle) noexcept;
             HCIConnectionRef removeTrackerConnection(const HCIConnectionRef& conn) noexcept;
             size_type countPendingTrackerConnections() noexcept;
             size_type getTrackerConnectionCount() noexcept;
 
-            HCIConnectionRef removeHCIConnection(HCIConnectionRefList_t& list, const uint16_t handle) noexcept;
+            HCIConnectionRef removeHCIConnection(HCIConnectionList& list, const uint16_t handle) noexcept;
             HCIConnectionRef removeTrackerConnection(const uint16_t handle) noexcept {
                 return removeHCIConnection(connectionList, handle);
             }
             HCIConnectionRef removeDisconnectCmd(const uint16_t handle) noexcept {
                 return removeHCIConnection(disconnectCmdList, handle);
             }
-            void dumpHCIConnections(const char *msg, jau::darray<HCIConnectionRef> &list) noexcept;
+            void dumpHCIConnections(const char *msg, HCIConnectionList &list) noexcept;
 
 
             /** One MgmtAdapterEventCallbackList per event type, allowing multiple callbacks to be invoked for each event */
@@ -352,17 +777,71 @@ namespace direct_bt {
             }
 
             HCISMPMsgCallbackList hciSMPMsgCallbackList;
+            HCIPeriodicAdvSyncCallbackList hciPeriodicAdvSyncCallbackList;
+            HCIPeriodicAdvReportCallbackList hciPeriodicAdvReportCallbackList;
 
             std::unique_ptr<MgmtEvent> translate(HCIEvent& ev) noexcept;
             std::unique_ptr<MgmtEvent> translate(HCICommand& ev) noexcept;
 
             std::unique_ptr<const SMPPDUMsg> getSMPPDUMsg(const HCIACLData::l2cap_frame & l2cap, const uint8_t * l2cap_data) const noexcept;
             void hciReaderWork(jau::service_runner& sr) noexcept;
+            void hciReaderProcess(const uint8_t* buffer, const jau::nsize_t len) noexcept;
+            void hciAdvEnqueue(const HCIMetaEventType mec, const uint8_t* param, const jau::nsize_t param_size) noexcept;
+            void hciAdvWork(jau::service_runner& sr) noexcept;
+            void hciAdvEndLocked(jau::service_runner& sr) noexcept;
+            void readAdvReports(const HCIMetaEventType mec, const uint8_t* param, const jau::nsize_t param_size, const uint64_t timestamp,
+                                jau::darray<std::unique_ptr<EInfoReport>>& eirlist) noexcept;
+            void sendAdvReports(jau::darray<std::unique_ptr<EInfoReport>>& eirlist) noexcept;
+            /**
+             * Reads the reports as non-owning views into `param`, not decoding any AD structure.
+             * <p>
+             * Chained extended reports are reassembled, emitted views of reassembled payloads stay valid
+             * until the next call, see EADReassembly.
+             * </p>
+             * <p>
+             * Reports not matching the ScanFilter are skipped, see setScanFilter().
+             * </p>
+             */
+            void readAdvReports(const HCIMetaEventType mec, const uint8_t* param, const jau::nsize_t param_size, const uint64_t timestamp,
+                                jau::darray<EInfoReportView>& eirlist) noexcept;
+            /** Dispatches LE_PERIODIC_ADV_SYNC_ESTABLISHED, LE_PERIODIC_ADV_REPORT and LE_PERIODIC_ADV_SYNC_LOST, bypassing MgmtEvent translation. */
+            void processPeriodicAdvEvent(const HCIMetaEventType mec, const uint8_t* param, const jau::nsize_t param_size) noexcept;
+            /** Dispatches LE_ADV_SET_TERMINATED, ending advertising of the terminated set only. */
+            void processAdvSetTerminated(const uint8_t* param, const jau::nsize_t param_size) noexcept;
+            /**
+             * Sets the enabled state of the given advertising set handles, or of all sets if `count` is zero,
+             * updating advertisingEnabled.
+             */
+            void setAdvSetsEnabled(const bool enable, const uint8_t* handles, const jau::nsize_t count) noexcept;
+            /** Removes the tracked sync of the given handle, returning it as lost via `res`. */
+            bool removePeriodicAdvSync(const uint16_t sync_handle, PeriodicAdvSync& res) noexcept;
+            /** Sends the report views, valid while their referenced `param` is, materializing EInfoReport only on demand. */
+            void sendAdvReports(const jau::darray<EInfoReportView>& eirlist) noexcept;
             void hciReaderEndLocked(jau::service_runner& sr) noexcept;
 
             bool sendCommand(HCICommand &req, const bool quiet=false) noexcept;
-            std::unique_ptr<HCIEvent> getNextReply(HCICommand &req, int32_t & retryCount, const jau::fraction_i64& replyTimeout) noexcept;
-            std::unique_ptr<HCIEvent> getNextCmdCompleteReply(HCICommand &req, HCICommandCompleteEvent **res) noexcept;
+            /**
+             * Registers the given waiter as outstanding command and sends the command once a controller credit is available.
+             * <p>
+             * Multiple commands may be outstanding if the controller announces more than one Num_HCI_Command_Packets credit,
+             * their replies are routed to the oldest waiter of the same opcode.
+             * </p>
+             * @return true if sent, otherwise the waiter has been retired
+             */
+            bool submitCommand(HCICommand &req, HCICmdWaiter& waiter, const bool quiet=false) noexcept;
+            void retireCommand(HCICmdWaiter& waiter) noexcept;
+            /**
+             * Returns the credit of the given waiter whose command has not been replied, e.g. after a reply timeout or send failure,
+             * assuming the controller dropped the command. Requires mtx_cmdWaiters.
+             */
+            void releaseCreditLocked(HCICmdWaiter& waiter) noexcept;
+            /**
+             * Routes a CMD_STATUS or CMD_COMPLETE reply to its outstanding command and updates the credits,
+             * ignoring the credits of unrouted replies, e.g. of a foreign HCI user or a timed out command.
+             */
+            void hciCmdReply(std::unique_ptr<HCIEvent> event) noexcept;
+            std::unique_ptr<HCIEvent> getNextReply(HCICommand &req, HCICmdWaiter& waiter, const jau::fraction_i64& replyTimeout) noexcept;
+            std::unique_ptr<HCIEvent> getNextCmdCompleteReply(HCICommand &req, HCICmdWaiter& waiter, HCICommandCompleteEvent **res) noexcept;
 
             std::unique_ptr<HCIEvent> processCommandStatus(HCICommand &req, HCIStatusCode *status, const bool quiet=false) noexcept;
 
@@ -371,7 +850,7 @@ namespace direct_bt {
                                                              const hci_cmd_event_struct **res, HCIStatusCode *status,
                                                              const bool quiet=false) noexcept;
             template<typename hci_cmd_event_struct>
-            std::unique_ptr<HCIEvent> receiveCommandComplete(HCICommand &req,
+            std::unique_ptr<HCIEvent> receiveCommandComplete(HCICommand &req, HCICmdWaiter& waiter,
                                                              const hci_cmd_event_struct **res, HCIStatusCode *status,
                                                              const bool quiet=false) noexcept;
 
@@ -381,9 +860,24 @@ namespace direct_bt {
             template<typename hci_cmd_event_struct>
             const hci_cmd_event_struct* getMetaReplyStruct(HCIEvent& event, HCIMetaEventType mec, HCIStatusCode *status) noexcept;
 
+            HCIHandler(const uint16_t dev_id, const int socket_descriptor, const bool virtual_ctrl, const BTMode btMode) noexcept;
+
         public:
             HCIHandler(const uint16_t dev_id, const BTMode btMode=BTMode::NONE) noexcept;
 
+            /**
+             * Constructs an instance connected to the given HCIVirtualController instead of a kernel HCI device,
+             * taking over its host socket, see HCIVirtualController::takeHostSocket().
+             * <p>
+             * The kernel HCI socket filter is not applied and
+             * startAdapter() and stopAdapter() are emulated via HCI reset.
+             * </p>
+             * <p>
+             * Intended for hardware-free testing and benchmarking.
+             * </p>
+             */
+            HCIHandler(const uint16_t dev_id, HCIVirtualController& ctrl, const BTMode btMode=BTMode::NONE) noexcept;
+
         private:
             void zeroSupCommands() noexcept;
             bool initSupCommands() noexcept;
@@ -401,6 +895,9 @@ namespace direct_bt {
 
             inline BTMode getBTMode() const noexcept { return btMode; }
 
+            /** Returns true if connected to a HCIVirtualController, see HCIHandler(const uint16_t, HCIVirtualController&, const BTMode). */
+            inline bool isVirtual() const noexcept { return virtual_ctrl; }
+
             inline void setBTMode(const BTMode mode) noexcept { btMode = mode; }
 
             /** Returns true if this mgmt instance is open, connected and hence valid, otherwise false */
@@ -419,6 +916,13 @@ namespace direct_bt {
                 return 0 != ( sup_commands[37] & ( 1 << 7 ) );
             }
 
+            /** Periodic advertising sync is available if HCI_LE_Periodic_Advertising_Create_Sync, its cancel and terminate commands are supported (Bluetooth 5.0). */
+            bool use_periodic_adv_sync() const noexcept {
+                return 0 != ( sup_commands[38] & ( 1 << 0 ) ) &&
+                       0 != ( sup_commands[38] & ( 1 << 1 ) ) &&
+                       0 != ( sup_commands[38] & ( 1 << 2 ) );
+            }
+
             bool use_resolv_add() const noexcept         { return 0 != ( sup_commands[34] & ( 1 << 3 ) ); }
             bool use_resolv_del() const noexcept         { return 0 != ( sup_commands[34] & ( 1 << 4 ) ); }
             bool use_resolv_clear() const noexcept       { return 0 != ( sup_commands[34] & ( 1 << 5 ) ); }
@@ -432,18 +936,142 @@ namespace direct_bt {
                 return is_set(le_ll_feats, LE_Features::LE_Ext_Adv);
             }
 
+            /**
+             * Returns the number of concurrently supported extended advertising sets, queried once from the controller.
+             * <pre>
+             * BT Core Spec v5.2: Vol 4 HCI, Part E HCI Functional: 7.8.58 LE Read Number of Supported Advertising Sets command (Bluetooth 5.0)
+             * </pre>
+             * Returns 1 if use_ext_adv() is false, i.e. legacy advertising.
+             */
+            uint8_t getExtAdvMaxSets() noexcept;
+
+            /**
+             * Returns the maximum advertising data length of one extended advertising set, queried once from the controller.
+             * <pre>
+             * BT Core Spec v5.2: Vol 4 HCI, Part E HCI Functional: 7.8.57 LE Read Maximum Advertising Data Length command (Bluetooth 5.0)
+             * </pre>
+             * Returns 31 if use_ext_adv() is false, i.e. legacy advertising.
+             */
+            uint16_t getExtAdvMaxDataLength() noexcept;
+
             ScanType getCurrentScanType() const noexcept { return currentScanType.load(); }
-            void setCurrentScanType(const ScanType v) noexcept { currentScanType = v; }
+            void setCurrentScanType(const ScanType v) noexcept;
 
             /**
-             * Advertising is enabled via le_start_adv() or le_enable_adv().
+             * Advertising is enabled via le_start_adv(), le_start_ext_adv() or le_enable_adv().
              *
              * Advertising is active until either disabled via le_enable_adv(false) or a connection has been made.
+             * Using extended advertising, a connection ends its advertising set only
+             * as reported via HCIMetaEventType::LE_ADV_SET_TERMINATED, see isAdvertisingSet().
              *
-             * @return true if advertising is active, otherwise false.
+             * @return true if advertising of any set is active, otherwise false.
              */
             bool isAdvertising() const noexcept { return advertisingEnabled.load(); }
 
+            /**
+             * Returns true if advertising of the given set handle is active, see isAdvertising().
+             *
+             * Legacy advertising uses handle 0.
+             */
+            bool isAdvertisingSet(const uint8_t handle) noexcept;
+
+            /**
+             * Returns the LE meta event mask passed by the kernel socket filter, bit `n-1` for HCIMetaEventType value `n`.
+             * <p>
+             * Returns zero if no kernel filter is attached, see HCIEnv::HCI_KERNEL_FILTER.
+             * </p>
+             */
+            uint32_t getKernelMetaEventFilter() noexcept;
+
+            /** Returns the number of kernel socket filter updates, see HCIEnv::HCI_KERNEL_FILTER. */
+            uint64_t getKernelFilterUpdates() const noexcept { return kfilter_updates; }
+
+            /** Returns true if LE advertising reports are processed on a dedicated worker thread, see HCIEnv::HCI_ADV_WORKER. */
+            bool usesAdvWorker() const noexcept { return env.HCI_ADV_WORKER; }
+
+            /** Returns the number of advertising report events queued for the worker thread, see HCIEnv::HCI_ADV_WORKER. */
+            uint64_t getAdvReportsEnqueued() const noexcept { return adv_reports_enqueued; }
+
+            /** Returns the number of advertising report events dropped due to a full worker ringbuffer, see HCIEnv::HCI_ADV_RING_CAPACITY. */
+            uint64_t getAdvReportsDropped() const noexcept { return adv_reports_dropped; }
+
+            /** Returns the number of advertising reports merged into a previous report of the same address, see HCIEnv::HCI_ADV_COALESCE. */
+            uint64_t getAdvReportsCoalesced() const noexcept { return adv_reports_coalesced; }
+
+            /**
+             * Sets the scan pre-filter applied to all received advertising reports.
+             * <p>
+             * Non-matching reports are dropped on the raw AD data before any MgmtEvtDeviceFound,
+             * EInfoReport or BTDevice gets created. An empty filter disables filtering.
+             * </p>
+             * <p>
+             * Reports are matched per address via ScanFilterTracker, i.e. later reports of an accepted address pass if matching its per report criteria
+             * and a rule's AD data criteria may be split across the advertising report and its scan response.
+             * </p>
+             * <p>
+             * The filter is published copy-on-write and taken up by the next advertising report event.
+             * </p>
+             * @see BTAdapter::setScanFilter()
+             */
+            void setScanFilter(const ScanFilter& filter) noexcept;
+
+            /** Returns the current scan pre-filter, nullptr if none is set. */
+            std::shared_ptr<const ScanFilter> getScanFilter() const noexcept;
+
+            /**
+             * Returns the chained extended advertising report reassembly for its statistics.
+             * <p>
+             * Its state is modified by the thread processing advertising reports.
+             * </p>
+             */
+            const EADReassembly& getEADReassembly() const noexcept { return eadReassembly; }
+
+            /**
+             * Returns the per address state of the scan pre-filter for its statistics.
+             * <p>
+             * Its state is modified by the thread processing advertising reports.
+             * </p>
+             */
+            const ScanFilterTracker& getScanFilterTracker() const noexcept { return scanFilterTracker; }
+
+            /** Returns the number of advertising reports dropped by the ScanFilter, see setScanFilter(). */
+            uint64_t getAdvReportsFiltered() const noexcept { return adv_reports_filtered; }
+
+            /** Returns the number of received periodic advertising reports, see addPeriodicAdvReportCallback(). */
+            uint64_t getPeriodicAdvReports() const noexcept { return periodic_reports; }
+
+            /** Returns a snapshot of all established periodic advertising syncs. */
+            jau::darray<PeriodicAdvSync> getPeriodicAdvSyncs() noexcept;
+
+            /**
+             * Returns the Num_HCI_Command_Packets credits as last announced by the controller,
+             * i.e. the number of HCI commands which may be sent without awaiting a reply.
+             * <p>
+             * Only replies to an outstanding command update the credits,
+             * a command timing out w/o any reply returns its credit.
+             * </p>
+             */
+            int32_t getCommandCredits() const noexcept { return cmd_credits; }
+
+            /** Returns the number of CMD_STATUS and CMD_COMPLETE replies without outstanding command, e.g. late replies after a timeout. */
+            uint64_t getCommandRepliesUnrouted() const noexcept { return cmd_replies_unrouted; }
+
+            /**
+             * Replays all received HCI packets of the given btsnoop capture through this instance's HCI reader processing,
+             * issuing the same callbacks as for live traffic, e.g. MgmtEvtDeviceFound for advertising reports.
+             * <p>
+             * Intended to reproduce and benchmark captured field traffic without an adapter,
+             * hence only allowed while the HCI reader thread is not running,
+             * e.g. on an instance which could not open its HCI channel or after close().<br>
+             * Sent packets are skipped and advertising reports are processed inline on the calling thread.
+             * </p>
+             * @param reader the opened btsnoop capture, see HCIEnv::HCI_SNOOP_FILE
+             * @param recorded_speed if true, packets are fed at their recorded timing, otherwise as fast as possible
+             * @param stats destination of throughput and per-stage latency statistics
+             * @return true if the whole capture has been replayed, otherwise false
+             */
+            bool replay(BTSnoopReader& reader, const bool recorded_speed, HCIReplayStats& stats) noexcept;
+
             std::string toString() const noexcept;
 
         private:
@@ -698,6 +1326,43 @@ namespace direct_bt {
                                          const uint16_t conn_interval_min=8, const uint16_t conn_interval_max=12,
                                          const uint16_t conn_latency=0, const uint16_t supervision_timeout=getHCIConnSupervisorTimeout(0, 15)) noexcept;
 
+            /**
+             * Synchronizes to the periodic advertising train of the given advertiser.
+             * <pre>
+             * BT Core Spec v5.2: Vol 4, Part E HCI: 7.8.67 LE Periodic Advertising Create Sync command (Bluetooth 5.0)
+             * </pre>
+             * <p>
+             * The sync is established asynchronously while scanning, reported via HCIPeriodicAdvSyncCallback,
+             * followed by its periodic advertising reports via HCIPeriodicAdvReportCallback.<br>
+             * Only one create sync may be pending, see le_cancel_periodic_adv_sync().
+             * </p>
+             * <p>
+             * Returns HCIStatusCode::UNKNOWN_COMMAND if not supported by the controller, see use_periodic_adv_sync().
+             * </p>
+             * @param address the advertiser's address, BDAddressType::BDADDR_LE_PUBLIC or BDAddressType::BDADDR_LE_RANDOM
+             * @param adv_sid the advertiser's Advertising_SID, see EInfoReportView::getAdvSID()
+             * @param skip number of periodic advertising events which may be skipped, default 0; Value range [0 .. 0x01F3]
+             * @param sync_timeout in units of 10ms, default value 1000 for 10s; Value range [0x0A .. 0x4000] for [100ms .. 163.84s]
+             */
+            HCIStatusCode le_create_periodic_adv_sync(const BDAddressAndType& address, const uint8_t adv_sid,
+                                                      const uint16_t skip=0, const uint16_t sync_timeout=1000) noexcept;
+
+            /**
+             * Cancels a pending le_create_periodic_adv_sync().
+             * <pre>
+             * BT Core Spec v5.2: Vol 4, Part E HCI: 7.8.68 LE Periodic Advertising Create Sync Cancel command (Bluetooth 5.0)
+             * </pre>
+             */
+            HCIStatusCode le_cancel_periodic_adv_sync() noexcept;
+
+            /**
+             * Terminates the given established periodic advertising sync.
+             * <pre>
+             * BT Core Spec v5.2: Vol 4, Part E HCI: 7.8.69 LE Periodic Advertising Terminate Sync command (Bluetooth 5.0)
+             * </pre>
+             */
+            HCIStatusCode le_terminate_periodic_adv_sync(const uint16_t sync_handle) noexcept;
+
             /**
              * Establish a connection to the given BREDR (non LE).
              * <pre>
@@ -894,6 +1559,27 @@ namespace direct_bt {
             HCIStatusCode le_set_scanrsp_data(const EInfoReport &eir,
                                               const EIRDataType mask = EIRDataType::SERVICE_UUID) noexcept;
 
+            void readExtAdvLimits() noexcept;
+
+            /** Sets the extended advertising parameter and optional random address of the given set. */
+            HCIStatusCode le_set_ext_adv_param(const ExtAdvSet& set, const HCILEOwnAddressType own_mac_type) noexcept;
+
+            /**
+             * Sets the extended advertising or scan response data of the given set,
+             * fragmented into HCI_MAX_EXT_AD_LENGTH operations if required.
+             * @param opc HCIOpcode::LE_SET_EXT_ADV_DATA or HCIOpcode::LE_SET_EXT_SCAN_RSP_DATA
+             */
+            HCIStatusCode le_set_ext_adv_data(const HCIOpcode opc, const uint8_t handle, const uint8_t* data, const jau::nsize_t size) noexcept;
+
+            /**
+             * Enables the given advertising set handles or disables advertising.
+             * The handles are ignored for legacy advertising, i.e. if use_ext_adv() is false.
+             *
+             * Enabling legacy advertising is disallowed while connections are open or pending,
+             * extended advertising sets may be enabled while connected.
+             */
+            HCIStatusCode le_enable_adv_sets(const bool enable, const uint8_t* handles, const jau::nsize_t count) noexcept;
+
         public:
             /**
              * Enables or disabled advertising.
@@ -958,6 +1644,31 @@ namespace direct_bt {
                                        const uint8_t adv_chan_map=0x07,
                                        const uint8_t filter_policy=0x00) noexcept;
 
+            /**
+             * Starts advertising of multiple concurrent BT5 extended advertising sets
+             * - BT Core Spec v5.2: Vol 4 HCI, Part E HCI Functional: 7.8.53 LE Set Extended Advertising Parameters command (Bluetooth 5.0)
+             * - BT Core Spec v5.2: Vol 4 HCI, Part E HCI Functional: 7.8.52 LE Set Advertising Set Random Address command (Bluetooth 5.0)
+             * - BT Core Spec v5.2: Vol 4 HCI, Part E HCI Functional: 7.8.54 LE Set Extended Advertising Data command (Bluetooth 5.0)
+             * - BT Core Spec v5.2: Vol 4 HCI, Part E HCI Functional: 7.8.55 LE Set Extended Scan Response Data command (Bluetooth 5.0)
+             * - BT Core Spec v5.2: Vol 4 HCI, Part E HCI Functional: 7.8.56 LE Set Extended Advertising Enable command (Bluetooth 5.0)
+             *
+             * Previously configured advertising sets are removed beforehand.
+             *
+             * If use_ext_adv() is false, falls back to le_start_adv() using the first set's legacy parameter
+             * and dropping all other sets.
+             *
+             * Advertising is active until either disabled via le_enable_adv(false) or a connection has been made,
+             * see isAdvertising(). A connection ends advertising of its set only, all other sets continue to advertise
+             * until disabled via le_enable_adv(false).
+             *
+             * @param sets the advertising sets, at most getExtAdvMaxSets()
+             * @param own_mac_type HCILEOwnAddressType::PUBLIC (default) or random/private, used for sets w/o ExtAdvSet::random_address
+             * @return HCIStatusCode::SUCCESS if successful, otherwise the HCIStatusCode error state
+             * @see ExtAdvSet
+             */
+            HCIStatusCode le_start_ext_adv(const jau::darray<ExtAdvSet>& sets,
+                                           const HCILEOwnAddressType own_mac_type=HCILEOwnAddressType::PUBLIC) noexcept;
+
             /** MgmtEventCallback handling  */
 
             /**
@@ -976,7 +1687,21 @@ namespace direct_bt {
             void addSMPMsgCallback(const HCISMPMsgCallback & l);
             size_type removeSMPMsgCallback(const HCISMPMsgCallback & l);
 
-            /** Removes all MgmtEventCallbacks from all MgmtEvent::Opcode lists and all SMPSecurityReqCallbacks. */
+            /** Adds the given HCIPeriodicAdvSyncCallback, see le_create_periodic_adv_sync(). */
+            void addPeriodicAdvSyncCallback(const HCIPeriodicAdvSyncCallback & l);
+            size_type removePeriodicAdvSyncCallback(const HCIPeriodicAdvSyncCallback & l);
+
+            /**
+             * Adds the given HCIPeriodicAdvReportCallback, see le_create_periodic_adv_sync().
+             * <p>
+             * Periodic advertising reports are delivered directly on the HCI reader thread without MgmtEvent translation,
+             * EInfoReport decoding or BTDevice bookkeeping.
+             * </p>
+             */
+            void addPeriodicAdvReportCallback(const HCIPeriodicAdvReportCallback & l);
+            size_type removePeriodicAdvReportCallback(const HCIPeriodicAdvReportCallback & l);
+
+            /** Removes all MgmtEventCallbacks from all MgmtEvent::Opcode lists, all SMPSecurityReqCallbacks and all periodic advertising callbacks. */
             void clearAllCallbacks() noexcept;
 
             /** Manually send a MgmtEvent to all of its listeners. */
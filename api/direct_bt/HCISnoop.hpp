@@ -0,0 +1,239 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef HCI_SNOOP_HPP_
+#define HCI_SNOOP_HPP_
+
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <fstream>
+
+#include <jau/basic_types.hpp>
+#include <jau/fraction_type.hpp>
+
+/**
+ * - - - - - - - - - - - - - - -
+ *
+ * Module HCISnoop:
+ *
+ * - btsnoop file format, as used by Android's HCI snoop log and understood by Wireshark
+ * - Datalink type 1002, HCI UART (H4), i.e. each packet is stored including its leading HCIPacketType
+ */
+namespace direct_bt {
+
+    /** \addtogroup DBTSystemAPI
+     *
+     *  @{
+     */
+
+    /**
+     * btsnoop file format constants.
+     */
+    class BTSnoop {
+        public:
+            /** File identification pattern, 8 bytes including the trailing zero. */
+            constexpr static const char MAGIC[8] = { 'b', 't', 's', 'n', 'o', 'o', 'p', 0 };
+            /** File format version. */
+            constexpr static const uint32_t VERSION = 1;
+            /** Datalink type HCI UART (H4), i.e. each packet leads with its HCIPacketType. */
+            constexpr static const uint32_t DATALINK_HCI_UART = 1002;
+            /** Size of the file header in bytes. */
+            constexpr static const jau::nsize_t HEADER_SIZE = 16;
+            /** Size of each record header in bytes. */
+            constexpr static const jau::nsize_t RECORD_HEADER_SIZE = 24;
+            /** Maximum accepted packet size of a read record, sanity limit well above any HCI packet. */
+            constexpr static const jau::nsize_t MAX_RECORD_SIZE = 0x10000;
+            /** Microseconds from midnight January 1st 0 AD to the Unix epoch, the btsnoop timestamp base. */
+            constexpr static const uint64_t EPOCH_DELTA_US = 0x00dcddb30f2f8000ULL;
+
+            /** Record flag bit 0: Packet has been received from the controller, otherwise sent. */
+            constexpr static const uint32_t FLAG_RECEIVED = 1U << 0;
+            /** Record flag bit 1: Packet is a command or event, otherwise data. */
+            constexpr static const uint32_t FLAG_CMD_EVT = 1U << 1;
+    };
+
+    /**
+     * A single btsnoop record.
+     */
+    struct BTSnoopRecord {
+        /** Timestamp in microseconds since midnight January 1st 0 AD. */
+        uint64_t timestamp_us;
+        /** Record flags, see BTSnoop::FLAG_RECEIVED and BTSnoop::FLAG_CMD_EVT. */
+        uint32_t flags;
+        /** Number of packets dropped between the previous and this record. */
+        uint32_t drops;
+        /** Packet data including the leading HCIPacketType. */
+        std::vector<uint8_t> data;
+
+        bool isReceived() const noexcept { return 0 != ( flags & BTSnoop::FLAG_RECEIVED ); }
+    };
+
+    /**
+     * Writes HCI packets to a btsnoop file, see HCIComm::set_snoop().
+     * <p>
+     * Timestamps are taken from the monotonic clock in microseconds offset by BTSnoop::EPOCH_DELTA_US,
+     * i.e. they are strictly relative to each other and not wall-clock time.
+     * </p>
+     * <p>
+     * Writing is thread safe.
+     * </p>
+     */
+    class BTSnoopWriter {
+        private:
+            std::mutex mtx_write;
+            std::ofstream file;
+            std::string fname;
+            uint64_t record_count;
+            bool good;
+
+        public:
+            /** Creates or truncates the given file and writes the btsnoop header. */
+            BTSnoopWriter(const std::string& fname) noexcept;
+
+            BTSnoopWriter(const BTSnoopWriter&) = delete;
+            void operator=(const BTSnoopWriter&) = delete;
+
+            ~BTSnoopWriter() noexcept { close(); }
+
+            const std::string& getFilename() const noexcept { return fname; }
+
+            bool is_open() noexcept;
+
+            void close() noexcept;
+
+            /** Returns the number of written records. */
+            uint64_t getRecordCount() noexcept;
+
+            /**
+             * Writes the given HCI packet timestamped with the current monotonic time.
+             * @param data packet data including the leading HCIPacketType
+             * @param size packet size
+             * @param received true if received from the controller, otherwise sent
+             * @return true if successful
+             */
+            bool write(const uint8_t* data, const jau::nsize_t size, const bool received) noexcept;
+
+            /**
+             * Writes the given HCI packet with the given timestamp in microseconds since midnight January 1st 0 AD.
+             */
+            bool write(const uint8_t* data, const jau::nsize_t size, const bool received, const uint64_t timestamp_us) noexcept;
+
+            /** Returns the current monotonic time in btsnoop microseconds, see BTSnoop::EPOCH_DELTA_US. */
+            static uint64_t getTimestamp() noexcept;
+    };
+
+    /**
+     * Reads HCI packets from a btsnoop file of datalink type BTSnoop::DATALINK_HCI_UART.
+     */
+    class BTSnoopReader {
+        private:
+            std::ifstream file;
+            std::string fname;
+            uint64_t record_count;
+            bool good;
+            bool end_of_file;
+
+        public:
+            /** Opens the given file and validates the btsnoop header. */
+            BTSnoopReader(const std::string& fname) noexcept;
+
+            BTSnoopReader(const BTSnoopReader&) = delete;
+            void operator=(const BTSnoopReader&) = delete;
+
+            const std::string& getFilename() const noexcept { return fname; }
+
+            /** Returns true if the file is open, its header valid and no read error occurred. */
+            bool is_open() const noexcept { return good; }
+
+            /** Returns true if all records have been read without error. */
+            bool at_end() const noexcept { return end_of_file; }
+
+            /** Returns the number of read records. */
+            uint64_t getRecordCount() const noexcept { return record_count; }
+
+            /**
+             * Reads the next record.
+             * @return true if successful, false at end of file or on error.
+             */
+            bool next(BTSnoopRecord& record) noexcept;
+    };
+
+    /**
+     * Latency statistics of one processing stage, see HCIReplayStats.
+     */
+    struct HCIReplayStageStats {
+        uint64_t count = 0;
+        uint64_t sum_ns = 0;
+        uint64_t min_ns = 0;
+        uint64_t max_ns = 0;
+
+        void add(const uint64_t ns) noexcept {
+            if( 0 == count || ns < min_ns ) { min_ns = ns; }
+            if( ns > max_ns ) { max_ns = ns; }
+            sum_ns += ns;
+            ++count;
+        }
+        double getAverage_ns() const noexcept { return 0 < count ? double(sum_ns) / double(count) : 0.0; }
+
+        std::string toString() const noexcept;
+    };
+
+    /**
+     * Statistics of an HCIHandler::replay() run.
+     * <p>
+     * Stages:
+     * - `process`: Complete processing of one received HCI packet, including all callbacks.
+     * - `adv_parse`: Parsing of one LE (extended) advertising report event into EInfoReportView instances.
+     * - `adv_dispatch`: Dispatching of one advertising report event's EInfoReportView instances to the MgmtEvtDeviceFound callbacks,
+     *   i.e. BTAdapter's device lookup, EInfoReport materialization and user AdapterStatusListener::deviceFound() code.
+     * </p>
+     */
+    struct HCIReplayStats {
+        /** Number of fed received packets. */
+        uint64_t packets = 0;
+        /** Number of skipped records, i.e. sent packets or invalid records. */
+        uint64_t skipped = 0;
+        /** Number of EInfoReportView instances produced by advertising report events. */
+        uint64_t adv_reports = 0;
+        /** Total wall duration of the replay in nanoseconds. */
+        uint64_t duration_ns = 0;
+
+        HCIReplayStageStats process;
+        HCIReplayStageStats adv_parse;
+        HCIReplayStageStats adv_dispatch;
+
+        /** Returns the throughput in processed packets per second. */
+        double getEventsPerSecond() const noexcept { return 0 < duration_ns ? double(packets) * 1e9 / double(duration_ns) : 0.0; }
+
+        std::string toString() const noexcept;
+    };
+
+    /**@}*/
+
+} // namespace direct_bt
+
+#endif /* HCI_SNOOP_HPP_ */
@@ -442,13 +442,21 @@ namespace direct_bt {
         LE_READ_PHY                 = 0x2030,
         LE_SET_DEFAULT_PHY          = 0x2031,
         LE_SET_PHY                  = 0x2032,
+        LE_SET_ADV_SET_RAND_ADDR    = 0x2035,
         LE_SET_EXT_ADV_PARAMS       = 0x2036,
         LE_SET_EXT_ADV_DATA         = 0x2037,
         LE_SET_EXT_SCAN_RSP_DATA    = 0x2038,
         LE_SET_EXT_ADV_ENABLE       = 0x2039,
+        LE_READ_MAX_ADV_DATA_LEN    = 0x203A,
+        LE_READ_NUM_SUPPORTED_ADV_SETS = 0x203B,
+        LE_REMOVE_ADV_SET           = 0x203C,
+        LE_CLEAR_ADV_SETS           = 0x203D,
         LE_SET_EXT_SCAN_PARAMS      = 0x2041,
         LE_SET_EXT_SCAN_ENABLE      = 0x2042,
         LE_EXT_CREATE_CONN          = 0x2043,
+        LE_PERIODIC_ADV_CREATE_SYNC        = 0x2044,
+        LE_PERIODIC_ADV_CREATE_SYNC_CANCEL = 0x2045,
+        LE_PERIODIC_ADV_TERMINATE_SYNC     = 0x2046,
         // etc etc - incomplete
     };
     constexpr uint16_t number(const HCIOpcode rhs) noexcept {
@@ -506,7 +514,10 @@ namespace direct_bt {
         LE_SET_EXT_ADV_ENABLE       = 55,
         LE_SET_EXT_SCAN_PARAMS      = 56,
         LE_SET_EXT_SCAN_ENABLE      = 57,
-        LE_EXT_CREATE_CONN          = 58
+        LE_EXT_CREATE_CONN          = 58,
+        LE_PERIODIC_ADV_CREATE_SYNC        = 59,
+        LE_PERIODIC_ADV_CREATE_SYNC_CANCEL = 60,
+        LE_PERIODIC_ADV_TERMINATE_SYNC     = 61
         // etc etc - incomplete
     };
     constexpr uint8_t number(const HCIOpcodeBit rhs) noexcept {
@@ -597,6 +608,84 @@ namespace direct_bt {
     };
     inline std::string to_string(const HCIPacket& p) noexcept { return p.toString(); }
 
+    /**
+     * Read-only view of a received raw HCI packet, neither owning nor copying the underlying memory.
+     * <p>
+     * Allows classifying, filtering and peeking into HCI event and ACL data packets
+     * without instantiating a HCIPacket, i.e. without heap allocation and copying the packet.
+     * </p>
+     * <p>
+     * The underlying memory must outlive this instance.
+     * </p>
+     * <p>
+     * BT Core Spec v5.2: Vol 4, Part E HCI: 5.4 Exchange of HCI-specific information
+     * </p>
+     */
+    class HCIPacketView
+    {
+        private:
+            const uint8_t* buffer;
+            jau::nsize_t size;
+
+        public:
+            HCIPacketView(const uint8_t* buffer_, const jau::nsize_t size_) noexcept
+            : buffer(buffer_), size(nullptr != buffer_ ? size_ : 0) {}
+
+            constexpr jau::nsize_t getTotalSize() const noexcept { return size; }
+            constexpr const uint8_t* get_ptr() const noexcept { return buffer; }
+
+            /** Returns the HCIPacketType or HCIPacketType::VENDOR if empty */
+            HCIPacketType getPacketType() const noexcept {
+                return 0 < size ? static_cast<HCIPacketType>( buffer[0] ) : HCIPacketType::VENDOR;
+            }
+
+            /** Returns true if this is a complete HCI event packet, i.e. covering its header and parameter. */
+            bool isValidEvent() const noexcept {
+                return HCIPacketType::EVENT == getPacketType() &&
+                       size >= number(HCIConstSizeT::EVENT_HDR_SIZE) &&
+                       size >= number(HCIConstSizeT::EVENT_HDR_SIZE) + getEventParamSize();
+            }
+            /** Returns the event type, requires isValidEvent(). */
+            HCIEventType getEventType() const noexcept { return static_cast<HCIEventType>( buffer[1] ); }
+            /** Returns the event parameter size, requires isValidEvent(). */
+            jau::nsize_t getEventParamSize() const noexcept { return buffer[2]; }
+            /** Returns the event parameter, requires isValidEvent(). */
+            const uint8_t* getEventParam() const noexcept { return buffer + number(HCIConstSizeT::EVENT_HDR_SIZE); }
+
+            /**
+             * Returns the meta subevent type if this is a valid HCIEventType::LE_META event
+             * carrying at least its subevent code, otherwise HCIMetaEventType::INVALID.
+             */
+            HCIMetaEventType getMetaEventType() const noexcept {
+                if( !isValidEvent() || HCIEventType::LE_META != getEventType() || 0 == getEventParamSize() ) {
+                    return HCIMetaEventType::INVALID;
+                }
+                return static_cast<HCIMetaEventType>( buffer[number(HCIConstSizeT::EVENT_HDR_SIZE)] );
+            }
+            /** Returns the meta event parameter size excluding the subevent code, requires a valid getMetaEventType(). */
+            jau::nsize_t getMetaEventParamSize() const noexcept { return getEventParamSize()-1; }
+            /** Returns the meta event parameter excluding the subevent code, requires a valid getMetaEventType(). */
+            const uint8_t* getMetaEventParam() const noexcept { return getEventParam()+1; }
+
+            /** Returns true if this is a complete HCI ACL data packet, i.e. covering its header and parameter. */
+            bool isValidACLData() const noexcept {
+                return HCIPacketType::ACLDATA == getPacketType() &&
+                       size >= number(HCIConstSizeT::ACL_HDR_SIZE) &&
+                       size >= number(HCIConstSizeT::ACL_HDR_SIZE) + getACLParamSize();
+            }
+            /** Returns the ACL handle and flags, requires isValidACLData(). */
+            uint16_t getACLHandleAndFlags() const noexcept { return jau::get_uint16(buffer + 1, jau::lb_endian_t::little); }
+            /** Returns the ACL parameter size, requires isValidACLData(). */
+            jau::nsize_t getACLParamSize() const noexcept { return jau::get_uint16(buffer + 3, jau::lb_endian_t::little); }
+            /** Returns the ACL parameter, requires isValidACLData(). */
+            const uint8_t* getACLParam() const noexcept { return buffer + number(HCIConstSizeT::ACL_HDR_SIZE); }
+
+            std::string toString() const noexcept {
+                return "HCIPacketView[type "+jau::to_hexstring(number(getPacketType()))+", tsz "+std::to_string(size)+
+                       ", data "+jau::bytesHexString(buffer, 0, size, true /* lsbFirst*/)+"]";
+            }
+    };
+
     /**
      * BT Core Spec v5.2: Vol 4, Part E HCI: 5.4.1 HCI Command packet
      * <p>
@@ -658,14 +747,14 @@ namespace direct_bt {
                 if( exp_param_size > paramSize ) {
                     throw jau::IndexOutOfBoundsError(exp_param_size, paramSize, E_FILE_LINE);
                 }
-                checkOpcode(getOpcode(), HCIOpcode::SPECIAL, HCIOpcode::LE_EXT_CREATE_CONN);
+                checkOpcode(getOpcode(), HCIOpcode::SPECIAL, HCIOpcode::LE_PERIODIC_ADV_TERMINATE_SYNC);
             }
 
             /** Enabling manual construction of command without given value. */
             HCICommand(const HCIOpcode opc, const jau::nsize_t param_size)
             : HCIPacket(HCIPacketType::COMMAND, number(HCIConstSizeT::COMMAND_HDR_SIZE)+param_size)
             {
-                checkOpcode(opc, HCIOpcode::SPECIAL, HCIOpcode::LE_EXT_CREATE_CONN);
+                checkOpcode(opc, HCIOpcode::SPECIAL, HCIOpcode::LE_PERIODIC_ADV_TERMINATE_SYNC);
                 if( 255 < param_size ) {
                     throw jau::IllegalArgumentError("HCICommand param size "+std::to_string(param_size)+" > 255", E_FILE_LINE);
                 }
@@ -1060,6 +1149,17 @@ namespace direct_bt {
 
             l2cap_frame getL2CAPFrame(const uint8_t* & l2cap_data) const noexcept;
 
+            /**
+             * Returns the L2CAP frame of the given raw ACL data parameter,
+             * allowing to peek into ACL data without instantiating HCIACLData.
+             * @param handle_and_flags the ACL handle and flags, see HCIPacketView::getACLHandleAndFlags()
+             * @param acl_param the ACL data parameter, see HCIPacketView::getACLParam()
+             * @param acl_param_size the ACL data parameter size, see HCIPacketView::getACLParamSize()
+             * @param l2cap_data resulting L2CAP payload pointer within `acl_param` or nullptr if not supported
+             */
+            static l2cap_frame getL2CAPFrame(const uint16_t handle_and_flags, const uint8_t* acl_param, const jau::nsize_t acl_param_size,
+                                             const uint8_t* & l2cap_data) noexcept;
+
             std::string toString() const noexcept {
                 const uint8_t* l2cap_data;
                 return "ACLData[size "+std::to_string(getParamSize())+", data "+getL2CAPFrame(l2cap_data).toString(l2cap_data)+", tsz "+std::to_string(getTotalSize())+"]";
@@ -0,0 +1,302 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef HCI_VIRTUAL_CONTROLLER_HPP_
+#define HCI_VIRTUAL_CONTROLLER_HPP_
+
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+
+#include <jau/basic_types.hpp>
+#include <jau/eui48.hpp>
+#include <jau/service_runner.hpp>
+
+#include "BTTypes0.hpp"
+#include "HCITypes.hpp"
+
+/**
+ * - - - - - - - - - - - - - - -
+ *
+ * Module HCIVirtualController:
+ *
+ * - In-process software stand-in of an LE controller for hardware-free testing and benchmarking
+ */
+namespace direct_bt {
+
+    /** \addtogroup DBTSystemAPI
+     *
+     *  @{
+     */
+
+    /**
+     * In-process software stand-in of an LE controller, connected to its host via a `SOCK_SEQPACKET` socketpair,
+     * see HCIHandler::HCIHandler(const uint16_t, HCIVirtualController&, const BTMode).
+     * <p>
+     * The controller answers the HCI commands issued by HCIHandler:
+     * - RESET, READ_LOCAL_VERSION, READ_LOCAL_COMMANDS and LE_READ_LOCAL_FEATURES, announcing legacy LE only
+     *   or LE_Features::LE_Ext_Adv if created with extended advertising
+     * - LE scanning and advertising parameter, data and enable commands
+     * - LE extended advertising set parameter, data, enable, clear and number of supported sets commands,
+     *   if created with extended advertising, see EXT_ADV_MAX_SETS
+     * - LE_CREATE_CONN, LE_CREATE_CONN_CANCEL, LE_READ_REMOTE_FEATURES and DISCONNECT
+     * - LE periodic advertising create sync, its cancel and terminate, syncing immediately to any requested train
+     * - all other commands are acknowledged with HCIStatusCode::SUCCESS and zeroed return parameters
+     * </p>
+     * <p>
+     * Controllers put into mutual radio range via link() see each other's advertising when scanning,
+     * can connect to each other while the peer is advertising and forward ACL data of an established connection,
+     * i.e. the central and peripheral HCI event flow of two in-process hosts.<br>
+     * A connection ends the peer's legacy advertising or its first enabled connectable extended advertising set,
+     * the latter reported to the peer's host via HCIMetaEventType::LE_ADV_SET_TERMINATED while its other sets continue.
+     * </p>
+     * <p>
+     * L2CAP channels of an established connection are bound to L2CAPClient and L2CAPServer
+     * via L2CAPClient::open(HCIVirtualController&, const BDAddressAndType&) and L2CAPServer::open(HCIVirtualController&),
+     * replacing the kernel's L2CAP sockets by `SOCK_SEQPACKET` channels to this controller.<br>
+     * Each written SDU is segmented into ACL data packets of at most ACL_MAX_DATA_SIZE bytes,
+     * forwarded over the link and reassembled by the peer controller for its bound channel,
+     * while ACL data of unbound channels, e.g. SMP, is passed to the peer's HCI host as-is.<br>
+     * Tearing down the connection closes its channels, i.e. the hosts read end-of-file.
+     * </p>
+     * <p>
+     * Only public addresses are supported and no HCI flow control is emulated.
+     * </p>
+     */
+    class HCIVirtualController {
+        public:
+            /** Maximum ACL data packet payload, i.e. the LE ACL data packet length announced by common controllers. */
+            constexpr static const jau::nsize_t ACL_MAX_DATA_SIZE = 251;
+
+            /** Maximum L2CAP SDU size of a bound channel, exceeding the maximum ATT PDU of 517 bytes. */
+            constexpr static const jau::nsize_t L2CAP_MAX_SDU_SIZE = 1024;
+
+            /** Number of supported extended advertising sets, if created with extended advertising. */
+            constexpr static const uint8_t EXT_ADV_MAX_SETS = 4;
+
+            /** The controller's public address */
+            const jau::EUI48 address;
+
+            /** True if announcing and supporting extended advertising, see LE_Features::LE_Ext_Adv. */
+            const bool ext_adv;
+
+        private:
+            struct Link {
+                uint16_t handle;
+                HCIVirtualController* peer;
+                uint16_t peer_handle;
+                /** Reassembly of a received L2CAP SDU for a bound channel */
+                std::vector<uint8_t> rx_sdu;
+                uint16_t rx_len;
+                uint16_t rx_cid;
+                bool rx_channel;
+
+                Link(const uint16_t handle_, HCIVirtualController* peer_, const uint16_t peer_handle_) noexcept
+                : handle(handle_), peer(peer_), peer_handle(peer_handle_), rx_len(0), rx_cid(0), rx_channel(false) {}
+            };
+
+            /** L2CAP channel of a link, bound to an L2CAPClient */
+            struct Channel {
+                uint16_t handle;
+                uint16_t cid;
+                int sd; // the controller's end of the channel
+            };
+
+            /** Extended advertising set */
+            struct AdvSet {
+                uint8_t handle;
+                bool connectable;
+                bool enabled;
+                std::vector<uint8_t> adv_data;
+                std::vector<uint8_t> scan_rsp_data;
+            };
+
+            /** L2CAPServer listening on a channel */
+            struct Listener {
+                uint16_t cid;
+                std::string name; // abstract AF_UNIX socket name
+            };
+
+            /** Guards the radio range and link graph of all instances */
+            static std::mutex mtx_links;
+
+            int ctrl_sd; // the controller's end of the socketpair
+            int host_sd; // the host's end of the socketpair, until passed via takeHostSocket()
+            int wake_sd[2]; // wakes up ctrlWork() to poll new channels
+            std::recursive_mutex mtx_write;
+            jau::service_runner ctrl_service;
+            uint8_t rbuffer[number(HCIConstSizeT::PACKET_MAX_SIZE)+number(HCIConstSizeT::ACL_HDR_SIZE)];
+            uint8_t pdu_buffer[4+L2CAP_MAX_SDU_SIZE]; // basic L2CAP header and SDU
+
+            // guarded by mtx_links
+            std::vector<HCIVirtualController*> range;
+            std::vector<Link> links;
+            std::vector<Channel> channels;
+            std::vector<Listener> listeners;
+            uint16_t next_handle;
+            uint16_t next_sync_handle;
+            std::vector<uint16_t> periodic_syncs;
+            bool scan_enabled;
+            bool adv_enabled;
+            std::vector<uint8_t> adv_data;
+            std::vector<uint8_t> scan_rsp_data;
+            std::vector<AdvSet> adv_sets;
+
+            jau::relaxed_atomic_uint64 cmd_count;
+            jau::relaxed_atomic_uint64 evt_count;
+            jau::relaxed_atomic_uint64 acl_count;
+
+            void ctrlWork(jau::service_runner& sr) noexcept;
+            void processCommand(const uint8_t* buffer, const jau::nsize_t len) noexcept;
+            void processACLData(const uint8_t* buffer, const jau::nsize_t len) noexcept;
+            void processChannelLocked(const int sd) noexcept;
+            void receiveACLLocked(Link& l, const uint8_t* buffer, const jau::nsize_t len) noexcept;
+            void wakeup() noexcept;
+
+            bool send(const uint8_t* buffer, const jau::nsize_t size) noexcept;
+            bool sendEvent(const HCIEventType evt, const uint8_t* param, const uint8_t param_size) noexcept;
+            bool sendMetaEvent(const HCIMetaEventType mec, const uint8_t* param, const uint8_t param_size) noexcept;
+            bool sendCmdComplete(const uint16_t opcode, const HCIStatusCode status, const uint8_t* ret, const uint8_t ret_size) noexcept;
+            bool sendCmdStatus(const uint16_t opcode, const HCIStatusCode status) noexcept;
+            bool sendConnComplete(const HCIStatusCode status, const uint16_t handle, const uint8_t role, const jau::EUI48& peer_address) noexcept;
+            bool sendDisconnComplete(const uint16_t handle, const HCIStatusCode reason) noexcept;
+            bool sendAdvReport(const AD_PDU_Type evt_type, const jau::EUI48& adv_address, const uint8_t* data, const uint8_t data_size, const int8_t rssi) noexcept;
+
+            bool sendAdvSetTerminated(const uint8_t adv_handle, const uint16_t conn_handle) noexcept;
+            /** Sends the advertising reports of this advertising peer to the given scanning controller. */
+            void sendAdvReportsLocked(HCIVirtualController& scanner) noexcept;
+
+            AdvSet& getAdvSetLocked(const uint8_t handle) noexcept;
+            HCIVirtualController* findInRangeLocked(const jau::EUI48& peer_address) noexcept;
+            Link* findLinkLocked(const uint16_t handle) noexcept;
+            void removeLinkLocked(const uint16_t handle) noexcept;
+            Channel* findChannelLocked(const uint16_t handle, const uint16_t cid) noexcept;
+            /** Closes the channels of the given link and CID, all CIDs if `cid` is zero. */
+            void closeChannelsLocked(const uint16_t handle, const uint16_t cid) noexcept;
+            void closeAllChannelsLocked() noexcept;
+            void unlinkAllLocked() noexcept;
+
+        public:
+            /**
+             * Creates the socketpair and starts the controller's command processing thread.
+             * @param address the controller's public address
+             * @param ext_adv true to announce and support extended advertising, defaults to false for legacy LE only
+             */
+            HCIVirtualController(const jau::EUI48& address, const bool ext_adv=false) noexcept;
+
+            HCIVirtualController(const HCIVirtualController&) = delete;
+            void operator=(const HCIVirtualController&) = delete;
+
+            /**
+             * Releases this instance after issuing close().
+             */
+            ~HCIVirtualController() noexcept { close(); }
+
+            bool is_open() const noexcept { return 0 <= ctrl_sd; }
+
+            /**
+             * Returns the host's end of the socketpair passing its ownership to the caller, i.e. HCIComm.
+             * @return the socket descriptor or -1 if already taken or not open
+             */
+            int takeHostSocket() noexcept;
+
+            /**
+             * Stops the controller, tears down all links and removes it from all peers' radio range.
+             */
+            void close() noexcept;
+
+            /**
+             * Puts both controllers into mutual radio range.
+             */
+            static void link(HCIVirtualController& a, HCIVirtualController& b) noexcept;
+
+            /**
+             * Injects an LE advertising report to the host while scanning, e.g. to emulate a crowded radio environment.
+             * @return true if sent, false if not scanning or on error
+             */
+            bool injectAdvertisingReport(const AD_PDU_Type evt_type, const jau::EUI48& adv_address,
+                                         const uint8_t* data, const uint8_t data_size, const int8_t rssi) noexcept;
+
+            /**
+             * Injects an LE periodic advertising report of the given established sync to the host.
+             * @return true if sent, false if the sync is not established or on error
+             */
+            bool injectPeriodicAdvReport(const uint16_t sync_handle, const uint8_t* data, const uint8_t data_size, const int8_t rssi) noexcept;
+
+            /**
+             * Drops the given established sync, sending LE periodic advertising sync lost to the host.
+             * @return true if sent, false if the sync is not established or on error
+             */
+            bool injectPeriodicAdvSyncLost(const uint16_t sync_handle) noexcept;
+
+            /**
+             * Creates a listening L2CAP channel for the given CID, passing its ownership to the caller, i.e. L2CAPServer.
+             * <p>
+             * Connected channels are accepted via acceptL2CAP().
+             * </p>
+             * @return the listening socket descriptor or -1 on error
+             */
+            int listenL2CAP(const uint16_t cid) noexcept;
+
+            /**
+             * Accepts a connected L2CAP channel on the given listening socket, see listenL2CAP().
+             * <p>
+             * Blocks until a peer opened the channel via openL2CAPChannel() or an error occurred, e.g. an interrupting signal.
+             * </p>
+             * @param listen_sd the listening socket descriptor
+             * @param remoteAddressAndType destination of the connecting peer's address
+             * @return the connected channel's socket descriptor or -1 on error with `errno` set
+             */
+            static int acceptL2CAP(const int listen_sd, BDAddressAndType& remoteAddressAndType) noexcept;
+
+            /**
+             * Opens the L2CAP channel of the given CID to the peer of an established connection,
+             * passing the channel's ownership to the caller, i.e. L2CAPClient.
+             * <p>
+             * The peer's channel is queued for its listening L2CAPServer, see listenL2CAP().
+             * </p>
+             * @return the channel's socket descriptor or -1 on error with `errno` set,
+             *         i.e. `ENOTCONN` if not connected to the peer and `ECONNREFUSED` if the peer does not listen on the CID.
+             */
+            int openL2CAPChannel(const jau::EUI48& peer_address, const uint16_t cid) noexcept;
+
+            /** Returns the number of received HCI commands. */
+            uint64_t getCommandCount() const noexcept { return cmd_count; }
+
+            /** Returns the number of sent HCI events. */
+            uint64_t getEventCount() const noexcept { return evt_count; }
+
+            /** Returns the number of forwarded ACL data packets, including the segmented SDUs of bound L2CAP channels. */
+            uint64_t getACLCount() const noexcept { return acl_count; }
+
+            std::string toString() const noexcept;
+    };
+
+    /**@}*/
+
+} // namespace direct_bt
+
+#endif /* HCI_VIRTUAL_CONTROLLER_HPP_ */
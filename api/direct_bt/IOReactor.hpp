@@ -0,0 +1,262 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef IO_REACTOR_HPP_
+#define IO_REACTOR_HPP_
+
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#include <jau/basic_types.hpp>
+#include <jau/environment.hpp>
+#include <jau/functional.hpp>
+#include <jau/service_runner.hpp>
+
+/**
+ * - - - - - - - - - - - - - - -
+ *
+ * Module IOReactor:
+ *
+ * - Shared epoll based readiness dispatch of socket readers, replacing one polling thread per socket
+ */
+namespace direct_bt {
+
+    /** \addtogroup DBTSystemAPI
+     *
+     *  @{
+     */
+
+    /**
+     * Managed environment properties of IOReactor.
+     */
+    class IOReactorEnv : public jau::root_environment {
+        private:
+            IOReactorEnv() noexcept; // NOLINT(modernize-use-equals-delete)
+
+            const bool exploding; // just to trigger exploding properties
+
+        public:
+            /**
+             * Enables the shared IOReactor for the per-device BTGattHandler socket readers, defaults to false.
+             * <p>
+             * If disabled, each reader owns a polling jau::service_runner thread.
+             * </p>
+             * <p>
+             * The HCIHandler reader always owns its thread, as HCI command replies must be received
+             * while a dispatched GATT callback blocks on an HCI command, e.g. BTDevice::disconnect().
+             * </p>
+             * <p>
+             * A GATT listener may issue requests to other devices, see IOReactor::BlockingScope,
+             * while a request to its own device fails immediately.
+             * </p>
+             * <p>
+             * Environment variable is 'direct_bt.reactor'.
+             * </p>
+             */
+            const bool REACTOR_ENABLED;
+
+            /**
+             * Number of IOReactor dispatch threads, defaults to 1.
+             * <p>
+             * Environment variable is 'direct_bt.reactor.threads', value range [1..16].
+             * </p>
+             */
+            const int32_t REACTOR_THREADS;
+
+            /**
+             * Debug all IOReactor registrations and dispatches
+             * <p>
+             * Environment variable is 'direct_bt.debug.reactor'.
+             * </p>
+             */
+            const bool DEBUG_REACTOR;
+
+        public:
+            static IOReactorEnv& get() noexcept {
+                /**
+                 * Thread safe starting with C++11 6.7:
+                 *
+                 * If control enters the declaration concurrently while the variable is being initialized,
+                 * the concurrent execution shall wait for completion of the initialization.
+                 *
+                 * (Magic Statics)
+                 *
+                 * Avoiding non-working double checked locking.
+                 */
+                static IOReactorEnv e;
+                return e;
+            }
+    };
+
+    /**
+     * Shared epoll based reactor multiplexing socket readers onto IOReactorEnv::REACTOR_THREADS dispatch threads.
+     * <p>
+     * A registered ReadyCallback is invoked on a dispatch thread whenever its socket becomes readable or hung up,
+     * it shall consume the available data without blocking and return true to stay registered.
+     * </p>
+     * <p>
+     * Sockets are registered one-shot and re-armed after each dispatch,
+     * hence a ReadyCallback is never invoked concurrently with itself.
+     * </p>
+     * <p>
+     * A ReadyCallback may block, e.g. a user GATT listener issuing a request to another device,
+     * if it marks the blocking section with a BlockingScope: Its pending dispatches are handed over
+     * and another dispatch thread is started if all are blocked, up to MAX_EXTRA_THREADS.
+     * Its own socket is not dispatched before it returns, see isDispatching().
+     * </p>
+     * <p>
+     * The dispatch threads are started with the first registration and stopped at destruction, i.e. process exit.
+     * </p>
+     */
+    class IOReactor {
+        public:
+            /**
+             * Readiness callback, invoked on a dispatch thread.
+             * @return true to stay registered, false to deregister, e.g. on error or closed socket
+             */
+            typedef jau::function<bool()> ReadyCallback;
+
+            /** Maximum number of dispatch threads started in addition to IOReactorEnv::REACTOR_THREADS for blocked ReadyCallback. */
+            static constexpr const int32_t MAX_EXTRA_THREADS = 16;
+
+            /**
+             * Marks a blocking section of a ReadyCallback while in scope, e.g. awaiting a reply dispatched by another ReadyCallback.
+             * <p>
+             * No-op if not constructed on a dispatch thread.
+             * </p>
+             */
+            class BlockingScope {
+                private:
+                    const bool blocking;
+
+                public:
+                    BlockingScope() noexcept;
+                    ~BlockingScope() noexcept;
+
+                    BlockingScope(const BlockingScope&) = delete;
+                    void operator=(const BlockingScope&) = delete;
+            };
+
+        private:
+            struct Entry {
+                int fd;
+                std::string name;
+                ReadyCallback cb;
+                bool busy; // callback in progress
+                bool removed;
+                std::thread::id busy_tid;
+            };
+
+            const IOReactorEnv & env;
+            int epoll_fd;
+            std::mutex mtx_entries;
+            std::condition_variable cv_entries;
+            std::unordered_map<uint64_t, std::shared_ptr<Entry>> entries;
+            uint64_t next_id;
+            std::vector<std::unique_ptr<jau::service_runner>> dispatcher;
+            /** Number of dispatch threads within a BlockingScope, guarded by mtx_entries */
+            jau::nsize_t blocked_count;
+            jau::relaxed_atomic_uint64 dispatch_count;
+            jau::relaxed_atomic_uint64 extra_started;
+
+            IOReactor() noexcept;
+
+            void dispatchWork(jau::service_runner& sr) noexcept;
+            void startLocked() noexcept;
+            void startDispatcherLocked() noexcept;
+            bool rearmLocked(const uint64_t id, Entry& e) noexcept;
+            void beginBlocking() noexcept;
+            void endBlocking() noexcept;
+
+        public:
+            /** Returns true if enabled via IOReactorEnv::REACTOR_ENABLED. */
+            static bool isEnabled() noexcept { return IOReactorEnv::get().REACTOR_ENABLED; }
+
+            /** Returns the process wide reactor instance. */
+            static IOReactor& get() noexcept {
+                static IOReactor r; // Magic Statics, see IOReactorEnv::get()
+                return r;
+            }
+
+            IOReactor(const IOReactor&) = delete;
+            void operator=(const IOReactor&) = delete;
+
+            ~IOReactor() noexcept;
+
+            /**
+             * Registers the given socket for readiness dispatch, starting the dispatch threads if required.
+             * @param fd the readable socket descriptor, shall stay open until removed
+             * @param name name for debugging
+             * @param cb readiness callback
+             * @return the non-zero registration id or zero on failure
+             */
+            uint64_t add(const int fd, const std::string& name, ReadyCallback cb) noexcept;
+
+            /**
+             * Removes the given registration and waits until its ReadyCallback has completed,
+             * unless called from within the callback itself.
+             * <p>
+             * No callback will be invoked after returning, hence the caller may close the socket
+             * and destruct the callback's target.
+             * </p>
+             * @return true if the registration existed and has been removed, otherwise false
+             */
+            bool remove(const uint64_t id) noexcept;
+
+            /** Returns true if the given registration exists. */
+            bool contains(const uint64_t id) noexcept;
+
+            /** Returns the number of registered sockets. */
+            jau::nsize_t size() noexcept;
+
+            /**
+             * Returns true if the current thread dispatches the ReadyCallback of the given registration.
+             * <p>
+             * A blocking wait for data of its own socket would never complete, as the socket is not dispatched until it returns.
+             * </p>
+             */
+            static bool isDispatching(const uint64_t id) noexcept;
+
+            /** Returns the number of dispatch threads started for blocked ReadyCallback, see BlockingScope. */
+            uint64_t getExtraThreadsStarted() const noexcept { return extra_started; }
+
+            /** Returns the number of dispatched readiness events. */
+            uint64_t getDispatchCount() const noexcept { return dispatch_count; }
+
+            std::string toString() noexcept;
+    };
+
+    /**@}*/
+
+} // namespace direct_bt
+
+#endif /* IO_REACTOR_HPP_ */
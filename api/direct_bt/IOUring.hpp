@@ -0,0 +1,187 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef IO_URING_HPP_
+#define IO_URING_HPP_
+
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <mutex>
+
+#include <jau/basic_types.hpp>
+#include <jau/fraction_type.hpp>
+
+/**
+ * - - - - - - - - - - - - - - -
+ *
+ * Module IOUring:
+ *
+ * - Optional io_uring based socket I/O backend of HCIComm and L2CAPClient
+ * - Build-time selected via CMake option `USE_IO_URING`, requiring liburing >= 2.4
+ */
+namespace direct_bt {
+
+    /** \addtogroup DBTSystemAPI
+     *
+     *  @{
+     */
+
+    /**
+     * io_uring channel of one packet based socket, i.e. `SOCK_SEQPACKET` or `SOCK_RAW`.
+     * <p>
+     * Receiving uses a multishot `recv` on a ring of provided buffers,
+     * i.e. one armed request delivers all incoming packets w/o a system call per packet
+     * and w/o the poll() and read() roundtrip of the blocking path.
+     * </p>
+     * <p>
+     * Sending uses a separate ring with one registered buffer arena of `slot_count` slots,
+     * write_batch() submits all packets linked in order via a single system call.
+     * </p>
+     * <p>
+     * Reading shall be performed by one thread only, writing is serialized internally.
+     * The owner shall release the channel before closing the socket.
+     * </p>
+     * <p>
+     * The channel must be the only reader of its socket,
+     * hence L2CAPClient does not use it if its socket is served by IOReactor.
+     * </p>
+     */
+    class IOUringChannel {
+        private:
+            struct Impl;
+
+            const int fd;
+            const jau::nsize_t slot_size;
+            const jau::nsize_t slot_count;
+            std::unique_ptr<Impl> impl;
+            std::mutex mtx_write;
+
+            IOUringChannel(const int fd, const jau::nsize_t slot_size, const jau::nsize_t slot_count) noexcept;
+
+        public:
+            /** Default number of receive and send slots. */
+            constexpr static const jau::nsize_t DEFAULT_SLOT_COUNT = 64;
+
+            /**
+             * Returns true if io_uring support has been built in, see CMake option `USE_IO_URING`,
+             * and is enabled at runtime.
+             * <p>
+             * Environment variable 'direct_bt.io_uring' may disable the backend, defaults to true.
+             * </p>
+             */
+            static bool isEnabled() noexcept;
+
+            /**
+             * Overrides the runtime enablement of the io_uring backend, e.g. to compare it with the blocking path.
+             * <p>
+             * Only affects channels lazily created thereafter by HCIComm and L2CAPClient.
+             * </p>
+             * @param enable true to enable the backend, false to use the blocking path
+             * @return false if enabling was requested but io_uring support has not been built in, otherwise true
+             */
+            static bool setEnabled(const bool enable) noexcept;
+
+            /**
+             * Creates a channel for the given socket, arming its multishot receive.
+             * @param fd the socket descriptor, ownership remains with the caller
+             * @param slot_size maximum packet size, larger received packets are truncated
+             * @param slot_count number of receive and send slots, a power of two up to 32768
+             * @return the channel or nullptr if io_uring is not built in or not supported by the running kernel
+             */
+            static std::unique_ptr<IOUringChannel> create(const int fd, const jau::nsize_t slot_size,
+                                                          const jau::nsize_t slot_count=DEFAULT_SLOT_COUNT) noexcept;
+
+            IOUringChannel(const IOUringChannel&) = delete;
+            void operator=(const IOUringChannel&) = delete;
+
+            /** Tears down both rings, cancelling the armed receive. */
+            ~IOUringChannel() noexcept;
+
+            int socket() const noexcept { return fd; }
+            jau::nsize_t getSlotSize() const noexcept { return slot_size; }
+
+            /**
+             * Reads the next received packet.
+             * <p>
+             * Returns early with `EINTR` if the calling thread is signaled, e.g. via `pthread_kill()` at close.
+             * </p>
+             * @param buffer destination
+             * @param capacity capacity of buffer, a larger packet is truncated
+             * @param timeout maximum wait, zero to wait infinitely
+             * @return number of bytes read, zero if the peer has shutdown or -1 on error and timeout with `errno` set
+             */
+            jau::snsize_t read(uint8_t* buffer, const jau::nsize_t capacity, const jau::fraction_i64& timeout) noexcept;
+
+            /**
+             * Reads all received packets up to `count` w/o a system call per packet, see HCIComm::read_batch().
+             * <p>
+             * Waits up to `timeout` for the first packet, then takes all further completed packets w/o waiting.
+             * Packet `i` is stored at `buffer + i * slot_capacity` with its length in `lengths[i]`, a larger packet is truncated.
+             * </p>
+             * <p>
+             * Returns early with `EINTR` if the calling thread is signaled, e.g. via `pthread_kill()` at close.
+             * </p>
+             * @param buffer destination of `count * slot_capacity` bytes
+             * @param slot_capacity capacity of each packet slot
+             * @param count number of packet slots in `buffer` and `lengths`
+             * @param lengths destination of the received packet lengths
+             * @param timeout maximum wait for the first packet, zero for no wait
+             * @return number of received packets, zero if none received w/o wait or the peer has shutdown,
+             *         or -1 on error and timeout with `errno` set
+             */
+            jau::snsize_t read_batch(uint8_t* buffer, const jau::nsize_t slot_capacity, const jau::nsize_t count,
+                                     jau::nsize_t* lengths, const jau::fraction_i64& timeout) noexcept;
+
+            /**
+             * Writes one packet, see write_batch().
+             * @return number of bytes written or -1 on error with `errno` set
+             */
+            jau::snsize_t write(const uint8_t* buffer, const jau::nsize_t length) noexcept;
+
+            /**
+             * Writes `count` packets in order via one linked submission.
+             * <p>
+             * Packets up to the slot size are sent from the registered buffer arena,
+             * larger ones directly from the given buffer.
+             * `count` is clamped to the slot count.
+             * </p>
+             * @param buffers the packets
+             * @param lengths the packet lengths
+             * @param count number of packets
+             * @return number of packets completely written, stopping at the first error,
+             *         or -1 if the first packet failed with `errno` set
+             */
+            jau::snsize_t write_batch(const uint8_t* const* buffers, const jau::nsize_t* lengths, const jau::nsize_t count) noexcept;
+
+            std::string toString() const noexcept;
+    };
+
+    /**@}*/
+
+} // namespace direct_bt
+
+#endif /* IO_URING_HPP_ */
@@ -39,6 +39,7 @@
 #include <jau/functional.hpp>
 
 #include "BTTypes0.hpp"
+#include "IOUring.hpp"
 
 extern "C" {
     #include <pthread.h>
@@ -54,6 +55,7 @@ extern "C" {
 namespace direct_bt {
 
     class BTDevice; // forward
+    class HCIVirtualController; // forward
 
     /** \addtogroup DBTSystemAPI
      *
@@ -230,10 +232,27 @@ namespace direct_bt {
             std::atomic<bool> has_ioerror;  // reflects state
             std::atomic<::pthread_t> tid_connect;
             std::atomic<::pthread_t> tid_read;
+            std::mutex mtx_uring;
+            std::shared_ptr<IOUringChannel> uring; // optional io_uring backend, created lazily
+            bool uring_failed;
 
             bool close_impl() noexcept;
 
+            /**
+             * Returns the io_uring backend if IOUringChannel::isEnabled() and IOReactor is disabled,
+             * lazily created for the open socket, otherwise nullptr.
+             */
+            std::shared_ptr<IOUringChannel> getUring() noexcept;
+
         public:
+            /**
+             * Packet slot size of the optional io_uring backend, see IOUringChannel.
+             * <p>
+             * Exceeds the maximum ATT PDU of 517 bytes and SMP PDU of 65 bytes on the LE fixed channels.
+             * </p>
+             */
+            constexpr static const jau::nsize_t URING_SLOT_SIZE = 1024;
+
             /**
              * Constructing a non connected L2CAP channel instance for the pre-defined PSM and CID.
              */
@@ -262,6 +281,17 @@ namespace direct_bt {
              */
             bool open(const BTDevice& device, const BTSecurityLevel sec_level=BTSecurityLevel::NONE) noexcept;
 
+            /**
+             * Opens the L2CAP channel to the given remote device via the HCIVirtualController, see HCIVirtualController::openL2CAPChannel().
+             * <p>
+             * Intended for hardware-free testing, no security level is applicable.
+             * </p>
+             * @param ctrl the virtual controller having established a connection to the remote device
+             * @param remoteAddressAndType the remote device listening on this instance's CID
+             * @return true if the channel has been opened, otherwise false
+             */
+            bool open(HCIVirtualController& ctrl, const BDAddressAndType& remoteAddressAndType) noexcept;
+
             const BDAddressAndType& getRemoteAddressAndType() const noexcept { return remoteAddressAndType; }
 
             /** Closing the L2CAP channel, locking {@link #mutex_write()}. */
@@ -294,6 +324,9 @@ namespace direct_bt {
 
             /**
              * Generic read, w/o locking suitable for a unique ringbuffer sink. Using L2CAPEnv::L2CAP_READER_POLL_TIMEOUT.
+             * <p>
+             * Uses the io_uring backend if IOUringChannel::isEnabled(), otherwise `poll()` and `read()`.
+             * </p>
              * @param buffer
              * @param capacity
              * @return number of bytes read if >= 0, otherwise L2CAPComm::ExitCode error code.
@@ -308,6 +341,18 @@ namespace direct_bt {
              */
             jau::snsize_t write(const uint8_t *buffer, const jau::nsize_t length) noexcept;
 
+            /**
+             * Batched write of `count` packets in order, locking {@link #mutex_write()}.
+             * <p>
+             * Submits all packets via one system call if IOUringChannel::isEnabled(), otherwise issues write() per packet.
+             * </p>
+             * @param buffers the packets
+             * @param lengths the packet lengths
+             * @param count number of packets
+             * @return number of packets written if >= 0, otherwise L2CAPComm::ExitCode error code.
+             */
+            jau::snsize_t write_batch(const uint8_t* const* buffers, const jau::nsize_t* lengths, const jau::nsize_t count) noexcept;
+
             std::string toString() const noexcept override;
     };
 
@@ -317,6 +362,7 @@ namespace direct_bt {
     class L2CAPServer : public L2CAPComm {
         private:
             std::atomic<::pthread_t> tid_accept;
+            bool virtual_ctrl;
 
             bool close_impl() noexcept;
 
@@ -330,6 +376,14 @@ namespace direct_bt {
 
             bool open() noexcept;
 
+            /**
+             * Opens the listening L2CAP channel via the HCIVirtualController, see HCIVirtualController::listenL2CAP().
+             * <p>
+             * Intended for hardware-free testing, accept() returns the channels opened by connected peers.
+             * </p>
+             */
+            bool open(HCIVirtualController& ctrl) noexcept;
+
             bool close() noexcept override { return close_impl(); }
 
             std::unique_ptr<L2CAPClient> accept() noexcept;
@@ -2124,11 +2124,14 @@ namespace direct_bt {
     class MgmtEvtDeviceFound : public MgmtEvent
     {
         private:
-            std::unique_ptr<EInfoReport> eireport;
+            const EInfoReportView* eireport_view;
+            mutable std::unique_ptr<EInfoReport> eireport; // lazily materialized from eireport_view
 
         protected:
             std::string baseString() const noexcept override {
-                if( nullptr != eireport ) {
+                if( nullptr != eireport_view ) {
+                    return MgmtEvent::baseString()+", "+eireport_view->toString();
+                } else if( nullptr != eireport ) {
                     return MgmtEvent::baseString()+", "+eireport->toString(false /* includeServices */);
                 } else {
                     return MgmtEvent::baseString()+", address="+getAddress().toString()+
@@ -2140,12 +2143,12 @@ namespace direct_bt {
 
         public:
             MgmtEvtDeviceFound(const uint8_t* buffer, const jau::nsize_t buffer_len)
-            : MgmtEvent(buffer, buffer_len, 14), eireport(nullptr)
+            : MgmtEvent(buffer, buffer_len, 14), eireport_view(nullptr), eireport(nullptr)
             {
                 checkOpcode(getOpcode(), Opcode::DEVICE_FOUND);
             }
             MgmtEvtDeviceFound(const uint16_t dev_id, std::unique_ptr<EInfoReport> && eir)
-            : MgmtEvent(Opcode::DEVICE_FOUND, dev_id, 6+1+1+4+2+0), eireport(std::move(eir))
+            : MgmtEvent(Opcode::DEVICE_FOUND, dev_id, 6+1+1+4+2+0), eireport_view(nullptr), eireport(std::move(eir))
             {
                 pdu.put_eui48_nc(MGMT_HEADER_SIZE, eireport->getAddress());
                 pdu.put_uint8_nc(MGMT_HEADER_SIZE+6, direct_bt::number(eireport->getAddressType()));
@@ -2154,8 +2157,44 @@ namespace direct_bt {
                 pdu.put_uint16_nc(MGMT_HEADER_SIZE+6+1+1+4, 0); // eir_len
             }
 
-            /** Returns reference to the immutable EInfoReport, assuming creation occurred via HCIHandler. Otherwise nullptr. */
-            const EInfoReport* getEIR() const noexcept { return eireport.get(); }
+            /**
+             * Creates a device found event referencing the given EInfoReportView,
+             * which must stay valid for the lifetime of this instance, i.e. during its dispatch.
+             * <p>
+             * The owning EInfoReport is only materialized on demand via getEIR().
+             * </p>
+             */
+            MgmtEvtDeviceFound(const uint16_t dev_id, const EInfoReportView& eir_view)
+            : MgmtEvent(Opcode::DEVICE_FOUND, dev_id, 6+1+1+4+2+0), eireport_view(&eir_view), eireport(nullptr)
+            {
+                pdu.put_eui48_nc(MGMT_HEADER_SIZE, eireport_view->getAddress());
+                pdu.put_uint8_nc(MGMT_HEADER_SIZE+6, direct_bt::number(eireport_view->getAddressType()));
+                pdu.put_int8_nc(MGMT_HEADER_SIZE+6+1, eireport_view->getRSSI());
+                pdu.put_uint32_nc(MGMT_HEADER_SIZE+6+1+1, direct_bt::number(eireport_view->getFlags())); // EIR flags only 8bit, Mgmt uses 32bit?
+                pdu.put_uint16_nc(MGMT_HEADER_SIZE+6+1+1+4, 0); // eir_len
+            }
+
+            /** Returns true if this event carries an EInfoReport or EInfoReportView, i.e. creation occurred via HCIHandler. */
+            bool hasEIR() const noexcept { return nullptr != eireport_view || nullptr != eireport; }
+
+            /**
+             * Returns reference to the immutable EInfoReport, assuming creation occurred via HCIHandler. Otherwise nullptr.
+             * <p>
+             * If created with an EInfoReportView, the EInfoReport gets materialized with the first call.
+             * </p>
+             */
+            const EInfoReport* getEIR() const noexcept {
+                if( nullptr == eireport && nullptr != eireport_view ) {
+                    eireport = eireport_view->materialize();
+                }
+                return eireport.get();
+            }
+
+            /** Returns true if the owning EInfoReport exists, i.e. was passed at creation or materialized via getEIR(). */
+            bool isEIRMaterialized() const noexcept { return nullptr != eireport; }
+
+            /** Returns the non-owning EInfoReportView if created with one, otherwise nullptr. */
+            const EInfoReportView* getEIRView() const noexcept { return eireport_view; }
 
             const EUI48& getAddress() const noexcept { return *reinterpret_cast<const EUI48 *>( pdu.get_ptr_nc(MGMT_HEADER_SIZE + 0) ); } // mgmt_addr_info
             BDAddressType getAddressType() const noexcept { return static_cast<BDAddressType>(pdu.get_uint8_nc(MGMT_HEADER_SIZE+6)); } // mgmt_addr_info
@@ -0,0 +1,183 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RPA_RESOLVER_HPP_
+#define RPA_RESOLVER_HPP_
+
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <mutex>
+
+#include <jau/basic_types.hpp>
+#include <jau/darray.hpp>
+#include <jau/eui48.hpp>
+#include <jau/int_types.hpp>
+#include <jau/ordered_atomic.hpp>
+
+#include "BTAddress.hpp"
+#include "SMPCrypto.hpp"
+
+/**
+ * - - - - - - - - - - - - - - -
+ *
+ * Module RPAResolver:
+ *
+ * - Resolving random private addresses (RPA) against a set of bonded Identity Resolving Keys (IRK)
+ */
+namespace direct_bt {
+
+    /** \addtogroup DBTSystemAPI
+     *
+     *  @{
+     */
+
+    /**
+     * Resolves random private addresses (RPA) against a set of Identity Resolving Keys (IRK)
+     * to their owner's identity address.
+     * <p>
+     * Each IRK is held with its precomputed AES key schedule, see SMPIRKSchedule,
+     * and an unknown RPA is evaluated against all IRKs in one batch.
+     * </p>
+     * <p>
+     * A bounded least recently used (LRU) cache maps recently seen RPAs to their resolved identity,
+     * or to being unresolvable. Since an advertiser rotates its RPA only every ~15 minutes,
+     * repeated reports of the same RPA are resolved w/o any AES evaluation.
+     * Adding an IRK drops all cached unresolvable RPAs, removing an IRK all RPAs resolved to its identity.
+     * </p>
+     * <p>
+     * All methods are thread safe.
+     * </p>
+     * @see BTAdapter::getRPAResolver()
+     */
+    class RPAResolver {
+        public:
+            /** Default number of cached RPA resolutions. */
+            static constexpr const jau::nsize_t DEFAULT_CACHE_CAPACITY = 128;
+
+        private:
+            struct CacheEntry {
+                EUI48 rpa;
+                /** The resolved identity, BDAddressType::BDADDR_UNDEFINED if unresolvable */
+                BDAddressAndType identity;
+                uint64_t last_use;
+            };
+
+            const jau::nsize_t cache_capacity;
+            mutable std::mutex mtx;
+            // parallel arrays, keeping the key schedules contiguous for batched evaluation
+            jau::darray<BDAddressAndType> identities;
+            jau::darray<jau::uint128dp_t> irks;
+            jau::darray<SMPIRKSchedule> scheds;
+            jau::darray<CacheEntry> cache;
+            uint64_t use_count;
+
+            jau::relaxed_atomic_uint64 cache_hits;
+            jau::relaxed_atomic_uint64 cache_misses;
+            jau::relaxed_atomic_uint64 evaluations;
+
+            jau::snsize_t indexOfLocked(const BDAddressAndType& identity) const noexcept;
+            void putCacheLocked(const EUI48& rpa, const BDAddressAndType& identity) noexcept;
+
+        public:
+            /**
+             * Constructs an empty resolver.
+             * @param cache_capacity_ maximum number of cached RPA resolutions, zero disables caching
+             */
+            RPAResolver(const jau::nsize_t cache_capacity_=DEFAULT_CACHE_CAPACITY) noexcept;
+
+            RPAResolver(const RPAResolver&) = delete;
+            void operator=(const RPAResolver&) = delete;
+
+            /**
+             * Adds the IRK of the given identity or replaces its former IRK.
+             * @param identity the IRK owner's identity address
+             * @param irk the Identity Resolving Key
+             */
+            void add(const BDAddressAndType& identity, const jau::uint128dp_t& irk) noexcept;
+
+            /**
+             * Removes the IRK of the given identity.
+             * @return true if removed, false if not contained
+             */
+            bool remove(const BDAddressAndType& identity) noexcept;
+
+            /** Removes all IRKs and cached resolutions. */
+            void clear() noexcept;
+
+            /** Returns the number of contained IRKs. */
+            jau::nsize_t size() const noexcept;
+
+            /**
+             * Resolves the given random private address (RPA).
+             * @param rpa the random private address
+             * @param identity set to the resolved identity address if successful
+             * @return true if resolved, otherwise false
+             */
+            bool resolve(const EUI48& rpa, BDAddressAndType& identity) noexcept;
+
+            /**
+             * Resolves the given random private address (RPA) to the object owning the resolved identity, e.g. a BTDevice,
+             * removing a stale IRK.
+             * <p>
+             * The IRK of the resolved identity is stale and removed if `valid` rejects the object returned by `lookup`,
+             * e.g. a device whose IRK has been removed or replaced.
+             * </p>
+             * @param rpa the random private address
+             * @param lookup `std::shared_ptr<T> lookup(const BDAddressAndType& identity)` returning the object of the resolved identity or nullptr
+             * @param valid `bool valid(const T& obj, const BDAddressAndType& identity)` returning true if `obj` still owns the IRK of `identity`
+             * @return the resolved and valid object, otherwise nullptr
+             * @see BTAdapter::findIndexedDevice()
+             */
+            template<class Lookup, class Valid>
+            auto resolve(const EUI48& rpa, Lookup lookup, Valid valid) noexcept -> decltype( lookup( BDAddressAndType() ) ) {
+                BDAddressAndType identity;
+                if( !resolve(rpa, identity) ) {
+                    return nullptr;
+                }
+                auto e = lookup(identity);
+                if( nullptr != e && !valid(*e, identity) ) {
+                    remove(identity);
+                    return nullptr;
+                }
+                return e;
+            }
+
+            /** Returns the number of resolve() calls answered by the cache. */
+            uint64_t getCacheHits() const noexcept { return cache_hits; }
+
+            /** Returns the number of resolve() calls requiring an evaluation of all IRKs. */
+            uint64_t getCacheMisses() const noexcept { return cache_misses; }
+
+            /** Returns the number of single IRK evaluations, i.e. AES operations, performed. */
+            uint64_t getEvaluations() const noexcept { return evaluations; }
+
+            std::string toString() const noexcept;
+    };
+
+    /**@}*/
+
+} // namespace direct_bt
+
+#endif /* RPA_RESOLVER_HPP_ */
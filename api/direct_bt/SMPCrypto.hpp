@@ -26,6 +26,8 @@
 #ifndef SMP_CRYPTO_HPP_
 #define SMP_CRYPTO_HPP_
 
+#include <string>
+
 #include <jau/int_types.hpp>
 #include <jau/byte_util.hpp>
 #include <jau/eui48.hpp>
@@ -33,9 +35,87 @@
 #include "BTAddress.hpp"
 
 namespace direct_bt {
+    /**
+     * AES-128 block cipher implementation used by the SMP crypto functions.
+     * <p>
+     * The fastest backend supported by the CPU is selected at runtime,
+     * falling back to the portable tinycrypt implementation.
+     * </p>
+     */
+    enum class SMPAESBackend : uint8_t {
+        /** Portable software implementation */
+        TINYCRYPT = 0,
+        /** x86 AES-NI instructions */
+        AESNI = 1,
+        /** ARMv8 cryptography extension AES instructions */
+        ARMV8_CE = 2
+    };
+    std::string to_string(const SMPAESBackend b) noexcept;
+
+    /** Returns true if the given SMPAESBackend is supported by this build and CPU. */
+    bool smp_crypto_aes_supported(const SMPAESBackend b) noexcept;
+
+    /** Returns the active SMPAESBackend, initially the fastest supported. */
+    SMPAESBackend smp_crypto_aes_backend() noexcept;
+
+    /**
+     * Sets the active SMPAESBackend, e.g. for cross-checking and benchmarking.
+     * <p>
+     * Existing SMPIRKSchedule instances keep using the backend they have been created with.
+     * </p>
+     * @return true if supported and set, otherwise false
+     */
+    bool smp_crypto_set_aes_backend(const SMPAESBackend b) noexcept;
+
+    /**
+     * Security function e, i.e. AES-128 encryption of one block using the active SMPAESBackend.
+     * @param key 128-bit key in little endian
+     * @param plaintext 128-bit plaintext in little endian
+     * @param enc 128-bit encrypted result in little endian
+     * @return true if successful, otherwise false
+     */
+    bool smp_crypto_e(const jau::uint128dp_t& key, const jau::uint128dp_t& plaintext, jau::uint128dp_t& enc) noexcept;
+
     /** Returns true if the given IRK matches the given random private address (RPA). */
     bool smp_crypto_rpa_irk_matches(const jau::uint128dp_t irk, const EUI48& rpa) noexcept;
 
+    /**
+     * Precomputed AES-128 key schedule of an Identity Resolving Key (IRK),
+     * resolving random private addresses (RPA) w/o repeating the key expansion per evaluation.
+     * <p>
+     * Results are identical to smp_crypto_rpa_irk_matches().
+     * </p>
+     * <p>
+     * The key schedule is laid out for the active SMPAESBackend at construction.
+     * </p>
+     */
+    class SMPIRKSchedule {
+        private:
+            alignas(16) uint8_t sched[176]; // AES-128 key schedule, 11 round keys
+            SMPAESBackend backend;
+            bool valid;
+
+        public:
+            SMPIRKSchedule() noexcept : sched(), backend(SMPAESBackend::TINYCRYPT), valid(false) {}
+
+            /** Expands the given IRK's key schedule */
+            explicit SMPIRKSchedule(const jau::uint128dp_t& irk) noexcept;
+
+            bool isValid() const noexcept { return valid; }
+
+            SMPAESBackend getBackend() const noexcept { return backend; }
+
+            /** Returns true if this IRK matches the given random private address (RPA). */
+            bool matches(const EUI48& rpa) const noexcept;
+
+            /**
+             * Batched evaluation of one random private address (RPA) against `count` key schedules,
+             * preparing the RPA's plaintext block only once.
+             * @return index of the first matching schedule or -1 if none matches
+             */
+            static jau::snsize_t find(const SMPIRKSchedule* scheds, const jau::nsize_t count, const EUI48& rpa) noexcept;
+    };
+
     bool smp_crypto_f5(const jau::uint256dp_t w, const jau::uint128dp_t n1, const jau::uint128dp_t n2,
                        const BDAddressAndType& a1, const BDAddressAndType& a2,
                        jau::uint128dp_t& mackey, jau::uint128dp_t& ltk) noexcept;
@@ -0,0 +1,359 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef SCAN_FILTER_HPP_
+#define SCAN_FILTER_HPP_
+
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <memory>
+
+#include <jau/basic_types.hpp>
+#include <jau/darray.hpp>
+#include <jau/fraction_type.hpp>
+#include <jau/eui48.hpp>
+#include <jau/uuid.hpp>
+
+#include "BTAddress.hpp"
+#include "BTTypes0.hpp"
+
+/**
+ * - - - - - - - - - - - - - - -
+ *
+ * Module ScanFilter:
+ *
+ * - Declarative advertising report pre-filter, evaluated on the raw AD data before any allocation
+ * - Per address filter state across an address' advertising and scan response reports
+ */
+namespace direct_bt {
+
+    /** \addtogroup DBTUserAPI
+     *
+     *  @{
+     */
+
+    /**
+     * One scan filter rule, matching an advertising report if all of its set criteria match.
+     * <p>
+     * Criteria are set via the chaining setter methods, e.g.
+     * <pre>
+     *   ScanFilterRule().manufacturer(0x0059).minRSSI(-80)
+     * </pre>
+     * Per report criteria (address, address type, RSSI and AD type presence) are tested first on each report,
+     * AD type criteria via the type presence set of EInfoReportView::getADIndex() only.
+     * The remaining AD data criteria (service, manufacturer specific data and name prefix)
+     * are tested within a single pass over the report's indexed AD structures
+     * and may be accumulated across multiple reports of one address, see matches(const EInfoReportView&, State&).
+     * </p>
+     * @see ScanFilter
+     */
+    class ScanFilterRule {
+        public:
+            /** Maximum number of manufacturer specific data bytes to be matched. */
+            static constexpr const jau::nsize_t MSD_MAX_SIZE = 27;
+
+        private:
+            enum Criteria : uint16_t {
+                CRIT_ADDRESS       = 1 << 0,
+                CRIT_ADDRESS_TYPE  = 1 << 1,
+                CRIT_MIN_RSSI      = 1 << 2,
+                CRIT_SERVICE       = 1 << 3,
+                CRIT_MSD           = 1 << 4,
+                CRIT_NAME_PREFIX   = 1 << 5,
+                CRIT_AD_TYPES      = 1 << 6,
+                /** AD data criteria accumulated across reports */
+                CRIT_AD_DATA       = CRIT_SERVICE | CRIT_MSD | CRIT_NAME_PREFIX
+            };
+            uint16_t criteria = 0;
+
+            uint8_t addr_value[6] = { 0 }; // little endian, pre-masked
+            uint8_t addr_mask[6] = { 0 };
+            BDAddressType address_type = BDAddressType::BDADDR_UNDEFINED;
+            int8_t min_rssi = -127;
+            std::shared_ptr<const jau::uuid_t> service_uuid;
+            uint8_t svc_le128[16] = { 0 }; // 128 bit little endian form, the 16 and 32 bit forms at octet index 12
+            bool svc_has16 = false;
+            bool svc_has32 = false;
+            uint16_t msd_company = 0;
+            uint8_t msd_len = 0;
+            uint8_t msd_value[MSD_MAX_SIZE] = { 0 }; // pre-masked
+            uint8_t msd_mask[MSD_MAX_SIZE] = { 0 };
+            uint8_t name_len = 0;
+            char name_prefix[EInfoReport::NAME_INLINE_SIZE] = { 0 };
+            uint32_t ad_types[8] = { 0 }; // bitset of required GAP_T
+
+        public:
+            /**
+             * Matching state of this rule's AD data criteria across multiple reports of one address,
+             * see matches(const EInfoReportView&, State&).
+             */
+            struct State {
+                /** Pending AD data criteria, all satisfied if zero. */
+                uint16_t pending;
+            };
+
+        private:
+            void matchesADData(const ADStructIndex& index, uint16_t& pending) const noexcept;
+
+        public:
+            ScanFilterRule() noexcept = default;
+
+            /**
+             * Requires the address to match the given address within its `prefix_len` most significant bytes,
+             * e.g. a prefix length of 3 matches the OUI of a public address.
+             * @param address the address
+             * @param prefix_len number of most significant bytes to match, [1..6], defaults to 6 for the complete address
+             */
+            ScanFilterRule& address(const jau::EUI48& address, const jau::nsize_t prefix_len=6) noexcept;
+
+            /** Requires the given BDAddressType. */
+            ScanFilterRule& addressType(const BDAddressType type) noexcept;
+
+            /** Requires an RSSI of at least the given value in dBm. */
+            ScanFilterRule& minRSSI(const int8_t rssi) noexcept;
+
+            /** Requires the given service UUID within any 16, 32 or 128 bit service UUID list. */
+            ScanFilterRule& service(const jau::uuid_t& uuid) noexcept;
+
+            /**
+             * Requires manufacturer specific data of given company,
+             * optionally with its leading data bytes matching `value` under the given byte `mask`.
+             * @param company the company identifier
+             * @param value leading data bytes to match, may be nullptr if `len` is zero
+             * @param mask byte mask applied to data and value, may be nullptr to match all bits
+             * @param len number of bytes to match, at most MSD_MAX_SIZE
+             */
+            ScanFilterRule& manufacturer(const uint16_t company, const uint8_t* value=nullptr, const uint8_t* mask=nullptr, const jau::nsize_t len=0) noexcept;
+
+            /** Requires a complete or shortened local name starting with the given prefix, at most EInfoReport::NAME_INLINE_SIZE bytes. */
+            ScanFilterRule& namePrefix(const std::string& prefix) noexcept;
+
+            /** Requires the presence of an AD structure of given type. */
+            ScanFilterRule& hasADType(const GAP_T type) noexcept;
+
+            /** Returns true if no criteria is set, i.e. matching all reports. */
+            bool isEmpty() const noexcept { return 0 == criteria; }
+
+            /** Returns true if this rule holds AD data criteria, which may be accumulated across reports, see matches(const EInfoReportView&, State&). */
+            bool hasADDataCriteria() const noexcept { return 0 != ( criteria & CRIT_AD_DATA ); }
+
+            /**
+             * Returns true if the given advertising report matches all set per report criteria,
+             * i.e. address, address type, RSSI and AD type presence.
+             */
+            bool matchesReport(const EInfoReportView& report) const noexcept;
+
+            /** Returns true if the given advertising report matches all set criteria. */
+            bool matches(const EInfoReportView& report) const noexcept;
+
+            /** Initializes the given state with all AD data criteria pending. */
+            void initState(State& state) const noexcept;
+
+            /**
+             * Returns true if the given advertising report matches all set per report criteria, see matchesReport(),
+             * and all AD data criteria are satisfied by this and previous reports of the same address,
+             * as accumulated in the given state.
+             * <p>
+             * Allows matching criteria split across the advertising report and its scan response,
+             * e.g. a service UUID advertised and a name in the scan response.
+             * Only reports matching the per report criteria are accumulated.
+             * </p>
+             * @param report the advertising report
+             * @param state the AD data criteria state of the report's address, see initState()
+             */
+            bool matches(const EInfoReportView& report, State& state) const noexcept;
+
+            std::string toString() const noexcept;
+    };
+
+    /**
+     * Scan filter of rules, matching an advertising report if any of its rules matches,
+     * or any report if it holds no rule.
+     * <p>
+     * Applied via BTAdapter::setScanFilter() by HCIHandler on each advertising report's EInfoReportView
+     * using a ScanFilterTracker, non-matching reports are dropped before any MgmtEvtDeviceFound, EInfoReport or BTDevice gets created.
+     * </p>
+     */
+    class ScanFilter {
+        private:
+            jau::darray<ScanFilterRule> rules;
+
+        public:
+            ScanFilter() noexcept = default;
+
+            /** Adds the given rule, alternative to all other rules. Empty rules are ignored. */
+            ScanFilter& add(const ScanFilterRule& rule) noexcept;
+
+            jau::nsize_t size() const noexcept { return rules.size(); }
+            bool isEmpty() const noexcept { return rules.empty(); }
+
+            /** Returns true if no rule is set or the given advertising report matches any rule. */
+            bool matches(const EInfoReportView& report) const noexcept {
+                if( rules.empty() ) {
+                    return true;
+                }
+                for(const ScanFilterRule& r : rules) {
+                    if( r.matches(report) ) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /** Result of matchesReport(). */
+            enum class ReportMatch : uint8_t {
+                /** No rule matches the report's per report criteria. */
+                NONE    = 0,
+                /** The report matches a rule, either no rule is set or a rule w/o AD data criteria matches. */
+                MATCH   = 1,
+                /** Only rules with AD data criteria match the report's per report criteria, requiring their State. */
+                PENDING = 2
+            };
+
+            /**
+             * Evaluates the stateless per report criteria of all rules on the given advertising report,
+             * see ScanFilterRule::matchesReport().
+             */
+            ReportMatch matchesReport(const EInfoReportView& report) const noexcept;
+
+            /**
+             * Initializes the given states, one per rule, with all AD data criteria pending.
+             * @param states array of size() states
+             */
+            void initStates(ScanFilterRule::State* states) const noexcept;
+
+            /**
+             * Returns true if no rule is set or the given advertising report matches any rule
+             * using the AD data criteria accumulated in the given states of the report's address,
+             * see ScanFilterRule::matches(const EInfoReportView&, ScanFilterRule::State&).
+             * @param report the advertising report
+             * @param states array of size() states of the report's address, see initStates()
+             */
+            bool matches(const EInfoReportView& report, ScanFilterRule::State* states) const noexcept;
+
+            std::string toString() const noexcept;
+    };
+
+    /**
+     * Applies a ScanFilter to the advertising reports of multiple addresses, keeping per address state.
+     * <p>
+     * - Per report criteria, e.g. address and RSSI, are evaluated first on every report w/o any state,
+     *   see ScanFilter::matchesReport(). Only reports passing them for a rule with AD data criteria get tracked.
+     * - AD data criteria are accumulated across all passing reports of an address, i.e. criteria of a rule may be split
+     *   across the advertising report and its scan response. Satisfied AD data criteria stay cached,
+     *   i.e. a later report of an accepted address passes if it matches the per report criteria of a satisfied rule.
+     * </p>
+     * <p>
+     * Address states are held in a fixed capacity open addressing table allocated at construction,
+     * their rule states in one array allocated once per filter, i.e. tracking an address does not allocate.
+     * </p>
+     * <p>
+     * The state of an address expires if it sent no report within the timeout.
+     * If the capacity of tracked addresses is exhausted, expired and then unaccepted addresses are dropped,
+     * otherwise an untracked address' report is matched on its own.
+     * All state is dropped if the filter changes.
+     * </p>
+     * <p>
+     * Not thread safe, used by the single thread processing advertising reports, see HCIHandler.
+     * </p>
+     */
+    class ScanFilterTracker {
+        private:
+            struct Slot {
+                jau::EUI48 address;
+                BDAddressType type;
+                bool used;
+                bool accepted;
+                std::size_t hash;
+                uint64_t ts_last;
+            };
+
+            const uint64_t timeout_ms;
+            const jau::nsize_t capacity;
+            /** Power of two table size minus one, the table holding at most half used slots. */
+            const jau::nsize_t mask;
+
+            std::shared_ptr<const ScanFilter> filter;
+            /** Number of rules of filter, i.e. states per slot. */
+            jau::nsize_t rule_count;
+            jau::darray<Slot> slots;
+            /** Rule states of slot `i` at `[i*rule_count .. (i+1)*rule_count)`. */
+            jau::darray<ScanFilterRule::State> states;
+            jau::nsize_t used_count;
+
+            uint64_t count_accepted;
+            uint64_t count_passed;
+
+            /** Returns the index of the given address' slot, or if not contained the empty slot to insert it. */
+            jau::nsize_t find(const jau::EUI48& address, const BDAddressType type, const std::size_t hash) const noexcept;
+
+            /** Removes the given slot, shifting back following slots of its probe sequence. */
+            void erase(jau::nsize_t i) noexcept;
+
+            /** Drops expired and, if still exhausted, all unaccepted entries. Returns true if capacity is available. */
+            bool purge(const uint64_t now) noexcept;
+
+        public:
+            /**
+             * @param timeout maximum time between two reports of an address to keep its state
+             * @param capacity maximum number of tracked addresses
+             */
+            ScanFilterTracker(const jau::fraction_i64& timeout, const jau::nsize_t capacity) noexcept;
+
+            ScanFilterTracker(const ScanFilterTracker&) = delete;
+            void operator=(const ScanFilterTracker&) = delete;
+
+            /**
+             * Returns true if the given advertising report passes the given filter.
+             * <p>
+             * All state is dropped if `filter_` differs from the previously used one.
+             * </p>
+             * @param filter_ the filter, not nullptr
+             * @param report the advertising report
+             * @param now current monotonic time in milliseconds, used to expire address states
+             */
+            bool matches(const std::shared_ptr<const ScanFilter>& filter_, const EInfoReportView& report, const uint64_t now) noexcept;
+
+            /** Drops all state. */
+            void clear() noexcept;
+
+            /** Returns the number of tracked addresses. */
+            jau::nsize_t size() const noexcept { return used_count; }
+
+            /** Returns the number of addresses accepted. */
+            uint64_t getAcceptedCount() const noexcept { return count_accepted; }
+
+            /** Returns the number of reports of an address accepted before, passed via its cached AD data criteria state. */
+            uint64_t getPassedCount() const noexcept { return count_passed; }
+
+            std::string toString() const noexcept;
+    };
+
+    /**@}*/
+
+} // namespace direct_bt
+
+#endif /* SCAN_FILTER_HPP_ */
@@ -0,0 +1,123 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef UUID_POOL_HPP_
+#define UUID_POOL_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <atomic>
+
+#include <jau/basic_types.hpp>
+#include <jau/uuid.hpp>
+
+/**
+ * - - - - - - - - - - - - - - -
+ *
+ * Module UUIDPool:
+ *
+ * - Process-wide interned jau::uuid_t instances, e.g. for advertised service UUIDs
+ */
+namespace direct_bt {
+
+    /** \addtogroup DBTSystemAPI
+     *
+     *  @{
+     */
+
+    /**
+     * Process-wide, lock-free pool of interned jau::uuid_t instances.
+     * <p>
+     * Each distinct UUID value and type size is created once and its canonical shared instance returned thereafter,
+     * hence reports repeating the same service UUIDs share instances without further heap allocation
+     * and equal interned UUIDs of same type size compare by pointer.
+     * </p>
+     * <p>
+     * Only 16 and 32 bit UUIDs and 128 bit UUIDs derived from the Bluetooth Base UUID are interned, see isInternable().
+     * Vendor specific 128 bit UUIDs, e.g. randomly advertised by passing devices, are always returned as non-interned instances,
+     * hence they cannot exhaust the pool for the assigned UUIDs.
+     * </p>
+     * <p>
+     * The pool is an insert-only open addressing hash table of CAPACITY slots, claimed via compare-and-swap.
+     * Interned instances are never released, hence at most MAX_SIZE UUIDs are interned,
+     * keeping the table half empty and its probe sequences short.
+     * </p>
+     * <p>
+     * A non-interned instance is returned if the pool holds MAX_SIZE UUIDs or no slot is available within MAX_PROBES,
+     * see getOverflowCount(). It is equal but not identical to other instances of same value.
+     * </p>
+     */
+    class UUIDPool {
+        public:
+            /** Number of slots, a power of two. */
+            static constexpr const jau::nsize_t CAPACITY = 1024;
+            /** Maximum number of probed slots per lookup. */
+            static constexpr const jau::nsize_t MAX_PROBES = 32;
+            /** Maximum number of interned UUIDs, i.e. half of CAPACITY. */
+            static constexpr const jau::nsize_t MAX_SIZE = CAPACITY / 2;
+
+        private:
+            struct Node {
+                uint8_t size;
+                uint8_t key[16]; // little endian
+                std::shared_ptr<const jau::uuid_t> uuid;
+            };
+            static std::atomic<Node*> slots[CAPACITY];
+            static std::atomic<jau::nsize_t> count;
+            static std::atomic<uint64_t> overflow_count;
+
+            static std::shared_ptr<const jau::uuid_t> create(const uint8_t* le_data, const jau::nsize_t size) noexcept;
+
+        public:
+            /**
+             * Returns true if the given UUID is interned, i.e. a 16 or 32 bit UUID or a 128 bit UUID derived from the Bluetooth Base UUID.
+             * @param le_data little endian UUID data
+             * @param type_size the uuid type size
+             */
+            static bool isInternable(const uint8_t* le_data, const jau::uuid_t::TypeSize type_size) noexcept;
+
+            /**
+             * Returns the interned UUID of given little endian data and type size, as read from AD or EIR data,
+             * or a non-interned instance if not isInternable() or the pool is full.
+             * @param le_data little endian UUID data
+             * @param type_size the uuid type size
+             */
+            static std::shared_ptr<const jau::uuid_t> get(const uint8_t* le_data, const jau::uuid_t::TypeSize type_size) noexcept;
+
+            /** Returns the interned instance of given UUID. */
+            static std::shared_ptr<const jau::uuid_t> get(const jau::uuid_t& uuid) noexcept;
+
+            /** Returns the number of interned UUIDs. */
+            static jau::nsize_t size() noexcept { return count; }
+
+            /** Returns the number of lookups returning a non-interned instance due to a full pool, see MAX_SIZE. */
+            static uint64_t getOverflowCount() noexcept { return overflow_count; }
+    };
+
+    /**@}*/
+
+} // namespace direct_bt
+
+#endif /* UUID_POOL_HPP_ */
@@ -433,7 +433,7 @@ jbyteArray Java_org_direct_1bt_EInfoReport_getAddressImpl(JNIEnv *env, jobject o
 jstring Java_org_direct_1bt_EInfoReport_getName(JNIEnv *env, jobject obj) {
     try {
         shared_ptr_ref<EInfoReport> ref(env, obj); // hold until done
-        return from_string_to_jstring(env, ref->getName());
+        return from_string_to_jstring(env, std::string(ref->getName()));
     } catch(...) {
         rethrow_and_raise_java_exception(env);
     }
@@ -448,7 +448,7 @@ jstring Java_org_direct_1bt_EInfoReport_getName(JNIEnv *env, jobject obj) {
 jstring Java_org_direct_1bt_EInfoReport_getShortName(JNIEnv *env, jobject obj) {
     try {
         shared_ptr_ref<EInfoReport> ref(env, obj); // hold until done
-        return from_string_to_jstring(env, ref->getShortName());
+        return from_string_to_jstring(env, std::string(ref->getShortName()));
     } catch(...) {
         rethrow_and_raise_java_exception(env);
     }
@@ -38,6 +38,7 @@
 #include "BTAdapter.hpp"
 #include "BTManager.hpp"
 #include "DBTConst.hpp"
+#include "BTAdapterUtil.hpp"
 
 extern "C" {
     #include <inttypes.h>
@@ -61,42 +62,6 @@ std::string direct_bt::to_string(const DiscoveryPolicy v) noexcept {
     return "Unknown DiscoveryPolicy "+jau::to_hexstring(number(v));
 }
 
-BTDeviceRef BTAdapter::findDevice(HCIHandler& hci, device_list_t & devices, const EUI48 & address, const BDAddressType addressType) noexcept {
-    BDAddressAndType rpa(address, addressType);
-    const jau::nsize_t size = devices.size();
-    for (jau::nsize_t i = 0; i < size; ++i) {
-        BTDeviceRef & e = devices[i];
-        if ( nullptr != e &&
-             (
-               ( address == e->getAddressAndType().address &&
-                 ( addressType == e->getAddressAndType().type || addressType == BDAddressType::BDADDR_UNDEFINED )
-               ) ||
-               ( address == e->getVisibleAddressAndType().address &&
-                 ( addressType == e->getVisibleAddressAndType().type || addressType == BDAddressType::BDADDR_UNDEFINED )
-               )
-             )
-           )
-        {
-            if( !rpa.isIdentityAddress() ) {
-                e->updateVisibleAddress(rpa);
-                hci.setResolvHCIConnectionAddr(rpa, e->getAddressAndType());
-            }
-            return e;
-        }
-    }
-    if( !rpa.isIdentityAddress() ) {
-        for (jau::nsize_t i = 0; i < size; ++i) {
-            BTDeviceRef & e = devices[i];
-            if ( nullptr != e && e->matches_irk(rpa) ) {
-                e->updateVisibleAddress(rpa);
-                hci.setResolvHCIConnectionAddr(rpa, e->getAddressAndType());
-                return e;
-            }
-        }
-    }
-    return nullptr;
-}
-
 BTDeviceRef BTAdapter::findDevice(device_list_t & devices, BTDevice const & device) noexcept {
     const jau::nsize_t size = devices.size();
     for (jau::nsize_t i = 0; i < size; ++i) {
@@ -147,6 +112,135 @@ BTDeviceRef BTAdapter::findWeakDevice(weak_device_list_t & devices, BTDevice con
     return nullptr;
 }
 
+void BTAdapter::indexAddressLocked(const BTDeviceRef& device, const BDAddressAndType& address) noexcept {
+    const int collisions = device_index->add(address, device);
+    if( 0 < collisions ) {
+        DBG_PRINT("BTAdapter::indexDevice: %s shared with %d other device(s), adding %s",
+                address.toString().c_str(), collisions, device->toString().c_str());
+    }
+}
+
+void BTAdapter::indexDevice(const BTDeviceRef& device, const uint8_t list) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_deviceIndex); // RAII-style acquire and relinquish via destructor
+    device->device_lists |= list;
+    if( 0 != ( list & DEVLIST_INDEXED ) ) {
+        indexAddressLocked(device, device->getAddressAndType());
+        indexAddressLocked(device, device->getVisibleAddressAndType());
+    }
+}
+
+void BTAdapter::unindexAddressLocked(const BTDevice& device, const BDAddressAndType& address) noexcept {
+    device_index->remove(address, &device);
+}
+
+void BTAdapter::unindexDevice(const BTDevice& device, const uint8_t list) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_deviceIndex); // RAII-style acquire and relinquish via destructor
+    const uint8_t lists = device.device_lists.fetch_and( static_cast<uint8_t>( ~list ) ) & static_cast<uint8_t>( ~list );
+    if( 0 != ( list & DEVLIST_INDEXED ) && 0 == ( lists & DEVLIST_INDEXED ) ) {
+        unindexAddressLocked(device, device.getAddressAndType());
+        unindexAddressLocked(device, device.getVisibleAddressAndType());
+    }
+}
+
+void BTAdapter::unindexDevices(const uint8_t list) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_deviceIndex); // RAII-style acquire and relinquish via destructor
+    device_index->remove_if([list](BTDevice& e) -> bool {
+        e.device_lists &= static_cast<uint8_t>( ~list );
+        return 0 == ( e.device_lists & DEVLIST_INDEXED );
+    });
+}
+
+void BTAdapter::reindexDevice(const BTDevice& device, const BDAddressAndType& old_address) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_deviceIndex); // RAII-style acquire and relinquish via destructor
+    BTDeviceRef e = device_index->get(old_address, &device);
+    if( nullptr == e ) {
+        return; // not indexed via old_address
+    }
+    if( old_address != device.getAddressAndType() && old_address != device.getVisibleAddressAndType() ) {
+        device_index->remove(old_address, &device);
+    }
+    indexAddressLocked(e, device.getAddressAndType());
+    indexAddressLocked(e, device.getVisibleAddressAndType());
+}
+
+void BTAdapter::updateRPAResolver(const BTDevice& device) noexcept {
+    SMPIdentityResolvingKey irk;
+    if( device.getRemoteIRK(irk) ) {
+        rpa_resolver.add(device.getAddressAndType(), irk.irk);
+    }
+}
+
+BTDeviceRef BTAdapter::findIndexedDevice(const EUI48 & address, const BDAddressType addressType, const uint8_t lists, uint8_t& lists_res) noexcept {
+    BDAddressAndType rpa(address, addressType);
+    BTDeviceRef e = nullptr;
+    lists_res = 0;
+    auto listed = [lists](const BTDevice& d) -> bool { return 0 != ( d.device_lists & lists ); };
+    {
+        const std::lock_guard<std::mutex> lock(mtx_deviceIndex); // RAII-style acquire and relinquish via destructor
+        if( BDAddressType::BDADDR_UNDEFINED != addressType ) {
+            e = device_index->find(rpa, listed);
+        } else {
+            e = device_index->find(address, listed);
+        }
+    }
+    if( rpa.isIdentityAddress() ) {
+        if( nullptr != e ) {
+            lists_res = e->device_lists;
+        }
+        return e;
+    }
+    if( nullptr == e ) {
+        e = rpa_resolver.resolve(address,
+                [&](const BDAddressAndType& identity) -> BTDeviceRef {
+                    const std::lock_guard<std::mutex> lock(mtx_deviceIndex); // RAII-style acquire and relinquish via destructor
+                    // prefer the device owning the identity over others sharing it as their visible address
+                    BTDeviceRef r = device_index->find(identity, [&](const BTDevice& d) -> bool { return listed(d) && identity == d.getAddressAndType(); });
+                    return nullptr != r ? r : device_index->find(identity, listed);
+                },
+                [&](const BTDevice& d, const BDAddressAndType& identity) -> bool {
+                    SMPIdentityResolvingKey irk;
+                    if( !d.getRemoteIRK(irk) || identity != d.getAddressAndType() ) {
+                        // stale resolver entry, i.e. IRK of device has been removed or replaced
+                        DBG_PRINT("BTAdapter::findIndexedDevice: Stale IRK of %s for %s", identity.toString().c_str(), rpa.toString().c_str());
+                        return false;
+                    }
+                    return true;
+                });
+    }
+    if( nullptr != e ) {
+        const BDAddressAndType old_visible = e->getVisibleAddressAndType();
+        if( e->updateVisibleAddress(rpa) ) {
+            reindexDevice(*e, old_visible);
+        }
+        hci.setResolvHCIConnectionAddr(rpa, e->getAddressAndType());
+        lists_res = e->device_lists;
+    }
+    return e;
+}
+
+void BTAdapter::findIndexedDevices(const EUI48 & address, const BDAddressType addressType,
+                                   BTDeviceRef& discovered, BTDeviceRef& shared, BTDeviceRef& connected) noexcept {
+    static_assert( 0x01 == DEVLIST_DISCOVERED && 0x02 == DEVLIST_SHARED && 0x04 == DEVLIST_CONNECTED );
+    const BDAddressAndType rpa(address, addressType);
+    auto bits = [](const BTDevice& d) -> uint8_t { return static_cast<uint8_t>( d.device_lists & DEVLIST_INDEXED ); };
+    auto find_each = [&](BTDeviceRef (&res)[3]) -> uint8_t {
+        const std::lock_guard<std::mutex> lock(mtx_deviceIndex); // RAII-style acquire and relinquish via destructor
+        if( BDAddressType::BDADDR_UNDEFINED != addressType ) {
+            return device_index->find_each(rpa, bits, res);
+        } else {
+            return device_index->find_each(address, bits, res);
+        }
+    };
+    BTDeviceRef res[3] = { nullptr, nullptr, nullptr };
+    if( 0 == find_each(res) && !rpa.isIdentityAddress() && nullptr != findIndexedDevice(address, addressType, DEVLIST_INDEXED) ) {
+        // resolved random private address, now indexed as the device's visible address
+        find_each(res);
+    }
+    discovered = res[0];
+    shared = res[1];
+    connected = res[2];
+}
+
 BTDeviceRef BTAdapter::findDevicePausingDiscovery (const EUI48 & address, const BDAddressType & addressType) noexcept {
     const std::lock_guard<std::mutex> lock(mtx_pausingDiscoveryDevices); // RAII-style acquire and relinquish via destructor
     return findWeakDevice(pausing_discovery_devices, address, addressType);
@@ -161,6 +255,7 @@ bool BTAdapter::addDevicePausingDiscovery(const BTDeviceRef & device) noexcept {
         }
         added_first = 0 == pausing_discovery_devices.size();
         pausing_discovery_devices.push_back(device);
+        indexDevice(device, DEVLIST_PAUSING);
     }
     if( added_first ) {
         if constexpr ( SCAN_DISABLED_POST_CONNECT ) {
@@ -187,6 +282,7 @@ bool BTAdapter::removeDevicePausingDiscovery(const BTDevice & device) noexcept {
                 pausing_discovery_devices.erase(it); // erase and move it to next element
             } else if ( device == *e ) {
                 pausing_discovery_devices.erase(it);
+                unindexDevice(*e, DEVLIST_PAUSING);
                 removed_last = 0 == pausing_discovery_devices.size();
                 break; // done
             } else {
@@ -205,6 +301,7 @@ bool BTAdapter::removeDevicePausingDiscovery(const BTDevice & device) noexcept {
 void BTAdapter::clearDevicesPausingDiscovery() noexcept {
     const std::lock_guard<std::mutex> lock(mtx_pausingDiscoveryDevices); // RAII-style acquire and relinquish via destructor
     pausing_discovery_devices.clear();
+    unindexDevices(DEVLIST_PAUSING);
 }
 
 jau::nsize_t BTAdapter::getDevicesPausingDiscoveryCount() noexcept {
@@ -218,6 +315,7 @@ bool BTAdapter::addConnectedDevice(const BTDeviceRef & device) noexcept {
         return false;
     }
     connectedDevices.push_back(device);
+    indexDevice(device, DEVLIST_CONNECTED);
     return true;
 }
 
@@ -226,6 +324,7 @@ bool BTAdapter::removeConnectedDevice(const BTDevice & device) noexcept {
     auto end = connectedDevices.end();
     for (auto it = connectedDevices.begin(); it != end; ++it) {
         if ( nullptr != *it && device == **it ) {
+            unindexDevice(**it, DEVLIST_CONNECTED);
             connectedDevices.erase(it);
             return true;
         }
@@ -252,8 +351,7 @@ BTAdapter::size_type BTAdapter::disconnectAllDevices(const HCIStatusCode reason)
 }
 
 BTDeviceRef BTAdapter::findConnectedDevice (const EUI48 & address, const BDAddressType & addressType) noexcept {
-    const std::lock_guard<std::mutex> lock(mtx_connectedDevices); // RAII-style acquire and relinquish via destructor
-    return findDevice(hci, connectedDevices, address, addressType);
+    return findIndexedDevice(address, addressType, DEVLIST_CONNECTED);
 }
 
 jau::nsize_t BTAdapter::getConnectedDeviceCount() const noexcept {
@@ -428,7 +526,17 @@ BTAdapter::BTAdapter(const BTAdapter::ctor_cookie& cc, BTManagerRef mgmt_, Adapt
   currentMetaScanType( ScanType::NONE ),
   discovery_policy ( DiscoveryPolicy::AUTO_OFF ),
   scan_filter_dup( true ),
+  device_update_window( static_cast<uint32_t>( jau::environment::getInt32Property("direct_bt.adapter.update.window", 0, 0 /* min */, 60000 /* max */) ) ),
+  device_updates_sent( 0 ), device_updates_suppressed( 0 ), device_updates_flushed( 0 ),
+  discovered_capacity( static_cast<uint32_t>( jau::environment::getInt32Property("direct_bt.adapter.discovered.capacity", 0, 0 /* min */, INT32_MAX /* max */) ) ),
+  discovered_ttl( static_cast<uint32_t>( jau::environment::getInt32Property("direct_bt.adapter.discovered.ttl", 0, 0 /* min */, INT32_MAX /* max */) ) ),
+  discovered_evicted_lru( 0 ), discovered_evicted_ttl( 0 ), ts_discovered_expiry( 0 ),
+  discoveredLRU( std::make_unique<DiscoveryLRU<BTDevice>>() ),
+  device_index( std::make_unique<device_index_t>() ),
   smp_watchdog("adapter"+std::to_string(dev_id)+"_smp_watchdog", THREAD_SHUTDOWN_TIMEOUT_MS),
+  update_timer("adapter"+std::to_string(dev_id)+"_update_timer", THREAD_SHUTDOWN_TIMEOUT_MS),
+  unpair_timer("adapter"+std::to_string(dev_id)+"_unpair_timer", THREAD_SHUTDOWN_TIMEOUT_MS),
+  unpair_sched( std::make_unique<DeferredUnpair>( UNPAIR_CLEAN_MAX ) ),
   l2cap_att_srv(dev_id, adapterInfo.addressAndType, L2CAP_PSM::UNDEFINED, L2CAP_CID::ATT),
   l2cap_service("BTAdapter::l2capServer", THREAD_SHUTDOWN_TIMEOUT_MS,
                 jau::bind_member(this, &BTAdapter::l2capServerWork),
@@ -451,6 +559,8 @@ BTAdapter::~BTAdapter() noexcept {
     if( !isValid() ) {
         DBG_PRINT("BTAdapter::dtor: dev_id %d, invalid, %p", dev_id, this);
         smp_watchdog.stop();
+        update_timer.stop();
+        unpair_timer.stop();
         mgmt->removeAdapter(this); // remove this instance from manager
         hci.clearAllCallbacks();
         return;
@@ -466,6 +576,17 @@ BTAdapter::~BTAdapter() noexcept {
 
 void BTAdapter::close() noexcept {
     smp_watchdog.stop();
+    {
+        const std::lock_guard<std::mutex> lock(mtx_updatePending); // RAII-style acquire and relinquish via destructor
+        updatePendingDevices.clear();
+        update_timer_armed = true; // inhibit re-arming
+    }
+    update_timer.stop();
+    {
+        const std::lock_guard<std::mutex> lock(mtx_unpairTimer); // RAII-style acquire and relinquish via destructor
+        unpair_timer_armed = true; // inhibit re-arming
+    }
+    unpair_timer.stop();
     if( !isValid() ) {
         // Native user app could have destroyed this instance already from
         DBG_PRINT("BTAdapter::close: dev_id %d, invalid, %p", dev_id, this);
@@ -499,15 +620,21 @@ void BTAdapter::close() noexcept {
     {
         const std::lock_guard<std::mutex> lock(mtx_discoveredDevices); // RAII-style acquire and relinquish via destructor
         discoveredDevices.clear();
+        discoveredLRU->clear();
+        unindexDevices(DEVLIST_DISCOVERED);
     }
     {
         const std::lock_guard<std::mutex> lock(mtx_connectedDevices); // RAII-style acquire and relinquish via destructor
         connectedDevices.clear();;
+        unindexDevices(DEVLIST_CONNECTED);
     }
     {
         const std::lock_guard<std::mutex> lock(mtx_sharedDevices); // RAII-style acquire and relinquish via destructor
         sharedDevices.clear();
+        unindexDevices(DEVLIST_SHARED);
     }
+    rpa_resolver.clear();
+    unpair_sched->clear();
     {
         const std::lock_guard<std::mutex> lock(mtx_keys); // RAII-style acquire and relinquish via destructor
         key_list.clear();
@@ -1288,7 +1415,9 @@ void BTAdapter::discoveryServerWork(jau::service_runner& sr) noexcept {
 HCIStatusCode BTAdapter::stopDiscovery() noexcept {
     clearDevicesPausingDiscovery();
 
-    return stopDiscoveryImpl(false /* forceDiscoveringEvent */, false /* temporary */);
+    const HCIStatusCode status = stopDiscoveryImpl(false /* forceDiscoveringEvent */, false /* temporary */);
+    flushDeviceUpdates(nullptr, true /* force */); // no further advertising reports to carry them
+    return status;
 }
 
 HCIStatusCode BTAdapter::stopDiscoveryImpl(const bool forceDiscoveringEvent, const bool temporary) noexcept {
@@ -1386,8 +1515,7 @@ exit:
 // *************************************************
 
 BTDeviceRef BTAdapter::findDiscoveredDevice (const EUI48 & address, const BDAddressType addressType) noexcept {
-    const std::lock_guard<std::mutex> lock(mtx_discoveredDevices); // RAII-style acquire and relinquish via destructor
-    return findDevice(hci, discoveredDevices, address, addressType);
+    return findIndexedDevice(address, addressType, DEVLIST_DISCOVERED);
 }
 
 bool BTAdapter::addDiscoveredDevice(BTDeviceRef const &device) noexcept {
@@ -1397,18 +1525,85 @@ bool BTAdapter::addDiscoveredDevice(BTDeviceRef const &device) noexcept {
         return false;
     }
     discoveredDevices.push_back(device);
+    discoveredLRU->touch(device.get());
+    indexDevice(device, DEVLIST_DISCOVERED);
+    evictDiscoveredDevicesLocked(device.get());
     return true;
 }
 
+void BTAdapter::touchDiscoveredDevice(BTDevice& device, const uint64_t timestamp) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_discoveredDevices); // RAII-style acquire and relinquish via destructor
+    device.ts_last_discovery = timestamp;
+    if( discoveredLRU->contains(&device) ) {
+        discoveredLRU->touch(&device);
+    }
+}
+
+void BTAdapter::eraseDiscoveredDeviceLocked(device_list_t::iterator it) noexcept {
+    const BTDevice& device = **it;
+    if( 0 == ( device.device_lists & DEVLIST_SHARED ) ) {
+        removeAllStatusListener( device );
+    }
+    unindexDevice(device, DEVLIST_DISCOVERED);
+    discoveredLRU->remove(&device);
+    discoveredDevices.erase(it);
+}
+
+void BTAdapter::eraseDiscoveredDeviceLocked(const BTDevice& device) noexcept {
+    for (auto it = discoveredDevices.begin(); it != discoveredDevices.end(); ++it) {
+        if ( it->get() == &device ) {
+            eraseDiscoveredDeviceLocked(it);
+            return;
+        }
+    }
+    discoveredLRU->remove(&device);
+}
+
+void BTAdapter::evictDiscoveredDevicesLocked(const BTDevice* keep) noexcept {
+    const size_type capacity = discovered_capacity;
+    if( 0 == capacity ) {
+        return;
+    }
+    const size_t count = discoveredLRU->evict(capacity, keep,
+            [](const BTDevice& device) -> bool { return 0 != ( device.device_lists & DEVLIST_PINNED ); },
+            [&](BTDevice& device) {
+                DBG_PRINT("BTAdapter::evictDiscoveredDevices: capacity %u, evict %s", (uint32_t)capacity, device.getAddressAndType().toString().c_str());
+                eraseDiscoveredDeviceLocked(device);
+            });
+    discovered_evicted_lru += count;
+}
+
+void BTAdapter::expireDiscoveredDevices(const uint64_t now) noexcept {
+    const uint64_t ttl = discovered_ttl;
+    if( 0 == ttl || now < ts_discovered_expiry + std::min<uint64_t>(ttl, DISCOVERED_EXPIRY_INTERVAL) ) {
+        return;
+    }
+    ts_discovered_expiry = now;
+    size_t count;
+    {
+        const std::lock_guard<std::mutex> lock(mtx_discoveredDevices); // RAII-style acquire and relinquish via destructor
+        count = discoveredLRU->expire(
+                [](const BTDevice& device) -> bool { return 0 != ( device.device_lists & DEVLIST_PINNED ); },
+                [&](const BTDevice& device) -> bool { return now > device.ts_last_discovery.load() + ttl; },
+                [&](BTDevice& device) { eraseDiscoveredDeviceLocked(device); });
+    }
+    if( 0 < count ) {
+        discovered_evicted_ttl += count;
+        DBG_PRINT("BTAdapter::expireDiscoveredDevices: ttl %" PRIu64 " ms, evicted %zu", ttl, count);
+    }
+}
+
+void BTAdapter::setDiscoveredDeviceCapacity(const uint32_t capacity) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_discoveredDevices); // RAII-style acquire and relinquish via destructor
+    discovered_capacity = capacity;
+    evictDiscoveredDevicesLocked(nullptr);
+}
+
 bool BTAdapter::removeDiscoveredDevice(const BDAddressAndType & addressAndType) noexcept {
     const std::lock_guard<std::mutex> lock(mtx_discoveredDevices); // RAII-style acquire and relinquish via destructor
     for (auto it = discoveredDevices.begin(); it != discoveredDevices.end(); ++it) {
-        const BTDevice& device = **it;
-        if ( nullptr != *it && addressAndType == device.addressAndType ) {
-            if( nullptr == getSharedDevice( device ) ) {
-                removeAllStatusListener( device );
-            }
-            discoveredDevices.erase(it);
+        if ( nullptr != *it && addressAndType == (*it)->addressAndType ) {
+            eraseDiscoveredDeviceLocked(it);
             return true;
         }
     }
@@ -1425,11 +1620,7 @@ BTAdapter::size_type BTAdapter::removeDiscoveredDevices() noexcept {
             auto it = discoveredDevices.end();
             do {
                 --it;
-                const BTDevice& device = **it;
-                if( nullptr == getSharedDevice( device ) ) {
-                    removeAllStatusListener( device );
-                }
-                discoveredDevices.erase(it);
+                eraseDiscoveredDeviceLocked(it);
             } while( it != discoveredDevices.begin() );
         }
     }
@@ -1455,6 +1646,7 @@ bool BTAdapter::addSharedDevice(BTDeviceRef const &device) noexcept {
         return false;
     }
     sharedDevices.push_back(device);
+    indexDevice(device, DEVLIST_SHARED);
     return true;
 }
 
@@ -1467,6 +1659,7 @@ void BTAdapter::removeSharedDevice(const BTDevice & device) noexcept {
     const std::lock_guard<std::mutex> lock(mtx_sharedDevices); // RAII-style acquire and relinquish via destructor
     for (auto it = sharedDevices.begin(); it != sharedDevices.end(); ) {
         if ( nullptr != *it && device == **it ) {
+            unindexDevice(device, DEVLIST_SHARED);
             sharedDevices.erase(it);
             return; // unique set
         } else {
@@ -1476,14 +1669,14 @@ void BTAdapter::removeSharedDevice(const BTDevice & device) noexcept {
 }
 
 BTDeviceRef BTAdapter::findSharedDevice (const EUI48 & address, const BDAddressType addressType) noexcept {
-    const std::lock_guard<std::mutex> lock(mtx_sharedDevices); // RAII-style acquire and relinquish via destructor
-    return findDevice(hci, sharedDevices, address, addressType);
+    return findIndexedDevice(address, addressType, DEVLIST_SHARED);
 }
 
 // *************************************************
 
 void BTAdapter::removeDevice(BTDevice & device) noexcept {
     WORDY_PRINT("DBTAdapter::removeDevice: Start %s", toString().c_str());
+    flushDeviceUpdates(&device, true /* force */); // last update ahead of removing its listener
     removeAllStatusListener(device);
 
     const HCIStatusCode status = device.disconnect(HCIStatusCode::REMOTE_USER_TERMINATED_CONNECTION);
@@ -1492,6 +1685,7 @@ void BTAdapter::removeDevice(BTDevice & device) noexcept {
     removeConnectedDevice(device); // usually done in BTAdapter::mgmtEvDeviceDisconnectedHCI
     removeDiscoveredDevice(device.addressAndType); // usually done in BTAdapter::mgmtEvDeviceDisconnectedHCI
     removeDevicePausingDiscovery(device);
+    rpa_resolver.remove(device.getAddressAndType());
     if( device.getAvailableSMPKeys(false /* responder */) == SMPKeyType::NONE ) {
         // Only remove from shared device list if not an initiator (LL master) having paired keys!
         removeSharedDevice(device);
@@ -1552,17 +1746,13 @@ bool BTAdapter::addSMPKeyBin(const SMPKeyBinRef& key, const bool write_file) noe
 }
 bool BTAdapter::removeSMPKeyBin(BDAddressAndType const & remoteAddress, const bool remove_file) noexcept {
     const std::lock_guard<std::mutex> lock(mtx_keys); // RAII-style acquire and relinquish via destructor
+    rpa_resolver.remove(remoteAddress);
     return removeSMPKeyBin(key_list, remoteAddress, remove_file, key_path);
 }
 
 // *************************************************
 
-HCIStatusCode BTAdapter::startAdvertising(const DBGattServerRef& gattServerData_,
-                               EInfoReport& eir, EIRDataType adv_mask, EIRDataType scanrsp_mask,
-                               const uint16_t adv_interval_min, const uint16_t adv_interval_max,
-                               const AD_PDU_Type adv_type,
-                               const uint8_t adv_chan_map,
-                               const uint8_t filter_policy) noexcept {
+HCIStatusCode BTAdapter::startAdvertisingPrologue(const DBGattServerRef& gattServerData_) noexcept {
     if( !isPowered() ) { // isValid() && hci.isOpen() && POWERED
         poweredOff(false /* active */, "startAdvertising.np");
         return HCIStatusCode::NOT_POWERED;
@@ -1601,10 +1791,17 @@ HCIStatusCode BTAdapter::startAdvertising(const DBGattServerRef& gattServerData_
         l2cap_service.stop();
         return HCIStatusCode::INTERNAL_FAILURE;
     }
+    if( nullptr != gattServerData_ ) {
+        gattServerData_->setServicesHandles();
+    }
+    return HCIStatusCode::SUCCESS;
+}
 
-    // set minimum ...
+void BTAdapter::setAdvertisingMinimum(EInfoReport& eir, EIRDataType& adv_mask, EIRDataType& scanrsp_mask) noexcept {
     eir.addFlags(GAPFlags::LE_Gen_Disc);
-    eir.setName(getName());
+    if( eir.getName().empty() ) {
+        eir.setName(getName());
+    }
     if( EIRDataType::NONE == ( adv_mask & EIRDataType::FLAGS ) ||
         EIRDataType::NONE == ( scanrsp_mask & EIRDataType::FLAGS ) ) {
         adv_mask = adv_mask | EIRDataType::FLAGS;
@@ -1613,18 +1810,9 @@ HCIStatusCode BTAdapter::startAdvertising(const DBGattServerRef& gattServerData_
         EIRDataType::NONE == ( scanrsp_mask & EIRDataType::NAME ) ) {
         scanrsp_mask = scanrsp_mask | EIRDataType::NAME;
     }
+}
 
-    if( nullptr != gattServerData_ ) {
-        gattServerData_->setServicesHandles();
-    }
-
-    const EUI48 peer_bdaddr=EUI48::ANY_DEVICE;
-    const HCILEOwnAddressType own_mac_type=visibleMACType;
-    const HCILEOwnAddressType peer_mac_type=HCILEOwnAddressType::PUBLIC;
-
-    HCIStatusCode status = hci.le_start_adv(eir, adv_mask, scanrsp_mask,
-                                            peer_bdaddr, own_mac_type, peer_mac_type,
-                                            adv_interval_min, adv_interval_max, adv_type, adv_chan_map, filter_policy);
+HCIStatusCode BTAdapter::startAdvertisingEpilogue(const DBGattServerRef& gattServerData_, const HCIStatusCode status) noexcept {
     if( HCIStatusCode::SUCCESS != status ) {
         ERR_PRINT("le_start_adv failed: %s - %s", to_string(status).c_str(), toString(true).c_str());
         gattServerData = nullptr;
@@ -1637,6 +1825,43 @@ HCIStatusCode BTAdapter::startAdvertising(const DBGattServerRef& gattServerData_
     return status;
 }
 
+HCIStatusCode BTAdapter::startAdvertising(const DBGattServerRef& gattServerData_,
+                               EInfoReport& eir, EIRDataType adv_mask, EIRDataType scanrsp_mask,
+                               const uint16_t adv_interval_min, const uint16_t adv_interval_max,
+                               const AD_PDU_Type adv_type,
+                               const uint8_t adv_chan_map,
+                               const uint8_t filter_policy) noexcept {
+    HCIStatusCode status = startAdvertisingPrologue(gattServerData_);
+    if( HCIStatusCode::SUCCESS != status ) {
+        return status;
+    }
+
+    // set minimum ...
+    eir.setName(getName());
+    setAdvertisingMinimum(eir, adv_mask, scanrsp_mask);
+
+    const EUI48 peer_bdaddr=EUI48::ANY_DEVICE;
+    const HCILEOwnAddressType own_mac_type=visibleMACType;
+    const HCILEOwnAddressType peer_mac_type=HCILEOwnAddressType::PUBLIC;
+
+    status = hci.le_start_adv(eir, adv_mask, scanrsp_mask,
+                              peer_bdaddr, own_mac_type, peer_mac_type,
+                              adv_interval_min, adv_interval_max, adv_type, adv_chan_map, filter_policy);
+    return startAdvertisingEpilogue(gattServerData_, status);
+}
+
+HCIStatusCode BTAdapter::startAdvertising(const DBGattServerRef& gattServerData_, jau::darray<ExtAdvSet>& sets) noexcept {
+    HCIStatusCode status = startAdvertisingPrologue(gattServerData_);
+    if( HCIStatusCode::SUCCESS != status ) {
+        return status;
+    }
+    for(ExtAdvSet& s : sets) {
+        setAdvertisingMinimum(s.eir, s.adv_mask, s.scanrsp_mask);
+    }
+    status = hci.le_start_ext_adv(sets, visibleMACType);
+    return startAdvertisingEpilogue(gattServerData_, status);
+}
+
 HCIStatusCode BTAdapter::startAdvertising(const DBGattServerRef& gattServerData_,
                                const uint16_t adv_interval_min, const uint16_t adv_interval_max,
                                const AD_PDU_Type adv_type,
@@ -1758,6 +1983,102 @@ void BTAdapter::sendDeviceUpdated(std::string cause, BTDeviceRef device, uint64_
     });
 }
 
+/** Returns the flush period of pending coalesced device updates, half the window. */
+static jau::fraction_i64 deviceUpdatePeriod(const uint32_t window) noexcept {
+    return jau::fractions_i64::milli * static_cast<int64_t>( std::max<uint32_t>(window / 2, 10) );
+}
+
+void BTAdapter::sendDeviceUpdatedCoalesced(std::string cause, const BTDeviceRef& device, uint64_t timestamp, EIRDataType updateMask) noexcept {
+    EIRDataType mask = updateMask;
+    switch( device->update_coalescer->update(timestamp, device_update_window, mask) ) {
+        case DeviceUpdateCoalescer::Result::SEND:
+            device_updates_sent++;
+            sendDeviceUpdated(std::move(cause), device, timestamp, mask);
+            break;
+        case DeviceUpdateCoalescer::Result::PENDING: {
+            bool arm;
+            {
+                const std::lock_guard<std::mutex> lock(mtx_updatePending); // RAII-style acquire and relinquish via destructor
+                updatePendingDevices.push_back(device);
+                arm = !update_timer_armed;
+                update_timer_armed = true;
+            }
+            if( arm ) {
+                armTimer(update_timer, deviceUpdatePeriod(device_update_window), &BTAdapter::update_timeoutfunc);
+            }
+        }
+            [[fallthrough]];
+        case DeviceUpdateCoalescer::Result::MERGED:
+            device_updates_suppressed++;
+            break;
+        default:
+            break;
+    }
+}
+
+void BTAdapter::flushDeviceUpdates(const BTDevice* device, const bool force) noexcept {
+    struct Flushed {
+        BTDeviceRef device;
+        uint64_t timestamp;
+        EIRDataType mask;
+    };
+    jau::darray<Flushed> flushed;
+    {
+        const uint64_t now = jau::getCurrentMilliseconds();
+        const uint64_t window = device_update_window;
+        const std::lock_guard<std::mutex> lock(mtx_updatePending); // RAII-style acquire and relinquish via destructor
+        for(auto it = updatePendingDevices.begin(); it != updatePendingDevices.end(); ) {
+            BTDeviceRef& d = *it;
+            if( nullptr != device && *device != *d ) {
+                ++it;
+                continue;
+            }
+            uint64_t timestamp = 0;
+            const EIRDataType mask = d->update_coalescer->flush(now, window, force, timestamp);
+            if( EIRDataType::NONE != mask ) {
+                flushed.push_back( Flushed { d, timestamp, mask } );
+            } else if( d->update_coalescer->hasPending() ) {
+                ++it;
+                continue; // within its window
+            }
+            it = updatePendingDevices.erase(it);
+        }
+    }
+    for(Flushed& f : flushed) {
+        device_updates_flushed++;
+        device_updates_sent++;
+        sendDeviceUpdated("DeviceUpdateFlushed", f.device, f.timestamp, f.mask);
+    }
+}
+
+void BTAdapter::armTimer(jau::simple_timer& timer, const jau::fraction_i64& period, jau::fraction_i64 (BTAdapter::*func)(jau::simple_timer&)) noexcept {
+    if( timer.start(period, jau::bind_member(this, func)) ) {
+        return;
+    }
+    timer.stop(); // previous run stopped itself, but has not ended yet
+    if( !timer.start(period, jau::bind_member(this, func)) ) {
+        ERR_PRINT("BTAdapter::armTimer(dev_id %d): Timer start failed", dev_id);
+    }
+}
+
+jau::fraction_i64 BTAdapter::update_timeoutfunc(jau::simple_timer& timer) {
+    if( timer.shall_stop() ) {
+        return 0_s;
+    }
+    flushDeviceUpdates(nullptr, false /* force */);
+    if( timer.shall_stop() ) {
+        return 0_s;
+    }
+    {
+        const std::lock_guard<std::mutex> lock(mtx_updatePending); // RAII-style acquire and relinquish via destructor
+        if( updatePendingDevices.empty() ) {
+            update_timer_armed = false; // re-armed by the next pending update
+            return 0_s;
+        }
+    }
+    return deviceUpdatePeriod(device_update_window);
+}
+
 // *************************************************
 
 void BTAdapter::mgmtEvHCIAnyHCI(const MgmtEvent& e) noexcept {
@@ -2034,6 +2355,69 @@ jau::fraction_i64 BTAdapter::smp_timeoutfunc(jau::simple_timer& timer) {
     return timer.shall_stop() ? 0_s : SMP_NEXT_EVENT_TIMEOUT_MS; // keep going until BTAdapter closes
 }
 
+void BTAdapter::scheduleUnpair(const BDAddressAndType& address) noexcept {
+    if constexpr ( !USE_LINUX_BT_SECURITY ) {
+        return;
+    }
+    const bool has_keys = address.isIdentityAddress() && nullptr != findSMPKeyBin(address);
+    if( !unpair_sched->schedule(address, has_keys) ) {
+        return;
+    }
+    bool arm;
+    {
+        const std::lock_guard<std::mutex> lock(mtx_unpairTimer); // RAII-style acquire and relinquish via destructor
+        arm = !unpair_timer_armed;
+        unpair_timer_armed = true;
+    }
+    if( arm ) {
+        armTimer(unpair_timer, DEFERRED_UNPAIR_PERIOD_MS, &BTAdapter::unpair_timeoutfunc);
+    }
+}
+
+bool BTAdapter::unpairDeferred(const BDAddressAndType& address) noexcept {
+    const HCIStatusCode res = mgmt->unpairDevice(dev_id, address, false /* disconnect */);
+    if( HCIStatusCode::SUCCESS != res && HCIStatusCode::NOT_PAIRED != res ) {
+        WARN_PRINT("(dev_id %d): Unpair device failed %s of %s",
+                dev_id, to_string(res).c_str(), address.toString().c_str());
+        return false;
+    }
+    return true;
+}
+
+void BTAdapter::flushUnpair(const BDAddressAndType& address) noexcept {
+    if constexpr ( !USE_LINUX_BT_SECURITY ) {
+        return;
+    }
+    unpair_sched->flush(address, [&](const BDAddressAndType& a) -> bool { return unpairDeferred(a); });
+}
+
+jau::fraction_i64 BTAdapter::unpair_timeoutfunc(jau::simple_timer& timer) {
+    if( timer.shall_stop() ) {
+        return 0_s;
+    }
+    const size_t count = unpair_sched->process(
+            [&](const BDAddressAndType& a) -> bool { return unpairDeferred(a); },
+            [&]() -> bool { return timer.shall_stop(); });
+    if( 0 < count ) {
+        DBG_PRINT("BTAdapter::unpair_timeoutfunc(dev_id %d): Unpaired %zu devices", dev_id, count);
+    }
+    if( timer.shall_stop() ) {
+        return 0_s;
+    }
+    {
+        const std::lock_guard<std::mutex> lock(mtx_unpairTimer); // RAII-style acquire and relinquish via destructor
+        if( 0 == unpair_sched->getPendingCount() ) {
+            unpair_timer_armed = false; // re-armed by the next scheduled unpair
+            return 0_s;
+        }
+    }
+    return DEFERRED_UNPAIR_PERIOD_MS;
+}
+
+uint64_t BTAdapter::getUnpairsDeferred() const noexcept { return unpair_sched->getDeferred(); }
+
+uint64_t BTAdapter::getUnpairsSkipped() const noexcept { return unpair_sched->getSkipped(); }
+
 void BTAdapter::mgmtEvDeviceConnectedHCI(const MgmtEvent& e) noexcept {
     const MgmtEvtDeviceConnected &event = *static_cast<const MgmtEvtDeviceConnected *>(&e);
     EInfoReport ad_report;
@@ -2079,6 +2463,7 @@ void BTAdapter::mgmtEvDeviceConnectedHCI(const MgmtEvent& e) noexcept {
         new_connect = BTRole::Master == getRole() ? 3 : 4;
         slave_unpair = BTRole::Slave == getRole();
     }
+    flushUnpair(device->getAddressAndType()); // pending stale keys removed before pairing
     bool has_smp_keys;
     if( BTRole::Slave == getRole() ) {
         has_smp_keys = nullptr != findSMPKeyBin( device->getAddressAndType() ); // PERIPHERAL_ADAPTER_MANAGES_SMP_KEYS
@@ -2512,12 +2897,16 @@ void BTAdapter::mgmtEvDeviceFoundHCI(const MgmtEvent& e) noexcept {
     // COND_PRINT(debug_event, "BTAdapter:hci:DeviceFound(dev_id %d): %s", dev_id, e.toString().c_str());
     const MgmtEvtDeviceFound &deviceFoundEvent = *static_cast<const MgmtEvtDeviceFound *>(&e);
 
-    const EInfoReport* eir = deviceFoundEvent.getEIR();
-    if( nullptr == eir ) {
+    if( !deviceFoundEvent.hasEIR() ) {
         // Sourced from Linux Mgmt, which we don't support
         ABORT("BTAdapter:hci:DeviceFound: Not sourced from LE_ADVERTISING_REPORT: %s", deviceFoundEvent.toString().c_str());
         return; // unreachable
     } // else: Sourced from HCIHandler via LE_ADVERTISING_REPORT (default!)
+    // The EInfoReport is only materialized from a lazy EInfoReportView if a device gets created or updated
+    const EInfoReportView* eir_view = deviceFoundEvent.getEIRView();
+    const EInfoReport* eir = nullptr;
+
+    expireDiscoveredDevices(jau::getCurrentMilliseconds());
 
     /**
      * + ------+-----------+------------+----------+----------+-------------------------------------------+
@@ -2532,23 +2921,27 @@ void BTAdapter::mgmtEvDeviceFoundHCI(const MgmtEvent& e) noexcept {
      * | 2.2.2 | false     | true       | true     | none     | Discovered and shared, not-updated -> Drop(3)
      * +-------+-----------+------------+----------+----------+-------------------------------------------+
      */
-    BTDeviceRef dev_connected = findConnectedDevice(eir->getAddress(), eir->getAddressType());
-    BTDeviceRef dev_discovered = findDiscoveredDevice(eir->getAddress(), eir->getAddressType());
-    BTDeviceRef dev_shared = findSharedDevice(eir->getAddress(), eir->getAddressType());
+    // A single device_index lookup answers the connected, discovered and shared membership, one device per list
+    BTDeviceRef dev_connected, dev_discovered, dev_shared;
+    findIndexedDevices(deviceFoundEvent.getAddress(), deviceFoundEvent.getAddressType(), dev_discovered, dev_shared, dev_connected);
     if( nullptr != dev_connected ) {
         // already connected device shall be suppressed
         DBG_PRINT("BTAdapter:hci:DeviceFound(1.0, dev_id %d): Discovered but already connected %s [discovered %d, shared %d] -> Drop(1) %s",
                   dev_id, dev_connected->getAddressAndType().toString().c_str(),
-                  nullptr != dev_discovered, nullptr != dev_shared, eir->toString().c_str());
+                  nullptr != dev_discovered, nullptr != dev_shared, deviceFoundEvent.toString().c_str());
         if( _print_device_lists || jau::environment::get().verbose ) {
             printDeviceLists();
         }
     } else if( nullptr == dev_discovered ) { // nullptr == dev_connected && nullptr == dev_discovered
+        eir = deviceFoundEvent.getEIR();
         if( nullptr == dev_shared ) {
             //
             // All new discovered device
             //
             dev_shared = BTDevice::make_shared(*this, *eir);
+            if( nullptr != eir_view ) {
+                dev_shared->setADFingerprint(*eir_view);
+            }
             addDiscoveredDevice(dev_shared);
             addSharedDevice(dev_shared);
             DBG_PRINT("BTAdapter:hci:DeviceFound(1.1, dev_id %d): New undiscovered/unshared %s -> deviceFound(..) %s",
@@ -2557,13 +2950,7 @@ void BTAdapter::mgmtEvDeviceFoundHCI(const MgmtEvent& e) noexcept {
                 printDeviceLists();
             }
 
-            {
-                const HCIStatusCode res = mgmt->unpairDevice(dev_id, dev_shared->getAddressAndType(), false /* disconnect */);
-                if( HCIStatusCode::SUCCESS != res && HCIStatusCode::NOT_PAIRED != res ) {
-                    WARN_PRINT("(dev_id %d): Unpair device failed %s of %s",
-                            dev_id, to_string(res).c_str(), dev_shared->getAddressAndType().toString().c_str());
-                }
-            }
+            scheduleUnpair(dev_shared->getAddressAndType()); // deferred, not blocking deviceFound(..)
             int i=0;
             bool device_used = false;
             jau::for_each_fidelity(statusListenerList, [&](StatusListenerPair &p) {
@@ -2592,19 +2979,22 @@ void BTAdapter::mgmtEvDeviceFoundHCI(const MgmtEvent& e) noexcept {
             // - removeSharedDevice(..), if non deviceFound(..) returned true
             //
             EIRDataType updateMask = dev_shared->update(*eir);
+            if( nullptr != eir_view ) {
+                dev_shared->setADFingerprint(*eir_view);
+            }
             addDiscoveredDevice(dev_shared); // re-add to discovered devices!
-            dev_shared->ts_last_discovery = eir->getTimestamp();
+            touchDiscoveredDevice(*dev_shared, eir->getTimestamp());
             DBG_PRINT("BTAdapter:hci:DeviceFound(1.2, dev_id %d): Undiscovered but shared %s -> deviceFound(..) [deviceUpdated(..)] %s",
                     dev_id, dev_shared->getAddressAndType().toString().c_str(), eir->toString().c_str());
             if( _print_device_lists || jau::environment::get().verbose ) {
                 printDeviceLists();
             }
 
-            if( !dev_shared->isPrePaired() ) {
-                HCIStatusCode res = dev_shared->unpair();
-                if( HCIStatusCode::SUCCESS != res && HCIStatusCode::NOT_PAIRED != res ) {
-                    WARN_PRINT("(dev_id %d): Unpair device failed: %s, %s",
-                                dev_id, to_string(res).c_str(), dev_shared->getAddressAndType().toString().c_str());
+            if constexpr ( USE_LINUX_BT_SECURITY ) {
+                if( !dev_shared->isPrePaired() ) {
+                    // see BTDevice::unpair(), kernel keys removed deferred
+                    dev_shared->clearSMPStates(false /* connected */);
+                    scheduleUnpair(dev_shared->getAddressAndType());
                 }
             }
             int i=0;
@@ -2626,15 +3016,27 @@ void BTAdapter::mgmtEvDeviceFoundHCI(const MgmtEvent& e) noexcept {
                 // and still allowing usage, as connecting will re-add to shared list
                 removeSharedDevice(*dev_shared); // pending dtor until discovered is flushed
             } else if( EIRDataType::NONE != updateMask ) {
-                sendDeviceUpdated("SharedDeviceFound", dev_shared, eir->getTimestamp(), updateMask);
+                sendDeviceUpdatedCoalesced("SharedDeviceFound", dev_shared, eir->getTimestamp(), updateMask);
             }
         }
     } else { // nullptr == dev_connected && nullptr != dev_discovered
         //
         // Already discovered device
         //
-        const EIRDataType updateMask = dev_discovered->update(*eir);
-        dev_discovered->ts_last_discovery = eir->getTimestamp();
+        EIRDataType updateMask = EIRDataType::NONE;
+        uint64_t timestamp;
+        if( nullptr != eir_view && dev_discovered->updateUnchanged(*eir_view, updateMask) ) {
+            // Unchanged raw AD payload: RSSI and TX power update only, no EInfoReport materialized nor copied
+            timestamp = eir_view->getTimestamp();
+        } else {
+            eir = deviceFoundEvent.getEIR();
+            updateMask = dev_discovered->update(*eir);
+            if( nullptr != eir_view ) {
+                dev_discovered->setADFingerprint(*eir_view);
+            }
+            timestamp = eir->getTimestamp();
+        }
+        touchDiscoveredDevice(*dev_discovered, timestamp);
         if( nullptr == dev_shared ) {
             //
             // Discovered but not a shared device,
@@ -2644,7 +3046,7 @@ void BTAdapter::mgmtEvDeviceFoundHCI(const MgmtEvent& e) noexcept {
                 // Name got updated, send out deviceFound(..) again
                 DBG_PRINT("BTAdapter:hci:DeviceFound(2.1.1, dev_id %d): Discovered but unshared %s, name changed %s -> deviceFound(..) %s",
                         dev_id, dev_discovered->getAddressAndType().toString().c_str(),
-                        direct_bt::to_string(updateMask).c_str(), eir->toString().c_str());
+                        direct_bt::to_string(updateMask).c_str(), deviceFoundEvent.toString().c_str());
                 addSharedDevice(dev_discovered); // re-add to shared devices!
                 if( _print_device_lists || jau::environment::get().verbose ) {
                     printDeviceLists();
@@ -2654,7 +3056,7 @@ void BTAdapter::mgmtEvDeviceFoundHCI(const MgmtEvent& e) noexcept {
                 jau::for_each_fidelity(statusListenerList, [&](StatusListenerPair &p) {
                     try {
                         if( p.match(dev_discovered) ) {
-                            device_used = p.listener->deviceFound(dev_discovered, eir->getTimestamp()) || device_used;
+                            device_used = p.listener->deviceFound(dev_discovered, timestamp) || device_used;
                         }
                     } catch (std::exception &except) {
                         ERR_PRINT("BTAdapter:hci:DeviceFound: %d/%zd: %s of %s: Caught exception %s",
@@ -2671,7 +3073,7 @@ void BTAdapter::mgmtEvDeviceFoundHCI(const MgmtEvent& e) noexcept {
             } else {
                 // Drop: NAME didn't change
                 COND_PRINT(debug_event, "BTAdapter:hci:DeviceFound(2.1.2, dev_id %d): Discovered but unshared %s, no name change -> Drop(2) %s",
-                        dev_id, dev_discovered->getAddressAndType().toString().c_str(), eir->toString().c_str());
+                        dev_id, dev_discovered->getAddressAndType().toString().c_str(), deviceFoundEvent.toString().c_str());
             }
         } else { // nullptr != dev_shared
             //
@@ -2682,17 +3084,18 @@ void BTAdapter::mgmtEvDeviceFoundHCI(const MgmtEvent& e) noexcept {
                 if( debug_event ) {
                     jau::PLAIN_PRINT(true, "BTAdapter:hci:DeviceFound(2.2.1, dev_id %d): Discovered and shared %s, updated %s -> deviceUpdated(..) %s",
                             dev_id, dev_shared->getAddressAndType().toString().c_str(),
-                            direct_bt::to_string(updateMask).c_str(), eir->toString().c_str());
+                            direct_bt::to_string(updateMask).c_str(), deviceFoundEvent.toString().c_str());
                     if( _print_device_lists || jau::environment::get().verbose ) {
                         printDeviceLists();
                     }
                 }
-                sendDeviceUpdated("DiscoveredDeviceFound", dev_shared, eir->getTimestamp(), updateMask);
+                sendDeviceUpdatedCoalesced("DiscoveredDeviceFound", dev_shared, timestamp, updateMask);
             } else {
-                // Drop: No update
+                // Drop: No update, but deliver a pending coalesced update past its window
+                sendDeviceUpdatedCoalesced("DiscoveredDeviceFound", dev_shared, timestamp, EIRDataType::NONE);
                 if( debug_event ) {
                     jau::PLAIN_PRINT(true, "BTAdapter:hci:DeviceFound(2.2.2, dev_id %d): Discovered and shared %s, not-updated -> Drop(3) %s",
-                            dev_id, dev_shared->getAddressAndType().toString().c_str(), eir->toString().c_str());
+                            dev_id, dev_shared->getAddressAndType().toString().c_str(), deviceFoundEvent.toString().c_str());
                     if( _print_device_lists || jau::environment::get().verbose ) {
                         printDeviceLists();
                     }
@@ -0,0 +1,143 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstring>
+#include <cstdint>
+
+#include "BTAdapterUtil.hpp"
+
+using namespace direct_bt;
+
+DeviceUpdateCoalescer::Result DeviceUpdateCoalescer::update(const uint64_t timestamp, const uint64_t window, EIRDataType& mask) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+    const EIRDataType merged = mask | pending;
+    if( EIRDataType::NONE == merged ) {
+        return Result::NONE;
+    }
+    if( 0 < window ) {
+        if( 0 < ts_last_sent && timestamp < ts_last_sent + window ) {
+            if( EIRDataType::NONE == mask ) {
+                return Result::NONE;
+            }
+            const bool was_pending = EIRDataType::NONE != pending;
+            pending = merged;
+            ts_pending = timestamp;
+            return was_pending ? Result::MERGED : Result::PENDING;
+        }
+        ts_last_sent = timestamp;
+    }
+    pending = EIRDataType::NONE;
+    mask = merged;
+    return Result::SEND;
+}
+
+EIRDataType DeviceUpdateCoalescer::flush(const uint64_t now, const uint64_t window, const bool force, uint64_t& timestamp) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+    if( EIRDataType::NONE == pending || ( !force && now < ts_last_sent + window ) ) {
+        return EIRDataType::NONE;
+    }
+    const EIRDataType res = pending;
+    pending = EIRDataType::NONE;
+    ts_last_sent = now;
+    timestamp = ts_pending;
+    return res;
+}
+
+bool DeviceUpdateCoalescer::hasPending() const noexcept {
+    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+    return EIRDataType::NONE != pending;
+}
+
+void DeviceUpdateCoalescer::clear() noexcept {
+    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+    ts_last_sent = 0;
+    ts_pending = 0;
+    pending = EIRDataType::NONE;
+}
+
+DeferredUnpair::DeferredUnpair(const size_t clean_capacity_) noexcept
+: clean_capacity(clean_capacity_), deferred(0), skipped(0)
+{ }
+
+void DeferredUnpair::addCleanLocked(const BDAddressAndType& address) noexcept {
+    auto it = clean.find(address);
+    if( it != clean.end() ) {
+        clean_order.splice(clean_order.end(), clean_order, it->second);
+        return;
+    }
+    if( clean_order.size() >= clean_capacity ) {
+        if( 0 == clean_capacity ) {
+            return;
+        }
+        clean.erase(clean_order.front()); // evict least recently unpaired
+        clean_order.pop_front();
+    }
+    clean[address] = clean_order.insert(clean_order.end(), address);
+}
+
+void DeferredUnpair::eraseCleanLocked(const BDAddressAndType& address) noexcept {
+    auto it = clean.find(address);
+    if( it != clean.end() ) {
+        clean_order.erase(it->second);
+        clean.erase(it);
+    }
+}
+
+bool DeferredUnpair::schedule(const BDAddressAndType& address, const bool has_keys) noexcept {
+    if( !address.isIdentityAddress() || !has_keys ) {
+        // kernel keys are bound to the identity address, unresolved private addresses can't hold any,
+        // as well as addresses w/o stored keys
+        skipped++;
+        return false;
+    }
+    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+    if( clean.end() != clean.find(address) || in_flight.end() != in_flight.find(address) || !pending.insert(address).second ) {
+        skipped++;
+        return false;
+    }
+    deferred++;
+    return true;
+}
+
+void DeferredUnpair::clear() noexcept {
+    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+    pending.clear();
+    clean_order.clear();
+    clean.clear();
+}
+
+size_t DeferredUnpair::getPendingCount() const noexcept {
+    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+    return pending.size();
+}
+
+bool DeferredUnpair::isClean(const BDAddressAndType& address) const noexcept {
+    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+    return clean.end() != clean.find(address);
+}
+
+size_t DeferredUnpair::getCleanCount() const noexcept {
+    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+    return clean.size();
+}
@@ -0,0 +1,557 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef BT_ADAPTER_UTIL_HPP_
+#define BT_ADAPTER_UTIL_HPP_
+
+#include <cstring>
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <jau/ordered_atomic.hpp>
+
+#include "BTTypes0.hpp"
+
+/**
+ * - - - - - - - - - - - - - - -
+ *
+ * Module BTAdapterUtil:
+ *
+ * - Private helper classes of BTAdapter and BTDevice, not part of the public API
+ */
+namespace direct_bt {
+
+    /**
+     * Per-device coalescing state of advertising caused deviceUpdated() events within a window,
+     * merging suppressed EIRDataType masks into one pending update.
+     * <p>
+     * Thread safe, updated by the HCI reader thread and flushed by BTAdapter's update timer,
+     * discovery stop and device removal, see BTAdapter::setDeviceUpdateWindow().
+     * </p>
+     */
+    class DeviceUpdateCoalescer {
+        public:
+            /** Result of update() */
+            enum class Result : uint8_t {
+                /** Nothing to dispatch */
+                NONE,
+                /** Dispatch the returned mask now */
+                SEND,
+                /** Suppressed, merged into the already pending update */
+                MERGED,
+                /** Suppressed as a new pending update, to be flushed past the window */
+                PENDING
+            };
+
+        private:
+            mutable std::mutex mtx;
+            uint64_t ts_last_sent = 0; // last dispatch, zero if none
+            uint64_t ts_pending = 0; // latest suppressed update
+            EIRDataType pending = EIRDataType::NONE; // merged mask of suppressed updates
+
+        public:
+            /**
+             * Coalesces an update at `timestamp`.
+             * @param timestamp the update's timestamp in milliseconds
+             * @param window the coalescing window in milliseconds, 0 disables coalescing
+             * @param mask the update's EIRDataType mask, may be EIRDataType::NONE to only deliver a pending update past the window.
+             *        Returns the mask to be dispatched merged with the pending update if Result::SEND.
+             */
+            Result update(const uint64_t timestamp, const uint64_t window, EIRDataType& mask) noexcept;
+
+            /**
+             * Returns and clears the pending update if its window has passed at `now` or if `force`, otherwise EIRDataType::NONE.
+             * @param now current time in milliseconds, starting a new window if flushed
+             * @param window the coalescing window in milliseconds
+             * @param force flush regardless of the window, e.g. on discovery stop or device removal
+             * @param timestamp returns the timestamp of the latest suppressed update if flushed
+             */
+            EIRDataType flush(const uint64_t now, const uint64_t window, const bool force, uint64_t& timestamp) noexcept;
+
+            /** Returns true if an update is pending. */
+            bool hasPending() const noexcept;
+
+            /** Clears the pending update and the window. */
+            void clear() noexcept;
+    };
+
+    /**
+     * Index of weakly referenced objects keyed by BDAddressAndType, e.g. BTAdapter's device index.
+     * <p>
+     * One key may refer to multiple live objects, e.g. a device's resolved identity or new visible address
+     * colliding with another device's address, hence no object silently replaces another one's entry.
+     * Lookups return the first live object matching a given predicate in order of insertion.
+     * Expired references are dropped on modification of their key.
+     * </p>
+     * <p>
+     * Not thread safe, used by BTAdapter under its device index lock.
+     * </p>
+     */
+    template<typename T>
+    class BDAddressIndex {
+        public:
+            typedef std::shared_ptr<T> ref_t;
+            typedef std::weak_ptr<T> weak_t;
+            typedef std::vector<weak_t> entries_t;
+            typedef std::unordered_map<BDAddressAndType, entries_t> map_t;
+
+        private:
+            map_t map;
+
+            static void compact(entries_t& entries) noexcept {
+                for(auto it = entries.begin(); it != entries.end(); ) {
+                    if( it->expired() ) {
+                        it = entries.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+
+            template<class Pred>
+            static ref_t find_in(const entries_t& entries, Pred p) noexcept {
+                for(const weak_t& w : entries) {
+                    ref_t e = w.lock();
+                    if( nullptr != e && p(*e) ) {
+                        return e;
+                    }
+                }
+                return nullptr;
+            }
+
+            template<size_t N, class Bits>
+            static uint8_t find_each_in(const entries_t& entries, Bits bits, ref_t (&res)[N]) noexcept {
+                uint8_t r = 0;
+                for(const weak_t& w : entries) {
+                    ref_t e = w.lock();
+                    if( nullptr == e ) {
+                        continue;
+                    }
+                    const uint8_t b = bits(*e);
+                    r |= b;
+                    for(size_t i=0; i<N; ++i) {
+                        if( nullptr == res[i] && 0 != ( b & ( 1U << i ) ) ) {
+                            res[i] = e;
+                        }
+                    }
+                }
+                return r;
+            }
+
+        public:
+            /**
+             * Adds `obj` for `key`, keeping other live objects of the same key.
+             * @return number of other live objects for `key` after adding, i.e. zero if no collision,
+             *         or -1 if `obj` was already indexed for `key`.
+             */
+            int add(const BDAddressAndType& key, const ref_t& obj) noexcept {
+                entries_t& entries = map[key];
+                compact(entries);
+                for(const weak_t& w : entries) {
+                    if( w.lock() == obj ) {
+                        return -1;
+                    }
+                }
+                entries.push_back(obj);
+                return static_cast<int>( entries.size() ) - 1;
+            }
+
+            /** Removes `obj` and expired references for `key`, returns true if `obj` was indexed for `key`. */
+            bool remove(const BDAddressAndType& key, const T* obj) noexcept {
+                auto it = map.find(key);
+                if( it == map.end() ) {
+                    return false;
+                }
+                entries_t& entries = it->second;
+                bool res = false;
+                for(auto it2 = entries.begin(); it2 != entries.end(); ) {
+                    ref_t e = it2->lock();
+                    if( nullptr == e || e.get() == obj ) {
+                        res = res || nullptr != e;
+                        it2 = entries.erase(it2);
+                    } else {
+                        ++it2;
+                    }
+                }
+                if( entries.empty() ) {
+                    map.erase(it);
+                }
+                return res;
+            }
+
+            /**
+             * Removes all objects for which `p(T&)` returns true and all expired references.
+             * <p>
+             * `p` is called for each entry, i.e. once per key the object is indexed with.
+             * </p>
+             */
+            template<class Pred>
+            void remove_if(Pred p) noexcept {
+                for(auto it = map.begin(); it != map.end(); ) {
+                    entries_t& entries = it->second;
+                    for(auto it2 = entries.begin(); it2 != entries.end(); ) {
+                        ref_t e = it2->lock();
+                        if( nullptr == e || p(*e) ) {
+                            it2 = entries.erase(it2);
+                        } else {
+                            ++it2;
+                        }
+                    }
+                    if( entries.empty() ) {
+                        it = map.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+
+            /**
+             * Returns the first live object for `key` per bit `i` in `[0..N)` set in `bits(const T&)` within `res[i]`,
+             * in one pass over the key's objects, e.g. one device per device list.
+             * <p>
+             * Unlike find(), an object of one bit colliding with an earlier inserted object of another bit is not masked.
+             * `res` shall be initialized to nullptr.
+             * </p>
+             * @param bits `uint8_t bits(const T&)` returning the object's bits
+             * @return the OR'ed bits of all live objects for `key`
+             */
+            template<size_t N, class Bits>
+            uint8_t find_each(const BDAddressAndType& key, Bits bits, ref_t (&res)[N]) const noexcept {
+                auto it = map.find(key);
+                if( it == map.end() ) {
+                    return 0;
+                }
+                return find_each_in(it->second, bits, res);
+            }
+
+            /** Same as find_each(const BDAddressAndType&, Bits, ref_t (&)[N]) for any key with the given `address`. */
+            template<size_t N, class Bits>
+            uint8_t find_each(const EUI48& address, Bits bits, ref_t (&res)[N]) const noexcept {
+                uint8_t r = 0;
+                for(const auto& kv : map) {
+                    if( address == kv.first.address ) {
+                        r |= find_each_in(kv.second, bits, res);
+                    }
+                }
+                return r;
+            }
+
+            /** Returns the first live object for `key` matching `p(const T&)`, otherwise nullptr. */
+            template<class Pred>
+            ref_t find(const BDAddressAndType& key, Pred p) const noexcept {
+                auto it = map.find(key);
+                if( it == map.end() ) {
+                    return nullptr;
+                }
+                return find_in(it->second, p);
+            }
+
+            /** Returns the first live object for any key with the given `address` matching `p(const T&)`, otherwise nullptr. */
+            template<class Pred>
+            ref_t find(const EUI48& address, Pred p) const noexcept {
+                for(const auto& kv : map) {
+                    if( address == kv.first.address ) {
+                        ref_t e = find_in(kv.second, p);
+                        if( nullptr != e ) {
+                            return e;
+                        }
+                    }
+                }
+                return nullptr;
+            }
+
+            /** Returns the live object `obj` if indexed for `key`, otherwise nullptr. */
+            ref_t get(const BDAddressAndType& key, const T* obj) const noexcept {
+                return find(key, [obj](const T& e) -> bool { return &e == obj; });
+            }
+
+            /** Returns the number of live objects for `key`. */
+            size_t count(const BDAddressAndType& key) const noexcept {
+                auto it = map.find(key);
+                if( it == map.end() ) {
+                    return 0;
+                }
+                size_t n = 0;
+                for(const weak_t& w : it->second) {
+                    if( !w.expired() ) {
+                        ++n;
+                    }
+                }
+                return n;
+            }
+
+            /** Returns the number of keys. */
+            size_t size() const noexcept { return map.size(); }
+
+            void clear() noexcept { map.clear(); }
+    };
+
+    /**
+     * Least recently discovered order of objects, e.g. BTAdapter's discovered devices,
+     * evicting them by capacity or idle time-to-live.
+     * <p>
+     * Marking an object as discovered and selecting the eviction candidate are O(1),
+     * except for skipping pinned objects at the front of the order.
+     * </p>
+     * <p>
+     * Not thread safe, used by BTAdapter under its discovered devices lock.
+     * </p>
+     */
+    template<typename T>
+    class DiscoveryLRU {
+        public:
+            typedef std::list<T*> list_t;
+
+        private:
+            list_t order; // front: least recently discovered
+            std::unordered_map<const T*, typename list_t::iterator> pos;
+
+            template<class Skip>
+            T* first(Skip skip) const noexcept {
+                for(T* e : order) {
+                    if( !skip(*e) ) {
+                        return e;
+                    }
+                }
+                return nullptr;
+            }
+
+        public:
+            /** Marks `obj` as most recently discovered, adding it if not contained. */
+            void touch(T* obj) noexcept {
+                auto it = pos.find(obj);
+                if( it != pos.end() ) {
+                    order.splice(order.end(), order, it->second);
+                } else {
+                    pos[obj] = order.insert(order.end(), obj);
+                }
+            }
+
+            /** Removes `obj`, returns true if contained. */
+            bool remove(const T* obj) noexcept {
+                auto it = pos.find(obj);
+                if( it == pos.end() ) {
+                    return false;
+                }
+                order.erase(it->second);
+                pos.erase(it);
+                return true;
+            }
+
+            bool contains(const T* obj) const noexcept { return pos.end() != pos.find(obj); }
+
+            /**
+             * Evicts the least recently discovered objects while exceeding `capacity`, skipping `keep` and those for which `pinned(const T&)` returns true.
+             * @param erase `void erase(T& obj)` removing `obj` from its owner, may call remove()
+             * @return number of evicted objects
+             */
+            template<class Pinned, class Erase>
+            size_t evict(const size_t capacity, const T* keep, Pinned pinned, Erase erase) noexcept {
+                size_t count = 0;
+                while( order.size() > capacity ) {
+                    T* e = first([&](const T& o) -> bool { return &o == keep || pinned(o); });
+                    if( nullptr == e ) {
+                        break; // all pinned
+                    }
+                    erase(*e);
+                    remove(e);
+                    ++count;
+                }
+                return count;
+            }
+
+            /**
+             * Evicts the least recently discovered objects for which `expired(const T&)` returns true,
+             * skipping those for which `pinned(const T&)` returns true and stopping at the first unexpired one.
+             * @param erase `void erase(T& obj)` removing `obj` from its owner, may call remove()
+             * @return number of evicted objects
+             */
+            template<class Pinned, class Expired, class Erase>
+            size_t expire(Pinned pinned, Expired expired, Erase erase) noexcept {
+                size_t count = 0;
+                T* e;
+                while( nullptr != ( e = first(pinned) ) && expired(*e) ) {
+                    erase(*e);
+                    remove(e);
+                    ++count;
+                }
+                return count;
+            }
+
+            size_t size() const noexcept { return order.size(); }
+
+            void clear() noexcept {
+                order.clear();
+                pos.clear();
+            }
+    };
+
+    /**
+     * Deferred unpair commands removing potentially stale kernel keys, see BTAdapter::scheduleUnpair().
+     * <p>
+     * Scheduled identity addresses are de-duplicated and issued in a batch via process(),
+     * while flush() issues a pending unpair of one address immediately.
+     * Unpair commands are issued w/o holding the lock, hence flush() only waits for a concurrent unpair of its own address.
+     * </p>
+     * <p>
+     * Successfully unpaired addresses are kept as clean, i.e. w/o kernel keys, and skipped until flushed.
+     * The number of clean addresses is bounded, evicting the least recently unpaired one.
+     * </p>
+     * <p>
+     * Thread safe.
+     * </p>
+     */
+    class DeferredUnpair {
+        private:
+            typedef std::list<BDAddressAndType> clean_list_t;
+
+            const size_t clean_capacity;
+            mutable std::mutex mtx;
+            std::condition_variable cv_in_flight;
+            std::unordered_set<BDAddressAndType> pending;
+            std::unordered_set<BDAddressAndType> in_flight; // unpair command being issued
+            clean_list_t clean_order; // front: least recently unpaired
+            std::unordered_map<BDAddressAndType, clean_list_t::iterator> clean;
+
+            jau::relaxed_atomic_uint64 deferred;
+            jau::relaxed_atomic_uint64 skipped;
+
+            void addCleanLocked(const BDAddressAndType& address) noexcept;
+            void eraseCleanLocked(const BDAddressAndType& address) noexcept;
+
+        public:
+            /**
+             * @param clean_capacity_ maximum number of kept clean addresses
+             */
+            DeferredUnpair(const size_t clean_capacity_) noexcept;
+
+            DeferredUnpair(const DeferredUnpair&) = delete;
+            void operator=(const DeferredUnpair&) = delete;
+
+            /**
+             * Schedules a deferred unpair of `address`.
+             * <p>
+             * Addresses which can't hold kernel keys, i.e. non identity addresses and those w/o stored keys,
+             * as well as clean, pending and currently unpaired addresses are skipped.
+             * </p>
+             * @param address the identity address
+             * @param has_keys true if keys are stored for `address`, e.g. an SMPKeyBin of BTAdapter, which may have been uploaded to the kernel
+             * @return true if scheduled, false if skipped
+             */
+            bool schedule(const BDAddressAndType& address, const bool has_keys) noexcept;
+
+            /**
+             * Issues a pending unpair of `address` immediately and marks it as potentially holding keys,
+             * to be called before connecting or uploading keys.
+             * <p>
+             * Waits for a concurrent unpair of `address` issued by process(), if any.
+             * </p>
+             * @param unpair `bool unpair(const BDAddressAndType& address)` issuing the unpair command
+             * @return true if a pending unpair has been issued
+             */
+            template<class Unpair>
+            bool flush(const BDAddressAndType& address, Unpair unpair) noexcept {
+                {
+                    std::unique_lock<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+                    while( in_flight.end() != in_flight.find(address) ) {
+                        cv_in_flight.wait(lock);
+                    }
+                    eraseCleanLocked(address); // may receive keys from now on
+                    if( 0 == pending.erase(address) ) {
+                        return false;
+                    }
+                    in_flight.insert(address);
+                }
+                unpair(address);
+                {
+                    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+                    in_flight.erase(address);
+                }
+                cv_in_flight.notify_all();
+                return true;
+            }
+
+            /**
+             * Issues all pending unpair commands one address at a time.
+             * @param unpair `bool unpair(const BDAddressAndType& address)` issuing the unpair command, returning true if the address is clean
+             * @param shall_stop `bool shall_stop()` returning true to stop, leaving the remaining addresses pending
+             * @return number of issued unpair commands
+             */
+            template<class Unpair, class Stop>
+            size_t process(Unpair unpair, Stop shall_stop) noexcept {
+                size_t count = 0;
+                while( !shall_stop() ) {
+                    BDAddressAndType address;
+                    {
+                        const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+                        if( pending.empty() ) {
+                            break;
+                        }
+                        auto it = pending.begin();
+                        address = *it;
+                        pending.erase(it);
+                        in_flight.insert(address);
+                    }
+                    const bool is_clean = unpair(address);
+                    {
+                        const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+                        in_flight.erase(address);
+                        if( is_clean ) {
+                            addCleanLocked(address);
+                        }
+                    }
+                    cv_in_flight.notify_all();
+                    ++count;
+                }
+                return count;
+            }
+
+            /** Clears all pending and clean addresses. */
+            void clear() noexcept;
+
+            /** Returns the number of pending addresses. */
+            size_t getPendingCount() const noexcept;
+
+            /** Returns true if `address` is clean, i.e. unpaired and not flushed since. */
+            bool isClean(const BDAddressAndType& address) const noexcept;
+
+            /** Returns the number of clean addresses. */
+            size_t getCleanCount() const noexcept;
+
+            /** Returns the number of scheduled deferred unpairs. */
+            uint64_t getDeferred() const noexcept { return deferred; }
+
+            /** Returns the number of skipped schedule() calls. */
+            uint64_t getSkipped() const noexcept { return skipped; }
+    };
+
+} // namespace direct_bt
+
+#endif /* BT_ADAPTER_UTIL_HPP_ */
@@ -39,6 +39,7 @@
 #include "BTDevice.hpp"
 #include "BTManager.hpp"
 #include "BTGattService.hpp"
+#include "BTAdapterUtil.hpp"
 
 using namespace direct_bt;
 using namespace jau::fractions_i64_literals;
@@ -47,11 +48,12 @@ BTDevice::BTDevice(const ctor_cookie& cc, BTAdapter & a, EInfoReport const & r)
 : adapter(a), btRole(!a.getRole()),
   l2cap_att( std::make_unique<L2CAPClient>(adapter.dev_id, adapter.getAddressAndType(), L2CAP_PSM::UNDEFINED, L2CAP_CID::ATT) ), // copy elision, not copy-ctor
   ts_last_discovery(r.getTimestamp()),
-  ts_last_update(ts_last_discovery),
+  ts_last_update(r.getTimestamp()),
   name(),
   eir( std::make_shared<EInfoReport>() ),
   eir_ind( std::make_shared<EInfoReport>() ),
   eir_scan_rsp( std::make_shared<EInfoReport>() ),
+  update_coalescer( std::make_unique<DeviceUpdateCoalescer>() ),
   hciConnHandle(0),
   le_features(LE_Features::NONE),
   le_phy_tx(LE_PHYs::NONE),
@@ -61,7 +63,7 @@ BTDevice::BTDevice(const ctor_cookie& cc, BTAdapter & a, EInfoReport const & r)
   supervision_timeout(0),
   smp_events(0),
   pairing_data { },
-  ts_creation(ts_last_discovery),
+  ts_creation(r.getTimestamp()),
   visibleAddressAndType{r.getAddress(), r.getAddressType()},
   addressAndType(visibleAddressAndType)
 {
@@ -138,7 +140,7 @@ std::string BTDevice::toString(bool includeDiscoveredServices) const noexcept {
     std::shared_ptr<const EInfoReport> eir_ = eir;
     std::string eir_s = BTRole::Slave == getRole() ? ", "+eir_->toString( includeDiscoveredServices ) : "";
     std::string out("Device["+to_string(getRole())+", "+addressAndType.toString()+resaddr_s+", name['"+name+
-            "'], age[total "+std::to_string(t0-ts_creation)+", ldisc "+std::to_string(t0-ts_last_discovery)+", lup "+std::to_string(t0-ts_last_update)+
+            "'], age[total "+std::to_string(t0-ts_creation)+", ldisc "+std::to_string(t0-ts_last_discovery.load())+", lup "+std::to_string(t0-ts_last_update)+
             "]ms, connected["+std::to_string(allowDisconnect)+"/"+std::to_string(isConnected)+", handle "+jau::to_hexstring(hciConnHandle)+
             ", phy[Tx "+direct_bt::to_string(le_phy_tx)+", Rx "+direct_bt::to_string(le_phy_rx)+
             "], l2cap "+jau::to_string(l2cap_att_open)+
@@ -160,6 +162,7 @@ void BTDevice::clearData() noexcept {
     // l2cap_att->close(); // already done
     // ts_last_discovery = 0; // leave
     // ts_last_update = 0; // leave
+    update_coalescer->clear();
     name.clear();
     rssi = 127; // The core spec defines 127 as the "not available" value
     tx_power = 127; // The core spec defines 127 as the "not available" value
@@ -181,7 +184,11 @@ void BTDevice::clearData() noexcept {
 
 bool BTDevice::updateIdentityAddress(BDAddressAndType const & identityAddress, bool sendEvent) noexcept {
     if( BDAddressType::BDADDR_LE_PUBLIC != addressAndType.type && addressAndType != identityAddress ) {
+        const BDAddressAndType old_address = addressAndType;
         addressAndType  = identityAddress;
+        adapter.reindexDevice(*this, old_address);
+        adapter.rpa_resolver.remove(old_address);
+        adapter.updateRPAResolver(*this);
         adapter.hci.setResolvHCIConnectionAddr(visibleAddressAndType, addressAndType);
         if( sendEvent ) {
             std::shared_ptr<BTDevice> sharedInstance = getSharedInstance();
@@ -209,6 +216,8 @@ bool BTDevice::updateVisibleAddress(BDAddressAndType const & randomPrivateAddres
 EIRDataType BTDevice::update(EInfoReport const & data) noexcept {
     const std::lock_guard<std::mutex> lock(mtx_eir); // RAII-style acquire and relinquish via destructor
 
+    ad_fingerprint.reset(data.getSource()); // set by caller if known, see setADFingerprint()
+
     btRole = !adapter.getRole(); // update role
 
     // Update eir CoW style
@@ -259,6 +268,21 @@ EIRDataType BTDevice::update(EInfoReport const & data) noexcept {
     return res0;
 }
 
+void BTDevice::setADFingerprint(EInfoReportView const & view) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_eir); // RAII-style acquire and relinquish via destructor
+    ad_fingerprint.set(view);
+}
+
+bool BTDevice::updateUnchanged(EInfoReportView const & view, EIRDataType& res) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_eir); // RAII-style acquire and relinquish via destructor
+    if( !ad_fingerprint.updateUnchanged(view, rssi, tx_power, res) ) {
+        return false;
+    }
+    btRole = !adapter.getRole(); // update role, as update(EInfoReport const &)
+    ts_last_update = view.getTimestamp();
+    return true;
+}
+
 EIRDataType BTDevice::update(GattGenericAccessSvc const &data, const uint64_t timestamp) noexcept {
     const std::lock_guard<std::mutex> lock(mtx_eir); // RAII-style acquire and relinquish via destructor
 
@@ -329,6 +353,7 @@ HCIStatusCode BTDevice::connectLE(const uint16_t le_scan_interval, const uint16_
         WARN_PRINT("Adapter not powered: %s, %s", adapter.toString().c_str(), toString().c_str());
         return HCIStatusCode::NOT_POWERED;
     }
+    adapter.flushUnpair(addressAndType); // pending stale keys removed before connecting
     HCILEOwnAddressType hci_own_mac_type = adapter.visibleMACType;
     HCILEPeerAddressType hci_peer_mac_type;
 
@@ -1389,6 +1414,7 @@ void BTDevice::hciSMPMsgCallback(const std::shared_ptr<BTDevice>& sthis, const S
                     pairing_data.irk_init.id_address = pairing_data.id_address_init.address;
                 }
             }
+            adapter.updateRPAResolver(*this);
         }   break;
 
         case SMPPDUMsg::Opcode::IDENTITY_ADDRESS_INFORMATION:{/* Lecacy: 4; SC: 2 */
@@ -1660,6 +1686,7 @@ HCIStatusCode BTDevice::uploadKeys() noexcept {
     }
     const std::unique_lock<std::recursive_mutex> lock_pairing(mtx_pairing); // RAII-style acquire and relinquish via destructor
     if constexpr ( USE_LINUX_BT_SECURITY ) {
+        adapter.flushUnpair(addressAndType); // pending stale keys removed before uploading
         const BTManagerRef& mngr = adapter.getManager();
         HCIStatusCode res = HCIStatusCode::SUCCESS;
 
@@ -1766,13 +1793,23 @@ void BTDevice::setIdentityResolvingKey(const SMPIdentityResolvingKey& irk) noexc
         pairing_data.keys_init_exp |= SMPKeyType::ID_KEY;
         pairing_data.id_address_init = BDAddressAndType(irk.id_address, BDAddressType::BDADDR_LE_PUBLIC);
     }
+    adapter.updateRPAResolver(*this);
 }
 
-bool BTDevice::matches_irk(const BDAddressAndType& rpa) noexcept {
+bool BTDevice::getRemoteIRK(SMPIdentityResolvingKey& irk) const noexcept {
     // self_is_responder == true: responder's IRK info (LL slave), else the initiator's (LL master)
     const bool self_is_responder = BTRole::Slave == btRole;
     if( is_set(self_is_responder ? pairing_data.keys_resp_has : pairing_data.keys_init_has, SMPKeyType::ID_KEY) ) {
-        SMPIdentityResolvingKey irk = getIdentityResolvingKey(self_is_responder);
+        irk = getIdentityResolvingKey(self_is_responder);
+        return true;
+    } else {
+        return false;
+    }
+}
+
+bool BTDevice::matches_irk(const BDAddressAndType& rpa) noexcept {
+    SMPIdentityResolvingKey irk;
+    if( getRemoteIRK(irk) ) {
         return irk.matches(rpa.address); // irk.id_address == this->addressAndType
     } else {
         return false;
@@ -2347,6 +2384,19 @@ bool BTDevice::sendNotification(const uint16_t char_value_handle, const jau::TRO
     return gh->sendNotification(char_value_handle, value);
 }
 
+bool BTDevice::sendNotifications(const uint16_t char_value_handle, const jau::TROOctets* const* values, const jau::nsize_t count) noexcept {
+    if( !isValidInstance() ) {
+        ERR_PRINT("Device invalid: %p", jau::to_hexstring((void*)this).c_str());
+        return false;
+    }
+    std::shared_ptr<BTGattHandler> gh = getGattHandler();
+    if( nullptr == gh || !gh->isConnected() ) {
+        WARN_PRINT("GATTHandler not connected -> disconnected on %s", toString().c_str());
+        return false;
+    }
+    return gh->sendNotifications(char_value_handle, values, count);
+}
+
 bool BTDevice::sendIndication(const uint16_t char_value_handle, const jau::TROOctets & value) noexcept {
     if( !isValidInstance() ) {
         ERR_PRINT("Device invalid: %p", jau::to_hexstring((void*)this).c_str());
@@ -2584,6 +2634,7 @@ HCIStatusCode BTDevice::unpair() noexcept {
             DBG_PRINT("BTDevice::unpair(): Unpair device failed: %s, %s", to_string(res).c_str(), toString().c_str());
         }
         clearSMPStates(getConnected() /* connected */);
+        adapter.rpa_resolver.remove(addressAndType);
         return res;
     } else if constexpr ( SMP_SUPPORTED_BY_OS ) {
         return HCIStatusCode::NOT_SUPPORTED;
@@ -27,6 +27,7 @@
 #include <string>
 #include <memory>
 #include <cstdint>
+#include <vector>
 #include <cstdio>
 
 #include  <algorithm>
@@ -414,12 +415,11 @@ bool BTGattHandler::replyAttPDUReq(std::unique_ptr<const AttPDUMsg> && pdu) noex
     }
 }
 
-void BTGattHandler::l2capReaderWork(jau::service_runner& sr) noexcept {
+bool BTGattHandler::l2capReaderProcess() noexcept {
     jau::snsize_t len;
     if( !validateConnected() ) {
         DBG_PRINT("GATTHandler::reader: Invalid IO state -> Stop");
-        sr.set_shall_stop();
-        return;
+        return false;
     }
 
     len = l2cap.read(rbuffer.get_wptr(), rbuffer.size());
@@ -480,9 +480,8 @@ void BTGattHandler::l2capReaderWork(jau::service_runner& sr) noexcept {
                 AttHandleValueCfm cfm;
                 if( !send(cfm) ) {
                     ERR_PRINT2("Indication Confirmation: Error req %s; %s", cfm.toString().c_str(), toString().c_str());
-                    sr.set_shall_stop();
                     has_ioerror = true;
-                    return;
+                    return false;
                 }
                 cfmSent = true;
             }
@@ -524,15 +523,13 @@ void BTGattHandler::l2capReaderWork(jau::service_runner& sr) noexcept {
             COND_PRINT(env.DEBUG_DATA, "GATTHandler::reader: Ring: %s", attPDU->toString().c_str());
             if( !attPDURing.putBlocking( std::move(attPDU), 0_s ) ) {
                 ERR_PRINT2("attPDURing put: %s", attPDURing.toString().c_str());
-                sr.set_shall_stop();
-                return;
+                return false;
             }
         } else if( AttPDUMsg::OpcodeType::REQUEST == opc_type ) {
             if( !replyAttPDUReq( std::move( attPDU ) ) ) {
                 ERR_PRINT2("ATT Reply: %s", toString().c_str());
-                sr.set_shall_stop();
                 has_ioerror = true;
-                return;
+                return false;
             }
         } else {
             ERR_PRINT("Unhandled: %s", attPDU->toString().c_str());
@@ -540,22 +537,34 @@ void BTGattHandler::l2capReaderWork(jau::service_runner& sr) noexcept {
     } else if( len == L2CAPClient::number(L2CAPClient::RWExitCode::INTERRUPTED) ) {
         WORDY_PRINT("GATTHandler::reader: l2cap read: IRQed res %d (%s); %s",
                 len, L2CAPClient::getRWExitCodeString(len).c_str(), getStateString().c_str());
-        if( !sr.shall_stop() ) {
-            // need to stop service_runner if interrupted externally
-            sr.set_shall_stop();
-        }
+        return false; // need to stop reader if interrupted externally
     } else if( len != L2CAPClient::number(L2CAPClient::RWExitCode::POLL_TIMEOUT) &&
                len != L2CAPClient::number(L2CAPClient::RWExitCode::READ_TIMEOUT) ) { // expected TIMEOUT if idle
         if( 0 > len ) { // actual error case
             IRQ_PRINT("GATTHandler::reader: l2cap read: Error res %d (%s); %s",
                     len, L2CAPClient::getRWExitCodeString(len).c_str(), getStateString().c_str());
-            sr.set_shall_stop();
             has_ioerror = true;
+            return false;
         } else { // zero size
             WORDY_PRINT("GATTHandler::reader: l2cap read: Zero res %d (%s); %s",
                     len, L2CAPClient::getRWExitCodeString(len).c_str(), getStateString().c_str());
         }
     }
+    return true;
+}
+
+void BTGattHandler::l2capReaderWork(jau::service_runner& sr) noexcept {
+    if( !l2capReaderProcess() ) {
+        sr.set_shall_stop();
+    }
+}
+
+bool BTGattHandler::l2capReaderReady() noexcept {
+    if( l2capReaderProcess() ) {
+        return true;
+    }
+    l2capReaderEndLocked(l2cap_reader_service);
+    return false;
 }
 
 void BTGattHandler::l2capReaderEndLocked(jau::service_runner& sr) noexcept {
@@ -577,7 +586,7 @@ void BTGattHandler::l2capReaderEndLocked(jau::service_runner& sr) noexcept {
 
 bool BTGattHandler::l2capReaderInterrupted(int dummy) /* const */ noexcept {
     (void)dummy;
-    if( l2cap_reader_service.shall_stop() || !is_connected ) {
+    if( ( !use_reactor && l2cap_reader_service.shall_stop() ) || !is_connected ) {
         return true;
     }
     BTDeviceRef device = getDeviceUnchecked();
@@ -602,6 +611,7 @@ BTGattHandler::BTGattHandler(const BTDeviceRef &device, L2CAPClient& l2cap_att,
                        jau::bind_member(this, &BTGattHandler::l2capReaderWork),
                        jau::service_runner::Callback() /* init */,
                        jau::bind_member(this, &BTGattHandler::l2capReaderEndLocked)),
+  use_reactor(IOReactor::isEnabled()), reactor_id(0),
   attPDURing(env.ATTPDU_RING_CAPACITY),
   serverMTU(number(Defaults::MIN_ATT_MTU)), usedMTU(number(Defaults::MIN_ATT_MTU)), clientMTUExchanged(false),
   gattServerData( device->getAdapter().getGATTServerData() ),
@@ -619,7 +629,13 @@ BTGattHandler::BTGattHandler(const BTDeviceRef &device, L2CAPClient& l2cap_att,
      */
     // l2cap.set_interrupted_query( jau::bind_member(&l2cap_reader_service, &jau::service_runner::shall_stop2) );
     l2cap.set_interrupted_query( jau::bind_member(this, &BTGattHandler::l2capReaderInterrupted) );
-    l2cap_reader_service.start();
+    if( use_reactor ) {
+        reactor_id = IOReactor::get().add(l2cap.socket(), "GATTHandler::reader_"+deviceString, jau::bind_member(this, &BTGattHandler::l2capReaderReady));
+        use_reactor = 0 != reactor_id;
+    }
+    if( !use_reactor ) {
+        l2cap_reader_service.start();
+    }
 
     DBG_PRINT("GATTHandler::ctor: Started: GattHandler[%s], l2cap[%s]: %s",
                 getStateString().c_str(), l2cap.getStateString().c_str(), toString().c_str());
@@ -681,6 +697,9 @@ bool BTGattHandler::disconnect(const bool disconnect_device, const bool ioerr_ca
     if( !is_connected.compare_exchange_strong(expConn, false) ) {
         // not connected
         const bool l2cap_service_stopped = l2cap_reader_service.join(); // [data] race: wait until disconnecting thread has stopped service
+        if( use_reactor ) {
+            IOReactor::get().remove(reactor_id);
+        }
         l2cap.close(); // owned by BTDevice.
         DBG_PRINT("GATTHandler::disconnect: Not connected: disconnect_device %d, ioerr %d: GattHandler[%s], l2cap[%s], stopped %d: %s",
                   disconnect_device, ioerr_cause, getStateString().c_str(), l2cap.getStateString().c_str(),
@@ -691,7 +710,15 @@ bool BTGattHandler::disconnect(const bool disconnect_device, const bool ioerr_ca
     }
 
     PERF3_TS_TD("GATTHandler::disconnect.1");
-    const bool l2cap_service_stop_res = l2cap_reader_service.stop();
+    bool l2cap_service_stop_res;
+    if( use_reactor ) {
+        l2cap_service_stop_res = IOReactor::get().remove(reactor_id);
+        if( l2cap_service_stop_res ) {
+            l2capReaderEndLocked(l2cap_reader_service);
+        }
+    } else {
+        l2cap_service_stop_res = l2cap_reader_service.stop();
+    }
     l2cap.close(); // owned by BTDevice.
     PERF3_TS_TD("GATTHandler::disconnect.X");
 
@@ -759,12 +786,61 @@ bool BTGattHandler::send(const AttPDUMsg & msg) noexcept {
     return true;
 }
 
+bool BTGattHandler::send(const AttPDUMsg* const* msgs, const jau::nsize_t count) noexcept {
+    if( !validateConnected() ) {
+        if( !l2capReaderInterrupted() ) {
+            ERR_PRINT("Invalid IO State: %u reqs to %s", count, toString().c_str());
+        }
+        return false;
+    }
+    std::vector<const uint8_t*> buffers(count);
+    std::vector<jau::nsize_t> lengths(count);
+    for(jau::nsize_t i=0; i<count; ++i) {
+        // [1 .. ATT_MTU-1] BT Core Spec v5.2: Vol 3, Part F 3.2.9 Long attribute values
+        if( msgs[i]->pdu.size() > usedMTU ) {
+            ERR_PRINT("Msg PDU size %zu >= used MTU %u, req %s to %s",
+                    msgs[i]->pdu.size(), usedMTU.load(), msgs[i]->toString().c_str(), toString().c_str());
+            return false;
+        }
+        buffers[i] = msgs[i]->pdu.get_ptr();
+        lengths[i] = static_cast<jau::nsize_t>( msgs[i]->pdu.size() );
+    }
+
+    // Thread safe l2cap.write_batch(..) operation, writing all or stopping at the first failed message
+    jau::nsize_t done = 0;
+    while( done < count ) {
+        const jau::snsize_t res = l2cap.write_batch(buffers.data() + done, lengths.data() + done, count - done);
+        if( 0 >= res ) {
+            if( res == L2CAPClient::number(L2CAPClient::RWExitCode::INTERRUPTED) ) { // expected exits
+                WORDY_PRINT("GATTHandler::send: l2cap write: IRQed res %d (%s); %s",
+                        res, L2CAPClient::getRWExitCodeString(res).c_str(), getStateString().c_str());
+            } else {
+                ERR_PRINT("l2cap write: Error res %d (%s); %s; %u/%u, %s -> disconnect: %s",
+                        res, L2CAPClient::getRWExitCodeString(res).c_str(), getStateString().c_str(),
+                        done, count, msgs[done]->toString().c_str(), toString().c_str());
+                has_ioerror = true;
+                disconnect(true /* disconnect_device */, true /* ioerr_cause */); // state -> Disconnected
+            }
+            return false;
+        }
+        done += static_cast<jau::nsize_t>(res);
+    }
+    return true;
+}
+
 std::unique_ptr<const AttPDUMsg> BTGattHandler::sendWithReply(const AttPDUMsg & msg, const jau::fraction_i64& timeout) noexcept {
+    if( use_reactor && IOReactor::isDispatching(reactor_id) ) {
+        // Our reply would be dispatched by this very callback after returning, e.g. a request from a listener of this device
+        ERR_PRINT("GATTHandler::sendWithReply: Request from own reader callback would block until timeout: req %s to %s",
+                msg.toString().c_str(), toString().c_str());
+        return nullptr;
+    }
     if( !send( msg ) ) {
         return nullptr;
     }
 
-    // Ringbuffer read is thread safe
+    // Ringbuffer read is thread safe, a blocked reactor dispatch hands over other devices' replies
+    const IOReactor::BlockingScope blocking;
     std::unique_ptr<const AttPDUMsg> res;
     if( !attPDURing.getBlocking(res, timeout) || nullptr == res ) {
         errno = ETIMEDOUT;
@@ -849,6 +925,37 @@ bool BTGattHandler::sendNotification(const uint16_t char_value_handle, const jau
     return send(data);
 }
 
+bool BTGattHandler::sendNotifications(const uint16_t char_value_handle, const jau::TROOctets* const* values, const jau::nsize_t count) noexcept {
+    if( GATTRole::Server != role ) {
+        ERR_PRINT("GATTRole not server");
+        return false;
+    }
+    if( DBGattServer::Mode::DB == gattServerHandler->getMode() &&
+        nullptr == findServerGattCharByValueHandle(char_value_handle) )
+    {
+        ERR_PRINT("Invalid char handle %s", jau::to_hexstring(char_value_handle).c_str());
+        return false;
+    }
+    const std::lock_guard<std::recursive_mutex> lock(mtx_command); // RAII-style acquire and relinquish via destructor
+    std::vector<std::unique_ptr<AttHandleValueRcv>> data;
+    std::vector<const AttPDUMsg*> msgs;
+    data.reserve(count);
+    msgs.reserve(count);
+    for(jau::nsize_t i=0; i<count; ++i) {
+        if( 0 == values[i]->size() ) {
+            COND_PRINT(env.DEBUG_DATA, "GATT SEND NTF: Zero size, skipped sending to %s", toString().c_str());
+            continue;
+        }
+        data.push_back( std::make_unique<AttHandleValueRcv>(true /* isNotify */, char_value_handle, *values[i], usedMTU) );
+        COND_PRINT(env.DEBUG_DATA, "GATT SEND NTF: %s to %s", data.back()->toString().c_str(), toString().c_str());
+        msgs.push_back( data.back().get() );
+    }
+    if( msgs.empty() ) {
+        return true;
+    }
+    return send(msgs.data(), static_cast<jau::nsize_t>( msgs.size() ));
+}
+
 bool BTGattHandler::sendIndication(const uint16_t char_value_handle, const jau::TROOctets & value) noexcept {
     if( GATTRole::Server != role ) {
         ERR_PRINT("GATTRole not server");
@@ -1587,7 +1694,7 @@ std::string BTGattHandler::toString() const noexcept {
            ", mtu "+std::to_string(usedMTU.load())+
            ", listener[BTGatt "+std::to_string(gattCharListenerList.size())+
            ", Native "+std::to_string(nativeGattCharListenerList.size())+
-           "], l2capWorker[running "+std::to_string(l2cap_reader_service.is_running())+
+           "], l2capWorker[reactor "+std::to_string(use_reactor)+", running "+std::to_string(l2cap_reader_service.is_running())+
            ", shallStop "+std::to_string(l2cap_reader_service.shall_stop())+
            ", thread_id "+jau::to_hexstring((void*)l2cap_reader_service.thread_id())+ // NOLINT(performance-no-int-to-ptr)
            "], "+getStateString()+"]";
@@ -76,6 +76,7 @@ MgmtEnv::MgmtEnv() noexcept
     L2CAPEnv::get();
     BTGattEnv::get();
     SMPEnv::get();
+    IOReactorEnv::get();
 }
 
 void BTManager::mgmtReaderWork(jau::service_runner& sr) noexcept {
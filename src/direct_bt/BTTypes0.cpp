@@ -37,6 +37,7 @@
 #include <jau/darray.hpp>
 
 #include "BTTypes0.hpp"
+#include "UUIDPool.hpp"
 
 using namespace direct_bt;
 
@@ -545,19 +546,31 @@ static std::string bt_compidtostr(const uint16_t companyid) noexcept {
 }
 
 ManufactureSpecificData::ManufactureSpecificData(uint16_t const company_)
-: company(company_), companyName(std::string(bt_compidtostr(company_))),
-  data(jau::lb_endian_t::little /* intentional zero sized */)
+: company(company_), data_len(0),
+  data_heap(jau::lb_endian_t::little /* intentional zero sized */)
 { }
 
-ManufactureSpecificData::ManufactureSpecificData(uint16_t const company_, uint8_t const * const data_, jau::nsize_t const data_len)
-: company(company_), companyName(std::string(bt_compidtostr(company_))),
-  data(data_, data_len, jau::lb_endian_t::little)
-{ }
+ManufactureSpecificData::ManufactureSpecificData(uint16_t const company_, uint8_t const * const data_, jau::nsize_t const data_len_)
+: company(company_), data_len(data_len_),
+  data_heap(jau::lb_endian_t::little /* intentional zero sized */)
+{
+    if( data_len <= INLINE_DATA_SIZE ) {
+        if( 0 < data_len ) {
+            memcpy(data_inline, data_, data_len);
+        }
+    } else {
+        data_heap = jau::POctets(data_, data_len, jau::lb_endian_t::little);
+    }
+}
+
+std::string ManufactureSpecificData::getCompanyName() const noexcept {
+    return std::string(bt_compidtostr(company));
+}
 
 std::string ManufactureSpecificData::toString() const noexcept {
   std::string out("MSD[company[");
-  out.append(std::to_string(company)+" "+companyName);
-  out.append("], data["+data.toString()+"]]");
+  out.append(std::to_string(company)+" "+getCompanyName());
+  out.append("], data["+getData().toString()+"]]");
   return out;
 }
 
@@ -670,14 +683,16 @@ EIRDataType EInfoReport::set(const EInfoReport& eir) noexcept {
         }
     }
     if( eir.isSet( EIRDataType::NAME) ) {
-        if( !isSet( EIRDataType::NAME ) || getName() != eir.getName() ) {
-            setName(eir.getName());
+        if( !isSet( EIRDataType::NAME ) || name != eir.name ) {
+            name = eir.name;
+            set(EIRDataType::NAME);
             direct_bt::set(res, EIRDataType::NAME);
         }
     }
     if( eir.isSet( EIRDataType::NAME_SHORT) ) {
-        if( !isSet( EIRDataType::NAME_SHORT ) || getShortName() != eir.getShortName() ) {
-            setShortName(eir.getShortName());
+        if( !isSet( EIRDataType::NAME_SHORT ) || name_short != eir.name_short ) {
+            name_short = eir.name_short;
+            set(EIRDataType::NAME_SHORT);
             direct_bt::set(res, EIRDataType::NAME_SHORT);
         }
     }
@@ -713,13 +728,13 @@ EIRDataType EInfoReport::set(const EInfoReport& eir) noexcept {
     }
     if( eir.isSet( EIRDataType::HASH) ) {
         if( !isSet( EIRDataType::HASH ) || getHash() != eir.getHash() ) {
-            setHash(eir.getHash().get_ptr());
+            setHash(eir.hash);
             direct_bt::set(res, EIRDataType::HASH);
         }
     }
     if( eir.isSet( EIRDataType::RANDOMIZER) ) {
         if( !isSet( EIRDataType::RANDOMIZER ) || getRandomizer() != eir.getRandomizer() ) {
-            setRandomizer(eir.getRandomizer().get_ptr());
+            setRandomizer(eir.randomizer);
             direct_bt::set(res, EIRDataType::RANDOMIZER);
         }
     }
@@ -771,15 +786,19 @@ std::string direct_bt::to_string(EInfoReport::Source source) noexcept {
     return "N/A";
 }
 
+BDAddressType EInfoReport::toAddressType(const uint8_t adAddressType) noexcept {
+    switch( adAddressType ) {
+        case 0x00: return BDAddressType::BDADDR_LE_PUBLIC;
+        case 0x01: return BDAddressType::BDADDR_LE_RANDOM;
+        case 0x02: return BDAddressType::BDADDR_LE_RANDOM;
+        case 0x03: return BDAddressType::BDADDR_LE_RANDOM;
+        default: return BDAddressType::BDADDR_UNDEFINED;
+    }
+}
+
 void EInfoReport::setADAddressType(uint8_t adAddressType) noexcept {
     ad_address_type = adAddressType;
-    switch( ad_address_type ) {
-        case 0x00: addressType = BDAddressType::BDADDR_LE_PUBLIC; break;
-        case 0x01: addressType = BDAddressType::BDADDR_LE_RANDOM; break;
-        case 0x02: addressType = BDAddressType::BDADDR_LE_RANDOM; break;
-        case 0x03: addressType = BDAddressType::BDADDR_LE_RANDOM; break;
-        default: addressType = BDAddressType::BDADDR_UNDEFINED; break;
-    }
+    addressType = toAddressType(ad_address_type);
     set(EIRDataType::BDADDR_TYPE);
 }
 
@@ -794,21 +813,27 @@ void EInfoReport::setAddressType(BDAddressType at) noexcept {
     set(EIRDataType::BDADDR_TYPE);
 }
 
+/** Returns the C-string length of given buffer, limited to NAME_INLINE_SIZE, as jau::get_string() */
+static jau::nsize_t get_name_len(const uint8_t *buffer, int buffer_len) noexcept {
+    const jau::nsize_t max_len = std::min<jau::nsize_t>(std::max<int>(0, buffer_len), EInfoReport::NAME_INLINE_SIZE);
+    return ::strnlen(reinterpret_cast<const char*>(buffer), max_len);
+}
+
 void EInfoReport::setName(const uint8_t *buffer, int buffer_len) noexcept {
-    name = jau::get_string(buffer, buffer_len, 30);
+    name.assign(reinterpret_cast<const char*>(buffer), get_name_len(buffer, buffer_len));
     set(EIRDataType::NAME);
 }
 void EInfoReport::setName(const std::string& name_) noexcept {
-    name = name_;
+    name.assign(name_.data(), name_.size());
     set(EIRDataType::NAME);
 }
 
 void EInfoReport::setShortName(const uint8_t *buffer, int buffer_len) noexcept {
-    name_short = jau::get_string(buffer, buffer_len, 30);
+    name_short.assign(reinterpret_cast<const char*>(buffer), get_name_len(buffer, buffer_len));
     set(EIRDataType::NAME_SHORT);
 }
 void EInfoReport::setShortName(const std::string& name_short_) noexcept {
-    name_short = name_short_;
+    name_short.assign(name_short_.data(), name_short_.size());
     set(EIRDataType::NAME_SHORT);
 }
 
@@ -834,19 +859,20 @@ void EInfoReport::setDeviceID(const uint16_t source_, const uint16_t vendor, con
 
 bool EInfoReport::addService(const std::shared_ptr<const jau::uuid_t>& uuid) noexcept
 {
+    // interned instances of same value and type size are identical
     auto begin = services.begin();
     auto it = std::find_if(begin, services.end(), [&](std::shared_ptr<const jau::uuid_t> const& p) {
-        return nullptr != p && uuid->equivalent(*p);
+        return p == uuid || ( nullptr != p && uuid->equivalent(*p) );
     });
     if ( it == std::end(services) ) {
-        services.push_back(uuid);
+        services.push_back( uuid ); // callers pass interned instances, see UUIDPool
         set(EIRDataType::SERVICE_UUID);
         return true;
     }
     return false;
 }
 bool EInfoReport::addService(const jau::uuid_t& uuid) noexcept {
-    return addService( uuid.clone() );
+    return addService( UUIDPool::get(uuid) );
 }
 
 std::string EInfoReport::eirDataMaskToString() const noexcept {
@@ -858,7 +884,7 @@ std::string EInfoReport::toString(const bool includeServices) const noexcept {
                     "["+source_ext_s+", address["+address.toString()+", "+to_string(getAddressType())+"/"+std::to_string(ad_address_type)+
                     "], "+eirDataMaskToString()+", ");
     if( isSet(EIRDataType::NAME) || isSet(EIRDataType::NAME_SHORT) ) {
-        out += "name['"+name+"'/'"+name_short+"'], ";
+        out += "name['"+name.str()+"'/'"+name_short.str()+"'], ";
     }
 
     if( isSet(EIRDataType::EVT_TYPE) || isSet(EIRDataType::EXT_EVT_TYPE) ) {
@@ -886,10 +912,10 @@ std::string EInfoReport::toString(const bool includeServices) const noexcept {
         out += "appearance "+jau::to_hexstring(static_cast<uint16_t>(appearance))+" ("+to_string(appearance)+"), ";
     }
     if( isSet(EIRDataType::HASH) ) {
-        out += "hash["+hash.toString()+"], ";
+        out += "hash["+getHash().toString()+"], ";
     }
     if( isSet(EIRDataType::RANDOMIZER) ) {
-        out += "randomizer["+randomizer.toString()+"], ";
+        out += "randomizer["+getRandomizer().toString()+"], ";
     }
     if( isSet(EIRDataType::DEVICE_ID) ) {
         out += "device-id[source "+jau::to_hexstring(did_source)+
@@ -936,8 +962,8 @@ bool EInfoReport::operator==(const EInfoReport& o) const noexcept {
            o.conn_interval_max == conn_interval_max &&
            o.device_class == device_class &&
            o.appearance == appearance &&
-           o.hash == hash &&
-           o.randomizer == randomizer &&
+           0 == memcmp(o.hash, hash, sizeof(hash)) &&
+           0 == memcmp(o.randomizer, randomizer, sizeof(randomizer)) &&
            o.did_source == did_source &&
            o.did_vendor == did_vendor &&
            o.did_product == did_product &&
@@ -978,6 +1004,63 @@ std::string EInfoReport::getDeviceIDModalias() const noexcept {
 // *************************************************
 // *************************************************
 
+/**
+ * Returns the EIRDataType bit EInfoReport::read_elem() sets for the given AD structure, EIRDataType::NONE if none.
+ */
+static EIRDataType ad_elem_mask(const uint8_t t, const uint8_t len) noexcept {
+    switch( static_cast<GAP_T>(t) ) {
+        case GAP_T::FLAGS:
+            if( 1 <= len ) { return EIRDataType::FLAGS; }
+            break;
+        case GAP_T::UUID16_INCOMPLETE:
+            [[fallthrough]];
+        case GAP_T::UUID16_COMPLETE:
+            if( 2 <= len ) { return EIRDataType::SERVICE_UUID; }
+            break;
+        case GAP_T::UUID32_INCOMPLETE:
+            [[fallthrough]];
+        case GAP_T::UUID32_COMPLETE:
+            if( 4 <= len ) { return EIRDataType::SERVICE_UUID; }
+            break;
+        case GAP_T::UUID128_INCOMPLETE:
+            [[fallthrough]];
+        case GAP_T::UUID128_COMPLETE:
+            if( 16 <= len ) { return EIRDataType::SERVICE_UUID; }
+            break;
+        case GAP_T::NAME_LOCAL_SHORT:
+            return EIRDataType::NAME_SHORT;
+        case GAP_T::NAME_LOCAL_COMPLETE:
+            return EIRDataType::NAME;
+        case GAP_T::TX_POWER_LEVEL:
+            if( 1 <= len ) { return EIRDataType::TX_POWER; }
+            break;
+        case GAP_T::SSP_CLASS_OF_DEVICE:
+            if( 3 <= len ) { return EIRDataType::DEVICE_CLASS; }
+            break;
+        case GAP_T::DEVICE_ID:
+            if( 8 <= len ) { return EIRDataType::DEVICE_ID; }
+            break;
+        case GAP_T::SLAVE_CONN_IVAL_RANGE:
+            if( 4 <= len ) { return EIRDataType::CONN_IVAL; }
+            break;
+        case GAP_T::GAP_APPEARANCE:
+            if( 2 <= len ) { return EIRDataType::APPEARANCE; }
+            break;
+        case GAP_T::SSP_HASH_C192:
+            if( 16 <= len ) { return EIRDataType::HASH; }
+            break;
+        case GAP_T::SSP_RANDOMIZER_R192:
+            if( 16 <= len ) { return EIRDataType::RANDOMIZER; }
+            break;
+        case GAP_T::MANUFACTURE_SPECIFIC:
+            if( 2 <= len ) { return EIRDataType::MANUF_DATA; }
+            break;
+        default:
+            break;
+    }
+    return EIRDataType::NONE;
+}
+
 int EInfoReport::next_data_elem(uint8_t *eir_elem_len, uint8_t *eir_elem_type, uint8_t const **eir_elem_data,
                                uint8_t const * data, int offset, int const size) noexcept
 {
@@ -1001,150 +1084,255 @@ int EInfoReport::next_data_elem(uint8_t *eir_elem_len, uint8_t *eir_elem_type, u
     return -ENOENT;
 }
 
-int EInfoReport::read_data(uint8_t const * data, uint8_t const data_length) noexcept {
-    int count = 0;
-    int offset = 0;
-    uint8_t elem_len, elem_type;
-    uint8_t const *elem_data;
+void EInfoReport::read_elem(const uint8_t elem_type, uint8_t const * elem_data, const uint8_t elem_len) noexcept {
+    // Guaranteed: elem_len >= 0!
+    switch ( static_cast<GAP_T>(elem_type) ) {
+        case GAP_T::FLAGS:
+            if( 1 <= elem_len ) {
+                setFlags(static_cast<GAPFlags>(*elem_data));
+            }
+            break;
 
-    while( 0 < ( offset = next_data_elem( &elem_len, &elem_type, &elem_data, data, offset, data_length ) ) )
-    {
-        count++;
+        case GAP_T::UUID16_INCOMPLETE:
+            [[fallthrough]];
+        case GAP_T::UUID16_COMPLETE:
+            setServicesComplete( GAP_T::UUID32_COMPLETE == static_cast<GAP_T>(elem_type) );
+            for(jau::nsize_t j=0; j<elem_len/2; j++) {
+                addService( UUIDPool::get(elem_data + j*2, jau::uuid_t::TypeSize::UUID16_SZ) );
+            }
+            break;
 
-        // Guaranteed: elem_len >= 0!
-        switch ( static_cast<GAP_T>(elem_type) ) {
-            case GAP_T::FLAGS:
-                if( 1 <= elem_len ) {
-                    setFlags(static_cast<GAPFlags>(*elem_data));
-                }
-                break;
+        case GAP_T::UUID32_INCOMPLETE:
+            [[fallthrough]];
+        case GAP_T::UUID32_COMPLETE:
+            setServicesComplete( GAP_T::UUID32_COMPLETE == static_cast<GAP_T>(elem_type) );
+            for(jau::nsize_t j=0; j<elem_len/4; j++) {
+                addService( UUIDPool::get(elem_data + j*4, jau::uuid_t::TypeSize::UUID32_SZ) );
+            }
+            break;
 
-            case GAP_T::UUID16_INCOMPLETE:
-                [[fallthrough]];
-            case GAP_T::UUID16_COMPLETE:
-                setServicesComplete( GAP_T::UUID32_COMPLETE == static_cast<GAP_T>(elem_type) );
-                for(jau::nsize_t j=0; j<elem_len/2; j++) {
-                    const std::shared_ptr<const jau::uuid_t> uuid( std::make_shared<const jau::uuid16_t>(elem_data + j*2, jau::lb_endian_t::little) );
-                    addService( uuid );
-                }
-                break;
+        case GAP_T::UUID128_INCOMPLETE:
+            [[fallthrough]];
+        case GAP_T::UUID128_COMPLETE:
+            setServicesComplete( GAP_T::UUID32_COMPLETE == static_cast<GAP_T>(elem_type) );
+            for(jau::nsize_t j=0; j<elem_len/16; j++) {
+                addService( UUIDPool::get(elem_data + j*16, jau::uuid_t::TypeSize::UUID128_SZ) );
+            }
+            break;
 
-            case GAP_T::UUID32_INCOMPLETE:
-                [[fallthrough]];
-            case GAP_T::UUID32_COMPLETE:
-                setServicesComplete( GAP_T::UUID32_COMPLETE == static_cast<GAP_T>(elem_type) );
-                for(jau::nsize_t j=0; j<elem_len/4; j++) {
-                    const std::shared_ptr<const jau::uuid_t> uuid( std::make_shared<const jau::uuid32_t>(elem_data + j*4, jau::lb_endian_t::little) );
-                    addService( uuid );
-                }
-                break;
+        case GAP_T::NAME_LOCAL_SHORT:
+            // INFO: Bluetooth Core Specification V5.2 [Vol. 3, Part C, 8, p 1341]
+            // INFO: A remote name request is required to obtain the full name, if needed.
+            setShortName(elem_data, elem_len);
+            break;
 
-            case GAP_T::UUID128_INCOMPLETE:
-                [[fallthrough]];
-            case GAP_T::UUID128_COMPLETE:
-                setServicesComplete( GAP_T::UUID32_COMPLETE == static_cast<GAP_T>(elem_type) );
-                for(jau::nsize_t j=0; j<elem_len/16; j++) {
-                    const std::shared_ptr<const jau::uuid_t> uuid( std::make_shared<const jau::uuid128_t>(elem_data + j*16, jau::lb_endian_t::little) );
-                    addService( uuid );
-                }
-                break;
+        case GAP_T::NAME_LOCAL_COMPLETE:
+            setName(elem_data, elem_len);
+            break;
 
-            case GAP_T::NAME_LOCAL_SHORT:
-                // INFO: Bluetooth Core Specification V5.2 [Vol. 3, Part C, 8, p 1341]
-                // INFO: A remote name request is required to obtain the full name, if needed.
-                setShortName(elem_data, elem_len);
-                break;
+        case GAP_T::TX_POWER_LEVEL:
+            if( 1 <= elem_len ) {
+                setTxPower(*const_uint8_to_const_int8_ptr(elem_data));
+            }
+            break;
 
-            case GAP_T::NAME_LOCAL_COMPLETE:
-                setName(elem_data, elem_len);
-                break;
+        case GAP_T::SSP_CLASS_OF_DEVICE:
+            if( 3 <= elem_len ) {
+                setDeviceClass(  elem_data[0] |
+                               ( elem_data[1] << 8 ) |
+                               ( elem_data[2] << 16 ) );
+            }
+            break;
 
-            case GAP_T::TX_POWER_LEVEL:
-                if( 1 <= elem_len ) {
-                    setTxPower(*const_uint8_to_const_int8_ptr(elem_data));
-                }
-                break;
+        case GAP_T::DEVICE_ID:
+            if( 8 <= elem_len ) {
+                setDeviceID(
+                    elem_data[0] | ( elem_data[1] << 8 ), // source
+                    elem_data[2] | ( elem_data[3] << 8 ), // vendor
+                    elem_data[4] | ( elem_data[5] << 8 ), // product
+                    elem_data[6] | ( elem_data[7] << 8 )); // version
+            }
+            break;
 
-            case GAP_T::SSP_CLASS_OF_DEVICE:
-                if( 3 <= elem_len ) {
-                    setDeviceClass(  elem_data[0] |
-                                   ( elem_data[1] << 8 ) |
-                                   ( elem_data[2] << 16 ) );
-                }
-                break;
+        case GAP_T::SLAVE_CONN_IVAL_RANGE:
+            if( 4 <= elem_len ) {
+                const uint16_t min = jau::get_uint16(elem_data + 0, jau::lb_endian_t::little);
+                const uint16_t max = jau::get_uint16(elem_data + 2, jau::lb_endian_t::little);
+                setConnInterval(min, max);
+            }
+            break;
 
-            case GAP_T::DEVICE_ID:
-                if( 8 <= elem_len ) {
-                    setDeviceID(
-                        data[0] | ( data[1] << 8 ), // source
-                        data[2] | ( data[3] << 8 ), // vendor
-                        data[4] | ( data[5] << 8 ), // product
-                        data[6] | ( data[7] << 8 )); // version
-                }
-                break;
+        case GAP_T::SOLICIT_UUID16:
+            [[fallthrough]];
+        case GAP_T::SOLICIT_UUID128:
+            [[fallthrough]];
+        case GAP_T::SVC_DATA_UUID16:
+            [[fallthrough]];
+        case GAP_T::PUB_TRGT_ADDR:
+            [[fallthrough]];
+        case GAP_T::RND_TRGT_ADDR:
+            break;
 
-            case GAP_T::SLAVE_CONN_IVAL_RANGE:
-                if( 4 <= elem_len ) {
-                    const uint16_t min = jau::get_uint16(elem_data + 0, jau::lb_endian_t::little);
-                    const uint16_t max = jau::get_uint16(elem_data + 2, jau::lb_endian_t::little);
-                    setConnInterval(min, max);
-                }
-                break;
+        case GAP_T::GAP_APPEARANCE:
+            if( 2 <= elem_len ) {
+                setAppearance(static_cast<AppearanceCat>( jau::get_uint16(elem_data + 0, jau::lb_endian_t::little) ));
+            }
+            break;
 
-            case GAP_T::SOLICIT_UUID16:
-                [[fallthrough]];
-            case GAP_T::SOLICIT_UUID128:
-                [[fallthrough]];
-            case GAP_T::SVC_DATA_UUID16:
-                [[fallthrough]];
-            case GAP_T::PUB_TRGT_ADDR:
-                [[fallthrough]];
-            case GAP_T::RND_TRGT_ADDR:
-                break;
+        case GAP_T::SSP_HASH_C192:
+            if( 16 <= elem_len ) {
+                setHash(elem_data);
+            }
+            break;
 
-            case GAP_T::GAP_APPEARANCE:
-                if( 2 <= elem_len ) {
-                    setAppearance(static_cast<AppearanceCat>( jau::get_uint16(elem_data + 0, jau::lb_endian_t::little) ));
-                }
-                break;
+        case GAP_T::SSP_RANDOMIZER_R192:
+            if( 16 <= elem_len ) {
+                setRandomizer(elem_data);
+            }
+            break;
 
-            case GAP_T::SSP_HASH_C192:
-                if( 16 <= elem_len ) {
-                    setHash(elem_data);
-                }
-                break;
+        case GAP_T::SOLICIT_UUID32:
+            [[fallthrough]];
+        case GAP_T::SVC_DATA_UUID32:
+            [[fallthrough]];
+        case GAP_T::SVC_DATA_UUID128:
+            break;
 
-            case GAP_T::SSP_RANDOMIZER_R192:
-                if( 16 <= elem_len ) {
-                    setRandomizer(elem_data);
-                }
-                break;
+        case GAP_T::MANUFACTURE_SPECIFIC:
+            if( 2 <= elem_len ) {
+                const uint16_t company = jau::get_uint16(elem_data + 0, jau::lb_endian_t::little);
+                const int data_size = elem_len-2;
+                setManufactureSpecificData(company, data_size > 0 ? elem_data+2 : nullptr, data_size);
+            }
+            break;
 
-            case GAP_T::SOLICIT_UUID32:
-                [[fallthrough]];
-            case GAP_T::SVC_DATA_UUID32:
-                [[fallthrough]];
-            case GAP_T::SVC_DATA_UUID128:
-                break;
+        default:
+            // FIXME: Use a data blob!!!!
+            DBG_PRINT("%s-Element: Unhandled type 0x%.2X with %d bytes net\n",
+                      to_string(source).c_str(), elem_type, elem_len);
+            break;
+    }
+}
 
-            case GAP_T::MANUFACTURE_SPECIFIC:
-                if( 2 <= elem_len ) {
-                    const uint16_t company = jau::get_uint16(elem_data + 0, jau::lb_endian_t::little);
-                    const int data_size = elem_len-2;
-                    setManufactureSpecificData(company, data_size > 0 ? elem_data+2 : nullptr, data_size);
-                }
-                break;
+int EInfoReport::read_data(uint8_t const * data, jau::nsize_t const data_length) noexcept {
+    int count = 0;
+    int offset = 0;
+    uint8_t elem_len, elem_type;
+    uint8_t const *elem_data;
 
-            default:
-                // FIXME: Use a data blob!!!!
-                DBG_PRINT("%s-Element @ [%d/%d]: Unhandled type 0x%.2X with %d bytes net\n",
-                          to_string(source).c_str(), offset, data_length, elem_type, elem_len);
-                break;
+    while( 0 < ( offset = next_data_elem( &elem_len, &elem_type, &elem_data, data, offset, data_length ) ) )
+    {
+        count++;
+        read_elem(elem_type, elem_data, elem_len);
+    }
+    return count;
+}
+
+int EInfoReport::read_data(const ADStructIndex& index, const EIRDataType select) noexcept {
+    int count = 0;
+    for(jau::nsize_t i=0; i<index.size(); ++i) {
+        const ADStructIndex::Elem& e = index[i];
+        if( EIRDataType::ALL == select || EIRDataType::NONE != ( ad_elem_mask(e.type, e.len) & select ) ) {
+            read_elem(e.type, index.getData() + e.offset, e.len);
+            count++;
+        }
+    }
+    if( index.isTruncated() ) {
+        int offset = static_cast<int>( index.end_offset );
+        uint8_t elem_len, elem_type;
+        uint8_t const *elem_data;
+        while( 0 < ( offset = next_data_elem( &elem_len, &elem_type, &elem_data, index.getData(), offset, index.getDataSize() ) ) ) {
+            if( EIRDataType::ALL == select || EIRDataType::NONE != ( ad_elem_mask(elem_type, elem_len) & select ) ) {
+                read_elem(elem_type, elem_data, elem_len);
+                count++;
+            }
         }
     }
     return count;
 }
 
+jau::nsize_t ADStructIndex::scan(uint8_t const * data_, jau::nsize_t const data_length) noexcept {
+    data = data_;
+    data_len = data_length;
+    end_offset = 0;
+    count = 0;
+    truncated = false;
+    type_set[0] = 0; type_set[1] = 0; type_set[2] = 0; type_set[3] = 0;
+
+    jau::nsize_t offset = 0;
+    while( offset + 1 < data_length ) {
+        const uint8_t len = data[offset]; // covers: type + data, less len field itself
+        if( 0 == len || offset + 1 + len > data_length ) {
+            break; // end of significant part or malformed
+        }
+        const uint8_t type = data[offset + 1];
+        type_set[type >> 6] |= 1ULL << ( type & 63 );
+        if( count < MAX_ELEMS ) {
+            elems[count++] = { static_cast<uint16_t>( offset + 2 ), type, static_cast<uint8_t>( len - 1 ) };
+            end_offset = offset + 1 + len;
+        } else {
+            truncated = true;
+        }
+        offset += 1 + len;
+    }
+    return count;
+}
+
+bool ADStructIndex::find(const GAP_T type, uint8_t const ** elem_data, uint8_t * elem_len) const noexcept {
+    if( !has(type) ) {
+        return false;
+    }
+    const uint8_t t = number(type);
+    for(jau::nsize_t i=0; i<count; ++i) {
+        if( t == elems[i].type ) {
+            *elem_data = data + elems[i].offset;
+            *elem_len = elems[i].len;
+            return true;
+        }
+    }
+    if( truncated ) {
+        int offset = static_cast<int>( end_offset );
+        uint8_t len, t2;
+        uint8_t const *d;
+        while( 0 < ( offset = EInfoReport::next_data_elem( &len, &t2, &d, data, offset, data_len ) ) ) {
+            if( t == t2 ) {
+                *elem_data = d;
+                *elem_len = len;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+EIRDataType ADStructIndex::getEIRDataMask() const noexcept {
+    EIRDataType mask = EIRDataType::NONE;
+    for(jau::nsize_t i=0; i<count; ++i) {
+        mask = mask | ad_elem_mask(elems[i].type, elems[i].len);
+    }
+    if( truncated ) {
+        int offset = static_cast<int>( end_offset );
+        uint8_t len, t;
+        uint8_t const *d;
+        while( 0 < ( offset = EInfoReport::next_data_elem( &len, &t, &d, data, offset, data_len ) ) ) {
+            mask = mask | ad_elem_mask(t, len);
+        }
+    }
+    return mask;
+}
+
+std::string ADStructIndex::toString() const noexcept {
+    std::string out("ADStructIndex[size "+std::to_string(data_len)+", elems "+std::to_string(count)+(truncated ? "+" : "")+": ");
+    for(jau::nsize_t i=0; i<count; ++i) {
+        if( 0 < i ) {
+            out.append(", ");
+        }
+        out.append(jau::to_hexstring(elems[i].type)).append("/").append(std::to_string(elems[i].len));
+    }
+    out.append("]");
+    return out;
+}
+
 #define _WARN_OOB(a) DBG_PRINT("%s: Out of buffer: count %zd + 1 + ad_sz %zd > data_len %zd -> drop %s\n", (a), count, ad_sz, data_length, toString(true).c_str());
 
 jau::nsize_t EInfoReport::write_data(EIRDataType write_mask, uint8_t * data, jau::nsize_t const data_length) const noexcept {
@@ -1172,7 +1360,7 @@ jau::nsize_t EInfoReport::write_data(EIRDataType write_mask, uint8_t * data, jau
         count    += ad_sz + 1;
         *data_i++ = ad_sz;
         *data_i++ = direct_bt::number( GAP_T::NAME_LOCAL_COMPLETE );
-        memcpy(data_i, name.c_str(), ad_sz-1);
+        memcpy(data_i, name.data(), ad_sz-1);
         data_i   += ad_sz-1;
     } else if( is_set(mask, EIRDataType::NAME_SHORT) ) {
         const jau::nsize_t ad_sz = 1 + name_short.size();
@@ -1183,7 +1371,7 @@ jau::nsize_t EInfoReport::write_data(EIRDataType write_mask, uint8_t * data, jau
         count    += ad_sz + 1;
         *data_i++ = ad_sz;
         *data_i++ = direct_bt::number( GAP_T::NAME_LOCAL_SHORT );
-        memcpy(data_i, name_short.c_str(), ad_sz-1);
+        memcpy(data_i, name_short.data(), ad_sz-1);
         data_i   += ad_sz-1;
     }
     if( is_set(mask, EIRDataType::MANUF_DATA) && nullptr != msd ) {
@@ -1347,67 +1535,271 @@ EInfoReport::Source EInfoReport::toSource(const EAD_Event_Type type) {
 
 
 jau::darray<std::unique_ptr<EInfoReport>> EInfoReport::read_ad_reports(uint8_t const * data, jau::nsize_t const data_length) noexcept {
+    jau::darray<EInfoReportView> views;
+    EInfoReportView::read_ad_reports(data, data_length, views);
+    jau::darray<std::unique_ptr<EInfoReport>> ad_reports(views.size());
+    for(const EInfoReportView& v : views) {
+        ad_reports.push_back( v.materialize() );
+    }
+    return ad_reports;
+}
+
+jau::darray<std::unique_ptr<EInfoReport>> EInfoReport::read_ext_ad_reports(uint8_t const * data, jau::nsize_t const data_length) noexcept {
+    jau::darray<EInfoReportView> views;
+    EInfoReportView::read_ext_ad_reports(data, data_length, views);
+    jau::darray<std::unique_ptr<EInfoReport>> ad_reports(views.size());
+    for(const EInfoReportView& v : views) {
+        ad_reports.push_back( v.materialize() );
+    }
+    return ad_reports;
+}
+
+// *************************************************
+// *************************************************
+// *************************************************
+
+bool EInfoReportView::find(const GAP_T type, uint8_t const ** elem_data, uint8_t * elem_len) const noexcept {
+    return ad_index.find(type, elem_data, elem_len);
+}
+
+EIRDataType EInfoReportView::getEIRDataMask() const noexcept {
+    EIRDataType mask = EIRDataType::BDADDR_TYPE | EIRDataType::BDADDR | EIRDataType::RSSI;
+    if( source_ext ) {
+        mask = mask | EIRDataType::EXT_EVT_TYPE | EIRDataType::TX_POWER;
+        if( is_set(ead_type, EAD_Event_Type::LEGACY_PDU) ) {
+            mask = mask | EIRDataType::EVT_TYPE;
+        }
+    } else {
+        mask = mask | EIRDataType::EVT_TYPE;
+    }
+    return mask | ad_index.getEIRDataMask(); // mirrors EInfoReport::read_data()
+}
+
+GAPFlags EInfoReportView::getFlags() const noexcept {
+    uint8_t const *d;
+    uint8_t len;
+    if( find(GAP_T::FLAGS, &d, &len) && 1 <= len ) {
+        return static_cast<GAPFlags>(*d);
+    }
+    return GAPFlags::NONE;
+}
+
+std::string_view EInfoReportView::getName() const noexcept {
+    uint8_t const *d;
+    uint8_t len;
+    if( find(GAP_T::NAME_LOCAL_COMPLETE, &d, &len) ) {
+        return std::string_view(reinterpret_cast<const char*>(d), get_name_len(d, len));
+    }
+    return std::string_view();
+}
+
+std::string_view EInfoReportView::getShortName() const noexcept {
+    uint8_t const *d;
+    uint8_t len;
+    if( find(GAP_T::NAME_LOCAL_SHORT, &d, &len) ) {
+        return std::string_view(reinterpret_cast<const char*>(d), get_name_len(d, len));
+    }
+    return std::string_view();
+}
+
+int8_t EInfoReportView::getTxPower() const noexcept {
+    uint8_t const *d;
+    uint8_t len;
+    if( find(GAP_T::TX_POWER_LEVEL, &d, &len) && 1 <= len ) {
+        return *const_uint8_to_const_int8_ptr(d);
+    }
+    return tx_power;
+}
+
+bool EInfoReportView::hasService(const jau::uuid_t& uuid) const noexcept {
+    if( !ad_index.has(GAP_T::UUID16_INCOMPLETE) && !ad_index.has(GAP_T::UUID16_COMPLETE) &&
+        !ad_index.has(GAP_T::UUID32_INCOMPLETE) && !ad_index.has(GAP_T::UUID32_COMPLETE) &&
+        !ad_index.has(GAP_T::UUID128_INCOMPLETE) && !ad_index.has(GAP_T::UUID128_COMPLETE) )
+    {
+        return false;
+    }
+    bool res = false;
+    ad_index.for_each([&](const uint8_t t, uint8_t const * d, const uint8_t len) -> bool {
+        switch( static_cast<GAP_T>(t) ) {
+            case GAP_T::UUID16_INCOMPLETE:
+                [[fallthrough]];
+            case GAP_T::UUID16_COMPLETE:
+                for(jau::nsize_t j=0; !res && j<len/2; j++) {
+                    res = uuid.equivalent( jau::uuid16_t(d + j*2, jau::lb_endian_t::little) );
+                }
+                break;
+            case GAP_T::UUID32_INCOMPLETE:
+                [[fallthrough]];
+            case GAP_T::UUID32_COMPLETE:
+                for(jau::nsize_t j=0; !res && j<len/4; j++) {
+                    res = uuid.equivalent( jau::uuid32_t(d + j*4, jau::lb_endian_t::little) );
+                }
+                break;
+            case GAP_T::UUID128_INCOMPLETE:
+                [[fallthrough]];
+            case GAP_T::UUID128_COMPLETE:
+                for(jau::nsize_t j=0; !res && j<len/16; j++) {
+                    res = uuid.equivalent( jau::uuid128_t(d + j*16, jau::lb_endian_t::little) );
+                }
+                break;
+            default:
+                break;
+        }
+        return !res; // continue until found
+    });
+    return res;
+}
+
+bool EInfoReportView::getManufactureSpecificData(uint16_t& company, uint8_t const ** msd_data, jau::nsize_t& msd_len) const noexcept {
+    uint8_t const *d;
+    uint8_t len;
+    if( find(GAP_T::MANUFACTURE_SPECIFIC, &d, &len) && 2 <= len ) {
+        company = jau::get_uint16(d + 0, jau::lb_endian_t::little);
+        msd_len = len - 2;
+        *msd_data = 0 < msd_len ? d + 2 : nullptr;
+        return true;
+    }
+    return false;
+}
+
+uint64_t EInfoReportView::getFingerprint() const noexcept {
+    uint64_t h = 14695981039346656037ULL;
+    h = ( h ^ direct_bt::number(evt_type) ) * 1099511628211ULL;
+    h = ( h ^ direct_bt::number(ead_type) ) * 1099511628211ULL;
+    h = ( h ^ data_len ) * 1099511628211ULL;
+    for(jau::nsize_t i=0; i<data_len; ++i) {
+        h = ( h ^ data[i] ) * 1099511628211ULL;
+    }
+    return 0 != h ? h : 1;
+}
+
+int ADFingerprint::index(const EInfoReport::Source source) noexcept {
+    switch( source ) {
+        case EInfoReport::Source::AD_IND: return 0;
+        case EInfoReport::Source::AD_SCAN_RSP: return 1;
+        default: return -1;
+    }
+}
+
+void ADFingerprint::reset(const EInfoReport::Source source) noexcept {
+    const int idx = index(source);
+    if( 0 <= idx ) {
+        fingerprint[idx] = 0;
+    }
+}
+
+void ADFingerprint::set(EInfoReportView const & view) noexcept {
+    const int idx = index(view.getSource());
+    if( 0 <= idx ) {
+        fingerprint[idx] = view.getFingerprint();
+    }
+}
+
+bool ADFingerprint::updateUnchanged(EInfoReportView const & view, int8_t& rssi, int8_t& tx_power, EIRDataType& res) const noexcept {
+    const int idx = index(view.getSource());
+    if( 0 > idx || 0 == fingerprint[idx] || view.getFingerprint() != fingerprint[idx] ) {
+        return false;
+    }
+    res = EIRDataType::NONE;
+    if( rssi != view.getRSSI() ) {
+        rssi = view.getRSSI();
+        direct_bt::set(res, EIRDataType::RSSI);
+    }
+    if( view.getSourceExt() ) {
+        // EAD header TX power is not part of the AD payload
+        const int8_t tx_power_ = view.getTxPower();
+        if( tx_power != tx_power_ ) {
+            tx_power = tx_power_;
+            direct_bt::set(res, EIRDataType::TX_POWER);
+        }
+    }
+    return true;
+}
+
+std::unique_ptr<EInfoReport> EInfoReportView::materialize() const noexcept {
+    std::unique_ptr<EInfoReport> eir = std::make_unique<EInfoReport>();
+    eir->setSource(source, source_ext);
+    eir->setTimestamp(timestamp);
+    if( source_ext ) {
+        eir->setExtEvtType(ead_type);
+        if( is_set(ead_type, EAD_Event_Type::LEGACY_PDU) ) {
+            eir->setEvtType(evt_type);
+        }
+        eir->setTxPower(tx_power); // AD data's TX_POWER_LEVEL overrides
+    } else {
+        eir->setEvtType(evt_type);
+    }
+    eir->setADAddressType(ad_address_type);
+    eir->setAddress(address);
+    eir->setRSSI(rssi);
+    if( 0 < data_len ) {
+        eir->read_data(ad_index, EIRDataType::ALL); // w/o walking the AD structures again
+    }
+    return eir;
+}
+
+std::string EInfoReportView::toString() const noexcept {
+    const std::string source_ext_s = source_ext ? "bt5" : "bt4";
+    return "EInfoReportView["+to_string(source)+", "+source_ext_s+", address["+address.toString()+", "+to_string(getAddressType())+"/"+std::to_string(ad_address_type)+
+           "], type[evt "+to_string(evt_type)+", ead "+to_string(ead_type)+"], rssi "+std::to_string(rssi)+", ad-size "+std::to_string(data_len)+"]";
+}
+
+jau::nsize_t EInfoReportView::read_ad_reports(uint8_t const * data, jau::nsize_t const data_length, jau::darray<EInfoReportView>& dest) noexcept {
     jau::nsize_t const num_reports = (jau::nsize_t) data[0];
-    jau::darray<std::unique_ptr<EInfoReport>> ad_reports;
+    jau::nsize_t const dest_size0 = dest.size();
 
     if( 0 == num_reports || num_reports > 0x19 ) {
         DBG_PRINT("AD-Reports: Invalid reports count: %d", num_reports);
-        return ad_reports;
+        return 0;
     }
     uint8_t const *limes = data + data_length;
     uint8_t const *i_octets = data + 1;
-    uint8_t ad_data_len[0x19];
     jau::nsize_t i;
     const uint64_t timestamp = jau::getCurrentMilliseconds();
 
     const int seg4_size = 1 + 1 + 6 + 1;
 
     for(i = 0; i < num_reports && i_octets < limes; i++) { // seg 1
-        ad_reports.push_back( std::make_unique<EInfoReport>() );
-        ad_reports[i]->setSource(Source::AD_IND, false /* ext */); // first guess
-        ad_reports[i]->setTimestamp(timestamp);
+        EInfoReportView v;
+        v.source_ext = false;
+        v.timestamp = timestamp;
 
         if( i_octets + seg4_size > limes ) {
             const jau::snsize_t bytes_left = static_cast<jau::snsize_t>(limes - i_octets);
             WARN_PRINT("AD-Reports: Insufficient data length (1) %zu: report %zu/%zu: min_data_len %zu > bytes-left %zu (Drop)",
                     data_length, i, num_reports, seg4_size, bytes_left);
-            ad_reports.pop_back();
             goto errout;
         }
 
         // seg 1: 1
-        {
-            const AD_PDU_Type ad_type = static_cast<AD_PDU_Type>(*i_octets++);
-            ad_reports[i]->setEvtType( ad_type );
-            ad_reports[i]->setSource( toSource( ad_type ), false /* ext */);
-        }
+        v.evt_type = static_cast<AD_PDU_Type>(*i_octets++);
+        v.source = EInfoReport::toSource( v.evt_type );
 
         // seg 2: 1
-        ad_reports[i]->setADAddressType(*i_octets++);
+        v.ad_address_type = *i_octets++;
 
         // seg 3: 6
-        ad_reports[i]->setAddress( jau::le_to_cpu( *((jau::EUI48 const *)i_octets) ) );
+        v.address = jau::le_to_cpu( *((jau::EUI48 const *)i_octets) );
         i_octets += 6;
 
         // seg 4: 1
-        ad_data_len[i] = *i_octets++;
+        v.data_len = *i_octets++;
 
         // seg 5: ADV Response Data (EIR)
-        if( i_octets + ad_data_len[i] + 1 > limes ) {
+        if( i_octets + v.data_len + 1 > limes ) {
             const jau::snsize_t bytes_left = static_cast<jau::snsize_t>(limes - i_octets);
             WARN_PRINT("AD-Reports: Insufficient data length (2) %zu: report %zu/%zu: eir_data_len + rssi %zu > bytes-left %zu (Drop)",
-                    data_length, i, num_reports, (ad_data_len[i] + 1), bytes_left);
-            ad_reports.pop_back();
+                    data_length, i, num_reports, (v.data_len + 1), bytes_left);
             goto errout;
         }
-        if( 0 < ad_data_len[i] ) {
-            ad_reports[i]->read_data(i_octets, ad_data_len[i]);
-            i_octets += ad_data_len[i];
-        }
+        v.setData(0 < v.data_len ? i_octets : nullptr, v.data_len);
+        i_octets += v.data_len;
 
         // seg 6: 1
-        ad_reports[i]->setRSSI(*const_uint8_to_const_int8_ptr(i_octets));
+        v.rssi = *const_uint8_to_const_int8_ptr(i_octets);
         i_octets++;
+
+        dest.push_back(v);
     }
 
 errout:
@@ -1424,63 +1816,57 @@ errout:
                     num_reports, bytes_took, bytes_left, data_length);
         }
         if( jau::environment::get().debug ) {
-            for(i=0; i<num_reports; i++) {
-                jau::INFO_PRINT("AD[%d]: ad_data_length %d, %s\n", (int)i, (int)ad_data_len[i], ad_reports[i]->toString(false).c_str());
+            for(i=dest_size0; i<dest.size(); i++) {
+                jau::INFO_PRINT("AD[%d]: %s\n", (int)(i-dest_size0), dest[i].toString().c_str());
             }
         }
 #endif
     }
-    return ad_reports;
+    return dest.size() - dest_size0;
 }
 
-jau::darray<std::unique_ptr<EInfoReport>> EInfoReport::read_ext_ad_reports(uint8_t const * data, jau::nsize_t const data_length) noexcept {
+jau::nsize_t EInfoReportView::read_ext_ad_reports(uint8_t const * data, jau::nsize_t const data_length, jau::darray<EInfoReportView>& dest) noexcept {
     jau::nsize_t const num_reports = (jau::nsize_t) data[0];
-    jau::darray<std::unique_ptr<EInfoReport>> ad_reports;
+    jau::nsize_t const dest_size0 = dest.size();
 
     if( 0 == num_reports || num_reports > 0x19 ) {
         DBG_PRINT("EAD-Reports: Invalid reports count: %d", num_reports);
-        return ad_reports;
+        return 0;
     }
     uint8_t const *limes = data + data_length;
     uint8_t const *i_octets = data + 1;
-    uint8_t ad_data_len[0x19];
     jau::nsize_t i;
     const uint64_t timestamp = jau::getCurrentMilliseconds();
 
     const int seg12_size = 2 + 1 + 6 + 1 + 1 + 1 + 1 + 1 + 2 + 1 + 6 + 1;
 
     for(i = 0; i < num_reports; i++) {
-        ad_reports.push_back( std::make_unique<EInfoReport>() );
-        ad_reports[i]->setSource( Source::AD_IND, true /* ext */); // first guess
-        ad_reports[i]->setTimestamp(timestamp);
+        EInfoReportView v;
+        v.source_ext = true;
+        v.timestamp = timestamp;
 
         if( i_octets + seg12_size > limes ) {
             const jau::snsize_t bytes_left = static_cast<jau::snsize_t>(limes - i_octets);
             WARN_PRINT("EAD-Reports: Insufficient data length (1) %zu: report %zu/%zu: min_data_len %zu > bytes-left %zu (Drop)",
                     data_length, i, num_reports, seg12_size, bytes_left);
-            ad_reports.pop_back();
             goto errout;
         }
 
         // seg 1: 2
-        {
-            const EAD_Event_Type ead_type = static_cast<EAD_Event_Type>(jau::get_uint16(i_octets + 0, jau::lb_endian_t::little));
-            ad_reports[i]->setExtEvtType(ead_type);
-            i_octets+=2;
-            if( is_set(ead_type, EAD_Event_Type::LEGACY_PDU) ) {
-                const AD_PDU_Type ad_type = static_cast<AD_PDU_Type>( ::number(ead_type) );
-                ad_reports[i]->setEvtType( ad_type );
-                ad_reports[i]->setSource( toSource( ad_type ), true /* ext */);
-            } else {
-                ad_reports[i]->setSource( toSource( ead_type ), true /* ext */);
-            }
+        v.ead_type = static_cast<EAD_Event_Type>(jau::get_uint16(i_octets + 0, jau::lb_endian_t::little));
+        i_octets+=2;
+        if( is_set(v.ead_type, EAD_Event_Type::LEGACY_PDU) ) {
+            v.evt_type = static_cast<AD_PDU_Type>( ::number(v.ead_type) );
+            v.source = EInfoReport::toSource( v.evt_type );
+        } else {
+            v.source = EInfoReport::toSource( v.ead_type );
         }
 
         // seg 2: 1
-        ad_reports[i]->setADAddressType(*i_octets++);
+        v.ad_address_type = *i_octets++;
 
         // seg 3: 6
-        ad_reports[i]->setAddress( jau::le_to_cpu( *((jau::EUI48 const *)i_octets) ) );
+        v.address = jau::le_to_cpu( *((jau::EUI48 const *)i_octets) );
         i_octets += 6;
 
         // seg 4: 1
@@ -1492,15 +1878,15 @@ jau::darray<std::unique_ptr<EInfoReport>> EInfoReport::read_ext_ad_reports(uint8
         i_octets++;
 
         // seg 6: 1
-        // Advertising_SID (TODO)
-        i_octets++;
+        // Advertising_SID
+        v.adv_sid = *i_octets++;
 
         // seg 7: 1
-        ad_reports[i]->setTxPower(*const_uint8_to_const_int8_ptr(i_octets));
+        v.tx_power = *const_uint8_to_const_int8_ptr(i_octets);
         i_octets++;
 
         // seg 8: 1
-        ad_reports[i]->setRSSI(*const_uint8_to_const_int8_ptr(i_octets));
+        v.rssi = *const_uint8_to_const_int8_ptr(i_octets);
         i_octets++;
 
         // seg 9: 2
@@ -1516,20 +1902,19 @@ jau::darray<std::unique_ptr<EInfoReport>> EInfoReport::read_ext_ad_reports(uint8
         i_octets+=6;
 
         // seg 12: 1
-        ad_data_len[i] = *i_octets++;
+        v.data_len = *i_octets++;
 
         // seg 13: ADV Response Data (EIR)
-        if( i_octets + ad_data_len[i] > limes ) {
+        if( i_octets + v.data_len > limes ) {
             const jau::snsize_t bytes_left = static_cast<jau::snsize_t>(limes - i_octets);
             WARN_PRINT("EAD-Reports: Insufficient data length (2) %zu: report %zu/%zu: eir_data_len %zu > bytes-left %zu (Drop)",
-                    data_length, i, num_reports, ad_data_len[i], bytes_left);
-            ad_reports.pop_back();
+                    data_length, i, num_reports, v.data_len, bytes_left);
             goto errout;
         }
-        if( 0 < ad_data_len[i] ) {
-            ad_reports[i]->read_data(i_octets, ad_data_len[i]);
-            i_octets += ad_data_len[i];
-        }
+        v.setData(0 < v.data_len ? i_octets : nullptr, v.data_len);
+        i_octets += v.data_len;
+
+        dest.push_back(v);
     }
 
 errout:
@@ -1546,13 +1931,13 @@ errout:
                     num_reports, bytes_took, bytes_left, data_length);
         }
         if( jau::environment::get().debug ) {
-            for(i=0; i<num_reports; i++) {
-                jau::INFO_PRINT("EAD[%d]: ad_data_length %d, %s\n", (int)i, (int)ad_data_len[i], ad_reports[i]->toString(false).c_str());
+            for(i=dest_size0; i<dest.size(); i++) {
+                jau::INFO_PRINT("EAD[%d]: %s\n", (int)(i-dest_size0), dest[i].toString().c_str());
             }
         }
 #endif
     }
-    return ad_reports;
+    return dest.size() - dest_size0;
 }
 
 // *************************************************
@@ -0,0 +1,185 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+#include <jau/debug.hpp>
+
+#include "EADReassembly.hpp"
+
+extern "C" {
+    #include <inttypes.h>
+}
+
+using namespace direct_bt;
+
+EADReassembly::EADReassembly(const jau::fraction_i64& timeout, const jau::nsize_t budget_) noexcept
+: timeout_ms( static_cast<uint64_t>( timeout.to_ms() ) ),
+  budget( std::max(MAX_DATA_SIZE, budget_) ),
+  pending_bytes(0),
+  count_fragments(0), count_completed(0), count_truncated(0), count_dropped(0), count_discarded(0)
+{ }
+
+void EADReassembly::drop(const jau::nsize_t idx, const uint64_t now) noexcept {
+    Chain& c = pending[idx];
+    DBG_PRINT("EADReassembly: Drop chain %s, sid %u, %zu bytes",
+              c.address.toString().c_str(), c.sid, c.data.size());
+    pending_bytes -= c.data.size();
+    if( MAX_TOMBSTONES <= tombstones.size() ) {
+        tombstones.erase(tombstones.cbegin());
+    }
+    tombstones.push_back( Chain { c.address, c.ad_address_type, c.sid, c.scan_rsp, now, std::vector<uint8_t>() } );
+    pending.erase(pending.cbegin() + idx);
+    ++count_dropped;
+}
+
+void EADReassembly::expire(const uint64_t now) noexcept {
+    for(jau::nsize_t i = 0; i < pending.size(); ) {
+        if( pending[i].ts_last + timeout_ms < now ) {
+            drop(i, now);
+        } else {
+            ++i;
+        }
+    }
+    for(jau::nsize_t i = 0; i < tombstones.size(); ) {
+        if( tombstones[i].ts_last + timeout_ms < now ) {
+            tombstones.erase(tombstones.cbegin() + i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+bool EADReassembly::append(const jau::nsize_t idx, const EInfoReportView& v, const uint64_t now) noexcept {
+    const jau::nsize_t n = v.getDataSize();
+    if( pending[idx].data.size() + n > MAX_DATA_SIZE ) {
+        drop(idx, now);
+        return false;
+    }
+    // evict oldest other chains exceeding the budget
+    jau::nsize_t i = idx;
+    while( pending_bytes + n > budget && 1 < pending.size() ) {
+        drop( 0 == i ? 1 : 0, now );
+        if( 0 < i ) {
+            --i;
+        }
+    }
+    Chain& c = pending[i];
+    c.data.insert(c.data.end(), v.getData(), v.getData() + n);
+    c.ts_last = now;
+    pending_bytes += n;
+    ++count_fragments;
+    return true;
+}
+
+void EADReassembly::process(jau::darray<EInfoReportView>& views, const jau::nsize_t begin, const uint64_t now) noexcept {
+    completed.clear(); // release previously emitted payloads
+    if( !pending.empty() || !tombstones.empty() ) {
+        expire(now);
+    }
+    jau::nsize_t k = begin;
+    for(jau::nsize_t i = begin; i < views.size(); ++i) {
+        EInfoReportView& v = views[i];
+        const EAD_DataStatus status = v.getDataStatus();
+        if( !v.getSourceExt() || is_set(v.getExtEvtType(), EAD_Event_Type::LEGACY_PDU) || EAD_DataStatus::RESERVED == status ) {
+            views[k++] = v;
+            continue;
+        }
+        if( !tombstones.empty() ) {
+            jau::nsize_t t = 0;
+            while( t < tombstones.size() && !tombstones[t].matches(v) ) { ++t; }
+            if( t < tombstones.size() ) {
+                // remaining fragment of a dropped chain
+                ++count_discarded;
+                if( EAD_DataStatus::INCOMPLETE_MORE == status ) {
+                    tombstones[t].ts_last = now;
+                } else {
+                    tombstones.erase(tombstones.cbegin() + t); // finishing fragment
+                }
+                continue;
+            }
+        }
+        jau::nsize_t idx = pending.size();
+        for(jau::nsize_t j = 0; j < pending.size(); ++j) {
+            if( pending[j].matches(v) ) {
+                idx = j;
+                break;
+            }
+        }
+        if( pending.size() == idx ) {
+            if( EAD_DataStatus::COMPLETE == status ) {
+                views[k++] = v; // unchained
+                continue;
+            }
+            pending.push_back( Chain { v.getAddress(), v.getADAddressType(), v.getAdvSID(),
+                                       is_set(v.getExtEvtType(), EAD_Event_Type::SCAN_RSP), now, std::vector<uint8_t>() } );
+        }
+        if( !append(idx, v, now) ) {
+            // dropped, exceeding MAX_DATA_SIZE
+            if( EAD_DataStatus::INCOMPLETE_MORE != status ) {
+                tombstones.erase(tombstones.cend() - 1); // finished with this fragment
+            }
+            continue;
+        }
+        if( EAD_DataStatus::INCOMPLETE_MORE == status ) {
+            continue; // buffered
+        }
+        // chain finished: index may have shifted due to budget eviction
+        for(idx = 0; idx < pending.size() && !pending[idx].matches(v); ++idx) { }
+        pending_bytes -= pending[idx].data.size();
+        completed.push_back( std::move( pending[idx] ) );
+        pending.erase(pending.cbegin() + idx);
+
+        const Chain& c = completed[completed.size()-1];
+        v.setData(c.data.data(), static_cast<uint16_t>( c.data.size() ));
+        if( EAD_DataStatus::COMPLETE == status ) {
+            v.ead_type = static_cast<EAD_Event_Type>( number(v.ead_type) & ~( number(EAD_Event_Type::DATA_B0) | number(EAD_Event_Type::DATA_B1) ) );
+            ++count_completed;
+        } else {
+            ++count_truncated;
+        }
+        views[k++] = v;
+    }
+    if( k < views.size() ) {
+        views.erase(views.cbegin() + k, views.cend());
+    }
+}
+
+void EADReassembly::clear() noexcept {
+    pending.clear();
+    completed.clear();
+    tombstones.clear();
+    pending_bytes = 0;
+}
+
+std::string EADReassembly::toString() const noexcept {
+    return "EADReassembly[pending "+std::to_string(pending.size())+" chains, "+std::to_string(pending_bytes)+"/"+std::to_string(budget)+" bytes"+
+           ", fragments "+std::to_string(count_fragments.load())+", completed "+std::to_string(count_completed.load())+
+           ", truncated "+std::to_string(count_truncated.load())+", dropped "+std::to_string(count_dropped.load())+
+           ", tombstones "+std::to_string(tombstones.size())+", discarded "+std::to_string(count_discarded.load())+
+           ", timeout "+std::to_string(timeout_ms)+" ms]";
+}
@@ -26,6 +26,7 @@
 #include <cstring>
 #include <cstdint>
 #include <cstdio>
+#include <algorithm>
 
 #include <jau/secmem.hpp>
 
@@ -105,9 +106,14 @@ int HCIComm::hci_close_dev(int dd) noexcept
 // *************************************************
 
 HCIComm::HCIComm(const uint16_t _dev_id, const uint16_t _channel) noexcept
+: HCIComm(_dev_id, _channel, hci_open_dev(_dev_id, _channel))
+{
+}
+
+HCIComm::HCIComm(const uint16_t _dev_id, const uint16_t _channel, const int _socket_descriptor) noexcept
 : dev_id( _dev_id ), channel( _channel ),
-  socket_descriptor( hci_open_dev(_dev_id, _channel) ),
-  interrupted_intern(false), is_interrupted_extern(/* Null Type */), tid_read(0)
+  socket_descriptor( _socket_descriptor ),
+  interrupted_intern(false), is_interrupted_extern(/* Null Type */), tid_read(0), uring_failed(false)
 {
 }
 
@@ -134,6 +140,12 @@ void HCIComm::close() noexcept {
             }
         }
     }
+    {
+        // release the io_uring backend before its socket, an in-flight read() holds its own reference
+        const std::lock_guard<std::mutex> lock_uring(mtx_uring); // RAII-style acquire and relinquish via destructor
+        uring = nullptr;
+        uring_failed = false;
+    }
     hci_close_dev(socket_descriptor);
     socket_descriptor = -1;
     interrupted_intern = false;
@@ -141,8 +153,21 @@ void HCIComm::close() noexcept {
     DBG_PRINT("HCIComm::close: End: dd %d", socket_descriptor.load());
 }
 
+std::shared_ptr<IOUringChannel> HCIComm::getUring(const jau::nsize_t slot_size) noexcept {
+    if( !IOUringChannel::isEnabled() ) {
+        return nullptr;
+    }
+    const std::lock_guard<std::mutex> lock(mtx_uring); // RAII-style acquire and relinquish via destructor
+    if( nullptr == uring && !uring_failed && 0 <= socket_descriptor ) {
+        uring = IOUringChannel::create(socket_descriptor, slot_size);
+        uring_failed = nullptr == uring;
+    }
+    return uring;
+}
+
 jau::snsize_t HCIComm::read(uint8_t* buffer, const jau::nsize_t capacity, const jau::fraction_i64& timeout) noexcept {
     jau::snsize_t len = 0;
+    std::shared_ptr<IOUringChannel> ch;
     if( 0 > socket_descriptor ) {
         goto errout;
     }
@@ -150,6 +175,17 @@ jau::snsize_t HCIComm::read(uint8_t* buffer, const jau::nsize_t capacity, const
         goto done;
     }
 
+    if( nullptr != ( ch = getUring(capacity) ) ) {
+        while ( ( len = ch->read(buffer, capacity, timeout) ) < 0 ) {
+            if ( !interrupted() && ( errno == EAGAIN || errno == EINTR ) ) {
+                // cont temp unavail or interruption
+                continue;
+            }
+            goto errout;
+        }
+        goto snoop_out;
+    }
+
     if( !timeout.is_zero() ) {
         struct pollfd p;
         int n = 1;
@@ -177,6 +213,11 @@ jau::snsize_t HCIComm::read(uint8_t* buffer, const jau::nsize_t capacity, const
         goto errout;
     }
 
+snoop_out:
+    if( nullptr != snoop ) {
+        snoop->write(buffer, len, true /* received */);
+    }
+
 done:
     return len;
 
@@ -184,6 +225,92 @@ errout:
     return -1;
 }
 
+jau::snsize_t HCIComm::read_batch(uint8_t* buffer, const jau::nsize_t slot_capacity, const jau::nsize_t slot_count,
+                                  jau::nsize_t* lengths, const jau::fraction_i64& timeout) noexcept {
+    struct ::mmsghdr msgs[MAX_BATCH_SLOTS];
+    struct ::iovec iovs[MAX_BATCH_SLOTS];
+    const jau::nsize_t count = std::min(slot_count, MAX_BATCH_SLOTS);
+    jau::snsize_t n = 0;
+    std::shared_ptr<IOUringChannel> ch;
+
+    if( 0 > socket_descriptor ) {
+        goto errout;
+    }
+    if( 0 == count || 0 == slot_capacity ) {
+        goto done;
+    }
+
+    if( nullptr != ( ch = getUring(slot_capacity) ) ) {
+        while ( ( n = ch->read_batch(buffer, slot_capacity, count, lengths, timeout) ) < 0 ) {
+            if ( !interrupted() && ( errno == EAGAIN || errno == EINTR ) ) {
+                // cont temp unavail or interruption
+                continue;
+            }
+            goto errout;
+        }
+        goto snoop_out;
+    }
+
+    if( !timeout.is_zero() ) {
+        struct pollfd p;
+        int pn = 1;
+        const int32_t timeoutMS = (int32_t) timeout.to_num_of(jau::fractions_i64::milli);
+
+        p.fd = socket_descriptor; p.events = POLLIN;
+        while ( !interrupted() && (pn = ::poll(&p, 1, timeoutMS)) < 0 ) {
+            if ( !interrupted() && ( errno == EAGAIN || errno == EINTR ) ) {
+                // cont temp unavail or interruption
+                continue;
+            }
+            goto errout;
+        }
+        if (!pn) {
+            errno = ETIMEDOUT;
+            goto errout;
+        }
+    }
+
+    for(jau::nsize_t i=0; i<count; ++i) {
+        iovs[i].iov_base = buffer + i * slot_capacity;
+        iovs[i].iov_len = slot_capacity;
+        ::memset(&msgs[i], 0, sizeof(msgs[i]));
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    // Socket is readable or no poll was requested: drain all queued packets w/o blocking
+    while ( ( n = ::recvmmsg(socket_descriptor, msgs, count, MSG_DONTWAIT, nullptr) ) < 0 ) {
+        if ( errno == EAGAIN || errno == EWOULDBLOCK ) {
+            // spurious wakeup, nothing queued
+            n = 0;
+            goto done;
+        }
+        if ( errno == EINTR && !interrupted() ) {
+            continue;
+        }
+        goto errout;
+    }
+    for(jau::snsize_t i=0; i<n; ++i) {
+        if( 0 == msgs[i].msg_len ) {
+            n = i; // end of stream, as IOUringChannel::read_batch()
+            break;
+        }
+        lengths[i] = msgs[i].msg_len;
+    }
+
+snoop_out:
+    if( nullptr != snoop ) {
+        for(jau::snsize_t i=0; i<n; ++i) {
+            snoop->write(buffer + i * slot_capacity, lengths[i], true /* received */);
+        }
+    }
+
+done:
+    return n;
+
+errout:
+    return -1;
+}
+
 jau::snsize_t HCIComm::write(const uint8_t* buffer, const jau::nsize_t size) noexcept {
     const std::lock_guard<std::recursive_mutex> lock(mtx_write); // RAII-style acquire and relinquish via destructor
     jau::snsize_t len = 0;
@@ -200,6 +327,9 @@ jau::snsize_t HCIComm::write(const uint8_t* buffer, const jau::nsize_t size) noe
         }
         goto errout;
     }
+    if( nullptr != snoop ) {
+        snoop->write(buffer, len, false /* received */);
+    }
 
 done:
     return len;
@@ -28,6 +28,7 @@
 #include <memory>
 #include <cstdint>
 #include <cstdio>
+#include <algorithm>
 
 // #define PERF_PRINT_ON 1
 #include <jau/debug.hpp>
@@ -49,6 +50,7 @@ extern "C" {
     #include <unistd.h>
     #include <poll.h>
     #include <signal.h>
+    #include <linux/filter.h>
     #ifdef __linux__
         #include <sys/ioctl.h>
     #endif
@@ -60,12 +62,20 @@ using namespace jau::fractions_i64_literals;
 HCIEnv::HCIEnv() noexcept
 : exploding( jau::environment::getExplodingProperties("direct_bt.hci") ),
   HCI_READER_THREAD_POLL_TIMEOUT( jau::environment::getFractionProperty("direct_bt.hci.reader.timeout", 10_s, 1500_ms /* min */, 365_d /* max */) ),
+  HCI_READER_BATCH_SIZE( jau::environment::getInt32Property("direct_bt.hci.reader.batch", 16, 1 /* min */, HCIComm::MAX_BATCH_SLOTS /* max */) ),
   HCI_COMMAND_STATUS_REPLY_TIMEOUT( jau::environment::getFractionProperty("direct_bt.hci.cmd.status.timeout", 3_s, 1500_ms /* min */, 365_d /* max */) ),
   HCI_COMMAND_COMPLETE_REPLY_TIMEOUT( jau::environment::getFractionProperty("direct_bt.hci.cmd.complete.timeout", 10_s, 1500_ms /* min */, 365_d /* max */) ),
   HCI_COMMAND_POLL_PERIOD( jau::environment::getFractionProperty("direct_bt.hci.cmd.poll.period", 125_ms, 50_ms, 365_d) ),
   HCI_EVT_RING_CAPACITY( jau::environment::getInt32Property("direct_bt.hci.ringsize", 64, 64 /* min */, 1024 /* max */) ),
   DEBUG_EVENT( jau::environment::getBooleanProperty("direct_bt.debug.hci.event", false) ),
   DEBUG_SCAN_AD_EIR( jau::environment::getBooleanProperty("direct_bt.debug.hci.scan_ad_eir", false) ),
+  HCI_ADV_WORKER( jau::environment::getBooleanProperty("direct_bt.hci.adv.worker", false) ),
+  HCI_ADV_RING_CAPACITY( jau::environment::getInt32Property("direct_bt.hci.adv.ringsize", 256, 64 /* min */, 8192 /* max */) ),
+  HCI_ADV_COALESCE( jau::environment::getBooleanProperty("direct_bt.hci.adv.coalesce", true) ),
+  HCI_EAD_REASSEMBLY_TIMEOUT( jau::environment::getFractionProperty("direct_bt.hci.ead.timeout", 2_s, 100_ms /* min */, 60_s /* max */) ),
+  HCI_EAD_REASSEMBLY_BUDGET( jau::environment::getInt32Property("direct_bt.hci.ead.budget", 16384, 1650 /* min */, 1048576 /* max */) ),
+  HCI_SNOOP_FILE( jau::environment::getProperty("direct_bt.hci.snoop") ),
+  HCI_KERNEL_FILTER( jau::environment::getBooleanProperty("direct_bt.hci.kernel_filter", true) ),
   HCI_READ_PACKET_MAX_RETRY( HCI_EVT_RING_CAPACITY )
 {
 }
@@ -74,72 +84,163 @@ __pack( struct hci_rp_status {
     __u8    status;
 } );
 
-HCIHandler::HCIConnectionRef HCIHandler::setResolvHCIConnectionAddr(jau::darray<HCIConnectionRef> &list,
-                                                                    const BDAddressAndType& visibleAddressAndType,
-                                                                    const BDAddressAndType& addressAndType) noexcept {
-    const std::lock_guard<std::recursive_mutex> lock(mtx_connectionList); // RAII-style acquire and relinquish via destructor
+HCIHandler::HCIConnectionRef HCIHandler::HCIConnectionList::findAddress(const BDAddressAndType& addressAndType) const noexcept {
+    auto it = byAddress.find(addressAndType);
+    return byAddress.end() != it ? it->second : nullptr;
+}
+
+HCIHandler::HCIConnectionRef HCIHandler::HCIConnectionList::findHandle(const uint16_t handle) const noexcept {
+    std::shared_ptr<handle_map_t> snapshot;
+    {
+        jau::sc_atomic_critical sync(sync_byHandle);
+        snapshot = byHandle;
+    }
+    auto it = snapshot->find(handle);
+    return snapshot->end() != it ? it->second : nullptr;
+}
+
+void HCIHandler::HCIConnectionList::putHandle(const HCIConnectionRef& conn) noexcept {
+    std::shared_ptr<handle_map_t> n = std::make_shared<handle_map_t>( *byHandle );
+    (*n)[conn->getHandle()] = conn;
+    jau::sc_atomic_critical sync(sync_byHandle);
+    byHandle = std::move(n);
+}
+
+void HCIHandler::HCIConnectionList::removeHandle(const HCIConnectionRef& conn) noexcept {
+    auto it = byHandle->find(conn->getHandle());
+    if( byHandle->end() == it || it->second != conn ) {
+        return;
+    }
+    std::shared_ptr<handle_map_t> n = std::make_shared<handle_map_t>( *byHandle );
+    n->erase(conn->getHandle());
+    jau::sc_atomic_critical sync(sync_byHandle);
+    byHandle = std::move(n);
+}
+
+void HCIHandler::HCIConnectionList::removeAddress(const HCIConnectionRef& conn) noexcept {
+    auto it = byAddress.find(conn->getVisibleAddressAndType());
+    if( byAddress.end() != it && it->second == conn ) {
+        byAddress.erase(it);
+    }
+    it = byAddress.find(conn->getAddressAndType());
+    if( byAddress.end() != it && it->second == conn ) {
+        byAddress.erase(it);
+    }
+}
+
+HCIHandler::HCIConnectionRef HCIHandler::HCIConnectionList::add(const BDAddressAndType& addressAndType, const uint16_t handle) {
+    HCIConnectionRef conn( std::make_shared<HCIConnection>(addressAndType, handle) );
+    list.push_back( conn );
+    byAddress[addressAndType] = conn;
+    if( 0 != handle ) {
+        putHandle(conn);
+    }
+    return conn;
+}
+
+void HCIHandler::HCIConnectionList::setHandle(const HCIConnectionRef& conn, const uint16_t handle) noexcept {
+    if( handle == conn->getHandle() ) {
+        return;
+    }
+    if( 0 != conn->getHandle() ) {
+        removeHandle(conn);
+    }
+    conn->setHandle(handle);
+    if( 0 != handle ) {
+        putHandle(conn);
+    }
+}
+
+void HCIHandler::HCIConnectionList::setResolvAddrAndType(const HCIConnectionRef& conn, const BDAddressAndType& addressAndType) noexcept {
+    if( conn->getAddressAndType() != conn->getVisibleAddressAndType() ) {
+        auto it = byAddress.find(conn->getAddressAndType());
+        if( byAddress.end() != it && it->second == conn ) {
+            byAddress.erase(it);
+        }
+    }
+    conn->setResolvAddrAndType(addressAndType);
+    byAddress[addressAndType] = conn;
+}
+
+bool HCIHandler::HCIConnectionList::remove(const HCIConnectionRef& conn) noexcept {
     auto end = list.end();
     for (auto it = list.begin(); it != end; ++it) {
-        HCIConnectionRef conn = *it;
-        if ( conn->equals(visibleAddressAndType) ) {
-            conn->setResolvAddrAndType(addressAndType);
-            return conn; // done
+        if ( *it == conn ) {
+            list.erase(it);
+            removeAddress(conn);
+            if( 0 != conn->getHandle() ) {
+                removeHandle(conn);
+            }
+            return true;
         }
     }
-    return nullptr;
+    return false;
+}
+
+void HCIHandler::HCIConnectionList::clear() noexcept {
+    list.clear();
+    byAddress.clear();
+    std::shared_ptr<handle_map_t> n = std::make_shared<handle_map_t>();
+    jau::sc_atomic_critical sync(sync_byHandle);
+    byHandle = std::move(n);
+}
+
+HCIHandler::HCIConnectionRef HCIHandler::setResolvHCIConnectionAddr(HCIConnectionList &list,
+                                                                    const BDAddressAndType& visibleAddressAndType,
+                                                                    const BDAddressAndType& addressAndType) noexcept {
+    const std::lock_guard<std::recursive_mutex> lock(mtx_connectionList); // RAII-style acquire and relinquish via destructor
+    HCIConnectionRef conn = list.findAddress(visibleAddressAndType);
+    if( nullptr != conn ) {
+        list.setResolvAddrAndType(conn, addressAndType);
+    }
+    return conn;
 }
 
-HCIHandler::HCIConnectionRef HCIHandler::addOrUpdateHCIConnection(jau::darray<HCIConnectionRef> &list,
+HCIHandler::HCIConnectionRef HCIHandler::addOrUpdateHCIConnection(HCIConnectionList &list,
                                                                   const BDAddressAndType& addressAndType, const uint16_t handle) noexcept {
     const std::lock_guard<std::recursive_mutex> lock(mtx_connectionList); // RAII-style acquire and relinquish via destructor
-    auto end = list.end();
-    for (auto it = list.begin(); it != end; ++it) {
-        HCIConnectionRef conn = *it;
-        if ( conn->equals(addressAndType) ) {
-            // reuse same entry
-            WORDY_PRINT("HCIHandler<%hu>::addTrackerConnection: address%s, handle %s: reuse entry %s - %s",
-               dev_id, addressAndType.toString().c_str(), jau::to_hexstring(handle).c_str(),
-               conn->toString().c_str(), toString().c_str());
-            // Overwrite tracked connection handle with given _valid_ handle only, i.e. non zero!
-            if( 0 != handle ) {
-                if( 0 != conn->getHandle() && handle != conn->getHandle() ) {
-                    WARN_PRINT("address%s, handle %s: reusing entry %s, overwriting non-zero handle - %s",
-                       addressAndType.toString().c_str(), jau::to_hexstring(handle).c_str(),
-                       conn->toString().c_str(), toString().c_str());
-                }
-                conn->setHandle( handle );
+    HCIConnectionRef conn = list.findAddress(addressAndType);
+    if( nullptr != conn ) {
+        // reuse same entry
+        WORDY_PRINT("HCIHandler<%hu>::addTrackerConnection: address%s, handle %s: reuse entry %s - %s",
+           dev_id, addressAndType.toString().c_str(), jau::to_hexstring(handle).c_str(),
+           conn->toString().c_str(), toString().c_str());
+        // Overwrite tracked connection handle with given _valid_ handle only, i.e. non zero!
+        if( 0 != handle ) {
+            if( 0 != conn->getHandle() && handle != conn->getHandle() ) {
+                WARN_PRINT("address%s, handle %s: reusing entry %s, overwriting non-zero handle - %s",
+                   addressAndType.toString().c_str(), jau::to_hexstring(handle).c_str(),
+                   conn->toString().c_str(), toString().c_str());
             }
-            return conn; // done
+            list.setHandle( conn, handle );
         }
+        return conn; // done
     }
     try {
-        HCIConnectionRef res( std::make_shared<HCIConnection>(addressAndType, handle) );
-        list.push_back( res );
-        return res;
+        conn = list.add(addressAndType, handle);
     } catch (const std::bad_alloc &e) {
         ABORT("Error: bad_alloc: HCIConnectionRef allocation failed");
         return nullptr; // unreachable
     }
+    if( &list == &connectionList ) {
+        updateEventFilter();
+    }
+    return conn;
 }
 
-HCIHandler::HCIConnectionRef HCIHandler::findHCIConnection(jau::darray<HCIConnectionRef> &list, const BDAddressAndType& addressAndType) noexcept {
+HCIHandler::HCIConnectionRef HCIHandler::findHCIConnection(HCIConnectionList &list, const BDAddressAndType& addressAndType) noexcept {
     const std::lock_guard<std::recursive_mutex> lock(mtx_connectionList); // RAII-style acquire and relinquish via destructor
-    const jau::nsize_t size = list.size();
-    for (jau::nsize_t i = 0; i < size; i++) {
-        HCIConnectionRef & e = list[i];
-        if( e->equals(addressAndType) ) {
-            return e;
-        }
-    }
-    return nullptr;
+    return list.findAddress(addressAndType);
 }
 
 HCIHandler::HCIConnectionRef HCIHandler::findTrackerConnection(const uint16_t handle) noexcept {
+    if( 0 != handle ) {
+        return connectionList.findHandle(handle); // lock-free
+    }
+    // pending connection w/o handle
     const std::lock_guard<std::recursive_mutex> lock(mtx_connectionList); // RAII-style acquire and relinquish via destructor
-    const jau::nsize_t size = connectionList.size();
-    for (jau::nsize_t i = 0; i < size; i++) {
-        HCIConnectionRef & e = connectionList[i];
-        if ( handle == e->getHandle() ) {
+    for (const HCIConnectionRef& e : connectionList.entries()) {
+        if ( 0 == e->getHandle() ) {
             return e;
         }
     }
@@ -148,20 +249,20 @@ HCIHandler::HCIConnectionRef HCIHandler::findTrackerConnection(const uint16_t ha
 
 HCIHandler::HCIConnectionRef HCIHandler::removeTrackerConnection(const HCIConnectionRef& conn) noexcept {
     const std::lock_guard<std::recursive_mutex> lock(mtx_connectionList); // RAII-style acquire and relinquish via destructor
-    auto end = connectionList.end();
-    for (auto it = connectionList.begin(); it != end; ++it) {
-        HCIConnectionRef e = *it;
-        if ( *e == *conn ) {
-            connectionList.erase(it);
-            return e; // done
-        }
+    HCIConnectionRef e = connectionList.findAddress(conn->getAddressAndType());
+    if( nullptr == e ) {
+        e = connectionList.findAddress(conn->getVisibleAddressAndType());
+    }
+    if( nullptr != e && connectionList.remove(e) ) {
+        updateEventFilter();
+        return e; // done
     }
     return nullptr;
 }
 HCIHandler::size_type HCIHandler::countPendingTrackerConnections() noexcept {
     const std::lock_guard<std::recursive_mutex> lock(mtx_connectionList); // RAII-style acquire and relinquish via destructor
     size_type count = 0;
-    for (const auto& e : connectionList) {
+    for (const auto& e : connectionList.entries()) {
         if ( e->getHandle() == 0 ) {
             count++;
         }
@@ -172,25 +273,32 @@ HCIHandler::size_type HCIHandler::getTrackerConnectionCount() noexcept {
     const std::lock_guard<std::recursive_mutex> lock(mtx_connectionList); // RAII-style acquire and relinquish via destructor
     return connectionList.size();
 }
-HCIHandler::HCIConnectionRef HCIHandler::removeHCIConnection(jau::darray<HCIConnectionRef> &list, const uint16_t handle) noexcept {
+HCIHandler::HCIConnectionRef HCIHandler::removeHCIConnection(HCIConnectionList &list, const uint16_t handle) noexcept {
     const std::lock_guard<std::recursive_mutex> lock(mtx_connectionList); // RAII-style acquire and relinquish via destructor
-    auto end = list.end();
-    for (auto it = list.begin(); it != end; ++it) {
-        HCIConnectionRef e = *it;
-        if ( e->getHandle() == handle ) {
-            list.erase(it);
-            return e; // done
+    HCIConnectionRef e = nullptr;
+    if( 0 != handle ) {
+        e = list.findHandle(handle);
+    } else {
+        for (const HCIConnectionRef& c : list.entries()) {
+            if ( 0 == c->getHandle() ) {
+                e = c;
+                break;
+            }
+        }
+    }
+    if( nullptr != e && list.remove(e) ) {
+        if( &list == &connectionList ) {
+            updateEventFilter();
         }
+        return e; // done
     }
     return nullptr;
 }
-void HCIHandler::dumpHCIConnections(const char *msg, jau::darray<HCIConnectionRef> &list) noexcept {
+void HCIHandler::dumpHCIConnections(const char *msg, HCIConnectionList &list) noexcept {
     const std::lock_guard<std::recursive_mutex> lock(mtx_connectionList); // RAII-style acquire and relinquish via destructor
-    auto end = list.end();
     size_t i=0;
-    jau::PLAIN_PRINT(true, "%s: %zu items", msg, list.size());
-    for (auto it = list.begin(); it != end; ++it) {
-        HCIConnectionRef e = *it;
+    jau::PLAIN_PRINT(true, "%s: %zu items", msg, (size_t)list.size());
+    for (const HCIConnectionRef& e : list.entries()) {
         jau::PLAIN_PRINT(true, "- %02zu: %s", i++, e->toString().c_str());
     }
 }
@@ -234,7 +342,10 @@ std::unique_ptr<MgmtEvent> HCIHandler::translate(HCIEvent& ev) noexcept {
                 const uint16_t handle = jau::le_to_cpu(ev_cc->handle);
                 const HCIConnectionRef conn = addOrUpdateTrackerConnection(addressAndType, handle);
                 if( HCIStatusCode::SUCCESS == status ) {
-                    advertisingEnabled = false;
+                    if( !use_ext_adv() ) {
+                        // extended advertising sets are terminated individually via LE_ADV_SET_TERMINATED
+                        setAdvSetsEnabled(false, nullptr, 0);
+                    }
                     return std::make_unique<MgmtEvtDeviceConnected>(dev_id, addressAndType, handle);
                 } else {
                     removeTrackerConnection(conn);
@@ -262,7 +373,10 @@ std::unique_ptr<MgmtEvent> HCIHandler::translate(HCIEvent& ev) noexcept {
                 const uint16_t handle = jau::le_to_cpu(ev_cc->handle);
                 const HCIConnectionRef conn = addOrUpdateTrackerConnection(addressAndType, handle);
                 if( HCIStatusCode::SUCCESS == status ) {
-                    advertisingEnabled = false;
+                    if( !use_ext_adv() ) {
+                        // extended advertising sets are terminated individually via LE_ADV_SET_TERMINATED
+                        setAdvSetsEnabled(false, nullptr, 0);
+                    }
                     return std::make_unique<MgmtEvtDeviceConnected>(dev_id, addressAndType, handle);
                 } else {
                     removeTrackerConnection(conn);
@@ -325,7 +439,9 @@ std::unique_ptr<MgmtEvent> HCIHandler::translate(HCIEvent& ev) noexcept {
             const BDAddressAndType addressAndType(jau::le_to_cpu(ev_cc->bdaddr), BDAddressType::BDADDR_BREDR);
             HCIConnectionRef conn = addOrUpdateTrackerConnection(addressAndType, ev_cc->handle);
             if( HCIStatusCode::SUCCESS == status ) {
-                advertisingEnabled = false;
+                if( !use_ext_adv() ) {
+                    setAdvSetsEnabled(false, nullptr, 0);
+                }
                 return std::make_unique<MgmtEvtDeviceConnected>(dev_id, conn->getAddressAndType(), conn->getHandle());
             } else {
                 try {
@@ -446,7 +562,7 @@ std::unique_ptr<const SMPPDUMsg> HCIHandler::getSMPPDUMsg(const HCIACLData::l2ca
 }
 
 void HCIHandler::hciReaderWork(jau::service_runner& sr) noexcept {
-    jau::snsize_t len;
+    jau::snsize_t count;
     if( !isOpen() ) {
         // not open
         ERR_PRINT("Not connected %s", toString().c_str());
@@ -454,141 +570,479 @@ void HCIHandler::hciReaderWork(jau::service_runner& sr) noexcept {
         return;
     }
 
-    len = comm.read(rbuffer.get_wptr(), rbuffer.size(), env.HCI_READER_THREAD_POLL_TIMEOUT);
-    if( 0 < len ) {
-        const jau::nsize_t len2 = static_cast<jau::nsize_t>(len);
-        const HCIPacketType pc = static_cast<HCIPacketType>( rbuffer.get_uint8_nc(0) );
-
-        // ACL
-        if( HCIPacketType::ACLDATA == pc ) {
-            std::unique_ptr<HCIACLData> acldata = HCIACLData::getSpecialized(rbuffer.get_ptr(), len2);
-            if( nullptr == acldata ) {
-                // not valid acl-data ...
-                if( jau::environment::get().verbose ) {
-                    WARN_PRINT("dev_id %u: IO RECV Drop ACL (non-acl-data) %s - %s",
-                            dev_id, jau::bytesHexString(rbuffer.get_ptr(), 0, len2, true /* lsbFirst*/).c_str(), toString().c_str());
-                }
-                return;
+    count = comm.read_batch(rbuffer.get_wptr(), HCI_MAX_MTU, rbuffer_lens.size(), rbuffer_lens.data(), env.HCI_READER_THREAD_POLL_TIMEOUT);
+    if( 0 < count ) {
+        for(jau::snsize_t i=0; i < count && !sr.shall_stop(); ++i) {
+            const jau::nsize_t len = rbuffer_lens[i];
+            if( 0 < len ) {
+                hciReaderProcess(rbuffer.get_ptr() + i * HCI_MAX_MTU, len);
             }
-            const uint8_t* l2cap_data = nullptr; // owned by acldata
-            HCIACLData::l2cap_frame l2cap = acldata->getL2CAPFrame(l2cap_data);
-            std::unique_ptr<const SMPPDUMsg> smpPDU = getSMPPDUMsg(l2cap, l2cap_data);
-            if( nullptr != smpPDU ) {
-                HCIConnectionRef conn = findTrackerConnection(l2cap.handle);
-
-                if( nullptr != conn ) {
-                    COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV ACL (SMP) %s for %s",
-                            dev_id, smpPDU->toString().c_str(), conn->toString().c_str());
-                    jau::for_each_fidelity(hciSMPMsgCallbackList, [&](HCISMPMsgCallback &cb) {
-                       cb(conn->getAddressAndType(), *smpPDU, l2cap);
-                    });
-                } else {
-                    WARN_PRINT("dev_id %u: IO RECV ACL Drop (SMP): Not tracked conn_handle %s: %s, %s",
-                            dev_id, jau::to_hexstring(l2cap.handle).c_str(),
-                            l2cap.toString().c_str(), smpPDU->toString().c_str());
-                }
-            } else if( !l2cap.isGATT() ) { // ignore handled GATT packages
-                COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV ACL Drop (L2CAP): ???? %s",
-                        dev_id, acldata->toString(l2cap, l2cap_data).c_str());
-            }
-            return;
         }
+    } else if( 0 == count || ETIMEDOUT == errno ) {
+        // no data, i.e. spurious wakeup or expected TIMEOUT if idle
+    } else if( comm.interrupted() ) { // expected exits
+        WORDY_PRINT("HCIHandler<%hu>::reader: HCIComm read: IRQed res %d, %s", dev_id, count, toString().c_str());
+    } else {
+        ERR_PRINT("HCIComm read: Error res %d, %s", count, toString().c_str());
+        // Keep alive - sr.set_shall_stop();
+    }
+}
 
-        // COMMAND
-        if( HCIPacketType::COMMAND == pc ) {
-            std::unique_ptr<HCICommand> event = HCICommand::getSpecialized(rbuffer.get_ptr(), len2);
-            if( nullptr == event ) {
-                // not a valid event ...
-                ERR_PRINT("IO RECV CMD Drop (non-command) %s - %s",
-                        jau::bytesHexString(rbuffer.get_ptr(), 0, len2, true /* lsbFirst*/).c_str(), toString().c_str());
-                return;
-            }
-            std::unique_ptr<MgmtEvent> mevent = translate(*event);
-            if( nullptr != mevent ) {
-                COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV CMD (CB) %s\n    -> %s", dev_id, event->toString().c_str(), mevent->toString().c_str());
-                sendMgmtEvent( *mevent );
-            } else {
-                COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV CMD Drop (no translation) %s", dev_id, event->toString().c_str());
+void HCIHandler::hciReaderProcess(const uint8_t* buffer, const jau::nsize_t len) noexcept {
+    // Peek via view first, only instantiate HCIPacket objects for non-dropped and non-advertising packets
+    const HCIPacketView pkt(buffer, len);
+    const HCIPacketType pc = pkt.getPacketType();
+
+    // ACL
+    if( HCIPacketType::ACLDATA == pc ) {
+        if( !pkt.isValidACLData() ) {
+            // not valid acl-data ...
+            if( jau::environment::get().verbose ) {
+                WARN_PRINT("dev_id %u: IO RECV Drop ACL (non-acl-data) %s - %s",
+                        dev_id, jau::bytesHexString(buffer, 0, len, true /* lsbFirst*/).c_str(), toString().c_str());
             }
             return;
         }
-
-        if( HCIPacketType::EVENT != pc ) {
-            WARN_PRINT("dev_id %u: IO RECV EVT Drop (not event, nor command, nor acl-data) %s - %s",
-                    dev_id, jau::bytesHexString(rbuffer.get_ptr(), 0, len2, true /* lsbFirst*/).c_str(), toString().c_str());
-            return;
+        const uint8_t* l2cap_data = nullptr; // owned by buffer
+        HCIACLData::l2cap_frame l2cap = HCIACLData::getL2CAPFrame(pkt.getACLHandleAndFlags(), pkt.getACLParam(), pkt.getACLParamSize(), l2cap_data);
+        std::unique_ptr<const SMPPDUMsg> smpPDU = getSMPPDUMsg(l2cap, l2cap_data);
+        if( nullptr != smpPDU ) {
+            HCIConnectionRef conn = findTrackerConnection(l2cap.handle);
+
+            if( nullptr != conn ) {
+                COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV ACL (SMP) %s for %s",
+                        dev_id, smpPDU->toString().c_str(), conn->toString().c_str());
+                jau::for_each_fidelity(hciSMPMsgCallbackList, [&](HCISMPMsgCallback &cb) {
+                   cb(conn->getAddressAndType(), *smpPDU, l2cap);
+                });
+            } else {
+                WARN_PRINT("dev_id %u: IO RECV ACL Drop (SMP): Not tracked conn_handle %s: %s, %s",
+                        dev_id, jau::to_hexstring(l2cap.handle).c_str(),
+                        l2cap.toString().c_str(), smpPDU->toString().c_str());
+            }
+        } else if( !l2cap.isGATT() ) { // ignore handled GATT packages
+            COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV ACL Drop (L2CAP): ???? %s",
+                    dev_id, l2cap.toString(l2cap_data).c_str());
         }
+        return;
+    }
 
-        // EVENT
-        std::unique_ptr<HCIEvent> event = HCIEvent::getSpecialized(rbuffer.get_ptr(), len2);
+    // COMMAND
+    if( HCIPacketType::COMMAND == pc ) {
+        std::unique_ptr<HCICommand> event = HCICommand::getSpecialized(buffer, len);
         if( nullptr == event ) {
             // not a valid event ...
-            ERR_PRINT("IO RECV EVT Drop (non-event) %s - %s",
-                    jau::bytesHexString(rbuffer.get_ptr(), 0, len2, true /* lsbFirst*/).c_str(), toString().c_str());
+            ERR_PRINT("IO RECV CMD Drop (non-command) %s - %s",
+                    jau::bytesHexString(buffer, 0, len, true /* lsbFirst*/).c_str(), toString().c_str());
             return;
         }
+        std::unique_ptr<MgmtEvent> mevent = translate(*event);
+        if( nullptr != mevent ) {
+            COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV CMD (CB) %s\n    -> %s", dev_id, event->toString().c_str(), mevent->toString().c_str());
+            sendMgmtEvent( *mevent );
+        } else {
+            COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV CMD Drop (no translation) %s", dev_id, event->toString().c_str());
+        }
+        return;
+    }
+
+    if( HCIPacketType::EVENT != pc ) {
+        WARN_PRINT("dev_id %u: IO RECV EVT Drop (not event, nor command, nor acl-data) %s - %s",
+                dev_id, jau::bytesHexString(buffer, 0, len, true /* lsbFirst*/).c_str(), toString().c_str());
+        return;
+    }
+
+    // EVENT
+    if( !pkt.isValidEvent() ) {
+        // not a valid event ...
+        ERR_PRINT("IO RECV EVT Drop (non-event) %s - %s",
+                jau::bytesHexString(buffer, 0, len, true /* lsbFirst*/).c_str(), toString().c_str());
+        return;
+    }
 
-        const HCIMetaEventType mec = event->getMetaEventType();
-        if( HCIMetaEventType::INVALID != mec && !filter_test_metaev(mec) ) {
-            // DROP
-            COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV EVT Drop (meta filter) %s", dev_id, event->toString().c_str());
-            return; // next packet
+    const HCIMetaEventType mec = pkt.getMetaEventType();
+    if( HCIMetaEventType::INVALID != mec && !filter_test_metaev(mec) ) {
+        // DROP
+        COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV EVT Drop (meta filter) %s", dev_id, pkt.toString().c_str());
+        return; // next packet
+    }
+
+    if( HCIMetaEventType::LE_ADVERTISING_REPORT == mec || HCIMetaEventType::LE_EXT_ADV_REPORT == mec ) {
+        if( env.HCI_ADV_WORKER && nullptr == replay_stats ) {
+            hciAdvEnqueue(mec, pkt.getMetaEventParam(), pkt.getMetaEventParamSize());
+        } else if( nullptr != replay_stats ) {
+            advViews.erase(advViews.cbegin(), advViews.cend()); // keep storage
+            const jau::fraction_timespec t0 = jau::getMonotonicTime();
+            readAdvReports(mec, pkt.getMetaEventParam(), pkt.getMetaEventParamSize(), 0, advViews);
+            const jau::fraction_timespec t1 = jau::getMonotonicTime();
+            sendAdvReports(advViews);
+            const jau::fraction_timespec t2 = jau::getMonotonicTime();
+            replay_stats->adv_reports += advViews.size();
+            replay_stats->adv_parse.add( static_cast<uint64_t>( ( t1 - t0 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) );
+            replay_stats->adv_dispatch.add( static_cast<uint64_t>( ( t2 - t1 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) );
+        } else {
+            // issue callbacks for the translated AD/EAD events
+            advViews.erase(advViews.cbegin(), advViews.cend()); // keep storage
+            readAdvReports(mec, pkt.getMetaEventParam(), pkt.getMetaEventParamSize(), 0, advViews);
+            sendAdvReports(advViews);
         }
+        return;
+    }
+    if( HCIMetaEventType::LE_PERIODIC_ADV_REPORT == mec ||
+        HCIMetaEventType::LE_PERIODIC_ADV_SYNC_ESTABLISHED == mec ||
+        HCIMetaEventType::LE_PERIODIC_ADV_SYNC_LOST == mec )
+    {
+        processPeriodicAdvEvent(mec, pkt.getMetaEventParam(), pkt.getMetaEventParamSize());
+        return;
+    }
+    if( HCIMetaEventType::LE_ADV_SET_TERMINATED == mec ) {
+        processAdvSetTerminated(pkt.getMetaEventParam(), pkt.getMetaEventParamSize());
+        return;
+    }
 
-        if( event->isEvent(HCIEventType::CMD_STATUS) || event->isEvent(HCIEventType::CMD_COMPLETE) )
-        {
-            COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV EVT (CMD REPLY) %s", dev_id, event->toString().c_str());
-            if( hciEventRing.isFull() ) {
-                const jau::nsize_t dropCount = hciEventRing.capacity()/4;
-                hciEventRing.drop(dropCount);
-                WARN_PRINT("dev_id %u: IO RECV Drop (%u oldest elements of %u capacity, ring full) - %s",
-                        dev_id, dropCount, hciEventRing.capacity(), toString().c_str());
-            }
-            if( !hciEventRing.putBlocking( std::move( event ), jau::fractions_i64::zero ) ) {
-                ERR_PRINT2("hciEventRing put: %s", hciEventRing.toString().c_str());
-                sr.set_shall_stop();
-                return;
-            }
-        } else if( event->isMetaEvent(HCIMetaEventType::LE_ADVERTISING_REPORT) ) {
-            // issue callbacks for the translated AD events
-            jau::darray<std::unique_ptr<EInfoReport>> eirlist = EInfoReport::read_ad_reports(event->getParam(), event->getParamSize());
-            for(jau::nsize_t eircount = 0; eircount < eirlist.size(); ++eircount) {
-                const MgmtEvtDeviceFound e(dev_id, std::move( eirlist[eircount] ) );
-                COND_PRINT(env.DEBUG_SCAN_AD_EIR, "HCIHandler<%hu>-IO RECV EVT (AD EIR) [%d] %s",
-                        dev_id, eircount, e.getEIR()->toString().c_str());
-                sendMgmtEvent( e );
-            }
-        } else if( event->isMetaEvent(HCIMetaEventType::LE_EXT_ADV_REPORT) ) {
-            // issue callbacks for the translated EAD events
-            jau::darray<std::unique_ptr<EInfoReport>> eirlist = EInfoReport::read_ext_ad_reports(event->getParam(), event->getParamSize());
-            for(jau::nsize_t eircount = 0; eircount < eirlist.size(); ++eircount) {
-                const MgmtEvtDeviceFound e(dev_id, std::move( eirlist[eircount] ) );
-                COND_PRINT(env.DEBUG_SCAN_AD_EIR, "HCIHandler<%hu>-IO RECV EVT (EAD EIR (ext)) [%d] %s",
-                        dev_id, eircount, e.getEIR()->toString().c_str());
-                sendMgmtEvent( e );
-            }
+    std::unique_ptr<HCIEvent> event = HCIEvent::getSpecialized(buffer, len);
+    if( nullptr == event ) {
+        // not a valid event ...
+        ERR_PRINT("IO RECV EVT Drop (non-event) %s - %s",
+                jau::bytesHexString(buffer, 0, len, true /* lsbFirst*/).c_str(), toString().c_str());
+        return;
+    }
+
+    if( event->isEvent(HCIEventType::CMD_STATUS) || event->isEvent(HCIEventType::CMD_COMPLETE) )
+    {
+        COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV EVT (CMD REPLY) %s", dev_id, event->toString().c_str());
+        hciCmdReply( std::move( event ) );
+    } else {
+        // issue a callback for the translated event
+        std::unique_ptr<MgmtEvent> mevent = translate(*event);
+        if( nullptr != mevent ) {
+            COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV EVT (CB) %s\n    -> %s", dev_id, event->toString().c_str(), mevent->toString().c_str());
+            sendMgmtEvent( *mevent );
         } else {
-            // issue a callback for the translated event
-            std::unique_ptr<MgmtEvent> mevent = translate(*event);
-            if( nullptr != mevent ) {
-                COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV EVT (CB) %s\n    -> %s", dev_id, event->toString().c_str(), mevent->toString().c_str());
-                sendMgmtEvent( *mevent );
-            } else {
-                COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV EVT Drop (no translation) %s", dev_id, event->toString().c_str());
+            COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV EVT Drop (no translation) %s", dev_id, event->toString().c_str());
+        }
+    }
+}
+
+bool HCIHandler::replay(BTSnoopReader& reader, const bool recorded_speed, HCIReplayStats& stats) noexcept {
+    if( hci_reader_service.is_running() ) {
+        ERR_PRINT("HCIHandler<%u>::replay: Reader running, not replaying %s - %s", dev_id, reader.getFilename().c_str(), toString().c_str());
+        return false;
+    }
+    if( !reader.is_open() ) {
+        ERR_PRINT("HCIHandler<%u>::replay: Capture not open %s - %s", dev_id, reader.getFilename().c_str(), toString().c_str());
+        return false;
+    }
+    stats = HCIReplayStats();
+    replay_stats = &stats;
+
+    BTSnoopRecord record;
+    uint64_t rec_t0 = 0;
+    const jau::fraction_timespec t0 = jau::getMonotonicTime();
+    while( reader.next(record) ) {
+        if( !record.isReceived() || 0 == record.data.size() ) {
+            ++stats.skipped;
+            continue;
+        }
+        if( recorded_speed ) {
+            if( 0 == stats.packets ) {
+                rec_t0 = record.timestamp_us;
+            } else if( record.timestamp_us > rec_t0 ) {
+                const int64_t delta_us = static_cast<int64_t>( record.timestamp_us - rec_t0 );
+                jau::sleep_until( t0 + jau::fraction_timespec( delta_us * jau::fractions_i64::micro ) );
             }
         }
-    } else if( 0 > len && ETIMEDOUT != errno && !comm.interrupted() ) { // expected exits
-        ERR_PRINT("HCIComm read: Error res %d, %s", len, toString().c_str());
-        // Keep alive - sr.set_shall_stop();
-    } else if( ETIMEDOUT != errno && !comm.interrupted() ) { // expected TIMEOUT if idle
-        WORDY_PRINT("HCIHandler<%hu>::reader: HCIComm read: IRQed res %d, %s", dev_id, len, toString().c_str());
+        const jau::fraction_timespec p0 = jau::getMonotonicTime();
+        hciReaderProcess(record.data.data(), record.data.size());
+        const jau::fraction_timespec p1 = jau::getMonotonicTime();
+        stats.process.add( static_cast<uint64_t>( ( p1 - p0 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) );
+        ++stats.packets;
+    }
+    const jau::fraction_timespec t1 = jau::getMonotonicTime();
+    stats.duration_ns = static_cast<uint64_t>( ( t1 - t0 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) );
+
+    replay_stats = nullptr;
+    {
+        const std::lock_guard<std::mutex> lock(mtx_cmdWaiters); // RAII-style acquire and relinquish via destructor
+        cmd_credits = 1; // replayed command replies have no pending command
     }
+    WORDY_PRINT("HCIHandler<%u>::replay: %s: %s", dev_id, reader.getFilename().c_str(), stats.toString().c_str());
+    return reader.at_end();
 }
 
 void HCIHandler::hciReaderEndLocked(jau::service_runner& sr) noexcept {
     (void)sr;
-    WORDY_PRINT("HCIHandler<%hu>::reader: Ended. Ring has %u entries flushed - %s", dev_id, hciEventRing.size(), toString().c_str());
-    hciEventRing.clear();
+    WORDY_PRINT("HCIHandler<%hu>::reader: Ended - %s", dev_id, toString().c_str());
+    cv_cmdWaiters.notify_all(); // no more replies, release waiting commands
+}
+
+void HCIHandler::readAdvReports(const HCIMetaEventType mec, const uint8_t* param, const jau::nsize_t param_size, const uint64_t timestamp,
+                                jau::darray<std::unique_ptr<EInfoReport>>& eirlist) noexcept {
+    // filter on the views, materializing accepted reports only
+    advViews.erase(advViews.cbegin(), advViews.cend()); // keep storage
+    readAdvReports(mec, param, param_size, timestamp, advViews);
+    for(const EInfoReportView& v : advViews) {
+        eirlist.push_back( v.materialize() );
+    }
+}
+
+void HCIHandler::sendAdvReports(jau::darray<std::unique_ptr<EInfoReport>>& eirlist) noexcept {
+    for(jau::nsize_t eircount = 0; eircount < eirlist.size(); ++eircount) {
+        if( nullptr == eirlist[eircount] ) {
+            continue; // coalesced
+        }
+        const MgmtEvtDeviceFound e(dev_id, std::move( eirlist[eircount] ) );
+        COND_PRINT(env.DEBUG_SCAN_AD_EIR, "HCIHandler<%hu>-IO RECV EVT (AD EIR) [%d] %s",
+                dev_id, eircount, e.getEIR()->toString().c_str());
+        sendMgmtEvent( e );
+    }
+}
+
+void HCIHandler::readAdvReports(const HCIMetaEventType mec, const uint8_t* param, const jau::nsize_t param_size, const uint64_t timestamp,
+                                jau::darray<EInfoReportView>& eirlist) noexcept {
+    const jau::nsize_t size0 = eirlist.size();
+    if( HCIMetaEventType::LE_EXT_ADV_REPORT == mec ) {
+        EInfoReportView::read_ext_ad_reports(param, param_size, eirlist);
+        eadReassembly.process(eirlist, size0, jau::getCurrentMilliseconds());
+    } else {
+        EInfoReportView::read_ad_reports(param, param_size, eirlist);
+    }
+    if( 0 < timestamp ) {
+        for(jau::nsize_t i = size0; i < eirlist.size(); ++i) {
+            eirlist[i].setTimestamp(timestamp); // reception time, not parsing time
+        }
+    }
+    std::shared_ptr<const ScanFilter> filter = getScanFilter();
+    if( nullptr != filter ) {
+        // compact accepted reports in place
+        const uint64_t now = jau::getCurrentMilliseconds();
+        jau::nsize_t k = size0;
+        for(jau::nsize_t i = size0; i < eirlist.size(); ++i) {
+            if( scanFilterTracker.matches(filter, eirlist[i], now) ) {
+                if( k != i ) {
+                    eirlist[k] = eirlist[i];
+                }
+                ++k;
+            } else {
+                ++adv_reports_filtered;
+            }
+        }
+        if( k < eirlist.size() ) {
+            eirlist.erase(eirlist.cbegin() + k, eirlist.cend());
+        }
+    } else if( 0 < scanFilterTracker.size() ) {
+        scanFilterTracker.clear();
+    }
+}
+
+void HCIHandler::setScanFilter(const ScanFilter& filter) noexcept {
+    std::shared_ptr<const ScanFilter> n = filter.isEmpty() ? nullptr : std::make_shared<const ScanFilter>(filter);
+    DBG_PRINT("HCIHandler<%hu>::setScanFilter: %s", dev_id, nullptr != n ? n->toString().c_str() : "none");
+    jau::sc_atomic_critical sync(sync_scanFilter);
+    scanFilter = std::move(n);
+}
+
+std::shared_ptr<const ScanFilter> HCIHandler::getScanFilter() const noexcept {
+    jau::sc_atomic_critical sync(sync_scanFilter);
+    return scanFilter;
+}
+
+std::string PeriodicAdvSync::toString() const noexcept {
+    return "PeriodicAdvSync["+to_string(status)+", handle "+jau::to_hexstring(sync_handle)+
+           ", sid "+std::to_string(adv_sid)+", "+address.toString()+", phy "+direct_bt::to_string(phy)+
+           ", interval "+std::to_string(interval)+", lost "+std::to_string(lost)+"]";
+}
+
+void HCIHandler::processPeriodicAdvEvent(const HCIMetaEventType mec, const uint8_t* param, const jau::nsize_t param_size) noexcept {
+    if( HCIMetaEventType::LE_PERIODIC_ADV_REPORT == mec ) {
+        // Sync_Handle(2), TX_Power, RSSI, CTE_Type, Data_Status, Data_Length, Data
+        if( 7 > param_size || 7U + param[6] > param_size ) {
+            WARN_PRINT("dev_id %u: LE_PERIODIC_ADV_REPORT: Invalid size %u", dev_id, param_size);
+            return;
+        }
+        ++periodic_reports;
+        const PeriodicAdvReport r { jau::get_uint16(param + 0, jau::lb_endian_t::little),
+                                    static_cast<int8_t>(param[2]), static_cast<int8_t>(param[3]), param[4],
+                                    static_cast<EAD_DataStatus>( std::min<uint8_t>(param[5], number(EAD_DataStatus::RESERVED)) ),
+                                    param + 7, param[6] };
+        jau::for_each_fidelity(hciPeriodicAdvReportCallbackList, [&](HCIPeriodicAdvReportCallback &cb) {
+            cb(r);
+        });
+        return;
+    }
+    PeriodicAdvSync s;
+    if( HCIMetaEventType::LE_PERIODIC_ADV_SYNC_ESTABLISHED == mec ) {
+        // Status, Sync_Handle(2), Advertising_SID, Advertiser_Address_Type, Advertiser_Address(6), PHY, Interval(2), Clock_Accuracy
+        if( 15 > param_size ) {
+            WARN_PRINT("dev_id %u: LE_PERIODIC_ADV_SYNC_ESTABLISHED: Invalid size %u", dev_id, param_size);
+            return;
+        }
+        s.status = static_cast<HCIStatusCode>(param[0]);
+        s.sync_handle = jau::get_uint16(param + 1, jau::lb_endian_t::little);
+        s.adv_sid = param[3];
+        s.address = BDAddressAndType(jau::EUI48(param + 5, jau::lb_endian_t::little),
+                                     to_BDAddressType( static_cast<HCILEPeerAddressType>(param[4]) ));
+        s.phy = static_cast<LE_PHYs>( 1 << ( std::max<uint8_t>(param[11], 1) - 1 ) ); // 0x01 1M, 0x02 2M, 0x03 Coded
+        s.interval = jau::get_uint16(param + 12, jau::lb_endian_t::little);
+        s.lost = false;
+        periodicAdvSyncPending = false;
+        if( HCIStatusCode::SUCCESS == s.status ) {
+            const std::lock_guard<std::mutex> lock(mtx_periodicAdvSync); // RAII-style acquire and relinquish via destructor
+            periodicAdvSyncs.push_back(s);
+        }
+    } else {
+        // LE_PERIODIC_ADV_SYNC_LOST: Sync_Handle(2)
+        if( 2 > param_size ) {
+            WARN_PRINT("dev_id %u: LE_PERIODIC_ADV_SYNC_LOST: Invalid size %u", dev_id, param_size);
+            return;
+        }
+        const uint16_t sync_handle = jau::get_uint16(param, jau::lb_endian_t::little);
+        if( !removePeriodicAdvSync(sync_handle, s) ) {
+            WARN_PRINT("dev_id %u: LE_PERIODIC_ADV_SYNC_LOST: Not tracked sync_handle %s", dev_id, jau::to_hexstring(sync_handle).c_str());
+            return;
+        }
+    }
+    DBG_PRINT("HCIHandler<%hu>::processPeriodicAdvEvent: %s: %s", dev_id, to_string(mec).c_str(), s.toString().c_str());
+    updateEventFilter();
+    jau::for_each_fidelity(hciPeriodicAdvSyncCallbackList, [&](HCIPeriodicAdvSyncCallback &cb) {
+        cb(s);
+    });
+}
+
+void HCIHandler::processAdvSetTerminated(const uint8_t* param, const jau::nsize_t param_size) noexcept {
+    // Status, Advertising_Handle, Connection_Handle(2), Num_Completed_Extended_Advertising_Events
+    if( 5 > param_size ) {
+        WARN_PRINT("dev_id %u: LE_ADV_SET_TERMINATED: Invalid size %u", dev_id, param_size);
+        return;
+    }
+    const HCIStatusCode status = static_cast<HCIStatusCode>(param[0]);
+    const uint8_t adv_handle = param[1];
+    setAdvSetsEnabled(false, &adv_handle, 1);
+    DBG_PRINT("HCIHandler<%hu>::processAdvSetTerminated: handle %u, status %s, conn_handle %s, events %u, advertising %d",
+            dev_id, adv_handle, to_string(status).c_str(),
+            jau::to_hexstring(jau::get_uint16(param + 2, jau::lb_endian_t::little)).c_str(), param[4], advertisingEnabled.load());
+}
+
+void HCIHandler::setAdvSetsEnabled(const bool enable, const uint8_t* handles, const jau::nsize_t count) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_advSets); // RAII-style acquire and relinquish via destructor
+    if( 0 == count ) {
+        for(uint64_t& m : advSetsEnabled) {
+            m = enable ? ~0ULL : 0;
+        }
+    }
+    for(jau::nsize_t i=0; i<count; ++i) {
+        const uint64_t bit = 1ULL << ( handles[i] & 0x3f );
+        if( enable ) {
+            advSetsEnabled[handles[i] >> 6] |= bit;
+        } else {
+            advSetsEnabled[handles[i] >> 6] &= ~bit;
+        }
+    }
+    advertisingEnabled = 0 != ( advSetsEnabled[0] | advSetsEnabled[1] | advSetsEnabled[2] | advSetsEnabled[3] );
+}
+
+bool HCIHandler::isAdvertisingSet(const uint8_t handle) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_advSets); // RAII-style acquire and relinquish via destructor
+    return 0 != ( advSetsEnabled[handle >> 6] & ( 1ULL << ( handle & 0x3f ) ) );
+}
+
+bool HCIHandler::removePeriodicAdvSync(const uint16_t sync_handle, PeriodicAdvSync& res) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_periodicAdvSync); // RAII-style acquire and relinquish via destructor
+    for(auto it = periodicAdvSyncs.begin(); it != periodicAdvSyncs.end(); ++it) {
+        if( it->sync_handle == sync_handle ) {
+            res = *it;
+            res.lost = true;
+            periodicAdvSyncs.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+jau::darray<PeriodicAdvSync> HCIHandler::getPeriodicAdvSyncs() noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_periodicAdvSync); // RAII-style acquire and relinquish via destructor
+    return periodicAdvSyncs;
+}
+
+void HCIHandler::sendAdvReports(const jau::darray<EInfoReportView>& eirlist) noexcept {
+    for(jau::nsize_t eircount = 0; eircount < eirlist.size(); ++eircount) {
+        const MgmtEvtDeviceFound e(dev_id, eirlist[eircount]);
+        COND_PRINT(env.DEBUG_SCAN_AD_EIR, "HCIHandler<%hu>-IO RECV EVT (AD EIR) [%d] %s",
+                dev_id, eircount, e.getEIR()->toString().c_str());
+        sendMgmtEvent( e );
+    }
+}
+
+void HCIHandler::hciAdvEnqueue(const HCIMetaEventType mec, const uint8_t* param, const jau::nsize_t param_size) noexcept {
+    HCIAdvReportSlot slot;
+    slot.timestamp = jau::getCurrentMilliseconds();
+    slot.type = mec;
+    slot.size = static_cast<uint8_t>( std::min<jau::nsize_t>(param_size, sizeof(slot.param)) );
+    memcpy(slot.param, param, slot.size);
+
+    // drop-oldest policy: the latest report of a device supersedes its older ones
+    if( hciAdvRing.isFull() ) {
+        hciAdvRing.drop(1);
+        ++adv_reports_dropped;
+        COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV EVT (AD) Drop oldest, ring full: dropped %" PRIu64 " - %s",
+                dev_id, adv_reports_dropped.load(), toString().c_str());
+    }
+    if( !hciAdvRing.putBlocking( std::move( slot ), jau::fractions_i64::zero ) ) {
+        ++adv_reports_dropped;
+        ERR_PRINT2("hciAdvRing put: %s", hciAdvRing.toString().c_str());
+        return;
+    }
+    ++adv_reports_enqueued;
+}
+
+void HCIHandler::hciAdvWork(jau::service_runner& sr) noexcept {
+    (void)sr;
+    HCIAdvReportSlot slot;
+    if( !hciAdvRing.getBlocking(slot, 500_ms) ) {
+        return; // timeout, allowing service_runner to check for shutdown
+    }
+    if( !env.HCI_ADV_COALESCE ) {
+        // views into slot.param, valid until next getBlocking()
+        advViews.erase(advViews.cbegin(), advViews.cend()); // keep storage
+        readAdvReports(slot.type, slot.param, slot.size, slot.timestamp, advViews);
+        sendAdvReports(advViews);
+        return;
+    }
+    jau::darray<std::unique_ptr<EInfoReport>>& eirlist = advReports;
+    eirlist.erase(eirlist.cbegin(), eirlist.cend()); // keep storage
+    readAdvReports(slot.type, slot.param, slot.size, slot.timestamp, eirlist);
+
+    // drain backlog and merge reports of same address, latest data wins
+    jau::nsize_t slot_count = 1;
+    while( slot_count < hciAdvRing.capacity() && hciAdvRing.get(slot) ) {
+        readAdvReports(slot.type, slot.param, slot.size, slot.timestamp, eirlist);
+        ++slot_count;
+    }
+    // address and PDU kind -> index of its latest report in eirlist,
+    // not merging a scan response into an advertising indication or vice versa
+    hciAdvCoalesceIndex.clear();
+    const jau::nsize_t size = eirlist.size();
+    for(jau::nsize_t i = 0; i < size; ++i) {
+        const HCIAdvCoalesceKey key { BDAddressAndType(eirlist[i]->getAddress(), eirlist[i]->getAddressType()), eirlist[i]->getSource() };
+        auto res = hciAdvCoalesceIndex.try_emplace(key, i);
+        if( !res.second ) {
+            const jau::nsize_t j = res.first->second;
+            // newer report data overrides, older report's remaining data is kept
+            eirlist[j]->set(*eirlist[i]);
+            eirlist[i] = std::move( eirlist[j] ); // deliver at latest position
+            eirlist[j] = nullptr;
+            res.first->second = i;
+            ++adv_reports_coalesced;
+        }
+    }
+    sendAdvReports(eirlist);
+}
+
+void HCIHandler::hciAdvEndLocked(jau::service_runner& sr) noexcept {
+    (void)sr;
+    WORDY_PRINT("HCIHandler<%hu>::adv: Ended. Ring has %u entries flushed, dropped %" PRIu64 ", coalesced %" PRIu64 " - %s",
+                dev_id, hciAdvRing.size(), adv_reports_dropped.load(), adv_reports_coalesced.load(), toString().c_str());
+    hciAdvRing.clear();
 }
 
 
@@ -625,39 +1079,139 @@ bool HCIHandler::sendCommand(HCICommand &req, const bool quiet) noexcept {
     return true;
 }
 
-std::unique_ptr<HCIEvent> HCIHandler::getNextReply(HCICommand &req, int32_t & retryCount, const jau::fraction_i64& replyTimeout) noexcept
-{
-    // Ringbuffer read is thread safe
-    while( retryCount < env.HCI_READ_PACKET_MAX_RETRY ) {
-        std::unique_ptr<HCIEvent> ev;
-        if( !hciEventRing.getBlocking(ev, replyTimeout) || nullptr == ev ) {
-            errno = ETIMEDOUT;
-            ERR_PRINT("nullptr result (timeout %" PRIi64 " ms -> abort): req %s - %s", replyTimeout.to_ms(), req.toString().c_str(), toString().c_str());
-            return nullptr;
-        } else if( !ev->validate(req) ) {
-            // This could occur due to an earlier timeout w/ a nullptr == res (see above),
-            // i.e. the pending reply processed here and naturally not-matching.
-            retryCount++;
-            COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV getNextReply: res mismatch (drop, retry %d): res %s; req %s",
-                       dev_id, retryCount, ev->toString().c_str(), req.toString().c_str());
+bool HCIHandler::submitCommand(HCICommand &req, HCICmdWaiter& waiter, const bool quiet) noexcept {
+    {
+        std::unique_lock<std::mutex> lock(mtx_cmdWaiters); // RAII-style acquire and relinquish via destructor
+        // A credit is returned latest when an outstanding command's reply times out, see releaseCreditLocked()
+        const jau::fraction_timespec timeout_time = jau::getMonotonicTime() + jau::fraction_timespec(env.HCI_COMMAND_COMPLETE_REPLY_TIMEOUT);
+        while( 0 >= cmd_credits && comm.is_open() ) {
+            std::cv_status s = wait_until(cv_cmdWaiters, lock, timeout_time);
+            if( std::cv_status::timeout == s && 0 >= cmd_credits ) {
+                if( !quiet || jau::environment::get().verbose ) {
+                    WARN_PRINT("dev_id %u: No command credit within %" PRIi64 " ms, pending %zu: req %s - %s",
+                            dev_id, env.HCI_COMMAND_COMPLETE_REPLY_TIMEOUT.to_ms(), cmdWaiters.size(),
+                            req.toString().c_str(), toString().c_str());
+                }
+                return false;
+            }
+        }
+        if( !comm.is_open() ) {
+            return false;
+        }
+        cmd_credits = cmd_credits - 1;
+        waiter.replies.clear();
+        waiter.credit_pending = true;
+        cmdWaiters.push_back(&waiter);
+    }
+    if( !sendCommand(req, quiet) ) {
+        retireCommand(waiter);
+        return false;
+    }
+    return true;
+}
+
+void HCIHandler::retireCommand(HCICmdWaiter& waiter) noexcept {
+    {
+        const std::lock_guard<std::mutex> lock(mtx_cmdWaiters); // RAII-style acquire and relinquish via destructor
+        releaseCreditLocked(waiter);
+        for(auto it = cmdWaiters.begin(); it != cmdWaiters.end(); ++it) {
+            if( *it == &waiter ) {
+                cmdWaiters.erase(it);
+                break;
+            }
+        }
+        waiter.replies.clear();
+    }
+    cv_cmdWaiters.notify_all(); // notify submitter awaiting a credit
+}
+
+void HCIHandler::releaseCreditLocked(HCICmdWaiter& waiter) noexcept {
+    if( waiter.credit_pending ) {
+        waiter.credit_pending = false;
+        if( 0 >= cmd_credits ) {
+            cmd_credits = 1;
+        }
+    }
+}
+
+void HCIHandler::hciCmdReply(std::unique_ptr<HCIEvent> event) noexcept {
+    uint8_t ncmd;
+    HCIOpcode opc;
+    if( event->isEvent(HCIEventType::CMD_COMPLETE) ) {
+        const HCICommandCompleteEvent* ev_cc = static_cast<const HCICommandCompleteEvent*>(event.get());
+        ncmd = ev_cc->getNumCommandPackets();
+        opc = ev_cc->getOpcode();
+    } else {
+        const HCICommandStatusEvent* ev_cs = static_cast<const HCICommandStatusEvent*>(event.get());
+        ncmd = ev_cs->getNumCommandPackets();
+        opc = ev_cs->getOpcode();
+    }
+    {
+        const std::lock_guard<std::mutex> lock(mtx_cmdWaiters); // RAII-style acquire and relinquish via destructor
+        if( HCIOpcode::SPECIAL == opc ) { // SPECIAL: NOP, credit update only
+            cmd_credits = ncmd;
         } else {
-            COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV getNextReply: res %s; req %s", dev_id, ev->toString().c_str(), req.toString().c_str());
-            return ev;
+            HCICmdWaiter* waiter = nullptr;
+            for(HCICmdWaiter* w : cmdWaiters) {
+                if( w->opcode == opc ) {
+                    waiter = w;
+                    break;
+                }
+            }
+            if( nullptr == waiter ) {
+                // Reply of a timed out command or of a foreign HCI user, its credit is not ours
+                cmd_replies_unrouted++;
+                COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV EVT (CMD REPLY) unrouted (drop): %s", dev_id, event->toString().c_str());
+            } else {
+                cmd_credits = ncmd;
+                waiter->credit_pending = false;
+                if( waiter->replies.size() >= static_cast<jau::nsize_t>(env.HCI_EVT_RING_CAPACITY) ) {
+                    WARN_PRINT("dev_id %u: IO RECV Drop (oldest reply of %zu, queue full) - %s",
+                            dev_id, waiter->replies.size(), toString().c_str());
+                    waiter->replies.erase(waiter->replies.cbegin());
+                }
+                waiter->replies.push_back( std::move( event ) );
+            }
         }
     }
-    return nullptr;
+    cv_cmdWaiters.notify_all(); // notify waiting commands and submitter
 }
 
-std::unique_ptr<HCIEvent> HCIHandler::getNextCmdCompleteReply(HCICommand &req, HCICommandCompleteEvent **res) noexcept {
-    const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
+std::unique_ptr<HCIEvent> HCIHandler::getNextReply(HCICommand &req, HCICmdWaiter& waiter, const jau::fraction_i64& replyTimeout) noexcept
+{
+    std::unique_ptr<HCIEvent> ev;
+    {
+        std::unique_lock<std::mutex> lock(mtx_cmdWaiters); // RAII-style acquire and relinquish via destructor
+        const jau::fraction_timespec timeout_time = jau::getMonotonicTime() + jau::fraction_timespec(replyTimeout);
+        while( waiter.replies.empty() && comm.is_open() ) {
+            std::cv_status s = wait_until(cv_cmdWaiters, lock, timeout_time);
+            if( std::cv_status::timeout == s && waiter.replies.empty() ) {
+                releaseCreditLocked(waiter); // unreplied command, return its credit now
+                break;
+            }
+        }
+        if( !waiter.replies.empty() ) {
+            ev = std::move( waiter.replies[0] );
+            waiter.replies.erase(waiter.replies.cbegin());
+        }
+    }
+    if( nullptr == ev ) {
+        errno = ETIMEDOUT;
+        ERR_PRINT("nullptr result (timeout %" PRIi64 " ms -> abort): req %s - %s", replyTimeout.to_ms(), req.toString().c_str(), toString().c_str());
+        return nullptr;
+    }
+    COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>-IO RECV getNextReply: res %s; req %s", dev_id, ev->toString().c_str(), req.toString().c_str());
+    return ev;
+}
 
+std::unique_ptr<HCIEvent> HCIHandler::getNextCmdCompleteReply(HCICommand &req, HCICmdWaiter& waiter, HCICommandCompleteEvent **res) noexcept {
     *res = nullptr;
 
     int32_t retryCount = 0;
     std::unique_ptr<HCIEvent> ev = nullptr;
 
     while( retryCount < env.HCI_READ_PACKET_MAX_RETRY ) {
-        ev = getNextReply(req, retryCount, env.HCI_COMMAND_COMPLETE_REPLY_TIMEOUT);
+        ev = getNextReply(req, waiter, env.HCI_COMMAND_COMPLETE_REPLY_TIMEOUT);
         if( nullptr == ev ) {
             break;  // timeout, leave loop
         } else if( ev->isEvent(HCIEventType::CMD_COMPLETE) ) {
@@ -691,21 +1245,45 @@ std::unique_ptr<HCIEvent> HCIHandler::getNextCmdCompleteReply(HCICommand &req, H
 }
 
 HCIHandler::HCIHandler(const uint16_t dev_id_, const BTMode btMode_) noexcept
+: HCIHandler(dev_id_, HCIComm::hci_open_dev(dev_id_, HCI_CHANNEL_RAW), false /* virtual_ctrl */, btMode_)
+{ }
+
+HCIHandler::HCIHandler(const uint16_t dev_id_, HCIVirtualController& ctrl, const BTMode btMode_) noexcept
+: HCIHandler(dev_id_, ctrl.takeHostSocket(), true /* virtual_ctrl */, btMode_)
+{ }
+
+HCIHandler::HCIHandler(const uint16_t dev_id_, const int socket_descriptor, const bool virtual_ctrl_, const BTMode btMode_) noexcept
 : env(HCIEnv::get()),
   dev_id(dev_id_),
-  rbuffer(HCI_MAX_MTU, jau::lb_endian_t::little),
-  comm(dev_id_, HCI_CHANNEL_RAW),
+  virtual_ctrl(virtual_ctrl_),
+  rbuffer(HCI_MAX_MTU * env.HCI_READER_BATCH_SIZE, jau::lb_endian_t::little),
+  rbuffer_lens(env.HCI_READER_BATCH_SIZE, 0),
+  comm(dev_id_, HCI_CHANNEL_RAW, socket_descriptor),
+  kfilter_metaev_mask(0), kfilter_scan_pending(false), kfilter_updates(0),
   hci_reader_service("HCIHandler::reader", THREAD_SHUTDOWN_TIMEOUT_MS,
                      jau::bind_member(this, &HCIHandler::hciReaderWork),
                      jau::service_runner::Callback() /* init */,
                      jau::bind_member(this, &HCIHandler::hciReaderEndLocked)),
-  hciEventRing(env.HCI_EVT_RING_CAPACITY),
+  cmd_credits(1), cmd_replies_unrouted(0),
+  hci_adv_service("HCIHandler::adv", THREAD_SHUTDOWN_TIMEOUT_MS,
+                  jau::bind_member(this, &HCIHandler::hciAdvWork),
+                  jau::service_runner::Callback() /* init */,
+                  jau::bind_member(this, &HCIHandler::hciAdvEndLocked)),
+  hciAdvRing(env.HCI_ADV_WORKER ? env.HCI_ADV_RING_CAPACITY : 1),
+  adv_reports_enqueued(0), adv_reports_dropped(0), adv_reports_coalesced(0), adv_reports_filtered(0),
+  eadReassembly(env.HCI_EAD_REASSEMBLY_TIMEOUT, static_cast<jau::nsize_t>(env.HCI_EAD_REASSEMBLY_BUDGET)),
+  scanFilterTracker(30_s, 1024),
+  replay_stats(nullptr),
   le_ll_feats( LE_Features::NONE ),
   sup_commands_set( false ),
+  ext_adv_max_sets( 0 ), ext_adv_max_data_len( 0 ),
   allowClose( comm.is_open() ),
   btMode(btMode_),
   currentScanType(ScanType::NONE),
-  advertisingEnabled(false)
+  advertisingEnabled(false),
+  advSetsEnabled{ 0, 0, 0, 0 },
+  periodicAdvSyncPending(false),
+  periodic_reports(0)
 {
     zeroSupCommands();
 
@@ -715,8 +1293,20 @@ HCIHandler::HCIHandler(const uint16_t dev_id_, const BTMode btMode_) noexcept
         return;
     }
 
+    if( !env.HCI_SNOOP_FILE.empty() ) {
+        std::shared_ptr<BTSnoopWriter> snoop = std::make_shared<BTSnoopWriter>(env.HCI_SNOOP_FILE+"-hci"+std::to_string(dev_id)+".btsnoop");
+        if( snoop->is_open() ) {
+            WORDY_PRINT("HCIHandler<%hu>.ctor: Capturing to %s", dev_id, snoop->getFilename().c_str());
+            comm.set_snoop( std::move(snoop) );
+        }
+    }
     comm.set_interrupted_query( jau::bind_member(&hci_reader_service, &jau::service_runner::shall_stop2) );
+    // Own reader thread, not the shared IOReactor: HCI command replies must be received
+    // while a reactor dispatched callback blocks on an HCI command.
     hci_reader_service.start();
+    if( env.HCI_ADV_WORKER ) {
+        hci_adv_service.start();
+    }
 
     PERF_TS_T0();
 
@@ -737,54 +1327,11 @@ HCIHandler::HCIHandler(const uint16_t dev_id_, const BTMode btMode_) noexcept
 
 #define FILTER_ALL_EVENTS 0
 
-    // Mandatory socket filter (not adapter filter!)
-    {
-#if 0
-        // No use for pre-existing hci_ufilter
-        hci_ufilter of;
-        socklen_t olen;
-
-        olen = sizeof(of);
-        if (getsockopt(comm.socket(), SOL_HCI, HCI_FILTER, &of, &olen) < 0) {
-            ERR_PRINT("getsockopt %s", toString().c_str());
-            goto fail;
-        }
-#endif
-        HCIComm::filter_clear(&filter_mask);
-        if constexpr ( CONSIDER_HCI_CMD_FOR_SMP_STATE ) {
-            // Currently only used to determine ENCRYPTION STATE, if at all.
-            HCIComm::filter_set_ptype(number(HCIPacketType::COMMAND), &filter_mask); // COMMANDs
-        }
-        HCIComm::filter_set_ptype(number(HCIPacketType::EVENT),  &filter_mask); // EVENTs
-        HCIComm::filter_set_ptype(number(HCIPacketType::ACLDATA),  &filter_mask); // SMP via ACL DATA
-
-        // Setup generic filter mask for all events, this is also required for
-#if FILTER_ALL_EVENTS
-        HCIComm::filter_all_events(&filter_mask); // all events
-#else
-        HCIComm::filter_set_event(number(HCIEventType::CONN_COMPLETE), &filter_mask);
-        HCIComm::filter_set_event(number(HCIEventType::DISCONN_COMPLETE), &filter_mask);
-        HCIComm::filter_set_event(number(HCIEventType::AUTH_COMPLETE), &filter_mask);
-        HCIComm::filter_set_event(number(HCIEventType::ENCRYPT_CHANGE), &filter_mask);
-        HCIComm::filter_set_event(number(HCIEventType::CMD_COMPLETE), &filter_mask);
-        HCIComm::filter_set_event(number(HCIEventType::CMD_STATUS), &filter_mask);
-        HCIComm::filter_set_event(number(HCIEventType::HARDWARE_ERROR), &filter_mask);
-        HCIComm::filter_set_event(number(HCIEventType::ENCRYPT_KEY_REFRESH_COMPLETE), &filter_mask);
-
-        // HCIComm::filter_set_event(number(HCIEventType::IO_CAPABILITY_REQUEST), &filter_mask);
-        // HCIComm::filter_set_event(number(HCIEventType::IO_CAPABILITY_RESPONSE), &filter_mask);
-        HCIComm::filter_set_event(number(HCIEventType::LE_META), &filter_mask);
-        // HCIComm::filter_set_event(number(HCIEventType::DISCONN_PHY_LINK_COMPLETE), &filter_mask);
-        // HCIComm::filter_set_event(number(HCIEventType::DISCONN_LOGICAL_LINK_COMPLETE), &filter_mask);
-#endif
-        HCIComm::filter_set_opcode(0, &filter_mask); // all opcode
-
-        if (setsockopt(comm.socket(), SOL_HCI, HCI_FILTER, &filter_mask, sizeof(filter_mask)) < 0) {
-            ERR_PRINT("setsockopt HCI_FILTER %s", toString().c_str());
-            goto fail;
-        }
+    // Mandatory socket filter (not adapter filter!), derived from callbacks, scan, advertising and connection state
+    if( !updateEventFilter() ) {
+        goto fail;
     }
-    // Mandatory own LE_META filter
+    // Mandatory own LE_META filter of all processed meta events, the kernel filter passes only the wanted subset
     {
         uint32_t mask = 0;
 #if FILTER_ALL_EVENTS
@@ -797,6 +1344,10 @@ HCIHandler::HCIHandler(const uint16_t dev_id_, const BTMode btMode_) noexcept
         filter_set_metaev(HCIMetaEventType::LE_EXT_CONN_COMPLETE, mask);
         filter_set_metaev(HCIMetaEventType::LE_PHY_UPDATE_COMPLETE, mask);
         filter_set_metaev(HCIMetaEventType::LE_EXT_ADV_REPORT, mask);
+        filter_set_metaev(HCIMetaEventType::LE_PERIODIC_ADV_SYNC_ESTABLISHED, mask);
+        filter_set_metaev(HCIMetaEventType::LE_PERIODIC_ADV_REPORT, mask);
+        filter_set_metaev(HCIMetaEventType::LE_PERIODIC_ADV_SYNC_LOST, mask);
+        filter_set_metaev(HCIMetaEventType::LE_ADV_SET_TERMINATED, mask);
         // filter_set_metaev(HCIMetaEventType::LE_CHANNEL_SEL_ALGO, mask);
 
 #endif
@@ -836,6 +1387,9 @@ HCIHandler::HCIHandler(const uint16_t dev_id_, const BTMode btMode_) noexcept
         filter_set_opcbit(HCIOpcodeBit::LE_SET_EXT_SCAN_PARAMS, mask);
         filter_set_opcbit(HCIOpcodeBit::LE_SET_EXT_SCAN_ENABLE, mask);
         filter_set_opcbit(HCIOpcodeBit::LE_EXT_CREATE_CONN, mask);
+        filter_set_opcbit(HCIOpcodeBit::LE_PERIODIC_ADV_CREATE_SYNC, mask);
+        filter_set_opcbit(HCIOpcodeBit::LE_PERIODIC_ADV_CREATE_SYNC_CANCEL, mask);
+        filter_set_opcbit(HCIOpcodeBit::LE_PERIODIC_ADV_TERMINATE_SYNC, mask);
 #endif
         filter_put_opcbit(mask);
     }
@@ -852,10 +1406,148 @@ fail:
     return;
 }
 
+/**
+ * Builds the classic BPF socket filter passing all but the LE meta events not contained in metaev_mask,
+ * bit `n-1` for HCIMetaEventType value `n`.
+ * <p>
+ * The filter sees each packet as read, i.e. leading HCIPacketType, event code, parameter length and subevent code.
+ * </p>
+ */
+static bool attachMetaEventFilter(const int sd, const uint32_t metaev_mask) noexcept {
+    struct ::sock_filter code[] = {
+        /*  0 */ BPF_STMT(BPF_LD  | BPF_B   | BPF_ABS, 0),                                            // A = packet type
+        /*  1 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,   number(HCIPacketType::EVENT), 0, 10),        // !EVENT -> accept
+        /*  2 */ BPF_STMT(BPF_LD  | BPF_B   | BPF_ABS, 1),                                            // A = event code
+        /*  3 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,   number(HCIEventType::LE_META), 0, 8),        // !LE_META -> accept
+        /*  4 */ BPF_STMT(BPF_LD  | BPF_B   | BPF_ABS, 3),                                            // A = subevent code
+        /*  5 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,   0, 7, 0),                                      // 0 -> drop
+        /*  6 */ BPF_JUMP(BPF_JMP | BPF_JGT | BPF_K,   32, 6, 0),                                     // > 32 -> drop
+        /*  7 */ BPF_STMT(BPF_ALU | BPF_SUB | BPF_K,   1),
+        /*  8 */ BPF_STMT(BPF_MISC| BPF_TAX,           0),                                            // X = subevent - 1
+        /*  9 */ BPF_STMT(BPF_LD  | BPF_IMM,           1),
+        /* 10 */ BPF_STMT(BPF_ALU | BPF_LSH | BPF_X,   0),                                            // A = 1 << X
+        /* 11 */ BPF_JUMP(BPF_JMP | BPF_JSET| BPF_K,   metaev_mask, 0, 1),                            // in mask -> accept, else drop
+        /* 12 */ BPF_STMT(BPF_RET | BPF_K,             0xffffffffU),                                  // accept
+        /* 13 */ BPF_STMT(BPF_RET | BPF_K,             0)                                             // drop
+    };
+    struct ::sock_fprog prog;
+    prog.len = sizeof(code) / sizeof(code[0]);
+    prog.filter = code;
+    return 0 <= ::setsockopt(sd, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog));
+}
+
+bool HCIHandler::updateEventFilter() noexcept {
+    if( !comm.is_open() ) {
+        return false;
+    }
+    const std::lock_guard<std::recursive_mutex> lock_conn(mtx_connectionList); // RAII-style acquire and relinquish via destructor
+    const std::lock_guard<std::mutex> lock(mtx_filter); // RAII-style acquire and relinquish via destructor
+
+    const bool all = FILTER_ALL_EVENTS || !env.HCI_KERNEL_FILTER;
+    auto wanted = [&](const MgmtEvent::Opcode opc) -> bool {
+        return all || 0 < mgmtEventCallbackLists[static_cast<uint16_t>(opc)].size();
+    };
+    const bool scanning = all || is_set(currentScanType, ScanType::LE) || kfilter_scan_pending;
+    bool periodic = all || periodicAdvSyncPending;
+    if( !periodic ) {
+        const std::lock_guard<std::mutex> lock_sync(mtx_periodicAdvSync); // RAII-style acquire and relinquish via destructor
+        periodic = !periodicAdvSyncs.empty();
+    }
+
+    hci_ufilter mask;
+    HCIComm::filter_clear(&mask);
+    if constexpr ( CONSIDER_HCI_CMD_FOR_SMP_STATE ) {
+        // Currently only used to determine ENCRYPTION STATE, if at all.
+        HCIComm::filter_set_ptype(number(HCIPacketType::COMMAND), &mask); // COMMANDs
+    }
+    HCIComm::filter_set_ptype(number(HCIPacketType::EVENT),  &mask); // EVENTs
+    HCIComm::filter_set_ptype(number(HCIPacketType::ACLDATA),  &mask); // SMP via ACL DATA
+
+    // Always required: command flow, connection tracking and controller failure
+    HCIComm::filter_set_event(number(HCIEventType::CONN_COMPLETE), &mask);
+    HCIComm::filter_set_event(number(HCIEventType::DISCONN_COMPLETE), &mask);
+    HCIComm::filter_set_event(number(HCIEventType::CMD_COMPLETE), &mask);
+    HCIComm::filter_set_event(number(HCIEventType::CMD_STATUS), &mask);
+    HCIComm::filter_set_event(number(HCIEventType::HARDWARE_ERROR), &mask);
+    HCIComm::filter_set_event(number(HCIEventType::LE_META), &mask);
+    if( all ) {
+        HCIComm::filter_set_event(number(HCIEventType::AUTH_COMPLETE), &mask);
+    }
+    // Connection related events pass regardless of the connection state: they are rare and may follow a connection
+    // not initiated by this host, e.g. via the whitelist, ahead of its tracking.
+    if( wanted(MgmtEvent::Opcode::HCI_ENC_CHANGED) ) {
+        HCIComm::filter_set_event(number(HCIEventType::ENCRYPT_CHANGE), &mask);
+    }
+    if( wanted(MgmtEvent::Opcode::HCI_ENC_KEY_REFRESH_COMPLETE) ) {
+        HCIComm::filter_set_event(number(HCIEventType::ENCRYPT_KEY_REFRESH_COMPLETE), &mask);
+    }
+    HCIComm::filter_set_opcode(0, &mask); // all opcode
+
+    uint32_t metaev_mask = 0;
+    filter_set_metaev(HCIMetaEventType::LE_CONN_COMPLETE, metaev_mask);
+    filter_set_metaev(HCIMetaEventType::LE_EXT_CONN_COMPLETE, metaev_mask);
+    filter_set_metaev(HCIMetaEventType::LE_ADV_SET_TERMINATED, metaev_mask);
+    if( scanning && wanted(MgmtEvent::Opcode::DEVICE_FOUND) ) {
+        filter_set_metaev(HCIMetaEventType::LE_ADVERTISING_REPORT, metaev_mask);
+        filter_set_metaev(HCIMetaEventType::LE_EXT_ADV_REPORT, metaev_mask);
+    }
+    if( periodic ) {
+        filter_set_metaev(HCIMetaEventType::LE_PERIODIC_ADV_SYNC_ESTABLISHED, metaev_mask);
+        filter_set_metaev(HCIMetaEventType::LE_PERIODIC_ADV_REPORT, metaev_mask);
+        filter_set_metaev(HCIMetaEventType::LE_PERIODIC_ADV_SYNC_LOST, metaev_mask);
+    }
+    if( wanted(MgmtEvent::Opcode::HCI_LE_REMOTE_FEATURES) ) {
+        filter_set_metaev(HCIMetaEventType::LE_REMOTE_FEAT_COMPLETE, metaev_mask);
+    }
+    if( wanted(MgmtEvent::Opcode::HCI_LE_LTK_REQUEST) ) {
+        filter_set_metaev(HCIMetaEventType::LE_LTK_REQUEST, metaev_mask);
+    }
+    if( wanted(MgmtEvent::Opcode::HCI_LE_PHY_UPDATE_COMPLETE) ) {
+        filter_set_metaev(HCIMetaEventType::LE_PHY_UPDATE_COMPLETE, metaev_mask);
+    }
+
+    if( 0 != ::memcmp(&mask, &filter_mask, sizeof(mask)) || 0 == kfilter_updates ) {
+        if ( !virtual_ctrl && setsockopt(comm.socket(), SOL_HCI, HCI_FILTER, &mask, sizeof(mask)) < 0) {
+            ERR_PRINT("setsockopt HCI_FILTER %s", toString().c_str());
+            return false;
+        }
+        filter_mask = mask;
+    }
+    if( all ) {
+        metaev_mask = 0; // no BPF filter
+    }
+    if( metaev_mask != kfilter_metaev_mask ) {
+        if( 0 == metaev_mask ) {
+            int dummy = 0;
+            ::setsockopt(comm.socket(), SOL_SOCKET, SO_DETACH_FILTER, &dummy, sizeof(dummy));
+        } else if( !attachMetaEventFilter(comm.socket(), metaev_mask) ) {
+            WARN_PRINT("dev_id %u: setsockopt SO_ATTACH_FILTER failed, LE meta events filtered in user space: %s", dev_id, toString().c_str());
+            metaev_mask = 0;
+        }
+        kfilter_metaev_mask = metaev_mask;
+    }
+    ++kfilter_updates;
+    COND_PRINT(env.DEBUG_EVENT, "HCIHandler<%hu>::updateEventFilter: events %08x %08x, meta %08x, scan %d, periodic %d",
+            dev_id, filter_mask.event_mask[0], filter_mask.event_mask[1], kfilter_metaev_mask, scanning, periodic);
+    return true;
+}
+
+uint32_t HCIHandler::getKernelMetaEventFilter() noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_filter); // RAII-style acquire and relinquish via destructor
+    return kfilter_metaev_mask;
+}
+
+void HCIHandler::setCurrentScanType(const ScanType v) noexcept {
+    currentScanType = v;
+    updateEventFilter();
+}
+
 void HCIHandler::zeroSupCommands() noexcept {
     jau::zero_bytes_sec(sup_commands, sizeof(sup_commands));
     sup_commands_set = false;
     le_ll_feats = LE_Features::NONE;
+    ext_adv_max_sets = 0;
+    ext_adv_max_data_len = 0;
 }
 bool HCIHandler::initSupCommands() noexcept {
     // We avoid using a lock or an atomic-switch as we rely on sensible calls.
@@ -865,23 +1557,32 @@ bool HCIHandler::initSupCommands() noexcept {
     }
     HCIStatusCode status;
 
+    // Both independent queries are submitted upfront, pipelined if the controller grants more than one command credit
+    HCICommand req0(HCIOpcode::LE_READ_LOCAL_FEATURES, 0);
+    HCICmdWaiter waiter0(*this, req0.getOpcode());
+    HCICommand req1(HCIOpcode::READ_LOCAL_COMMANDS, 0);
+    HCICmdWaiter waiter1(*this, req1.getOpcode());
+    if( !submitCommand(req0, waiter0, true /* quiet */) || !submitCommand(req1, waiter1, true /* quiet */) ) {
+        DBG_PRINT("HCIHandler<%hu>::initSupCommands: Send failed - %s", dev_id, toString().c_str());
+        zeroSupCommands();
+        return false;
+    }
+
     le_ll_feats = LE_Features::NONE;
     {
-        HCICommand req0(HCIOpcode::LE_READ_LOCAL_FEATURES, 0);
         const hci_rp_le_read_local_features * ev_lf;
-        std::unique_ptr<HCIEvent> ev = processCommandComplete(req0, &ev_lf, &status, true /* quiet */);
+        std::unique_ptr<HCIEvent> ev = receiveCommandComplete(req0, waiter0, &ev_lf, &status, true /* quiet */);
         if( nullptr == ev || nullptr == ev_lf || HCIStatusCode::SUCCESS != status ) {
             DBG_PRINT("HCIHandler<%hu>::initSupCommands: LE_READ_LOCAL_FEATURES: 0x%x (%s) - %s",
-                    number(status), to_string(status).c_str(), toString().c_str());
+                    dev_id, number(status), to_string(status).c_str(), toString().c_str());
             zeroSupCommands();
             return false;
         }
         le_ll_feats = static_cast<LE_Features>( jau::get_uint64(ev_lf->features + 0, jau::lb_endian_t::little) );
     }
 
-    HCICommand req0(HCIOpcode::READ_LOCAL_COMMANDS, 0);
     const hci_rp_read_local_commands * ev_cmds;
-    std::unique_ptr<HCIEvent> ev = processCommandComplete(req0, &ev_cmds, &status, true /* quiet */);
+    std::unique_ptr<HCIEvent> ev = receiveCommandComplete(req1, waiter1, &ev_cmds, &status, true /* quiet */);
     if( nullptr == ev || nullptr == ev_cmds || HCIStatusCode::SUCCESS != status ) {
         DBG_PRINT("HCIHandler<%hu>::initSupCommands: READ_LOCAL_COMMANDS: 0x%x (%s) - %s",
                 dev_id, number(status), to_string(status).c_str(), toString().c_str());
@@ -959,6 +1660,7 @@ void HCIHandler::close() noexcept {
     if( !allowClose.compare_exchange_strong(expConn, false) ) {
         // not open
         const bool hci_service_stopped = hci_reader_service.join(); // [data] race: wait until disconnecting thread has stopped service
+        hci_adv_service.join();
         comm.close();
         DBG_PRINT("HCIHandler<%hu>::close: Not open: stopped %d, %s", dev_id, hci_service_stopped, toString().c_str());
         clearAllCallbacks();
@@ -974,7 +1676,9 @@ void HCIHandler::close() noexcept {
 
     PERF_TS_TD("HCIHandler::close.1");
     hci_reader_service.stop();
+    hci_adv_service.stop();
     comm.close();
+    cv_cmdWaiters.notify_all(); // release waiting commands
     PERF_TS_TD("HCIHandler::close.X");
 
     DBG_PRINT("HCIHandler<%hu>::close: End %s", dev_id, toString().c_str());
@@ -984,7 +1688,9 @@ std::string HCIHandler::toString() const noexcept {
     return "HCIHandler["+std::to_string(dev_id)+", BTMode "+to_string(btMode)+", open "+std::to_string(isOpen())+
             ", adv "+std::to_string(advertisingEnabled)+", scan "+to_string(currentScanType)+
             ", ext[init "+std::to_string(sup_commands_set)+", adv "+std::to_string(use_ext_adv())+", scan "+std::to_string(use_ext_scan())+", conn "+std::to_string(use_ext_conn())+
-            "], ring[entries "+std::to_string(hciEventRing.size())+"]]";
+            "], cmd[credits "+std::to_string(cmd_credits)+", unrouted "+std::to_string(cmd_replies_unrouted)+"]"+
+            ( env.HCI_ADV_WORKER ? ", adv-ring[entries "+std::to_string(hciAdvRing.size())+", dropped "+std::to_string(adv_reports_dropped.load())+
+                                   ", coalesced "+std::to_string(adv_reports_coalesced.load())+"]" : "" )+"]";
 }
 
 HCIStatusCode HCIHandler::startAdapter() {
@@ -997,6 +1703,9 @@ HCIStatusCode HCIHandler::startAdapter() {
     const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
     DBG_PRINT("HCIHandler<%hu>::startAdapter.0: %s", dev_id, toString().c_str());
 
+    if( virtual_ctrl ) {
+        res = resetHCI();
+    } else {
     #if defined(__linux__)
         int res_ioctl;
         if( ( res_ioctl = ioctl(comm.socket(), HCIDEVUP, dev_id) ) < 0 ) {
@@ -1015,6 +1724,7 @@ HCIStatusCode HCIHandler::startAdapter() {
         #warning add implementation
         ABORT("add implementation");
     #endif
+    }
     if( HCIStatusCode::SUCCESS == res ) {
         res = resetAllStates(true) ? HCIStatusCode::SUCCESS : HCIStatusCode::FAILED;
     }
@@ -1032,6 +1742,9 @@ HCIStatusCode HCIHandler::stopAdapter() {
     const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
     DBG_PRINT("HCIHandler<%hu>::stopAdapter.0: %s", dev_id, toString().c_str());
 
+    if( virtual_ctrl ) {
+        res = resetHCI();
+    } else {
     #if defined(__linux__)
         int res_ioctl;
         if( ( res_ioctl = ioctl(comm.socket(), HCIDEVDOWN, dev_id) ) < 0) {
@@ -1046,6 +1759,7 @@ HCIStatusCode HCIHandler::stopAdapter() {
         #warning add implementation
         ABORT("add implementation");
     #endif
+    }
     if( HCIStatusCode::SUCCESS == res ) {
         resetAllStates(false);
     }
@@ -1095,7 +1809,13 @@ bool HCIHandler::resetAllStates(const bool powered_on) noexcept {
     connectionList.clear();
     disconnectCmdList.clear();
     currentScanType = ScanType::NONE;
-    advertisingEnabled = false;
+    setAdvSetsEnabled(false, nullptr, 0);
+    periodicAdvSyncPending = false;
+    {
+        const std::lock_guard<std::mutex> lock_sync(mtx_periodicAdvSync); // RAII-style acquire and relinquish via destructor
+        periodicAdvSyncs.clear();
+    }
+    updateEventFilter();
     zeroSupCommands();
     if( powered_on ) {
         return initSupCommands();
@@ -1152,6 +1872,8 @@ HCIStatusCode HCIHandler::le_set_scan_param(const bool le_scan_active,
         ERR_PRINT("Not connected %s", toString().c_str());
         return HCIStatusCode::DISCONNECTED;
     }
+    const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
+
     if( is_set(currentScanType, ScanType::LE) ) {
         WARN_PRINT("Not allowed: LE Scan Enabled: %s - tried scan [interval %.3f ms, window %.3f ms]",
                 toString().c_str(), 0.625f * (float)le_scan_interval, 0.625f * (float)le_scan_window);
@@ -1216,6 +1938,11 @@ HCIStatusCode HCIHandler::le_enable_scan(const bool enable, const bool filter_du
 
     HCIStatusCode status;
     if( currentScanType != nextScanType ) {
+        if( enable ) {
+            // pass advertising reports ahead of the enabled scan
+            kfilter_scan_pending = true;
+            updateEventFilter();
+        }
         if( use_ext_scan() ) {
             HCIStructCommand<hci_cp_le_set_ext_scan_enable> req0(HCIOpcode::LE_SET_EXT_SCAN_ENABLE);
             hci_cp_le_set_ext_scan_enable * cp = req0.getWStruct();
@@ -1241,6 +1968,12 @@ HCIStatusCode HCIHandler::le_enable_scan(const bool enable, const bool filter_du
 
     if( HCIStatusCode::SUCCESS == status ) {
         currentScanType = nextScanType;
+    }
+    if( kfilter_scan_pending || HCIStatusCode::SUCCESS == status ) {
+        kfilter_scan_pending = false;
+        updateEventFilter();
+    }
+    if( HCIStatusCode::SUCCESS == status ) {
         const MgmtEvtDiscovering e(dev_id, ScanType::LE, enable);
         sendMgmtEvent( e );
     }
@@ -1413,6 +2146,116 @@ HCIStatusCode HCIHandler::le_create_conn(const EUI48 &peer_bdaddr,
     return status;
 }
 
+HCIStatusCode HCIHandler::le_create_periodic_adv_sync(const BDAddressAndType& address, const uint8_t adv_sid,
+                                                       const uint16_t skip, const uint16_t sync_timeout) noexcept {
+    if( !isOpen() ) {
+        ERR_PRINT("Not connected %s", toString().c_str());
+        return HCIStatusCode::DISCONNECTED;
+    }
+    if( !use_periodic_adv_sync() ) {
+        WARN_PRINT("dev_id %u: Not supported by controller %s", dev_id, toString().c_str());
+        return HCIStatusCode::UNKNOWN_COMMAND;
+    }
+    if( BDAddressType::BDADDR_LE_PUBLIC != address.type && BDAddressType::BDADDR_LE_RANDOM != address.type ) {
+        WARN_PRINT("dev_id %u: Not an LE address %s", dev_id, address.toString().c_str());
+        return HCIStatusCode::INVALID_PARAMS;
+    }
+    const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
+
+    if( periodicAdvSyncPending ) {
+        WARN_PRINT("dev_id %u: Not allowed: Create sync pending %s", dev_id, toString().c_str());
+        return HCIStatusCode::COMMAND_DISALLOWED;
+    }
+    struct le_periodic_adv_create_sync {
+        __u8      options;
+        __u8      sid;
+        __u8      addr_type;
+        bdaddr_t  addr;
+        __le16    skip;
+        __le16    sync_timeout;
+        __u8      sync_cte_type;
+    } __packed;
+    HCIStructCommand<le_periodic_adv_create_sync> req0(HCIOpcode::LE_PERIODIC_ADV_CREATE_SYNC);
+    le_periodic_adv_create_sync * cp = req0.getWStruct();
+    cp->options = 0; // use given advertiser, reporting enabled
+    cp->sid = adv_sid;
+    cp->addr_type = BDAddressType::BDADDR_LE_PUBLIC == address.type ? 0x00 : 0x01;
+    cp->addr = jau::cpu_to_le(address.address);
+    cp->skip = jau::cpu_to_le(skip);
+    cp->sync_timeout = jau::cpu_to_le(sync_timeout);
+    cp->sync_cte_type = 0; // no CTE restrictions
+
+    // pass the sync events ahead of the command
+    periodicAdvSyncPending = true;
+    updateEventFilter();
+
+    HCIStatusCode status;
+    std::unique_ptr<HCIEvent> ev = processCommandStatus(req0, &status);
+    // Events on successful sync:
+    // - HCI_LE_Periodic_Advertising_Sync_Established
+    // - HCI_LE_Periodic_Advertising_Report
+    if( HCIStatusCode::SUCCESS != status ) {
+        ERR_PRINT("%s: 0x%x (%s) - %s", to_string(req0.getOpcode()).c_str(), number(status), to_string(status).c_str(), toString().c_str());
+        periodicAdvSyncPending = false;
+        updateEventFilter();
+    }
+    return status;
+}
+
+HCIStatusCode HCIHandler::le_cancel_periodic_adv_sync() noexcept {
+    if( !isOpen() ) {
+        ERR_PRINT("Not connected %s", toString().c_str());
+        return HCIStatusCode::DISCONNECTED;
+    }
+    if( !use_periodic_adv_sync() ) {
+        return HCIStatusCode::UNKNOWN_COMMAND;
+    }
+    const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
+
+    HCICommand req0(HCIOpcode::LE_PERIODIC_ADV_CREATE_SYNC_CANCEL, 0);
+    const hci_rp_status * ev_status;
+    HCIStatusCode status;
+    std::unique_ptr<HCIEvent> ev = processCommandComplete(req0, &ev_status, &status);
+    // Sync_Established with HCIStatusCode::OPERATION_CANCELLED_BY_HOST follows, clearing periodicAdvSyncPending
+    if( nullptr == ev || HCIStatusCode::SUCCESS != status ) {
+        WARN_PRINT("%s: 0x%x (%s) - %s", to_string(req0.getOpcode()).c_str(), number(status), to_string(status).c_str(), toString().c_str());
+    }
+    return status;
+}
+
+HCIStatusCode HCIHandler::le_terminate_periodic_adv_sync(const uint16_t sync_handle) noexcept {
+    if( !isOpen() ) {
+        ERR_PRINT("Not connected %s", toString().c_str());
+        return HCIStatusCode::DISCONNECTED;
+    }
+    if( !use_periodic_adv_sync() ) {
+        return HCIStatusCode::UNKNOWN_COMMAND;
+    }
+    const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
+
+    struct le_periodic_adv_terminate_sync {
+        __le16    handle;
+    } __packed;
+    HCIStructCommand<le_periodic_adv_terminate_sync> req0(HCIOpcode::LE_PERIODIC_ADV_TERMINATE_SYNC);
+    le_periodic_adv_terminate_sync * cp = req0.getWStruct();
+    cp->handle = jau::cpu_to_le(sync_handle);
+    const hci_rp_status * ev_status;
+    HCIStatusCode status;
+    std::unique_ptr<HCIEvent> ev = processCommandComplete(req0, &ev_status, &status);
+    if( nullptr == ev || HCIStatusCode::SUCCESS != status ) {
+        WARN_PRINT("%s: 0x%x (%s) - %s", to_string(req0.getOpcode()).c_str(), number(status), to_string(status).c_str(), toString().c_str());
+        return status;
+    }
+    PeriodicAdvSync s;
+    if( removePeriodicAdvSync(sync_handle, s) ) {
+        updateEventFilter();
+        jau::for_each_fidelity(hciPeriodicAdvSyncCallbackList, [&](HCIPeriodicAdvSyncCallback &cb) {
+            cb(s);
+        });
+    }
+    return status;
+}
+
 HCIStatusCode HCIHandler::create_conn(const EUI48 &bdaddr,
                                      const uint16_t pkt_type,
                                      const uint16_t clock_offset, const uint8_t role_switch) noexcept {
@@ -1786,6 +2629,7 @@ HCIStatusCode HCIHandler::le_set_adv_param(const EUI48 &peer_bdaddr,
     DBG_PRINT("HCIHandler<%hu>::le_set_adv_param: adv-interval[%.3f ms .. %.3f ms], filter %d - %s",
             dev_id, 0.625f * (float)adv_interval_min, 0.625f * (float)adv_interval_max,
             filter_policy, toString().c_str());
+    const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
 
     HCIStatusCode status;
     if( use_ext_adv() ) {
@@ -1860,6 +2704,7 @@ HCIStatusCode HCIHandler::le_set_adv_param(const EUI48 &peer_bdaddr,
 HCIStatusCode HCIHandler::le_set_adv_data(const EInfoReport &eir, const EIRDataType mask) noexcept {
     DBG_PRINT("HCIHandler<%hu>::le_set_adv_data: eir %s, mask %s",
         dev_id, eir.toString(true).c_str(), to_string(mask).c_str());
+    const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
 
     HCIStatusCode status;
     if( use_ext_adv() ) {
@@ -1892,6 +2737,7 @@ HCIStatusCode HCIHandler::le_set_adv_data(const EInfoReport &eir, const EIRDataT
 
 HCIStatusCode HCIHandler::le_set_scanrsp_data(const EInfoReport &eir, const EIRDataType mask) noexcept {
     DBG_PRINT("HCIHandler<%hu>::le_set_scanrsp_data: %s", dev_id, eir.toString(true).c_str());
+    const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
 
     HCIStatusCode status;
     if( use_ext_adv() ) {
@@ -1923,6 +2769,11 @@ HCIStatusCode HCIHandler::le_set_scanrsp_data(const EInfoReport &eir, const EIRD
 }
 
 HCIStatusCode HCIHandler::le_enable_adv(const bool enable) noexcept {
+    const uint8_t handle = 0x00;
+    return le_enable_adv_sets(enable, &handle, 1);
+}
+
+HCIStatusCode HCIHandler::le_enable_adv_sets(const bool enable, const uint8_t* handles, const jau::nsize_t count) noexcept {
     if( !isOpen() ) {
         ERR_PRINT("Not connected %s", toString().c_str());
         return HCIStatusCode::DISCONNECTED;
@@ -1934,32 +2785,36 @@ HCIStatusCode HCIHandler::le_enable_adv(const bool enable) noexcept {
             WARN_PRINT("Not allowed (scan enabled): %s", toString().c_str());
             return HCIStatusCode::COMMAND_DISALLOWED;
         }
-        const size_type connCount = getTrackerConnectionCount();
+        const size_type connCount = use_ext_adv() ? 0 : getTrackerConnectionCount(); // extended sets continue while connected
         if( 0 < connCount ) {
             WARN_PRINT("Not allowed (%zu connections open/pending): %s", (size_t)connCount, toString().c_str());
             return HCIStatusCode::COMMAND_DISALLOWED;
         }
     }
-    DBG_PRINT("HCIHandler<%hu>::le_enable_adv: enable %d - %s", dev_id, enable, toString().c_str());
+    DBG_PRINT("HCIHandler<%hu>::le_enable_adv: enable %d, sets %u - %s", dev_id, enable, count, toString().c_str());
 
     HCIStatusCode status = HCIStatusCode::SUCCESS;
 
     if( use_ext_adv() ) {
         const hci_rp_status * ev_status;
         if( enable ) {
-            struct hci_cp_le_set_ext_adv_enable_1 {
+            struct hci_cp_le_set_ext_adv_enable_n {
                 __u8  enable;
                 __u8  num_of_sets;
-                hci_cp_ext_adv_set sets[1];
+                hci_cp_ext_adv_set sets[0x3F];
             } __packed;
 
-            HCIStructCommand<hci_cp_le_set_ext_adv_enable_1> req0(HCIOpcode::LE_SET_EXT_ADV_ENABLE);
-            hci_cp_le_set_ext_adv_enable_1 * cp = req0.getWStruct();
+            HCIStructCommand<hci_cp_le_set_ext_adv_enable_n> req0(HCIOpcode::LE_SET_EXT_ADV_ENABLE);
+            hci_cp_le_set_ext_adv_enable_n * cp = req0.getWStruct();
+            const jau::nsize_t num_of_sets = std::min<jau::nsize_t>(count, 0x3F);
             cp->enable = 0x01;
-            cp->num_of_sets = 1;
-            cp->sets[0].handle = 0x00;
-            cp->sets[0].duration = 0; // continue adv until host disables
-            cp->sets[0].max_events = 0; // no maximum number of adv events
+            cp->num_of_sets = static_cast<uint8_t>(num_of_sets);
+            for(jau::nsize_t i=0; i<num_of_sets; ++i) {
+                cp->sets[i].handle = handles[i];
+                cp->sets[i].duration = 0; // continue adv until host disables
+                cp->sets[i].max_events = 0; // no maximum number of adv events
+            }
+            req0.trimParamSize( 2 + num_of_sets * sizeof(hci_cp_ext_adv_set) );
             std::unique_ptr<HCIEvent> ev = processCommandComplete(req0, &ev_status, &status);
         } else {
             HCIStructCommand<hci_cp_le_set_ext_adv_enable> req0(HCIOpcode::LE_SET_EXT_ADV_ENABLE);
@@ -1979,7 +2834,12 @@ HCIStatusCode HCIHandler::le_enable_adv(const bool enable) noexcept {
         std::unique_ptr<HCIEvent> ev = processCommandComplete(req0, &ev_status, &status);
     }
     if( HCIStatusCode::SUCCESS == status ) {
-        advertisingEnabled = enable;
+        if( enable ) {
+            const uint8_t legacy_handle = 0x00;
+            setAdvSetsEnabled(true, use_ext_adv() ? handles : &legacy_handle, use_ext_adv() ? count : 1);
+        } else {
+            setAdvSetsEnabled(false, nullptr, 0); // all sets disabled
+        }
     } else if( advertisingEnabled == enable ) {
         // Override erroneous HCI failure when
         // - disabling advertising when already disabled, or
@@ -2052,21 +2912,315 @@ HCIStatusCode HCIHandler::le_start_adv(const EInfoReport &eir,
     return status;
 }
 
-std::unique_ptr<HCIEvent> HCIHandler::processCommandStatus(HCICommand &req, HCIStatusCode *status, const bool quiet) noexcept
-{
+static uint8_t to_hci_adv_phy(const LE_PHYs phy) noexcept {
+    switch( phy ) {
+        case LE_PHYs::LE_2M: return 0x02;
+        case LE_PHYs::LE_CODED: return 0x03;
+        default: return 0x01;
+    }
+}
+
+uint16_t ExtAdvSet::getEventProperties() const noexcept {
+    if( legacy_pdu ) {
+        if( isConnectable() ) {
+            return number(AD_PDU_Type::ADV_IND2);
+        } else if( isScannable() ) {
+            return number(AD_PDU_Type::SCAN_IND2);
+        } else {
+            return number(AD_PDU_Type::NONCONN_IND2);
+        }
+    }
+    // Extended PDUs are either connectable (bit 0) or scannable (bit 1)
+    if( isConnectable() ) {
+        return 0x0001;
+    } else if( isScannable() ) {
+        return 0x0002;
+    } else {
+        return 0x0000;
+    }
+}
+
+HCIStatusCode ExtAdvSet::validate() const noexcept {
+    switch( adv_type ) {
+        case AD_PDU_Type::ADV_IND:
+            [[fallthrough]];
+        case AD_PDU_Type::ADV_SCAN_IND:
+            [[fallthrough]];
+        case AD_PDU_Type::ADV_NONCONN_IND:
+            [[fallthrough]];
+        case AD_PDU_Type::ADV_IND2:
+            [[fallthrough]];
+        case AD_PDU_Type::SCAN_IND2:
+            [[fallthrough]];
+        case AD_PDU_Type::NONCONN_IND2:
+            break;
+        default:
+            return HCIStatusCode::INVALID_PARAMS;
+    }
+    if( MAX_HANDLE < handle || 0x0F < sid || adv_interval_min > adv_interval_max ) {
+        return HCIStatusCode::INVALID_PARAMS;
+    }
+    if( LE_PHYs::LE_1M != primary_phy && ( legacy_pdu || LE_PHYs::LE_CODED != primary_phy ) ) {
+        return HCIStatusCode::INVALID_PARAMS; // legacy PDUs on LE_1M only, LE_2M never primary
+    }
+    if( LE_PHYs::LE_1M != secondary_phy && LE_PHYs::LE_2M != secondary_phy && LE_PHYs::LE_CODED != secondary_phy ) {
+        return HCIStatusCode::INVALID_PARAMS;
+    }
+    return HCIStatusCode::SUCCESS;
+}
+
+std::string ExtAdvSet::toString() const noexcept {
+    return "ExtAdvSet[handle "+jau::to_hexstring(handle)+", sid "+std::to_string(sid)+", "+to_string(adv_type)+
+           ", legacy "+std::to_string(legacy_pdu)+", props "+jau::to_hexstring(getEventProperties())+
+           ", phy["+direct_bt::to_string(primary_phy)+", "+direct_bt::to_string(secondary_phy)+"]"+
+           ", adv-interval["+std::to_string(adv_interval_min)+".."+std::to_string(adv_interval_max)+"]"+
+           ", random "+random_address.toString()+", adv "+to_string(adv_mask)+", scanrsp "+to_string(scanrsp_mask)+"]";
+}
+
+void HCIHandler::readExtAdvLimits() noexcept {
+    if( 0 != ext_adv_max_sets || !use_ext_adv() || !isOpen() ) {
+        return;
+    }
+    const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
+    HCIStatusCode status;
+    uint8_t max_sets = 1;
+    uint16_t max_data_len = HCI_MAX_EXT_AD_LENGTH;
+    {
+        struct le_read_num_supported_adv_sets_rp {
+            __u8  status;
+            __u8  num_of_sets;
+        } __packed;
+        HCICommand req0(HCIOpcode::LE_READ_NUM_SUPPORTED_ADV_SETS, 0);
+        const le_read_num_supported_adv_sets_rp * ev_reply;
+        std::unique_ptr<HCIEvent> ev = processCommandComplete(req0, &ev_reply, &status);
+        if( nullptr == ev || nullptr == ev_reply || HCIStatusCode::SUCCESS != status ) {
+            WARN_PRINT("dev_id %u: %s: 0x%x (%s) - %s", dev_id, to_string(req0.getOpcode()).c_str(), number(status), to_string(status).c_str(), toString().c_str());
+        } else if( 0 < ev_reply->num_of_sets ) {
+            max_sets = std::min<uint8_t>(ev_reply->num_of_sets, 0x3F); // LE Set Extended Advertising Enable limit
+        }
+    }
+    {
+        struct le_read_max_adv_data_len_rp {
+            __u8    status;
+            __le16  max_len;
+        } __packed;
+        HCICommand req0(HCIOpcode::LE_READ_MAX_ADV_DATA_LEN, 0);
+        const le_read_max_adv_data_len_rp * ev_reply;
+        std::unique_ptr<HCIEvent> ev = processCommandComplete(req0, &ev_reply, &status);
+        if( nullptr == ev || nullptr == ev_reply || HCIStatusCode::SUCCESS != status ) {
+            WARN_PRINT("dev_id %u: %s: 0x%x (%s) - %s", dev_id, to_string(req0.getOpcode()).c_str(), number(status), to_string(status).c_str(), toString().c_str());
+        } else {
+            max_data_len = std::max<uint16_t>(HCI_MAX_AD_LENGTH, std::min<uint16_t>(jau::le_to_cpu(ev_reply->max_len), ExtAdvSet::MAX_DATA_SIZE));
+        }
+    }
+    ext_adv_max_data_len = max_data_len;
+    ext_adv_max_sets = max_sets;
+    DBG_PRINT("HCIHandler<%hu>::readExtAdvLimits: sets %u, data_len %u", dev_id, max_sets, max_data_len);
+}
+
+uint8_t HCIHandler::getExtAdvMaxSets() noexcept {
+    if( !use_ext_adv() ) {
+        return 1;
+    }
+    readExtAdvLimits();
+    return 0 < ext_adv_max_sets ? ext_adv_max_sets : 1;
+}
+
+uint16_t HCIHandler::getExtAdvMaxDataLength() noexcept {
+    if( !use_ext_adv() ) {
+        return HCI_MAX_AD_LENGTH;
+    }
+    readExtAdvLimits();
+    return 0 < ext_adv_max_data_len ? ext_adv_max_data_len : HCI_MAX_EXT_AD_LENGTH;
+}
+
+HCIStatusCode HCIHandler::le_set_ext_adv_param(const ExtAdvSet& set, const HCILEOwnAddressType own_mac_type) noexcept {
+    DBG_PRINT("HCIHandler<%hu>::le_set_ext_adv_param: %s - %s", dev_id, set.toString().c_str(), toString().c_str());
+    const bool own_random = EUI48::ANY_DEVICE != set.random_address;
     const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
 
+    HCIStatusCode status;
+    HCIStructCommand<hci_cp_le_set_ext_adv_params> req0(HCIOpcode::LE_SET_EXT_ADV_PARAMS);
+    hci_cp_le_set_ext_adv_params * cp = req0.getWStruct();
+    cp->handle = set.handle;
+    cp->evt_properties = jau::cpu_to_le(set.getEventProperties());
+    jau::put_uint16(cp->min_interval + 0, set.adv_interval_min, jau::lb_endian_t::little);
+    jau::put_uint16(cp->max_interval + 0, set.adv_interval_max, jau::lb_endian_t::little);
+    cp->channel_map = set.adv_chan_map;
+    cp->own_addr_type = static_cast<uint8_t>( own_random ? HCILEOwnAddressType::RANDOM : own_mac_type );
+    cp->peer_addr_type = static_cast<uint8_t>(HCILEOwnAddressType::PUBLIC);
+    cp->peer_addr = jau::cpu_to_le(EUI48::ANY_DEVICE);
+    cp->filter_policy = set.filter_policy;
+    cp->tx_power = static_cast<uint8_t>(set.tx_power);
+    cp->primary_phy = to_hci_adv_phy(set.legacy_pdu ? LE_PHYs::LE_1M : set.primary_phy);
+    cp->secondary_phy = to_hci_adv_phy(set.legacy_pdu ? LE_PHYs::LE_1M : set.secondary_phy);
+    cp->sid = set.sid;
+    cp->notif_enable = 0x01;
+    const hci_rp_le_set_ext_adv_params * ev_reply;
+    std::unique_ptr<HCIEvent> ev = processCommandComplete(req0, &ev_reply, &status);
+    if( HCIStatusCode::SUCCESS != status || !own_random ) {
+        return status;
+    }
+    HCIStructCommand<hci_cp_le_set_adv_set_rand_addr> req1(HCIOpcode::LE_SET_ADV_SET_RAND_ADDR);
+    hci_cp_le_set_adv_set_rand_addr * cp1 = req1.getWStruct();
+    cp1->handle = set.handle;
+    cp1->bdaddr = jau::cpu_to_le(set.random_address);
+    const hci_rp_status * ev_status;
+    ev = processCommandComplete(req1, &ev_status, &status);
+    return status;
+}
+
+HCIStatusCode HCIHandler::le_set_ext_adv_data(const HCIOpcode opc, const uint8_t handle, const uint8_t* data, const jau::nsize_t size) noexcept {
+    // fragments shall not interleave with other advertising commands
+    const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
+
+    HCIStatusCode status = HCIStatusCode::SUCCESS;
+    jau::nsize_t offset = 0;
+    do {
+        const jau::nsize_t frag_len = std::min<jau::nsize_t>(size - offset, HCI_MAX_EXT_AD_LENGTH);
+        const bool first = 0 == offset;
+        const bool last = size == offset + frag_len;
+
+        // hci_cp_le_set_ext_scan_rsp_data has the same layout
+        HCIStructCommand<hci_cp_le_set_ext_adv_data> req0(opc);
+        hci_cp_le_set_ext_adv_data * cp = req0.getWStruct();
+        cp->handle = handle;
+        if( first && last ) {
+            cp->operation = LE_SET_ADV_DATA_OP_COMPLETE;
+        } else if( first ) {
+            cp->operation = 0x01; // first fragment
+        } else if( last ) {
+            cp->operation = 0x02; // last fragment
+        } else {
+            cp->operation = 0x00; // intermediate fragment
+        }
+        cp->frag_pref = LE_SET_ADV_DATA_NO_FRAG;
+        cp->length = static_cast<uint8_t>(frag_len);
+        if( 0 < frag_len ) {
+            memcpy(cp->data, data + offset, frag_len);
+        }
+        req0.trimParamSize( req0.getParamSize() + cp->length - sizeof(cp->data) );
+
+        const hci_rp_status * ev_status;
+        std::unique_ptr<HCIEvent> ev = processCommandComplete(req0, &ev_status, &status);
+        offset += frag_len;
+    } while( HCIStatusCode::SUCCESS == status && offset < size );
+
+    if( HCIStatusCode::SUCCESS != status ) {
+        WARN_PRINT("dev_id %u: %s: handle %u, %u/%u bytes: 0x%x (%s) - %s", dev_id, to_string(opc).c_str(), handle, offset, size,
+                number(status), to_string(status).c_str(), toString().c_str());
+    }
+    return status;
+}
+
+HCIStatusCode HCIHandler::le_start_ext_adv(const jau::darray<ExtAdvSet>& sets, const HCILEOwnAddressType own_mac_type) noexcept {
+    if( !isOpen() ) {
+        ERR_PRINT("Not connected %s", toString().c_str());
+        return HCIStatusCode::DISCONNECTED;
+    }
+    if( 0 == sets.size() ) {
+        WARN_PRINT("dev_id %u: No advertising set given - %s", dev_id, toString().c_str());
+        return HCIStatusCode::INVALID_PARAMS;
+    }
+    for(jau::nsize_t i=0; i<sets.size(); ++i) {
+        const ExtAdvSet& s = sets[i];
+        HCIStatusCode status = s.validate();
+        for(jau::nsize_t j=0; j<i && HCIStatusCode::SUCCESS == status; ++j) {
+            if( sets[j].handle == s.handle ) {
+                status = HCIStatusCode::INVALID_PARAMS; // duplicate handle
+            }
+        }
+        if( HCIStatusCode::SUCCESS != status ) {
+            WARN_PRINT("dev_id %u: Invalid set [%u] %s - %s", dev_id, i, s.toString().c_str(), toString().c_str());
+            return status;
+        }
+    }
+    if( !use_ext_adv() ) {
+        const ExtAdvSet& s = sets[0];
+        if( 1 < sets.size() || !s.legacy_pdu || EUI48::ANY_DEVICE != s.random_address ) {
+            WARN_PRINT("dev_id %u: Extended advertising not supported, legacy advertising of first set only: %s", dev_id, s.toString().c_str());
+        }
+        const AD_PDU_Type adv_type = s.isConnectable() ? AD_PDU_Type::ADV_IND :
+                                     ( s.isScannable() ? AD_PDU_Type::ADV_SCAN_IND : AD_PDU_Type::ADV_NONCONN_IND );
+        return le_start_adv(s.eir, s.adv_mask, s.scanrsp_mask,
+                            EUI48::ANY_DEVICE, own_mac_type, HCILEOwnAddressType::PUBLIC,
+                            s.adv_interval_min, s.adv_interval_max, adv_type, s.adv_chan_map, s.filter_policy);
+    }
+    const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
+
+    if( ScanType::NONE != currentScanType ) {
+        WARN_PRINT("Not allowed (scan enabled): %s", toString().c_str());
+        return HCIStatusCode::COMMAND_DISALLOWED;
+    }
+    const jau::nsize_t max_sets = getExtAdvMaxSets();
+    if( sets.size() > max_sets ) {
+        WARN_PRINT("dev_id %u: %u sets exceed the controller's %u sets - %s", dev_id, sets.size(), max_sets, toString().c_str());
+        return HCIStatusCode::LIMIT_REACHED;
+    }
+    const jau::nsize_t max_data_len = getExtAdvMaxDataLength();
+
+    HCIStatusCode status;
+    if( advertisingEnabled ) {
+        status = le_enable_adv_sets(false, nullptr, 0);
+        if( HCIStatusCode::SUCCESS != status ) {
+            return status;
+        }
+    }
+    {
+        // remove previously configured sets, freeing their controller resources
+        HCICommand req0(HCIOpcode::LE_CLEAR_ADV_SETS, 0);
+        const hci_rp_status * ev_status;
+        std::unique_ptr<HCIEvent> ev = processCommandComplete(req0, &ev_status, &status);
+        DBG_PRINT("HCIHandler<%hu>::le_start_ext_adv: %s: %s", dev_id, to_string(req0.getOpcode()).c_str(), to_string(status).c_str());
+    }
+    uint8_t handles[0x3F];
+    uint8_t data[ExtAdvSet::MAX_DATA_SIZE];
+    for(jau::nsize_t i=0; i<sets.size(); ++i) {
+        const ExtAdvSet& s = sets[i];
+        status = le_set_ext_adv_param(s, own_mac_type);
+        if( HCIStatusCode::SUCCESS != status ) {
+            WARN_PRINT("le_set_ext_adv_param: %s: %s - %s", s.toString().c_str(), to_string(status).c_str(), toString().c_str());
+            return status;
+        }
+        if( s.legacy_pdu ) {
+            jau::nsize_t len = s.eir.write_data(s.adv_mask, data, HCI_MAX_AD_LENGTH);
+            status = le_set_ext_adv_data(HCIOpcode::LE_SET_EXT_ADV_DATA, s.handle, data, len);
+            if( HCIStatusCode::SUCCESS == status && s.isScannable() ) {
+                len = s.eir.write_data(s.scanrsp_mask, data, HCI_MAX_AD_LENGTH);
+                status = le_set_ext_adv_data(HCIOpcode::LE_SET_EXT_SCAN_RSP_DATA, s.handle, data, len);
+            }
+        } else {
+            // Extended PDUs: no advertising data for scannable, no scan response for non-scannable sets
+            const jau::nsize_t len = s.eir.write_data(s.adv_mask | s.scanrsp_mask, data, max_data_len);
+            status = le_set_ext_adv_data(s.isScannable() ? HCIOpcode::LE_SET_EXT_SCAN_RSP_DATA : HCIOpcode::LE_SET_EXT_ADV_DATA,
+                                         s.handle, data, len);
+        }
+        if( HCIStatusCode::SUCCESS != status ) {
+            return status;
+        }
+        handles[i] = s.handle;
+    }
+    status = le_enable_adv_sets(true, handles, sets.size());
+    if( HCIStatusCode::SUCCESS != status ) {
+        WARN_PRINT("le_enable_adv failed: %s - %s", to_string(status).c_str(), toString().c_str());
+    }
+    return status;
+}
+
+std::unique_ptr<HCIEvent> HCIHandler::processCommandStatus(HCICommand &req, HCIStatusCode *status, const bool quiet) noexcept
+{
     *status = HCIStatusCode::INTERNAL_FAILURE;
 
     int32_t retryCount = 0;
     std::unique_ptr<HCIEvent> ev = nullptr;
+    HCICmdWaiter waiter(*this, req.getOpcode());
 
-    if( !sendCommand(req) ) {
+    if( !submitCommand(req, waiter, quiet) ) {
         goto exit;
     }
 
     while( retryCount < env.HCI_READ_PACKET_MAX_RETRY ) {
-        ev = getNextReply(req, retryCount, env.HCI_COMMAND_STATUS_REPLY_TIMEOUT);
+        ev = getNextReply(req, waiter, env.HCI_COMMAND_STATUS_REPLY_TIMEOUT);
         if( nullptr == ev ) {
             *status = HCIStatusCode::INTERNAL_TIMEOUT;
             break; // timeout, leave loop
@@ -2104,12 +3258,11 @@ std::unique_ptr<HCIEvent> HCIHandler::processCommandComplete(HCICommand &req,
                                                              const hci_cmd_event_struct **res, HCIStatusCode *status,
                                                              const bool quiet) noexcept
 {
-    const std::lock_guard<std::recursive_mutex> lock(mtx_sendReply); // RAII-style acquire and relinquish via destructor
-
     *res = nullptr;
     *status = HCIStatusCode::INTERNAL_FAILURE;
 
-    if( !sendCommand(req, quiet) ) {
+    HCICmdWaiter waiter(*this, req.getOpcode());
+    if( !submitCommand(req, waiter, quiet) ) {
         if( !quiet || jau::environment::get().verbose ) {
             WARN_PRINT("Send failed: Status 0x%2.2X (%s), errno %d %s: res nullptr, req %s - %s",
                     number(*status), to_string(*status).c_str(), errno, strerror(errno),
@@ -2118,11 +3271,11 @@ std::unique_ptr<HCIEvent> HCIHandler::processCommandComplete(HCICommand &req,
         return nullptr; // timeout
     }
 
-    return receiveCommandComplete(req, res, status, quiet);
+    return receiveCommandComplete(req, waiter, res, status, quiet);
 }
 
 template<typename hci_cmd_event_struct>
-std::unique_ptr<HCIEvent> HCIHandler::receiveCommandComplete(HCICommand &req,
+std::unique_ptr<HCIEvent> HCIHandler::receiveCommandComplete(HCICommand &req, HCICmdWaiter& waiter,
                                                              const hci_cmd_event_struct **res, HCIStatusCode *status,
                                                              const bool quiet) noexcept
 {
@@ -2131,7 +3284,7 @@ std::unique_ptr<HCIEvent> HCIHandler::receiveCommandComplete(HCICommand &req,
 
     const HCIEventType evc = HCIEventType::CMD_COMPLETE;
     HCICommandCompleteEvent * ev_cc;
-    std::unique_ptr<HCIEvent> ev = getNextCmdCompleteReply(req, &ev_cc);
+    std::unique_ptr<HCIEvent> ev = getNextCmdCompleteReply(req, waiter, &ev_cc);
     if( nullptr == ev ) {
         *status = HCIStatusCode::INTERNAL_TIMEOUT;
         if( !quiet || jau::environment::get().verbose ) {
@@ -2229,6 +3382,7 @@ bool HCIHandler::addMgmtEventCallback(const MgmtEvent::Opcode opc, const MgmtEve
     }
     MgmtEventCallbackList &l = mgmtEventCallbackLists[static_cast<uint16_t>(opc)];
     /* const bool added = */ l.push_back_unique(cb, _mgmtEventCallbackEqComparator);
+    updateEventFilter();
     return true;
 }
 HCIHandler::size_type HCIHandler::removeMgmtEventCallback(const MgmtEvent::Opcode opc, const MgmtEventCallback &cb) noexcept {
@@ -2237,7 +3391,11 @@ HCIHandler::size_type HCIHandler::removeMgmtEventCallback(const MgmtEvent::Opcod
         return 0;
     }
     MgmtEventCallbackList &l = mgmtEventCallbackLists[static_cast<uint16_t>(opc)];
-    return l.erase_matching(cb, true /* all_matching */, _mgmtEventCallbackEqComparator);
+    const size_type count = l.erase_matching(cb, true /* all_matching */, _mgmtEventCallbackEqComparator);
+    if( 0 < count ) {
+        updateEventFilter();
+    }
+    return count;
 }
 void HCIHandler::clearMgmtEventCallbacks(const MgmtEvent::Opcode opc) noexcept {
     if( !isValidMgmtEventCallbackListsIndex(opc) ) {
@@ -2245,12 +3403,16 @@ void HCIHandler::clearMgmtEventCallbacks(const MgmtEvent::Opcode opc) noexcept {
         return;
     }
     mgmtEventCallbackLists[static_cast<uint16_t>(opc)].clear();
+    updateEventFilter();
 }
 void HCIHandler::clearAllCallbacks() noexcept {
     for(auto & mgmtEventCallbackList : mgmtEventCallbackLists) {
         mgmtEventCallbackList.clear();
     }
     hciSMPMsgCallbackList.clear();
+    hciPeriodicAdvSyncCallbackList.clear();
+    hciPeriodicAdvReportCallbackList.clear();
+    updateEventFilter();
 }
 
 /**
@@ -2268,4 +3430,28 @@ HCIHandler::size_type HCIHandler::removeSMPMsgCallback(const HCISMPMsgCallback &
     return hciSMPMsgCallbackList.erase_matching(l, true /* all_matching */, _changedHCISMPMsgCallbackEqComp);
 }
 
+/**
+ * Periodic advertising callback handling
+ */
+
+static HCIPeriodicAdvSyncCallbackList::equal_comparator _changedHCIPeriodicAdvSyncCallbackEqComp =
+        [](const HCIPeriodicAdvSyncCallback& a, const HCIPeriodicAdvSyncCallback& b) noexcept -> bool { return a == b; };
+
+static HCIPeriodicAdvReportCallbackList::equal_comparator _changedHCIPeriodicAdvReportCallbackEqComp =
+        [](const HCIPeriodicAdvReportCallback& a, const HCIPeriodicAdvReportCallback& b) noexcept -> bool { return a == b; };
+
+void HCIHandler::addPeriodicAdvSyncCallback(const HCIPeriodicAdvSyncCallback & l) {
+    hciPeriodicAdvSyncCallbackList.push_back(l);
+}
+HCIHandler::size_type HCIHandler::removePeriodicAdvSyncCallback(const HCIPeriodicAdvSyncCallback & l) {
+    return hciPeriodicAdvSyncCallbackList.erase_matching(l, true /* all_matching */, _changedHCIPeriodicAdvSyncCallbackEqComp);
+}
+
+void HCIHandler::addPeriodicAdvReportCallback(const HCIPeriodicAdvReportCallback & l) {
+    hciPeriodicAdvReportCallbackList.push_back(l);
+}
+HCIHandler::size_type HCIHandler::removePeriodicAdvReportCallback(const HCIPeriodicAdvReportCallback & l) {
+    return hciPeriodicAdvReportCallbackList.erase_matching(l, true /* all_matching */, _changedHCIPeriodicAdvReportCallbackEqComp);
+}
+
 
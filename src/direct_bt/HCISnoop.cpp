@@ -0,0 +1,193 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+
+#include <jau/debug.hpp>
+#include <jau/byte_util.hpp>
+
+#include "HCISnoop.hpp"
+#include "HCITypes.hpp"
+
+extern "C" {
+    #include <inttypes.h>
+}
+
+using namespace direct_bt;
+
+BTSnoopWriter::BTSnoopWriter(const std::string& fname_) noexcept
+: file(fname_, std::ios::out | std::ios::binary | std::ios::trunc), fname(fname_), record_count(0), good(false)
+{
+    if ( !file.good() || !file.is_open() ) {
+        ERR_PRINT("BTSnoopWriter: Failed: File not open %s", fname.c_str());
+        return;
+    }
+    uint8_t buffer[BTSnoop::HEADER_SIZE];
+    ::memcpy(buffer, BTSnoop::MAGIC, sizeof(BTSnoop::MAGIC));
+    jau::put_uint32(buffer + 8, BTSnoop::VERSION, jau::lb_endian_t::big);
+    jau::put_uint32(buffer + 12, BTSnoop::DATALINK_HCI_UART, jau::lb_endian_t::big);
+    file.write((char*)buffer, sizeof(buffer));
+    file.flush();
+    good = file.good();
+    if( !good ) {
+        ERR_PRINT("BTSnoopWriter: Failed: Header write %s", fname.c_str());
+    }
+}
+
+bool BTSnoopWriter::is_open() noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_write); // RAII-style acquire and relinquish via destructor
+    return good;
+}
+
+void BTSnoopWriter::close() noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_write); // RAII-style acquire and relinquish via destructor
+    if( file.is_open() ) {
+        file.flush();
+        file.close();
+    }
+    good = false;
+}
+
+uint64_t BTSnoopWriter::getRecordCount() noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_write); // RAII-style acquire and relinquish via destructor
+    return record_count;
+}
+
+uint64_t BTSnoopWriter::getTimestamp() noexcept {
+    const jau::fraction_timespec t = jau::getMonotonicTime();
+    return BTSnoop::EPOCH_DELTA_US + static_cast<uint64_t>(t.tv_sec) * 1000000UL + static_cast<uint64_t>(t.tv_nsec) / 1000UL;
+}
+
+bool BTSnoopWriter::write(const uint8_t* data, const jau::nsize_t size, const bool received) noexcept {
+    return write(data, size, received, getTimestamp());
+}
+
+bool BTSnoopWriter::write(const uint8_t* data, const jau::nsize_t size, const bool received, const uint64_t timestamp_us) noexcept {
+    if( 0 == size ) {
+        return true;
+    }
+    uint32_t flags = received ? BTSnoop::FLAG_RECEIVED : 0;
+    const HCIPacketType pc = static_cast<HCIPacketType>( data[0] );
+    if( HCIPacketType::COMMAND == pc || HCIPacketType::EVENT == pc ) {
+        flags |= BTSnoop::FLAG_CMD_EVT;
+    }
+    uint8_t buffer[BTSnoop::RECORD_HEADER_SIZE];
+    jau::put_uint32(buffer + 0, size, jau::lb_endian_t::big); // original length
+    jau::put_uint32(buffer + 4, size, jau::lb_endian_t::big); // included length
+    jau::put_uint32(buffer + 8, flags, jau::lb_endian_t::big);
+    jau::put_uint32(buffer + 12, 0, jau::lb_endian_t::big); // cumulative drops
+    jau::put_uint64(buffer + 16, timestamp_us, jau::lb_endian_t::big);
+
+    const std::lock_guard<std::mutex> lock(mtx_write); // RAII-style acquire and relinquish via destructor
+    if( !good ) {
+        return false;
+    }
+    file.write((char*)buffer, sizeof(buffer));
+    file.write((const char*)data, size);
+    good = file.good();
+    if( good ) {
+        ++record_count;
+    } else {
+        ERR_PRINT("BTSnoopWriter: Failed: Record write %s, records %" PRIu64, fname.c_str(), record_count);
+    }
+    return good;
+}
+
+BTSnoopReader::BTSnoopReader(const std::string& fname_) noexcept
+: file(fname_, std::ios::in | std::ios::binary), fname(fname_), record_count(0), good(false), end_of_file(false)
+{
+    if ( !file.is_open() ) {
+        ERR_PRINT("BTSnoopReader: Failed: File not open %s", fname.c_str());
+        return;
+    }
+    uint8_t buffer[BTSnoop::HEADER_SIZE];
+    file.read((char*)buffer, sizeof(buffer));
+    if( file.fail() ) {
+        ERR_PRINT("BTSnoopReader: Failed: Header read %s", fname.c_str());
+        return;
+    }
+    if( 0 != ::memcmp(buffer, BTSnoop::MAGIC, sizeof(BTSnoop::MAGIC)) ) {
+        ERR_PRINT("BTSnoopReader: Failed: Not a btsnoop file %s", fname.c_str());
+        return;
+    }
+    const uint32_t version = jau::get_uint32(buffer + 8, jau::lb_endian_t::big);
+    const uint32_t datalink = jau::get_uint32(buffer + 12, jau::lb_endian_t::big);
+    if( BTSnoop::VERSION != version || BTSnoop::DATALINK_HCI_UART != datalink ) {
+        ERR_PRINT("BTSnoopReader: Failed: Unsupported version %u or datalink %u, %s", version, datalink, fname.c_str());
+        return;
+    }
+    good = true;
+}
+
+bool BTSnoopReader::next(BTSnoopRecord& record) noexcept {
+    if( !good ) {
+        return false;
+    }
+    uint8_t buffer[BTSnoop::RECORD_HEADER_SIZE];
+    file.read((char*)buffer, sizeof(buffer));
+    if( file.fail() ) {
+        end_of_file = file.eof() && 0 == file.gcount();
+        if( !end_of_file ) {
+            ERR_PRINT("BTSnoopReader: Failed: Truncated record header %" PRIu64 ", %s", record_count, fname.c_str());
+        }
+        good = false;
+        return false;
+    }
+    const uint32_t orig_len = jau::get_uint32(buffer + 0, jau::lb_endian_t::big);
+    const uint32_t incl_len = jau::get_uint32(buffer + 4, jau::lb_endian_t::big);
+    record.flags = jau::get_uint32(buffer + 8, jau::lb_endian_t::big);
+    record.drops = jau::get_uint32(buffer + 12, jau::lb_endian_t::big);
+    record.timestamp_us = jau::get_uint64(buffer + 16, jau::lb_endian_t::big);
+    if( incl_len > orig_len || incl_len > BTSnoop::MAX_RECORD_SIZE ) {
+        ERR_PRINT("BTSnoopReader: Failed: Invalid record %" PRIu64 " length %u/%u, %s", record_count, incl_len, orig_len, fname.c_str());
+        good = false;
+        return false;
+    }
+    record.data.resize(incl_len);
+    file.read((char*)record.data.data(), incl_len);
+    if( file.fail() ) {
+        ERR_PRINT("BTSnoopReader: Failed: Truncated record %" PRIu64 ", %s", record_count, fname.c_str());
+        good = false;
+        return false;
+    }
+    ++record_count;
+    return true;
+}
+
+std::string HCIReplayStageStats::toString() const noexcept {
+    return "[count "+std::to_string(count)+
+           ", avg "+std::to_string(static_cast<uint64_t>(getAverage_ns()))+
+           " ns, min "+std::to_string(min_ns)+" ns, max "+std::to_string(max_ns)+" ns]";
+}
+
+std::string HCIReplayStats::toString() const noexcept {
+    return "HCIReplayStats[packets "+std::to_string(packets)+", skipped "+std::to_string(skipped)+
+           ", adv_reports "+std::to_string(adv_reports)+
+           ", duration "+std::to_string(duration_ns/1000000UL)+" ms, "+std::to_string(static_cast<uint64_t>(getEventsPerSecond()))+" events/s"+
+           ", process "+process.toString()+
+           ", adv_parse "+adv_parse.toString()+
+           ", adv_dispatch "+adv_dispatch.toString()+"]";
+}
@@ -210,13 +210,21 @@ std::string to_string(const HCIOGF op) noexcept {
     X(LE_READ_PHY) \
     X(LE_SET_DEFAULT_PHY) \
     X(LE_SET_PHY) \
+    X(LE_SET_ADV_SET_RAND_ADDR) \
     X(LE_SET_EXT_ADV_PARAMS) \
     X(LE_SET_EXT_ADV_DATA) \
     X(LE_SET_EXT_SCAN_RSP_DATA) \
     X(LE_SET_EXT_ADV_ENABLE) \
+    X(LE_READ_MAX_ADV_DATA_LEN) \
+    X(LE_READ_NUM_SUPPORTED_ADV_SETS) \
+    X(LE_REMOVE_ADV_SET) \
+    X(LE_CLEAR_ADV_SETS) \
     X(LE_SET_EXT_SCAN_PARAMS) \
     X(LE_SET_EXT_SCAN_ENABLE) \
-    X(LE_EXT_CREATE_CONN)
+    X(LE_EXT_CREATE_CONN) \
+    X(LE_PERIODIC_ADV_CREATE_SYNC) \
+    X(LE_PERIODIC_ADV_CREATE_SYNC_CANCEL) \
+    X(LE_PERIODIC_ADV_TERMINATE_SYNC)
 
 
 #define HCI_OPCODE_CASE_TO_STRING(V) case HCIOpcode::V: return #V;
@@ -424,9 +432,13 @@ __pack ( struct l2cap_hdr {
 } );
 
 HCIACLData::l2cap_frame HCIACLData::getL2CAPFrame(const uint8_t* & l2cap_data) const noexcept {
-    const uint16_t h_f = getHandleAndFlags();
-    uint16_t size = static_cast<uint16_t>(getParamSize());
-    const uint8_t * data = getParam();
+    return getL2CAPFrame(getHandleAndFlags(), getParam(), getParamSize(), l2cap_data);
+}
+
+HCIACLData::l2cap_frame HCIACLData::getL2CAPFrame(const uint16_t h_f, const uint8_t* acl_param, const jau::nsize_t acl_param_size,
+                                                  const uint8_t* & l2cap_data) noexcept {
+    uint16_t size = static_cast<uint16_t>(acl_param_size);
+    const uint8_t * data = acl_param;
     const uint16_t handle = get_handle(h_f);
     const HCIACLData::l2cap_frame::PBFlag pb_flag { get_pbflag(h_f) };
     const uint8_t bc_flag = get_bcflag(h_f);
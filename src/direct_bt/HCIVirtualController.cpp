@@ -0,0 +1,874 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+
+#include <jau/debug.hpp>
+#include <jau/byte_util.hpp>
+#include <jau/secmem.hpp>
+
+#include "HCIVirtualController.hpp"
+#include "DBTConst.hpp"
+
+extern "C" {
+    #include <inttypes.h>
+    #include <unistd.h>
+    #include <sys/types.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <poll.h>
+}
+
+using namespace direct_bt;
+
+std::mutex HCIVirtualController::mtx_links;
+
+/** Unique id of listening L2CAP channel names within this process */
+static std::atomic<uint32_t> listener_id(0);
+
+/** Sets the given abstract AF_UNIX socket name, returning the address length. */
+static socklen_t setAbstractAddress(const std::string& name, sockaddr_un& a) noexcept {
+    jau::zero_bytes_sec(&a, sizeof(a));
+    a.sun_family = AF_UNIX;
+    const size_t len = std::min<size_t>(name.size(), sizeof(a.sun_path) - 1);
+    ::memcpy(a.sun_path + 1, name.c_str(), len); // leading zero: abstract namespace
+    return static_cast<socklen_t>( offsetof(sockaddr_un, sun_path) + 1 + len );
+}
+
+HCIVirtualController::HCIVirtualController(const jau::EUI48& address_, const bool ext_adv_) noexcept
+: address(address_), ext_adv(ext_adv_), ctrl_sd(-1), host_sd(-1), wake_sd{-1, -1},
+  ctrl_service("HCIVirtualController::ctrl", THREAD_SHUTDOWN_TIMEOUT_MS,
+               jau::bind_member(this, &HCIVirtualController::ctrlWork),
+               jau::service_runner::Callback() /* init */,
+               jau::service_runner::Callback() /* end */),
+  next_handle(0x0040), next_sync_handle(0x0001), scan_enabled(false), adv_enabled(false),
+  cmd_count(0), evt_count(0), acl_count(0)
+{
+    int fds[2];
+    if( 0 > ::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds) ) {
+        ERR_PRINT("HCIVirtualController: socketpair failed");
+        return;
+    }
+    if( 0 > ::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0, wake_sd) ) {
+        ERR_PRINT("HCIVirtualController: socketpair failed");
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return;
+    }
+    ctrl_sd = fds[0];
+    host_sd = fds[1];
+    ctrl_service.start();
+    DBG_PRINT("HCIVirtualController: Started %s", toString().c_str());
+}
+
+int HCIVirtualController::takeHostSocket() noexcept {
+    const int sd = host_sd;
+    host_sd = -1;
+    return sd;
+}
+
+void HCIVirtualController::close() noexcept {
+    if( 0 > ctrl_sd ) {
+        return;
+    }
+    ::shutdown(ctrl_sd, SHUT_RDWR); // wake up a blocking poll
+    ctrl_service.stop();
+    {
+        const std::lock_guard<std::mutex> lock(mtx_links); // RAII-style acquire and relinquish via destructor
+        unlinkAllLocked();
+        listeners.clear();
+    }
+    {
+        const std::lock_guard<std::recursive_mutex> lock(mtx_write); // RAII-style acquire and relinquish via destructor
+        ::close(ctrl_sd);
+        ctrl_sd = -1;
+    }
+    ::close(wake_sd[0]);
+    ::close(wake_sd[1]);
+    wake_sd[0] = -1;
+    wake_sd[1] = -1;
+    if( 0 <= host_sd ) {
+        ::close(host_sd);
+        host_sd = -1;
+    }
+    DBG_PRINT("HCIVirtualController: Closed %s", toString().c_str());
+}
+
+void HCIVirtualController::link(HCIVirtualController& a, HCIVirtualController& b) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_links); // RAII-style acquire and relinquish via destructor
+    if( &a == &b ) {
+        return;
+    }
+    if( a.range.end() == std::find(a.range.begin(), a.range.end(), &b) ) {
+        a.range.push_back(&b);
+    }
+    if( b.range.end() == std::find(b.range.begin(), b.range.end(), &a) ) {
+        b.range.push_back(&a);
+    }
+}
+
+void HCIVirtualController::unlinkAllLocked() noexcept {
+    for(Link& l : links) {
+        l.peer->sendDisconnComplete(l.peer_handle, HCIStatusCode::REMOTE_DEVICE_TERMINATED_CONNECTION_POWER_OFF);
+        l.peer->removeLinkLocked(l.peer_handle);
+    }
+    links.clear();
+    closeAllChannelsLocked();
+    for(HCIVirtualController* p : range) {
+        p->range.erase(std::remove(p->range.begin(), p->range.end(), this), p->range.end());
+    }
+    range.clear();
+}
+
+HCIVirtualController* HCIVirtualController::findInRangeLocked(const jau::EUI48& peer_address) noexcept {
+    for(HCIVirtualController* p : range) {
+        if( p->address == peer_address ) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+HCIVirtualController::Link* HCIVirtualController::findLinkLocked(const uint16_t handle) noexcept {
+    for(Link& l : links) {
+        if( l.handle == handle ) {
+            return &l;
+        }
+    }
+    return nullptr;
+}
+
+void HCIVirtualController::removeLinkLocked(const uint16_t handle) noexcept {
+    links.erase(std::remove_if(links.begin(), links.end(), [&](const Link& l) { return l.handle == handle; }), links.end());
+    closeChannelsLocked(handle, 0);
+}
+
+HCIVirtualController::Channel* HCIVirtualController::findChannelLocked(const uint16_t handle, const uint16_t cid) noexcept {
+    for(Channel& c : channels) {
+        if( c.handle == handle && c.cid == cid ) {
+            return &c;
+        }
+    }
+    return nullptr;
+}
+
+void HCIVirtualController::closeChannelsLocked(const uint16_t handle, const uint16_t cid) noexcept {
+    for(auto it = channels.begin(); it != channels.end(); ) {
+        if( it->handle == handle && ( 0 == cid || it->cid == cid ) ) {
+            ::close(it->sd); // host reads end-of-file
+            it = channels.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void HCIVirtualController::closeAllChannelsLocked() noexcept {
+    for(const Channel& c : channels) {
+        ::close(c.sd);
+    }
+    channels.clear();
+}
+
+void HCIVirtualController::wakeup() noexcept {
+    const uint8_t b = 0;
+    ::send(wake_sd[1], &b, 1, MSG_DONTWAIT | MSG_NOSIGNAL); // a pending wakeup suffices
+}
+
+void HCIVirtualController::ctrlWork(jau::service_runner& sr) noexcept {
+    std::vector<struct pollfd> p;
+    {
+        const std::lock_guard<std::mutex> lock(mtx_links); // RAII-style acquire and relinquish via destructor
+        p.reserve(2 + channels.size());
+        p.push_back( { ctrl_sd, POLLIN, 0 } );
+        p.push_back( { wake_sd[0], POLLIN, 0 } );
+        for(const Channel& c : channels) {
+            p.push_back( { c.sd, POLLIN, 0 } );
+        }
+    }
+    const int n = ::poll(p.data(), p.size(), 500 /* ms */);
+    if( 0 > n ) {
+        if( EAGAIN != errno && EINTR != errno ) {
+            sr.set_shall_stop();
+        }
+        return;
+    }
+    if( 0 == n || sr.shall_stop() ) {
+        return;
+    }
+    if( 0 != p[1].revents ) {
+        uint8_t b[16];
+        while( 0 < ::recv(wake_sd[0], b, sizeof(b), MSG_DONTWAIT) ) { }
+    }
+    if( 2 < p.size() ) {
+        const std::lock_guard<std::mutex> lock(mtx_links); // RAII-style acquire and relinquish via destructor
+        for(size_t i = 2; i < p.size(); ++i) {
+            if( 0 != p[i].revents ) {
+                processChannelLocked(p[i].fd);
+            }
+        }
+    }
+    if( 0 == p[0].revents ) {
+        return;
+    }
+    const ssize_t len = ::read(ctrl_sd, rbuffer, sizeof(rbuffer));
+    if( 0 >= len ) {
+        if( 0 == len || ( EAGAIN != errno && EINTR != errno ) ) {
+            // host closed its end or error
+            sr.set_shall_stop();
+        }
+        return;
+    }
+    switch( static_cast<HCIPacketType>( rbuffer[0] ) ) {
+        case HCIPacketType::COMMAND:
+            processCommand(rbuffer, len);
+            break;
+        case HCIPacketType::ACLDATA:
+            processACLData(rbuffer, len);
+            break;
+        default:
+            DBG_PRINT("HCIVirtualController: Drop packet type %s, len %zd", jau::to_hexstring(rbuffer[0]).c_str(), len);
+            break;
+    }
+}
+
+void HCIVirtualController::processCommand(const uint8_t* buffer, const jau::nsize_t len) noexcept {
+    if( len < number(HCIConstSizeT::COMMAND_HDR_SIZE) ) {
+        return;
+    }
+    const uint16_t opcode = jau::get_uint16(buffer + 1, jau::lb_endian_t::little);
+    const uint8_t plen = std::min<jau::nsize_t>(buffer[3], len - number(HCIConstSizeT::COMMAND_HDR_SIZE));
+    const uint8_t* param = buffer + number(HCIConstSizeT::COMMAND_HDR_SIZE);
+    ++cmd_count;
+
+    const std::lock_guard<std::mutex> lock(mtx_links); // RAII-style acquire and relinquish via destructor
+    switch( static_cast<HCIOpcode>( opcode ) ) {
+        case HCIOpcode::RESET: {
+            for(Link& l : links) {
+                l.peer->sendDisconnComplete(l.peer_handle, HCIStatusCode::REMOTE_DEVICE_TERMINATED_CONNECTION_POWER_OFF);
+                l.peer->removeLinkLocked(l.peer_handle);
+            }
+            links.clear();
+            closeAllChannelsLocked();
+            periodic_syncs.clear();
+            scan_enabled = false;
+            adv_enabled = false;
+            adv_data.clear();
+            scan_rsp_data.clear();
+            adv_sets.clear();
+            sendCmdComplete(opcode, HCIStatusCode::SUCCESS, nullptr, 0);
+        } break;
+        case HCIOpcode::READ_LOCAL_VERSION: {
+            uint8_t ret[8];
+            jau::zero_bytes_sec(ret, sizeof(ret));
+            ret[0] = 0x0b; // hci_ver 5.2
+            ret[3] = 0x0b; // lmp_ver 5.2
+            jau::put_uint16(ret + 4, 0xffff, jau::lb_endian_t::little); // manufacturer: none
+            sendCmdComplete(opcode, HCIStatusCode::SUCCESS, ret, sizeof(ret));
+        } break;
+        case HCIOpcode::READ_LOCAL_COMMANDS: {
+            uint8_t ret[64];
+            jau::zero_bytes_sec(ret, sizeof(ret)); // no optional and no extended commands
+            ret[38] = 0x07; // but LE periodic advertising create sync, cancel and terminate
+            sendCmdComplete(opcode, HCIStatusCode::SUCCESS, ret, sizeof(ret));
+        } break;
+        case HCIOpcode::LE_READ_LOCAL_FEATURES: {
+            uint8_t ret[8];
+            jau::zero_bytes_sec(ret, sizeof(ret)); // legacy LE only, unless extended advertising
+            if( ext_adv ) {
+                jau::put_uint64(ret, number(LE_Features::LE_Ext_Adv), jau::lb_endian_t::little);
+            }
+            sendCmdComplete(opcode, HCIStatusCode::SUCCESS, ret, sizeof(ret));
+        } break;
+        case HCIOpcode::LE_SET_ADV_DATA:
+            [[fallthrough]];
+        case HCIOpcode::LE_SET_SCAN_RSP_DATA: {
+            std::vector<uint8_t>& dst = HCIOpcode::LE_SET_ADV_DATA == static_cast<HCIOpcode>( opcode ) ? adv_data : scan_rsp_data;
+            if( 1 <= plen ) {
+                const uint8_t size = std::min<uint8_t>(param[0], plen - 1);
+                dst.assign(param + 1, param + 1 + size);
+            }
+            sendCmdComplete(opcode, HCIStatusCode::SUCCESS, nullptr, 0);
+        } break;
+        case HCIOpcode::LE_SET_ADV_ENABLE: {
+            adv_enabled = 1 <= plen && 0 != param[0];
+            sendCmdComplete(opcode, HCIStatusCode::SUCCESS, nullptr, 0);
+            if( adv_enabled ) {
+                for(HCIVirtualController* p : range) {
+                    if( p->scan_enabled ) {
+                        p->sendAdvReport(AD_PDU_Type::ADV_IND, address, adv_data.data(), static_cast<uint8_t>(adv_data.size()), -40);
+                    }
+                }
+            }
+        } break;
+        case HCIOpcode::LE_READ_NUM_SUPPORTED_ADV_SETS: {
+            const uint8_t ret[] = { EXT_ADV_MAX_SETS };
+            sendCmdComplete(opcode, ext_adv ? HCIStatusCode::SUCCESS : HCIStatusCode::UNKNOWN_COMMAND, ret, sizeof(ret));
+        } break;
+        case HCIOpcode::LE_SET_EXT_ADV_PARAMS: {
+            if( !ext_adv || 3 > plen ) {
+                sendCmdComplete(opcode, ext_adv ? HCIStatusCode::INVALID_HCI_COMMAND_PARAMETERS : HCIStatusCode::UNKNOWN_COMMAND, nullptr, 0);
+                break;
+            }
+            AdvSet& set = getAdvSetLocked(param[0]);
+            set.connectable = 0 != ( jau::get_uint16(param + 1, jau::lb_endian_t::little) & 0x0001 );
+            const uint8_t ret[] = { 0x00 }; // selected tx power 0 dBm
+            sendCmdComplete(opcode, HCIStatusCode::SUCCESS, ret, sizeof(ret));
+        } break;
+        case HCIOpcode::LE_SET_EXT_ADV_DATA:
+            [[fallthrough]];
+        case HCIOpcode::LE_SET_EXT_SCAN_RSP_DATA: {
+            // handle, operation, fragment preference, length and data: only complete data supported
+            if( !ext_adv || 4 > plen ) {
+                sendCmdComplete(opcode, ext_adv ? HCIStatusCode::INVALID_HCI_COMMAND_PARAMETERS : HCIStatusCode::UNKNOWN_COMMAND, nullptr, 0);
+                break;
+            }
+            AdvSet& set = getAdvSetLocked(param[0]);
+            std::vector<uint8_t>& dst = HCIOpcode::LE_SET_EXT_ADV_DATA == static_cast<HCIOpcode>( opcode ) ? set.adv_data : set.scan_rsp_data;
+            const uint8_t size = std::min<uint8_t>(param[3], plen - 4);
+            dst.assign(param + 4, param + 4 + size);
+            sendCmdComplete(opcode, HCIStatusCode::SUCCESS, nullptr, 0);
+        } break;
+        case HCIOpcode::LE_SET_EXT_ADV_ENABLE: {
+            // enable, num_of_sets and sets of handle, duration and max_events
+            if( !ext_adv || 2 > plen || plen < 2 + 4 * param[1] ) {
+                sendCmdComplete(opcode, ext_adv ? HCIStatusCode::INVALID_HCI_COMMAND_PARAMETERS : HCIStatusCode::UNKNOWN_COMMAND, nullptr, 0);
+                break;
+            }
+            const bool enable = 0 != param[0];
+            if( 0 == param[1] ) {
+                if( !enable ) { // disables all sets
+                    for(AdvSet& set : adv_sets) {
+                        set.enabled = false;
+                    }
+                }
+            } else {
+                for(uint8_t i=0; i<param[1]; ++i) {
+                    getAdvSetLocked(param[2 + 4 * i]).enabled = enable;
+                }
+            }
+            sendCmdComplete(opcode, HCIStatusCode::SUCCESS, nullptr, 0);
+            if( enable ) {
+                for(HCIVirtualController* p : range) {
+                    if( p->scan_enabled ) {
+                        sendAdvReportsLocked(*p);
+                    }
+                }
+            }
+        } break;
+        case HCIOpcode::LE_CLEAR_ADV_SETS: {
+            adv_sets.clear();
+            sendCmdComplete(opcode, HCIStatusCode::SUCCESS, nullptr, 0);
+        } break;
+        case HCIOpcode::LE_SET_SCAN_ENABLE: {
+            scan_enabled = 1 <= plen && 0 != param[0];
+            sendCmdComplete(opcode, HCIStatusCode::SUCCESS, nullptr, 0);
+            if( scan_enabled ) {
+                for(HCIVirtualController* p : range) {
+                    p->sendAdvReportsLocked(*this);
+                }
+            }
+        } break;
+        case HCIOpcode::LE_CREATE_CONN: {
+            if( 12 > plen ) {
+                sendCmdStatus(opcode, HCIStatusCode::INVALID_HCI_COMMAND_PARAMETERS);
+                break;
+            }
+            const jau::EUI48 peer_address(param + 6, jau::lb_endian_t::little);
+            sendCmdStatus(opcode, HCIStatusCode::SUCCESS);
+            HCIVirtualController* peer = findInRangeLocked(peer_address);
+            AdvSet* peer_set = nullptr;
+            if( nullptr != peer && !peer->adv_enabled ) {
+                for(AdvSet& set : peer->adv_sets) {
+                    if( set.enabled && set.connectable ) {
+                        peer_set = &set;
+                        break;
+                    }
+                }
+            }
+            if( nullptr == peer || ( !peer->adv_enabled && nullptr == peer_set ) ) {
+                sendConnComplete(HCIStatusCode::CONNECTION_EST_FAILED_OR_SYNC_TIMEOUT, 0, 0x00, peer_address);
+                break;
+            }
+            const uint16_t handle = next_handle++;
+            const uint16_t peer_handle = peer->next_handle++;
+            links.emplace_back( handle, peer, peer_handle );
+            peer->links.emplace_back( peer_handle, this, handle );
+            // a connection ends legacy advertising or the connected advertising set only
+            if( nullptr != peer_set ) {
+                peer_set->enabled = false;
+            } else {
+                peer->adv_enabled = false;
+            }
+            sendConnComplete(HCIStatusCode::SUCCESS, handle, 0x00 /* central */, peer_address);
+            peer->sendConnComplete(HCIStatusCode::SUCCESS, peer_handle, 0x01 /* peripheral */, address);
+            if( nullptr != peer_set ) {
+                peer->sendAdvSetTerminated(peer_set->handle, peer_handle);
+            }
+        } break;
+        case HCIOpcode::LE_CREATE_CONN_CANCEL: {
+            // connections complete or fail immediately, hence nothing pending to cancel
+            sendCmdComplete(opcode, HCIStatusCode::COMMAND_DISALLOWED, nullptr, 0);
+        } break;
+        case HCIOpcode::LE_READ_REMOTE_FEATURES: {
+            const uint16_t handle = 2 <= plen ? jau::get_uint16(param, jau::lb_endian_t::little) : 0;
+            if( nullptr == findLinkLocked(handle) ) {
+                sendCmdStatus(opcode, HCIStatusCode::UNKNOWN_CONNECTION_IDENTIFIER);
+                break;
+            }
+            sendCmdStatus(opcode, HCIStatusCode::SUCCESS);
+            uint8_t ev[1+2+8];
+            jau::zero_bytes_sec(ev, sizeof(ev));
+            ev[0] = number(HCIStatusCode::SUCCESS);
+            jau::put_uint16(ev + 1, handle, jau::lb_endian_t::little);
+            sendMetaEvent(HCIMetaEventType::LE_REMOTE_FEAT_COMPLETE, ev, sizeof(ev));
+        } break;
+        case HCIOpcode::DISCONNECT: {
+            const uint16_t handle = 2 <= plen ? jau::get_uint16(param, jau::lb_endian_t::little) : 0;
+            const HCIStatusCode reason = 3 <= plen ? static_cast<HCIStatusCode>(param[2]) : HCIStatusCode::REMOTE_USER_TERMINATED_CONNECTION;
+            Link* l = findLinkLocked(handle);
+            if( nullptr == l ) {
+                sendCmdStatus(opcode, HCIStatusCode::UNKNOWN_CONNECTION_IDENTIFIER);
+                break;
+            }
+            const Link link = *l;
+            removeLinkLocked(handle);
+            link.peer->removeLinkLocked(link.peer_handle);
+            sendCmdStatus(opcode, HCIStatusCode::SUCCESS);
+            sendDisconnComplete(handle, HCIStatusCode::CONNECTION_TERMINATED_BY_LOCAL_HOST);
+            link.peer->sendDisconnComplete(link.peer_handle, reason);
+        } break;
+        case HCIOpcode::LE_PERIODIC_ADV_CREATE_SYNC: {
+            if( 14 > plen ) {
+                sendCmdStatus(opcode, HCIStatusCode::INVALID_HCI_COMMAND_PARAMETERS);
+                break;
+            }
+            sendCmdStatus(opcode, HCIStatusCode::SUCCESS);
+            // syncs immediately to any requested train, its reports are injected via injectPeriodicAdvReport()
+            const uint16_t sync_handle = next_sync_handle++;
+            periodic_syncs.push_back(sync_handle);
+            uint8_t ev[15];
+            ev[0] = number(HCIStatusCode::SUCCESS);
+            jau::put_uint16(ev + 1, sync_handle, jau::lb_endian_t::little);
+            ::memcpy(ev + 3, param + 1, 8); // Advertising_SID, Advertiser_Address_Type, Advertiser_Address
+            ev[11] = 0x01; // LE 1M
+            jau::put_uint16(ev + 12, 0x0050, jau::lb_endian_t::little); // 100ms
+            ev[14] = 0x00; // 500 ppm
+            sendMetaEvent(HCIMetaEventType::LE_PERIODIC_ADV_SYNC_ESTABLISHED, ev, sizeof(ev));
+        } break;
+        case HCIOpcode::LE_PERIODIC_ADV_CREATE_SYNC_CANCEL: {
+            // syncs are established immediately, hence nothing pending to cancel
+            sendCmdComplete(opcode, HCIStatusCode::COMMAND_DISALLOWED, nullptr, 0);
+        } break;
+        case HCIOpcode::LE_PERIODIC_ADV_TERMINATE_SYNC: {
+            const uint16_t sync_handle = 2 <= plen ? jau::get_uint16(param, jau::lb_endian_t::little) : 0;
+            auto it = std::find(periodic_syncs.begin(), periodic_syncs.end(), sync_handle);
+            if( periodic_syncs.end() == it ) {
+                sendCmdComplete(opcode, HCIStatusCode::UNKNOWN_ADVERTISING_IDENTIFIER, nullptr, 0);
+                break;
+            }
+            periodic_syncs.erase(it);
+            sendCmdComplete(opcode, HCIStatusCode::SUCCESS, nullptr, 0);
+        } break;
+        default: {
+            // Acknowledge w/ zeroed return parameter, sufficient for the remaining commands issued by HCIHandler
+            uint8_t ret[32];
+            jau::zero_bytes_sec(ret, sizeof(ret));
+            sendCmdComplete(opcode, HCIStatusCode::SUCCESS, ret, sizeof(ret));
+        } break;
+    }
+}
+
+void HCIVirtualController::processACLData(const uint8_t* buffer, const jau::nsize_t len) noexcept {
+    if( len < number(HCIConstSizeT::ACL_HDR_SIZE) ) {
+        return;
+    }
+    const uint16_t handle_and_flags = jau::get_uint16(buffer + 1, jau::lb_endian_t::little);
+    const uint16_t handle = handle_and_flags & 0x0fff;
+
+    const std::lock_guard<std::mutex> lock(mtx_links); // RAII-style acquire and relinquish via destructor
+    Link* l = findLinkLocked(handle);
+    if( nullptr == l ) {
+        DBG_PRINT("HCIVirtualController: Drop ACL data for unknown handle %s", jau::to_hexstring(handle).c_str());
+        return;
+    }
+    Link* pl = l->peer->findLinkLocked(l->peer_handle);
+    if( nullptr == pl ) {
+        return;
+    }
+    // forward to the peer with the peer's handle, retaining packet boundary and broadcast flags
+    uint8_t pkt[sizeof(rbuffer)];
+    ::memcpy(pkt, buffer, len);
+    jau::put_uint16(pkt + 1, ( handle_and_flags & 0xf000 ) | ( l->peer_handle & 0x0fff ), jau::lb_endian_t::little);
+    l->peer->receiveACLLocked(*pl, pkt, len);
+    ++acl_count;
+}
+
+void HCIVirtualController::processChannelLocked(const int sd) noexcept {
+    auto it = std::find_if(channels.begin(), channels.end(), [&](const Channel& c) { return c.sd == sd; });
+    if( channels.end() == it ) {
+        return; // closed meanwhile
+    }
+    const ssize_t len = ::recv(sd, pdu_buffer + 4, L2CAP_MAX_SDU_SIZE, MSG_DONTWAIT);
+    if( 0 > len && ( EAGAIN == errno || EINTR == errno ) ) {
+        return;
+    }
+    if( 0 >= len ) {
+        // host closed its channel or error
+        DBG_PRINT("HCIVirtualController: Closed channel handle %s, cid %s", jau::to_hexstring(it->handle).c_str(), jau::to_hexstring(it->cid).c_str());
+        ::close(sd);
+        channels.erase(it);
+        return;
+    }
+    Link* l = findLinkLocked(it->handle);
+    Link* pl = nullptr != l ? l->peer->findLinkLocked(l->peer_handle) : nullptr;
+    if( nullptr == pl ) {
+        return;
+    }
+    // basic L2CAP header, BT Core Spec v5.2: Vol 3, Part A: 3.1
+    const jau::nsize_t pdu_len = 4 + static_cast<jau::nsize_t>(len);
+    jau::put_uint16(pdu_buffer + 0, static_cast<uint16_t>(len), jau::lb_endian_t::little);
+    jau::put_uint16(pdu_buffer + 2, it->cid, jau::lb_endian_t::little);
+
+    // segment into ACL data packets of the peer's handle: first w/ the L2CAP header, then continuing fragments
+    uint8_t pkt[number(HCIConstSizeT::ACL_HDR_SIZE) + ACL_MAX_DATA_SIZE];
+    for(jau::nsize_t offset = 0; offset < pdu_len; offset += ACL_MAX_DATA_SIZE) {
+        const jau::nsize_t size = std::min<jau::nsize_t>(pdu_len - offset, ACL_MAX_DATA_SIZE);
+        const uint16_t pb_flag = 0 == offset ? 0x2000 : 0x1000;
+        pkt[0] = number(HCIPacketType::ACLDATA);
+        jau::put_uint16(pkt + 1, pb_flag | ( l->peer_handle & 0x0fff ), jau::lb_endian_t::little);
+        jau::put_uint16(pkt + 3, static_cast<uint16_t>(size), jau::lb_endian_t::little);
+        ::memcpy(pkt + number(HCIConstSizeT::ACL_HDR_SIZE), pdu_buffer + offset, size);
+        l->peer->receiveACLLocked(*pl, pkt, number(HCIConstSizeT::ACL_HDR_SIZE) + size);
+        ++acl_count;
+    }
+}
+
+void HCIVirtualController::receiveACLLocked(Link& l, const uint8_t* buffer, const jau::nsize_t len) noexcept {
+    const uint16_t handle_and_flags = jau::get_uint16(buffer + 1, jau::lb_endian_t::little);
+    const uint8_t* data = buffer + number(HCIConstSizeT::ACL_HDR_SIZE);
+    const jau::nsize_t size = std::min<jau::nsize_t>(jau::get_uint16(buffer + 3, jau::lb_endian_t::little), len - number(HCIConstSizeT::ACL_HDR_SIZE));
+
+    if( 0x1000 != ( handle_and_flags & 0x3000 ) ) {
+        // first fragment, leading w/ the basic L2CAP header
+        l.rx_sdu.clear();
+        l.rx_channel = false;
+        if( 4 <= size ) {
+            l.rx_len = jau::get_uint16(data + 0, jau::lb_endian_t::little);
+            l.rx_cid = jau::get_uint16(data + 2, jau::lb_endian_t::little);
+            l.rx_channel = nullptr != findChannelLocked(l.handle, l.rx_cid);
+            if( l.rx_channel ) {
+                l.rx_sdu.assign(data + 4, data + size);
+            }
+        }
+    } else if( l.rx_channel ) {
+        l.rx_sdu.insert(l.rx_sdu.end(), data, data + size);
+    }
+    if( !l.rx_channel ) {
+        send(buffer, len); // unbound channel, e.g. SMP, passed to the HCI host
+        return;
+    }
+    if( l.rx_sdu.size() >= l.rx_len ) {
+        Channel* c = findChannelLocked(l.handle, l.rx_cid);
+        if( nullptr != c && 0 > ::send(c->sd, l.rx_sdu.data(), l.rx_len, MSG_NOSIGNAL) ) {
+            DBG_PRINT("HCIVirtualController: Drop SDU for channel handle %s, cid %s, errno %d",
+                    jau::to_hexstring(l.handle).c_str(), jau::to_hexstring(l.rx_cid).c_str(), errno);
+        }
+        l.rx_sdu.clear();
+        l.rx_channel = false;
+    }
+}
+
+int HCIVirtualController::listenL2CAP(const uint16_t cid) noexcept {
+    const int sd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if( 0 > sd ) {
+        ERR_PRINT("HCIVirtualController: socket failed");
+        return -1;
+    }
+    const std::string name = "direct_bt.vctrl."+std::to_string(::getpid())+"."+std::to_string(listener_id++);
+    sockaddr_un a;
+    const socklen_t alen = setAbstractAddress(name, a);
+    if( 0 > ::bind(sd, (struct sockaddr*)&a, alen) || 0 > ::listen(sd, 10) ) {
+        ERR_PRINT("HCIVirtualController: bind/listen failed, cid %s", jau::to_hexstring(cid).c_str());
+        ::close(sd);
+        return -1;
+    }
+    const std::lock_guard<std::mutex> lock(mtx_links); // RAII-style acquire and relinquish via destructor
+    listeners.erase(std::remove_if(listeners.begin(), listeners.end(), [&](const Listener& li) { return li.cid == cid; }), listeners.end());
+    listeners.push_back( Listener{ cid, name } );
+    return sd;
+}
+
+int HCIVirtualController::acceptL2CAP(const int listen_sd, BDAddressAndType& remoteAddressAndType) noexcept {
+    const int sd = ::accept4(listen_sd, nullptr, nullptr, SOCK_CLOEXEC);
+    if( 0 > sd ) {
+        return -1;
+    }
+    // initiator's address, announced by openL2CAPChannel()
+    uint8_t b[7];
+    const ssize_t len = ::recv(sd, b, sizeof(b), 0);
+    if( sizeof(b) != len ) {
+        const int err = 0 > len ? errno : EPROTO;
+        ::close(sd);
+        errno = err;
+        return -1;
+    }
+    remoteAddressAndType = BDAddressAndType(jau::EUI48(b, jau::lb_endian_t::little), static_cast<BDAddressType>(b[6]));
+    return sd;
+}
+
+int HCIVirtualController::openL2CAPChannel(const jau::EUI48& peer_address, const uint16_t cid) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_links); // RAII-style acquire and relinquish via destructor
+    auto l = std::find_if(links.begin(), links.end(), [&](const Link& k) { return k.peer->address == peer_address; });
+    if( links.end() == l ) {
+        errno = ENOTCONN;
+        return -1;
+    }
+    HCIVirtualController* peer = l->peer;
+    auto li = std::find_if(peer->listeners.begin(), peer->listeners.end(), [&](const Listener& k) { return k.cid == cid; });
+    if( peer->listeners.end() == li ) {
+        errno = ECONNREFUSED;
+        return -1;
+    }
+    int fds[2];
+    if( 0 > ::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds) ) {
+        return -1;
+    }
+    const int peer_sd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    uint8_t b[7];
+    address.put(b, jau::lb_endian_t::little);
+    b[6] = number(BDAddressType::BDADDR_LE_PUBLIC);
+    sockaddr_un a;
+    const socklen_t alen = setAbstractAddress(li->name, a);
+    if( 0 > peer_sd || 0 > ::connect(peer_sd, (struct sockaddr*)&a, alen) || 0 > ::send(peer_sd, b, sizeof(b), MSG_NOSIGNAL) ) {
+        const int err = errno;
+        if( 0 <= peer_sd ) {
+            ::close(peer_sd);
+        }
+        ::close(fds[0]);
+        ::close(fds[1]);
+        if( ECONNREFUSED == err ) {
+            peer->listeners.erase(li); // listening host has closed
+        }
+        errno = err;
+        return -1;
+    }
+    closeChannelsLocked(l->handle, cid);
+    peer->closeChannelsLocked(l->peer_handle, cid);
+    channels.push_back( Channel{ l->handle, cid, fds[0] } );
+    peer->channels.push_back( Channel{ l->peer_handle, cid, peer_sd } );
+    wakeup();
+    peer->wakeup();
+    return fds[1];
+}
+
+bool HCIVirtualController::send(const uint8_t* buffer, const jau::nsize_t size) noexcept {
+    const std::lock_guard<std::recursive_mutex> lock(mtx_write); // RAII-style acquire and relinquish via destructor
+    if( 0 > ctrl_sd ) {
+        return false;
+    }
+    ssize_t len;
+    while( ( len = ::write(ctrl_sd, buffer, size) ) < 0 ) {
+        if( EAGAIN == errno || EINTR == errno ) {
+            continue;
+        }
+        return false;
+    }
+    return true;
+}
+
+bool HCIVirtualController::sendEvent(const HCIEventType evt, const uint8_t* param, const uint8_t param_size) noexcept {
+    uint8_t pkt[number(HCIConstSizeT::EVENT_HDR_SIZE) + 255];
+    pkt[0] = number(HCIPacketType::EVENT);
+    pkt[1] = number(evt);
+    pkt[2] = param_size;
+    if( 0 < param_size ) {
+        ::memcpy(pkt + number(HCIConstSizeT::EVENT_HDR_SIZE), param, param_size);
+    }
+    if( send(pkt, number(HCIConstSizeT::EVENT_HDR_SIZE) + param_size) ) {
+        ++evt_count;
+        return true;
+    }
+    return false;
+}
+
+bool HCIVirtualController::sendMetaEvent(const HCIMetaEventType mec, const uint8_t* param, const uint8_t param_size) noexcept {
+    uint8_t ev[255];
+    const uint8_t size = std::min<uint8_t>(param_size, sizeof(ev) - 1);
+    ev[0] = number(mec);
+    ::memcpy(ev + 1, param, size);
+    return sendEvent(HCIEventType::LE_META, ev, 1 + size);
+}
+
+bool HCIVirtualController::sendCmdComplete(const uint16_t opcode, const HCIStatusCode status, const uint8_t* ret, const uint8_t ret_size) noexcept {
+    uint8_t ev[255];
+    const uint8_t size = std::min<uint8_t>(ret_size, sizeof(ev) - 4);
+    ev[0] = 1; // ncmd
+    jau::put_uint16(ev + 1, opcode, jau::lb_endian_t::little);
+    ev[3] = number(status);
+    if( 0 < size ) {
+        ::memcpy(ev + 4, ret, size);
+    }
+    return sendEvent(HCIEventType::CMD_COMPLETE, ev, 4 + size);
+}
+
+bool HCIVirtualController::sendCmdStatus(const uint16_t opcode, const HCIStatusCode status) noexcept {
+    uint8_t ev[4];
+    ev[0] = number(status);
+    ev[1] = 1; // ncmd
+    jau::put_uint16(ev + 2, opcode, jau::lb_endian_t::little);
+    return sendEvent(HCIEventType::CMD_STATUS, ev, sizeof(ev));
+}
+
+bool HCIVirtualController::sendConnComplete(const HCIStatusCode status, const uint16_t handle, const uint8_t role, const jau::EUI48& peer_address) noexcept {
+    uint8_t ev[18];
+    jau::zero_bytes_sec(ev, sizeof(ev));
+    ev[0] = number(status);
+    jau::put_uint16(ev + 1, handle, jau::lb_endian_t::little);
+    ev[3] = role;
+    ev[4] = 0x00; // public peer address
+    peer_address.put(ev + 5, jau::lb_endian_t::little);
+    jau::put_uint16(ev + 11, 0x0018, jau::lb_endian_t::little); // interval 30ms
+    jau::put_uint16(ev + 13, 0x0000, jau::lb_endian_t::little); // latency
+    jau::put_uint16(ev + 15, 0x01f4, jau::lb_endian_t::little); // supervision timeout 5s
+    ev[17] = 0x00; // clock accuracy
+    return sendMetaEvent(HCIMetaEventType::LE_CONN_COMPLETE, ev, sizeof(ev));
+}
+
+bool HCIVirtualController::sendDisconnComplete(const uint16_t handle, const HCIStatusCode reason) noexcept {
+    uint8_t ev[4];
+    ev[0] = number(HCIStatusCode::SUCCESS);
+    jau::put_uint16(ev + 1, handle, jau::lb_endian_t::little);
+    ev[3] = number(reason);
+    return sendEvent(HCIEventType::DISCONN_COMPLETE, ev, sizeof(ev));
+}
+
+bool HCIVirtualController::sendAdvReport(const AD_PDU_Type evt_type, const jau::EUI48& adv_address, const uint8_t* data, const uint8_t data_size, const int8_t rssi) noexcept {
+    uint8_t ev[255];
+    const uint8_t size = std::min<uint8_t>(data_size, 31);
+    ev[0] = 1; // num_reports
+    ev[1] = number(evt_type);
+    ev[2] = 0x00; // public address
+    adv_address.put(ev + 3, jau::lb_endian_t::little);
+    ev[9] = size;
+    if( 0 < size ) {
+        ::memcpy(ev + 10, data, size);
+    }
+    ev[10 + size] = static_cast<uint8_t>(rssi);
+    return sendMetaEvent(HCIMetaEventType::LE_ADVERTISING_REPORT, ev, 11 + size);
+}
+
+bool HCIVirtualController::sendAdvSetTerminated(const uint8_t adv_handle, const uint16_t conn_handle) noexcept {
+    uint8_t ev[5];
+    ev[0] = number(HCIStatusCode::SUCCESS);
+    ev[1] = adv_handle;
+    jau::put_uint16(ev + 2, conn_handle, jau::lb_endian_t::little);
+    ev[4] = 0; // num_completed_ext_adv_events
+    return sendMetaEvent(HCIMetaEventType::LE_ADV_SET_TERMINATED, ev, sizeof(ev));
+}
+
+void HCIVirtualController::sendAdvReportsLocked(HCIVirtualController& scanner) noexcept {
+    if( adv_enabled ) {
+        scanner.sendAdvReport(AD_PDU_Type::ADV_IND, address, adv_data.data(), static_cast<uint8_t>(adv_data.size()), -40);
+        if( 0 < scan_rsp_data.size() ) {
+            scanner.sendAdvReport(AD_PDU_Type::SCAN_RSP, address, scan_rsp_data.data(), static_cast<uint8_t>(scan_rsp_data.size()), -40);
+        }
+    }
+    // extended advertising sets are reported as legacy advertising reports
+    for(const AdvSet& set : adv_sets) {
+        if( set.enabled ) {
+            scanner.sendAdvReport(AD_PDU_Type::ADV_IND, address, set.adv_data.data(), static_cast<uint8_t>(set.adv_data.size()), -40);
+            if( 0 < set.scan_rsp_data.size() ) {
+                scanner.sendAdvReport(AD_PDU_Type::SCAN_RSP, address, set.scan_rsp_data.data(), static_cast<uint8_t>(set.scan_rsp_data.size()), -40);
+            }
+        }
+    }
+}
+
+HCIVirtualController::AdvSet& HCIVirtualController::getAdvSetLocked(const uint8_t handle) noexcept {
+    for(AdvSet& set : adv_sets) {
+        if( handle == set.handle ) {
+            return set;
+        }
+    }
+    adv_sets.push_back( AdvSet { handle, false, false, std::vector<uint8_t>(), std::vector<uint8_t>() } );
+    return adv_sets.back();
+}
+
+bool HCIVirtualController::injectAdvertisingReport(const AD_PDU_Type evt_type, const jau::EUI48& adv_address,
+                                                   const uint8_t* data, const uint8_t data_size, const int8_t rssi) noexcept {
+    {
+        const std::lock_guard<std::mutex> lock(mtx_links); // RAII-style acquire and relinquish via destructor
+        if( !scan_enabled ) {
+            return false;
+        }
+    }
+    return sendAdvReport(evt_type, adv_address, data, data_size, rssi);
+}
+
+bool HCIVirtualController::injectPeriodicAdvReport(const uint16_t sync_handle, const uint8_t* data, const uint8_t data_size, const int8_t rssi) noexcept {
+    {
+        const std::lock_guard<std::mutex> lock(mtx_links); // RAII-style acquire and relinquish via destructor
+        if( periodic_syncs.end() == std::find(periodic_syncs.begin(), periodic_syncs.end(), sync_handle) ) {
+            return false;
+        }
+    }
+    uint8_t ev[255];
+    const uint8_t size = std::min<uint8_t>(data_size, sizeof(ev) - 7);
+    jau::put_uint16(ev + 0, sync_handle, jau::lb_endian_t::little);
+    ev[2] = 0x7f; // tx_power n/a
+    ev[3] = static_cast<uint8_t>(rssi);
+    ev[4] = 0xff; // no CTE
+    ev[5] = number(EAD_DataStatus::COMPLETE);
+    ev[6] = size;
+    if( 0 < size ) {
+        ::memcpy(ev + 7, data, size);
+    }
+    return sendMetaEvent(HCIMetaEventType::LE_PERIODIC_ADV_REPORT, ev, 7 + size);
+}
+
+bool HCIVirtualController::injectPeriodicAdvSyncLost(const uint16_t sync_handle) noexcept {
+    {
+        const std::lock_guard<std::mutex> lock(mtx_links); // RAII-style acquire and relinquish via destructor
+        auto it = std::find(periodic_syncs.begin(), periodic_syncs.end(), sync_handle);
+        if( periodic_syncs.end() == it ) {
+            return false;
+        }
+        periodic_syncs.erase(it);
+    }
+    uint8_t ev[2];
+    jau::put_uint16(ev, sync_handle, jau::lb_endian_t::little);
+    return sendMetaEvent(HCIMetaEventType::LE_PERIODIC_ADV_SYNC_LOST, ev, sizeof(ev));
+}
+
+std::string HCIVirtualController::toString() const noexcept {
+    return "HCIVirtualController["+address.toString()+", open "+std::to_string(is_open())+
+           ", cmds "+std::to_string(cmd_count.load())+", evts "+std::to_string(evt_count.load())+
+           ", acl "+std::to_string(acl_count.load())+"]";
+}
@@ -0,0 +1,294 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+
+#include <jau/debug.hpp>
+
+#include "DBTConst.hpp"
+#include "IOReactor.hpp"
+
+extern "C" {
+    #include <inttypes.h>
+    #include <unistd.h>
+    #include <sys/epoll.h>
+}
+
+using namespace direct_bt;
+using namespace jau::fractions_i64_literals;
+
+namespace {
+    /** epoll events of one dispatchWork() iteration, handed over by a blocking ReadyCallback. */
+    struct DispatchBatch {
+        const struct ::epoll_event* events;
+        int next;
+        int count;
+    };
+    /** Registration id dispatched by the current thread, zero if none */
+    thread_local uint64_t tl_dispatch_id = 0;
+    thread_local DispatchBatch* tl_batch = nullptr;
+}
+
+IOReactorEnv::IOReactorEnv() noexcept
+: exploding( jau::environment::getExplodingProperties("direct_bt.reactor") ),
+  REACTOR_ENABLED( jau::environment::getBooleanProperty("direct_bt.reactor", false) ),
+  REACTOR_THREADS( jau::environment::getInt32Property("direct_bt.reactor.threads", 1, 1 /* min */, 16 /* max */) ),
+  DEBUG_REACTOR( jau::environment::getBooleanProperty("direct_bt.debug.reactor", false) )
+{
+}
+
+IOReactor::IOReactor() noexcept
+: env(IOReactorEnv::get()),
+  epoll_fd( ::epoll_create1(EPOLL_CLOEXEC) ),
+  next_id(1),
+  blocked_count(0),
+  dispatch_count(0), extra_started(0)
+{
+    if( 0 > epoll_fd ) {
+        ERR_PRINT("IOReactor: epoll_create1 failed");
+    }
+}
+
+IOReactor::~IOReactor() noexcept {
+    for(std::unique_ptr<jau::service_runner>& sr : dispatcher) {
+        sr->stop();
+    }
+    dispatcher.clear();
+    {
+        const std::lock_guard<std::mutex> lock(mtx_entries); // RAII-style acquire and relinquish via destructor
+        entries.clear();
+    }
+    if( 0 <= epoll_fd ) {
+        ::close(epoll_fd);
+        epoll_fd = -1;
+    }
+}
+
+void IOReactor::startLocked() noexcept {
+    if( !dispatcher.empty() ) {
+        return;
+    }
+    for(int32_t i=0; i<env.REACTOR_THREADS; ++i) {
+        startDispatcherLocked();
+    }
+    DBG_PRINT("IOReactor: Started %d dispatch threads", env.REACTOR_THREADS);
+}
+
+void IOReactor::startDispatcherLocked() noexcept {
+    std::unique_ptr<jau::service_runner> sr = std::make_unique<jau::service_runner>(
+            "IOReactor::dispatch_"+std::to_string(dispatcher.size()), THREAD_SHUTDOWN_TIMEOUT_MS,
+            jau::bind_member(this, &IOReactor::dispatchWork),
+            jau::service_runner::Callback() /* init */,
+            jau::service_runner::Callback() /* end */);
+    sr->start();
+    dispatcher.push_back( std::move(sr) );
+}
+
+bool IOReactor::rearmLocked(const uint64_t id, Entry& e) noexcept {
+    struct ::epoll_event ev;
+    ::memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    ev.data.u64 = id;
+    return 0 <= ::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, e.fd, &ev);
+}
+
+void IOReactor::dispatchWork(jau::service_runner& sr) noexcept {
+    constexpr const int max_events = 16;
+    constexpr const int timeoutMS = 500; // bounded for shutdown
+    struct ::epoll_event events[max_events];
+
+    const int n = ::epoll_wait(epoll_fd, events, max_events, timeoutMS);
+    if( 0 > n ) {
+        if( EINTR != errno ) {
+            ERR_PRINT("IOReactor: epoll_wait failed");
+            jau::sleep_for( 10_ms ); // avoid busy loop
+        }
+        return;
+    }
+    DispatchBatch batch { events, 0, n };
+    tl_batch = &batch;
+    for(int i=0; i<batch.count && !sr.shall_stop(); ++i) {
+        batch.next = i + 1;
+        const uint64_t id = events[i].data.u64;
+        std::shared_ptr<Entry> e;
+        {
+            const std::lock_guard<std::mutex> lock(mtx_entries); // RAII-style acquire and relinquish via destructor
+            auto it = entries.find(id);
+            if( entries.end() == it || it->second->removed ) {
+                continue;
+            }
+            e = it->second;
+            e->busy = true;
+            e->busy_tid = std::this_thread::get_id();
+        }
+        dispatch_count++;
+        COND_PRINT(env.DEBUG_REACTOR, "IOReactor: Dispatch %s, fd %d, events 0x%x", e->name.c_str(), e->fd, events[i].events);
+        bool keep = false;
+        tl_dispatch_id = id;
+        try {
+            keep = e->cb();
+        } catch (std::exception &ex) {
+            ERR_PRINT("IOReactor: %s: Caught exception %s", e->name.c_str(), ex.what());
+        }
+        tl_dispatch_id = 0;
+        {
+            const std::lock_guard<std::mutex> lock(mtx_entries); // RAII-style acquire and relinquish via destructor
+            e->busy = false;
+            if( !e->removed ) {
+                if( !keep || !rearmLocked(id, *e) ) {
+                    if( keep ) {
+                        ERR_PRINT("IOReactor: Re-arm failed %s, fd %d", e->name.c_str(), e->fd);
+                    }
+                    ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, e->fd, nullptr);
+                    e->removed = true;
+                    entries.erase(id);
+                    DBG_PRINT("IOReactor: Ended %s, fd %d", e->name.c_str(), e->fd);
+                }
+            }
+        }
+        cv_entries.notify_all();
+    }
+    tl_batch = nullptr;
+}
+
+IOReactor::BlockingScope::BlockingScope() noexcept
+: blocking( 0 != tl_dispatch_id )
+{
+    if( blocking ) {
+        IOReactor::get().beginBlocking();
+    }
+}
+
+IOReactor::BlockingScope::~BlockingScope() noexcept {
+    if( blocking ) {
+        IOReactor::get().endBlocking();
+    }
+}
+
+void IOReactor::beginBlocking() noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_entries); // RAII-style acquire and relinquish via destructor
+    // hand over the not yet dispatched events of this thread's batch, their one-shot registrations are re-armed
+    if( nullptr != tl_batch ) {
+        for(int i=tl_batch->next; i<tl_batch->count; ++i) {
+            const uint64_t id = tl_batch->events[i].data.u64;
+            auto it = entries.find(id);
+            if( entries.end() != it && !it->second->removed ) {
+                rearmLocked(id, *it->second);
+            }
+        }
+        tl_batch->count = tl_batch->next;
+    }
+    ++blocked_count;
+    if( blocked_count >= dispatcher.size() ) {
+        if( dispatcher.size() < static_cast<size_t>( env.REACTOR_THREADS + MAX_EXTRA_THREADS ) ) {
+            startDispatcherLocked();
+            extra_started++;
+            DBG_PRINT("IOReactor: Blocking callback, started dispatch thread %zu", dispatcher.size());
+        } else {
+            WARN_PRINT("IOReactor: Blocking callback, all %zu dispatch threads blocked", dispatcher.size());
+        }
+    }
+}
+
+void IOReactor::endBlocking() noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_entries); // RAII-style acquire and relinquish via destructor
+    --blocked_count;
+}
+
+bool IOReactor::isDispatching(const uint64_t id) noexcept {
+    return 0 != id && id == tl_dispatch_id;
+}
+
+uint64_t IOReactor::add(const int fd, const std::string& name, ReadyCallback cb) noexcept {
+    if( 0 > fd ) {
+        ERR_PRINT("IOReactor: Invalid fd %d for %s", fd, name.c_str());
+        return 0;
+    }
+    const std::lock_guard<std::mutex> lock(mtx_entries); // RAII-style acquire and relinquish via destructor
+    if( 0 > epoll_fd ) {
+        ERR_PRINT("IOReactor: Not open, %s", name.c_str());
+        return 0;
+    }
+    const uint64_t id = next_id++;
+    std::shared_ptr<Entry> e = std::make_shared<Entry>();
+    e->fd = fd;
+    e->name = name;
+    e->cb = std::move(cb);
+    e->busy = false;
+    e->removed = false;
+
+    struct ::epoll_event ev;
+    ::memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    ev.data.u64 = id;
+    entries[id] = e; // dispatch blocks on mtx_entries until we are done
+    if( 0 > ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) ) {
+        ERR_PRINT("IOReactor: epoll_ctl add failed %s, fd %d", name.c_str(), fd);
+        entries.erase(id);
+        return 0;
+    }
+    startLocked();
+    COND_PRINT(env.DEBUG_REACTOR, "IOReactor: Added %s, fd %d, id %" PRIu64 ", entries %zu", name.c_str(), fd, id, entries.size());
+    return id;
+}
+
+bool IOReactor::remove(const uint64_t id) noexcept {
+    std::unique_lock<std::mutex> lock(mtx_entries); // RAII-style acquire and relinquish via destructor
+    auto it = entries.find(id);
+    if( entries.end() == it ) {
+        return false;
+    }
+    std::shared_ptr<Entry> e = it->second;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, e->fd, nullptr); // may fail if already closed
+    e->removed = true;
+    entries.erase(it);
+    if( e->busy_tid != std::this_thread::get_id() ) {
+        while( e->busy ) {
+            cv_entries.wait(lock);
+        }
+    }
+    COND_PRINT(env.DEBUG_REACTOR, "IOReactor: Removed %s, fd %d, id %" PRIu64 ", entries %zu", e->name.c_str(), e->fd, id, entries.size());
+    return true;
+}
+
+bool IOReactor::contains(const uint64_t id) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_entries); // RAII-style acquire and relinquish via destructor
+    return entries.end() != entries.find(id);
+}
+
+jau::nsize_t IOReactor::size() noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_entries); // RAII-style acquire and relinquish via destructor
+    return entries.size();
+}
+
+std::string IOReactor::toString() noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_entries); // RAII-style acquire and relinquish via destructor
+    return "IOReactor[enabled "+std::to_string(env.REACTOR_ENABLED)+
+           ", threads "+std::to_string(dispatcher.size())+
+           ", blocked "+std::to_string(blocked_count)+
+           ", entries "+std::to_string(entries.size())+
+           ", dispatched "+std::to_string(dispatch_count)+"]";
+}
@@ -0,0 +1,417 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+
+#include <jau/debug.hpp>
+#include <jau/environment.hpp>
+#include <jau/ordered_atomic.hpp>
+
+#include "IOUring.hpp"
+
+extern "C" {
+    #include <inttypes.h>
+    #include <errno.h>
+    #include <sys/uio.h>
+#ifdef DIRECT_BT_USE_IO_URING
+    #include <liburing.h>
+#endif
+}
+
+using namespace direct_bt;
+
+#ifdef DIRECT_BT_USE_IO_URING
+static jau::relaxed_atomic_bool& uringEnabled() noexcept {
+    static jau::relaxed_atomic_bool enabled( jau::environment::getBooleanProperty("direct_bt.io_uring", true) );
+    return enabled;
+}
+#endif
+
+bool IOUringChannel::isEnabled() noexcept {
+#ifdef DIRECT_BT_USE_IO_URING
+    return uringEnabled();
+#else
+    return false;
+#endif
+}
+
+bool IOUringChannel::setEnabled(const bool enable) noexcept {
+#ifdef DIRECT_BT_USE_IO_URING
+    uringEnabled() = enable;
+    return true;
+#else
+    return !enable;
+#endif
+}
+
+#ifdef DIRECT_BT_USE_IO_URING
+
+/** Provided buffer group ID of the receive ring. */
+static constexpr const int RX_BGID = 0;
+
+static bool armReceive(struct ::io_uring& ring, const int fd) noexcept {
+    struct ::io_uring_sqe* sqe = ::io_uring_get_sqe(&ring);
+    if( nullptr == sqe ) {
+        return false;
+    }
+    ::io_uring_prep_recv_multishot(sqe, fd, nullptr, 0, 0);
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = RX_BGID;
+    return 1 == ::io_uring_submit(&ring);
+}
+
+struct IOUringChannel::Impl {
+    struct ::io_uring rx_ring;
+    struct ::io_uring tx_ring;
+    struct ::io_uring_buf_ring* rx_bufs;
+    std::unique_ptr<uint8_t[]> rx_arena;
+    std::unique_ptr<uint8_t[]> tx_arena;
+    bool rx_ring_valid;
+    bool tx_ring_valid;
+    bool rx_armed;
+    bool rx_eof;
+    int rx_mask;
+    uint64_t rx_packets;
+    uint64_t rx_rearms;
+    uint64_t tx_packets;
+    uint64_t tx_submits;
+
+    Impl() noexcept
+    : rx_bufs(nullptr), rx_ring_valid(false), tx_ring_valid(false), rx_armed(false), rx_eof(false), rx_mask(0),
+      rx_packets(0), rx_rearms(0), tx_packets(0), tx_submits(0)
+    { }
+
+    /**
+     * Fetches the next receive completion, re-arming a terminated multishot receive.
+     * Waits up to `ts` or infinitely if nullptr, if `wait` is true.
+     * @return zero on success, `-ETIME` on timeout, `-EAGAIN` if none completed w/o wait or another negative error
+     */
+    int rxNext(const int fd, struct ::io_uring_cqe** cqe, struct ::__kernel_timespec* ts, const bool wait) noexcept {
+        for(;;) {
+            if( !rx_armed ) {
+                if( !armReceive(rx_ring, fd) ) {
+                    return -EIO;
+                }
+                rx_armed = true;
+                ++rx_rearms;
+            }
+            const int res = wait ? ::io_uring_wait_cqe_timeout(&rx_ring, cqe, ts) : ::io_uring_peek_cqe(&rx_ring, cqe);
+            if( 0 != res ) {
+                return res;
+            }
+            if( 0 == ( (*cqe)->flags & IORING_CQE_F_MORE ) ) {
+                rx_armed = false; // terminated, e.g. buffers exhausted or error
+            }
+            if( -ENOBUFS == (*cqe)->res ) {
+                // all slots in use, they are returned after copying: re-arm and retry
+                ::io_uring_cqe_seen(&rx_ring, *cqe);
+                continue;
+            }
+            return 0;
+        }
+    }
+
+    /**
+     * Copies the completed packet to `buffer` and hands its slot back to the kernel.
+     * @return number of bytes copied, zero if the peer has shutdown or -1 on error with `errno` set
+     */
+    jau::snsize_t rxTake(struct ::io_uring_cqe* cqe, uint8_t* buffer, const jau::nsize_t capacity, const jau::nsize_t slot_size) noexcept {
+        jau::snsize_t len = -1;
+        if( 0 > cqe->res ) {
+            errno = -cqe->res;
+        } else if( 0 == cqe->res ) {
+            len = 0; // end of stream, don't re-arm a shutdown socket
+            rx_eof = true;
+        }
+        if( 0 != ( cqe->flags & IORING_CQE_F_BUFFER ) ) {
+            const unsigned int bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+            uint8_t* slot = rx_arena.get() + bid * slot_size;
+            if( 0 < cqe->res ) {
+                len = std::min<jau::snsize_t>(cqe->res, static_cast<jau::snsize_t>(capacity));
+                ::memcpy(buffer, slot, len);
+                ++rx_packets;
+            }
+            // hand the slot back to the kernel
+            ::io_uring_buf_ring_add(rx_bufs, slot, slot_size, static_cast<unsigned short>(bid), rx_mask, 0);
+            ::io_uring_buf_ring_advance(rx_bufs, 1);
+        }
+        ::io_uring_cqe_seen(&rx_ring, cqe);
+        return len;
+    }
+};
+
+static void toKernelTimespec(const jau::fraction_i64& timeout, struct ::__kernel_timespec& ts) noexcept {
+    const int64_t ns = timeout.to_num_of(jau::fractions_i64::nano);
+    ts.tv_sec = ns / 1000000000L;
+    ts.tv_nsec = ns % 1000000000L;
+}
+
+IOUringChannel::IOUringChannel(const int fd_, const jau::nsize_t slot_size_, const jau::nsize_t slot_count_) noexcept
+: fd(fd_), slot_size(slot_size_), slot_count(slot_count_), impl(std::make_unique<Impl>())
+{ }
+
+IOUringChannel::~IOUringChannel() noexcept {
+    if( impl->rx_ring_valid ) {
+        if( nullptr != impl->rx_bufs ) {
+            ::io_uring_free_buf_ring(&impl->rx_ring, impl->rx_bufs, slot_count, RX_BGID);
+        }
+        ::io_uring_queue_exit(&impl->rx_ring); // cancels the armed receive
+    }
+    if( impl->tx_ring_valid ) {
+        ::io_uring_queue_exit(&impl->tx_ring);
+    }
+}
+
+std::unique_ptr<IOUringChannel> IOUringChannel::create(const int fd_, const jau::nsize_t slot_size_, const jau::nsize_t slot_count_) noexcept {
+    if( 0 > fd_ || 0 == slot_size_ || 0 == slot_count_ || 32768 < slot_count_ || 0 != ( slot_count_ & ( slot_count_ - 1 ) ) ) {
+        ERR_PRINT("IOUringChannel::create: Invalid arguments fd %d, slot_size %u, slot_count %u", fd_, slot_size_, slot_count_);
+        return nullptr;
+    }
+    std::unique_ptr<IOUringChannel> ch( new IOUringChannel(fd_, slot_size_, slot_count_) );
+    Impl& i = *ch->impl;
+    int res;
+
+    if( 0 != ( res = ::io_uring_queue_init(8, &i.rx_ring, 0) ) ) {
+        DBG_PRINT("IOUringChannel::create: rx io_uring_queue_init failed: %d", res);
+        return nullptr;
+    }
+    i.rx_ring_valid = true;
+    i.rx_bufs = ::io_uring_setup_buf_ring(&i.rx_ring, slot_count_, RX_BGID, 0, &res);
+    if( nullptr == i.rx_bufs ) {
+        DBG_PRINT("IOUringChannel::create: io_uring_setup_buf_ring failed: %d", res);
+        return nullptr;
+    }
+    i.rx_arena = std::make_unique<uint8_t[]>(slot_count_ * slot_size_);
+    i.rx_mask = ::io_uring_buf_ring_mask(slot_count_);
+    for(jau::nsize_t b=0; b<slot_count_; ++b) {
+        ::io_uring_buf_ring_add(i.rx_bufs, i.rx_arena.get() + b * slot_size_, slot_size_, static_cast<unsigned short>(b), i.rx_mask, static_cast<int>(b));
+    }
+    ::io_uring_buf_ring_advance(i.rx_bufs, static_cast<int>(slot_count_));
+
+    if( 0 != ( res = ::io_uring_queue_init(slot_count_, &i.tx_ring, 0) ) ) {
+        DBG_PRINT("IOUringChannel::create: tx io_uring_queue_init failed: %d", res);
+        return nullptr;
+    }
+    i.tx_ring_valid = true;
+    i.tx_arena = std::make_unique<uint8_t[]>(slot_count_ * slot_size_);
+    {
+        struct ::iovec iov;
+        iov.iov_base = i.tx_arena.get();
+        iov.iov_len = slot_count_ * slot_size_;
+        if( 0 != ( res = ::io_uring_register_buffers(&i.tx_ring, &iov, 1) ) ) {
+            DBG_PRINT("IOUringChannel::create: io_uring_register_buffers failed: %d", res);
+            return nullptr;
+        }
+    }
+
+    if( !armReceive(i.rx_ring, fd_) ) {
+        DBG_PRINT("IOUringChannel::create: Arming multishot receive failed");
+        return nullptr;
+    }
+    i.rx_armed = true;
+    {
+        // Kernel w/o multishot receive rejects the request inline
+        struct ::io_uring_cqe* cqe = nullptr;
+        if( 0 == ::io_uring_peek_cqe(&i.rx_ring, &cqe) && nullptr != cqe && -EINVAL == cqe->res ) {
+            DBG_PRINT("IOUringChannel::create: Multishot receive not supported");
+            ::io_uring_cqe_seen(&i.rx_ring, cqe);
+            return nullptr;
+        }
+    }
+    DBG_PRINT("IOUringChannel::create: %s", ch->toString().c_str());
+    return ch;
+}
+
+jau::snsize_t IOUringChannel::read(uint8_t* buffer, const jau::nsize_t capacity, const jau::fraction_i64& timeout) noexcept {
+    Impl& i = *impl;
+    struct ::io_uring_cqe* cqe = nullptr;
+    struct ::__kernel_timespec ts = { 0, 0 };
+
+    if( i.rx_eof ) {
+        return 0;
+    }
+    if( !timeout.is_zero() ) {
+        toKernelTimespec(timeout, ts);
+    }
+    const int res = i.rxNext(fd, &cqe, timeout.is_zero() ? nullptr : &ts, true /* wait */);
+    if( 0 != res ) {
+        errno = -ETIME == res ? ETIMEDOUT : -res;
+        return -1;
+    }
+    return i.rxTake(cqe, buffer, capacity, slot_size);
+}
+
+jau::snsize_t IOUringChannel::read_batch(uint8_t* buffer, const jau::nsize_t slot_capacity, const jau::nsize_t count,
+                                         jau::nsize_t* lengths, const jau::fraction_i64& timeout) noexcept {
+    Impl& i = *impl;
+    struct ::io_uring_cqe* cqe = nullptr;
+    struct ::__kernel_timespec ts = { 0, 0 };
+    jau::nsize_t n = 0;
+
+    if( i.rx_eof || 0 == count || 0 == slot_capacity ) {
+        return 0;
+    }
+    if( !timeout.is_zero() ) {
+        toKernelTimespec(timeout, ts);
+    }
+    int res = i.rxNext(fd, &cqe, &ts, !timeout.is_zero() /* wait */);
+    while( 0 == res ) {
+        const jau::snsize_t len = i.rxTake(cqe, buffer + n * slot_capacity, slot_capacity, slot_size);
+        if( 0 > len ) {
+            return 0 < n ? static_cast<jau::snsize_t>(n) : -1; // errno set
+        }
+        if( 0 == len ) {
+            break; // end of stream
+        }
+        lengths[n++] = static_cast<jau::nsize_t>(len);
+        if( n == count ) {
+            break;
+        }
+        res = i.rxNext(fd, &cqe, nullptr, false /* wait */);
+    }
+    if( 0 == n && 0 != res && -EAGAIN != res ) {
+        errno = -ETIME == res ? ETIMEDOUT : -res;
+        return -1;
+    }
+    return static_cast<jau::snsize_t>(n);
+}
+
+jau::snsize_t IOUringChannel::write(const uint8_t* buffer, const jau::nsize_t length) noexcept {
+    const jau::snsize_t n = write_batch(&buffer, &length, 1);
+    return 1 == n ? static_cast<jau::snsize_t>(length) : -1;
+}
+
+jau::snsize_t IOUringChannel::write_batch(const uint8_t* const* buffers, const jau::nsize_t* lengths, const jau::nsize_t count_) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx_write); // RAII-style acquire and relinquish via destructor
+    Impl& i = *impl;
+    const jau::nsize_t count = std::min(count_, slot_count);
+    if( 0 == count ) {
+        return 0;
+    }
+    for(jau::nsize_t p=0; p<count; ++p) {
+        struct ::io_uring_sqe* sqe = ::io_uring_get_sqe(&i.tx_ring);
+        if( lengths[p] <= slot_size ) {
+            uint8_t* slot = i.tx_arena.get() + p * slot_size;
+            ::memcpy(slot, buffers[p], lengths[p]);
+            ::io_uring_prep_write_fixed(sqe, fd, slot, lengths[p], 0, 0);
+        } else {
+            ::io_uring_prep_write(sqe, fd, buffers[p], lengths[p], 0);
+        }
+        ::io_uring_sqe_set_data64(sqe, p);
+        if( p < count - 1 ) {
+            sqe->flags |= IOSQE_IO_LINK; // keep packet order, cancel the remainder on failure
+        }
+    }
+    int res;
+    while( ( res = ::io_uring_submit_and_wait(&i.tx_ring, count) ) < 0 && -EINTR == res ) { }
+    if( 0 > res ) {
+        errno = -res;
+        return -1;
+    }
+    ++i.tx_submits;
+
+    // Reap all completions, counting the leading successfully written packets
+    jau::nsize_t done = 0;
+    jau::nsize_t first_err = count;
+    int err = 0;
+    for(jau::nsize_t c=0; c<count; ++c) {
+        struct ::io_uring_cqe* cqe = nullptr;
+        while( ( res = ::io_uring_wait_cqe(&i.tx_ring, &cqe) ) < 0 && -EINTR == res ) { }
+        if( 0 > res ) {
+            errno = -res;
+            return 0 < done ? static_cast<jau::snsize_t>(done) : -1;
+        }
+        const jau::nsize_t p = static_cast<jau::nsize_t>( ::io_uring_cqe_get_data64(cqe) );
+        if( 0 > cqe->res || static_cast<jau::nsize_t>(cqe->res) != lengths[p] ) {
+            if( p < first_err ) {
+                first_err = p;
+                err = 0 > cqe->res ? -cqe->res : EIO;
+            }
+        }
+        ::io_uring_cqe_seen(&i.tx_ring, cqe);
+    }
+    done = first_err;
+    i.tx_packets += done;
+    if( 0 == done ) {
+        errno = err;
+        return -1;
+    }
+    return static_cast<jau::snsize_t>(done);
+}
+
+std::string IOUringChannel::toString() const noexcept {
+    return "IOUringChannel[fd "+std::to_string(fd)+", slots "+std::to_string(slot_count)+" x "+std::to_string(slot_size)+
+           ", rx[packets "+std::to_string(impl->rx_packets)+", rearms "+std::to_string(impl->rx_rearms)+
+           "], tx[packets "+std::to_string(impl->tx_packets)+", submits "+std::to_string(impl->tx_submits)+"]]";
+}
+
+#else /* DIRECT_BT_USE_IO_URING */
+
+struct IOUringChannel::Impl { };
+
+IOUringChannel::IOUringChannel(const int fd_, const jau::nsize_t slot_size_, const jau::nsize_t slot_count_) noexcept
+: fd(fd_), slot_size(slot_size_), slot_count(slot_count_), impl(nullptr)
+{ }
+
+IOUringChannel::~IOUringChannel() noexcept = default;
+
+std::unique_ptr<IOUringChannel> IOUringChannel::create(const int fd_, const jau::nsize_t slot_size_, const jau::nsize_t slot_count_) noexcept {
+    (void)fd_; (void)slot_size_; (void)slot_count_;
+    return nullptr;
+}
+
+jau::snsize_t IOUringChannel::read(uint8_t* buffer, const jau::nsize_t capacity, const jau::fraction_i64& timeout) noexcept {
+    (void)buffer; (void)capacity; (void)timeout;
+    errno = ENOTSUP;
+    return -1;
+}
+
+jau::snsize_t IOUringChannel::read_batch(uint8_t* buffer, const jau::nsize_t slot_capacity, const jau::nsize_t count,
+                                         jau::nsize_t* lengths, const jau::fraction_i64& timeout) noexcept {
+    (void)buffer; (void)slot_capacity; (void)count; (void)lengths; (void)timeout;
+    errno = ENOTSUP;
+    return -1;
+}
+
+jau::snsize_t IOUringChannel::write(const uint8_t* buffer, const jau::nsize_t length) noexcept {
+    (void)buffer; (void)length;
+    errno = ENOTSUP;
+    return -1;
+}
+
+jau::snsize_t IOUringChannel::write_batch(const uint8_t* const* buffers, const jau::nsize_t* lengths, const jau::nsize_t count) noexcept {
+    (void)buffers; (void)lengths; (void)count;
+    errno = ENOTSUP;
+    return -1;
+}
+
+std::string IOUringChannel::toString() const noexcept {
+    return "IOUringChannel[fd "+std::to_string(fd)+", n/a]";
+}
+
+#endif /* DIRECT_BT_USE_IO_URING */
@@ -41,6 +41,8 @@
 #include "L2CAPIoctl.hpp"
 
 #include "BTDevice.hpp"
+#include "HCIVirtualController.hpp"
+#include "IOReactor.hpp"
 
 extern "C" {
     #include <unistd.h>
@@ -252,14 +254,14 @@ BTSecurityLevel L2CAPComm::getBTSecurityLevelImpl(const BDAddressAndType& remote
 L2CAPClient::L2CAPClient(const uint16_t adev_id_, BDAddressAndType adapterAddressAndType_, const L2CAP_PSM psm_, const L2CAP_CID cid_) noexcept
 : L2CAPComm(adev_id_, std::move(adapterAddressAndType_), psm_, cid_),
   remoteAddressAndType(BDAddressAndType::ANY_BREDR_DEVICE),
-  has_ioerror(false), tid_connect(0), tid_read(0)
+  has_ioerror(false), tid_connect(0), tid_read(0), uring_failed(false)
 { }
 
 L2CAPClient::L2CAPClient(const uint16_t adev_id_, BDAddressAndType adapterAddressAndType_, const L2CAP_PSM psm_, const L2CAP_CID cid_,
                          BDAddressAndType remoteAddressAndType_, int client_socket_) noexcept
 : L2CAPComm(adev_id_, std::move(adapterAddressAndType_), psm_, cid_),
   remoteAddressAndType(std::move(remoteAddressAndType_)),
-  has_ioerror(false), tid_connect(0), tid_read(0)
+  has_ioerror(false), tid_connect(0), tid_read(0), uring_failed(false)
 {
     socket_ = client_socket_;
     is_open_ = 0 <= client_socket_;
@@ -393,6 +395,37 @@ failure:
     return false;
 }
 
+bool L2CAPClient::open(HCIVirtualController& ctrl, const BDAddressAndType& remoteAddressAndType_) noexcept {
+    bool expOpen = false; // C++11, exp as value since C++20
+    if( !is_open_.compare_exchange_strong(expOpen, true) ) {
+        DBG_PRINT("L2CAPClient::open(%s): Already open: dev_id %u, dd %d, %s, psm %s, cid %s; %s",
+                  remoteAddressAndType_.toString().c_str(),
+                  adev_id, socket_.load(), remoteAddressAndType.toString().c_str(),
+                  to_string(psm).c_str(), to_string(cid).c_str(),
+                  getStateString().c_str());
+        return false;
+    }
+    const std::lock_guard<std::recursive_mutex> lock(mtx_write); // RAII-style acquire and relinquish via destructor
+
+    has_ioerror = false;
+    remoteAddressAndType = remoteAddressAndType_;
+    socket_ = ctrl.openL2CAPChannel(remoteAddressAndType.address, direct_bt::number(cid));
+    if( 0 > socket_ ) {
+        ERR_PRINT("L2CAPClient::open: Virtual connect failed: dev_id %u, %s, psm %s, cid %s; %s",
+                  adev_id, remoteAddressAndType.toString().c_str(),
+                  to_string(psm).c_str(), to_string(cid).c_str(),
+                  getStateString().c_str());
+        const int err = errno;
+        close();
+        errno = err;
+        return false;
+    }
+    DBG_PRINT("L2CAPClient::open: Virtual connected: dev_id %u, dd %d, %s, psm %s, cid %s",
+              adev_id, socket_.load(), remoteAddressAndType.toString().c_str(),
+              to_string(psm).c_str(), to_string(cid).c_str());
+    return true;
+}
+
 bool L2CAPClient::close_impl() noexcept {
     bool expOpen = true; // C++11, exp as value since C++20
     if( !is_open_.compare_exchange_strong(expOpen, false) ) {
@@ -447,6 +480,12 @@ bool L2CAPClient::close_impl() noexcept {
         }
     }
 
+    {
+        // release the io_uring backend before its socket, an in-flight read() holds its own reference
+        const std::lock_guard<std::mutex> lock_uring(mtx_uring); // RAII-style acquire and relinquish via destructor
+        uring = nullptr;
+        uring_failed = false;
+    }
     l2cap_close_dev(socket_);
     socket_ = -1;
     interrupted_intern = false;
@@ -517,10 +556,28 @@ std::string L2CAPClient::getRWExitCodeString(const RWExitCode ec) noexcept {
     return "Unknown ExitCode";
 }
 
+std::shared_ptr<IOUringChannel> L2CAPClient::getUring() noexcept {
+    if( !IOUringChannel::isEnabled() || IOReactor::isEnabled() ) {
+        // IOReactor's epoll readiness dispatch requires the blocking path
+        return nullptr;
+    }
+    const std::lock_guard<std::mutex> lock(mtx_uring); // RAII-style acquire and relinquish via destructor
+    if( nullptr == uring && !uring_failed && is_open_ && 0 <= socket_ ) {
+        uring = IOUringChannel::create(socket_, URING_SLOT_SIZE);
+        uring_failed = nullptr == uring;
+        if( uring_failed ) {
+            WORDY_PRINT("L2CAPClient::getUring: io_uring n/a, using poll/read; dev_id %u, dd %d, %s",
+                  adev_id, socket_.load(), remoteAddressAndType.toString().c_str());
+        }
+    }
+    return uring;
+}
+
 jau::snsize_t L2CAPClient::read(uint8_t* buffer, const jau::nsize_t capacity) noexcept {
     const int32_t timeoutMS = env.L2CAP_READER_POLL_TIMEOUT;
     jau::snsize_t len = 0;
     jau::snsize_t err_res = 0;
+    std::shared_ptr<IOUringChannel> ch;
 
     if( !is_open_ ) {
         err_res = number(RWExitCode::NOT_OPEN);
@@ -540,6 +597,31 @@ jau::snsize_t L2CAPClient::read(uint8_t* buffer, const jau::nsize_t capacity) no
 
     tid_read = ::pthread_self(); // temporary safe tid to allow interruption
 
+    if( nullptr != ( ch = getUring() ) ) {
+        const jau::fraction_i64 timeout = jau::fractions_i64::milli * static_cast<int64_t>(timeoutMS);
+        while ( ( len = ch->read(buffer, capacity, timeout) ) < 0 ) {
+            if( !is_open_ ) {
+                err_res = number(RWExitCode::NOT_OPEN);
+                goto errout;
+            }
+            if( interrupted() ) {
+                err_res = number(RWExitCode::INTERRUPTED);
+                goto errout;
+            }
+            if ( errno == EAGAIN || errno == EINTR ) {
+                // cont temp unavail or interruption
+                continue;
+            }
+            if( errno == ETIMEDOUT ) {
+                err_res = number(RWExitCode::POLL_TIMEOUT); // expected if idle, as w/ poll()
+            } else {
+                err_res = number(RWExitCode::READ_ERROR);
+            }
+            goto errout;
+        }
+        goto done;
+    }
+
     if( timeoutMS ) {
         struct pollfd p;
         int n = 1;
@@ -643,6 +725,7 @@ jau::snsize_t L2CAPClient::write(const uint8_t * buffer, const jau::nsize_t leng
     const std::lock_guard<std::recursive_mutex> lock(mtx_write); // RAII-style acquire and relinquish via destructor
     jau::snsize_t len = 0;
     jau::snsize_t err_res = 0;
+    std::shared_ptr<IOUringChannel> ch;
 
     if( !is_open_ ) {
         err_res = number(RWExitCode::NOT_OPEN);
@@ -660,6 +743,23 @@ jau::snsize_t L2CAPClient::write(const uint8_t * buffer, const jau::nsize_t leng
         goto done;
     }
 
+    if( nullptr != ( ch = getUring() ) ) {
+        while ( is_open_ && !interrupted() && ( len = ch->write(buffer, length) ) < 0 ) {
+            if( EAGAIN == errno || EINTR == errno ) {
+                // cont temp unavail or interruption
+                continue;
+            }
+            err_res = number(RWExitCode::WRITE_ERROR);
+            goto errout;
+        }
+        if( 0 > len ) {
+            // closed or interrupted while retrying
+            err_res = is_open_ ? number(RWExitCode::INTERRUPTED) : number(RWExitCode::NOT_OPEN);
+            goto errout;
+        }
+        goto done;
+    }
+
     while ( is_open_ && !interrupted() && ( len = ::write(socket_, buffer, length) ) < 0 ) {
         if( !is_open_ ) {
             err_res = number(RWExitCode::NOT_OPEN);
@@ -709,6 +809,47 @@ errout:
     return err_res;
 }
 
+jau::snsize_t L2CAPClient::write_batch(const uint8_t* const* buffers, const jau::nsize_t* lengths, const jau::nsize_t count) noexcept {
+    const std::lock_guard<std::recursive_mutex> lock(mtx_write); // RAII-style acquire and relinquish via destructor
+    std::shared_ptr<IOUringChannel> ch;
+
+    if( 0 == count ) {
+        return 0;
+    }
+    if( is_open_ && !interrupted() && 0 <= socket_ && nullptr != ( ch = getUring() ) ) {
+        jau::nsize_t done = 0;
+        while( done < count && is_open_ && !interrupted() ) {
+            const jau::snsize_t n = ch->write_batch(buffers + done, lengths + done, count - done);
+            if( 0 > n ) {
+                if( EAGAIN == errno || EINTR == errno ) {
+                    // cont temp unavail or interruption
+                    continue;
+                }
+                break;
+            }
+            done += static_cast<jau::nsize_t>(n);
+        }
+        if( done == count ) {
+            return static_cast<jau::snsize_t>(done);
+        }
+        // let write() report the failed packet's error code
+        buffers += done;
+        lengths += done;
+        const jau::snsize_t res = write(buffers[0], lengths[0]);
+        if( 0 > res ) {
+            return 0 < done ? static_cast<jau::snsize_t>(done) : res;
+        }
+        return static_cast<jau::snsize_t>(done) + 1;
+    }
+    for(jau::nsize_t i=0; i<count; ++i) {
+        const jau::snsize_t res = write(buffers[i], lengths[i]);
+        if( 0 > res ) {
+            return 0 < i ? static_cast<jau::snsize_t>(i) : res;
+        }
+    }
+    return static_cast<jau::snsize_t>(count);
+}
+
 std::string L2CAPClient::toString() const noexcept {
     return "L2CAPClient[dev_id "+std::to_string(adev_id)+", dd "+std::to_string(socket_)+
             ", psm "+to_string(psm)+
@@ -723,7 +864,7 @@ std::string L2CAPClient::toString() const noexcept {
 // *************************************************
 
 L2CAPServer::L2CAPServer(const uint16_t adev_id_, BDAddressAndType localAddressAndType_, const L2CAP_PSM psm_, const L2CAP_CID cid_) noexcept
-: L2CAPComm(adev_id_, std::move(localAddressAndType_), psm_, cid_), tid_accept(0)
+: L2CAPComm(adev_id_, std::move(localAddressAndType_), psm_, cid_), tid_accept(0), virtual_ctrl(false)
 { }
 
 bool L2CAPServer::open() noexcept {
@@ -769,6 +910,31 @@ failure:
     return false;
 }
 
+bool L2CAPServer::open(HCIVirtualController& ctrl) noexcept {
+    bool expOpen = false; // C++11, exp as value since C++20
+    if( !is_open_.compare_exchange_strong(expOpen, true) ) {
+        DBG_PRINT("L2CAPServer::open: Already open: dev_id %u, dd %d, psm %s, cid %s, local %s",
+                  adev_id, socket_.load(), to_string(psm).c_str(), to_string(cid).c_str(),
+                  localAddressAndType.toString().c_str());
+        return false;
+    }
+    const std::lock_guard<std::recursive_mutex> lock(mtx_open); // RAII-style acquire and relinquish via destructor
+
+    socket_ = ctrl.listenL2CAP(direct_bt::number(cid));
+    virtual_ctrl = true;
+    if( 0 > socket_ ) {
+        ERR_PRINT("L2CAPServer::open: Virtual listen failed: dev_id %u, psm %s, cid %s, local %s",
+                  adev_id, to_string(psm).c_str(), to_string(cid).c_str(),
+                  localAddressAndType.toString().c_str());
+        close();
+        return false;
+    }
+    DBG_PRINT("L2CAPServer::open: Virtual: dev_id %u, dd %d, psm %s, cid %s, local %s",
+              adev_id, socket_.load(), to_string(psm).c_str(), to_string(cid).c_str(),
+              localAddressAndType.toString().c_str());
+    return true;
+}
+
 bool L2CAPServer::close_impl() noexcept {
     bool expOpen = true; // C++11, exp as value since C++20
     if( !is_open_.compare_exchange_strong(expOpen, false) ) {
@@ -830,13 +996,21 @@ std::unique_ptr<L2CAPClient> L2CAPServer::accept() noexcept {
 
     while( is_open_ && !interrupted() ) {
         // blocking
-        jau::zero_bytes_sec((void *)&peer, sizeof(peer));
-        socklen_t addrlen = sizeof(peer); // on return it will contain the actual size of the peer address
-        int client_socket = ::accept(socket_, (struct sockaddr*)&peer, &addrlen);
+        int client_socket;
+        BDAddressAndType remoteAddressAndType;
+        L2CAP_PSM c_psm = psm;
+        L2CAP_CID c_cid = cid;
+        if( virtual_ctrl ) {
+            client_socket = HCIVirtualController::acceptL2CAP(socket_, remoteAddressAndType);
+        } else {
+            jau::zero_bytes_sec((void *)&peer, sizeof(peer));
+            socklen_t addrlen = sizeof(peer); // on return it will contain the actual size of the peer address
+            client_socket = ::accept(socket_, (struct sockaddr*)&peer, &addrlen);
 
-        BDAddressAndType remoteAddressAndType(jau::le_to_cpu(peer.l2_bdaddr), static_cast<BDAddressType>(peer.l2_bdaddr_type));
-        L2CAP_PSM c_psm = static_cast<L2CAP_PSM>(jau::le_to_cpu(peer.l2_psm));
-        L2CAP_CID c_cid = static_cast<L2CAP_CID>(jau::le_to_cpu(peer.l2_cid));
+            remoteAddressAndType = BDAddressAndType(jau::le_to_cpu(peer.l2_bdaddr), static_cast<BDAddressType>(peer.l2_bdaddr_type));
+            c_psm = static_cast<L2CAP_PSM>(jau::le_to_cpu(peer.l2_psm));
+            c_cid = static_cast<L2CAP_CID>(jau::le_to_cpu(peer.l2_cid));
+        }
 
         if( 0 <= client_socket )
         {
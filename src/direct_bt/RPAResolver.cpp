@@ -0,0 +1,158 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstring>
+#include <cstdint>
+
+#include <jau/debug.hpp>
+
+#include "RPAResolver.hpp"
+
+using namespace direct_bt;
+
+RPAResolver::RPAResolver(const jau::nsize_t cache_capacity_) noexcept
+: cache_capacity(cache_capacity_), use_count(0),
+  cache_hits(0), cache_misses(0), evaluations(0)
+{
+    cache.reserve(cache_capacity);
+}
+
+jau::snsize_t RPAResolver::indexOfLocked(const BDAddressAndType& identity) const noexcept {
+    const jau::nsize_t size = identities.size();
+    for(jau::nsize_t i=0; i<size; ++i) {
+        if( identity == identities[i] ) {
+            return static_cast<jau::snsize_t>(i);
+        }
+    }
+    return -1;
+}
+
+void RPAResolver::putCacheLocked(const EUI48& rpa, const BDAddressAndType& identity) noexcept {
+    if( 0 == cache_capacity ) {
+        return;
+    }
+    if( cache.size() < cache_capacity ) {
+        cache.push_back( CacheEntry{ rpa, identity, ++use_count } );
+        return;
+    }
+    // evict the least recently used
+    jau::nsize_t lru = 0;
+    for(jau::nsize_t i=1; i<cache.size(); ++i) {
+        if( cache[i].last_use < cache[lru].last_use ) {
+            lru = i;
+        }
+    }
+    cache[lru] = CacheEntry{ rpa, identity, ++use_count };
+}
+
+void RPAResolver::add(const BDAddressAndType& identity, const jau::uint128dp_t& irk) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+    const jau::snsize_t idx = indexOfLocked(identity);
+    if( 0 <= idx ) {
+        const jau::nsize_t i = static_cast<jau::nsize_t>(idx);
+        if( 0 == std::memcmp(irks[i].data, irk.data, sizeof(irk.data)) ) {
+            return; // unchanged
+        }
+        irks[i] = irk;
+        scheds[i] = SMPIRKSchedule(irk);
+    } else {
+        identities.push_back(identity);
+        irks.push_back(irk);
+        scheds.push_back(SMPIRKSchedule(irk));
+    }
+    // drop unresolvable and former resolutions of this identity
+    for(auto it = cache.begin(); it != cache.end(); ) {
+        if( BDAddressType::BDADDR_UNDEFINED == it->identity.type || identity == it->identity ) {
+            cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    DBG_PRINT("RPAResolver::add: %s, %s", identity.toString().c_str(), toString().c_str());
+}
+
+bool RPAResolver::remove(const BDAddressAndType& identity) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+    const jau::snsize_t idx = indexOfLocked(identity);
+    if( 0 > idx ) {
+        return false;
+    }
+    identities.erase(identities.begin() + idx);
+    irks.erase(irks.begin() + idx);
+    scheds.erase(scheds.begin() + idx);
+    for(auto it = cache.begin(); it != cache.end(); ) {
+        if( identity == it->identity ) {
+            cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return true;
+}
+
+void RPAResolver::clear() noexcept {
+    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+    identities.clear();
+    irks.clear();
+    scheds.clear();
+    cache.clear();
+}
+
+jau::nsize_t RPAResolver::size() const noexcept {
+    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+    return identities.size();
+}
+
+bool RPAResolver::resolve(const EUI48& rpa, BDAddressAndType& identity) noexcept {
+    const std::lock_guard<std::mutex> lock(mtx); // RAII-style acquire and relinquish via destructor
+    for(CacheEntry& c : cache) {
+        if( rpa == c.rpa ) {
+            c.last_use = ++use_count;
+            cache_hits++;
+            if( BDAddressType::BDADDR_UNDEFINED == c.identity.type ) {
+                return false;
+            }
+            identity = c.identity;
+            return true;
+        }
+    }
+    cache_misses++;
+    evaluations += scheds.size();
+    const jau::snsize_t idx = SMPIRKSchedule::find(scheds.data(), scheds.size(), rpa);
+    if( 0 <= idx ) {
+        identity = identities[static_cast<jau::nsize_t>(idx)];
+        putCacheLocked(rpa, identity);
+        return true;
+    } else {
+        putCacheLocked(rpa, BDAddressAndType(EUI48::ANY_DEVICE, BDAddressType::BDADDR_UNDEFINED));
+        return false;
+    }
+}
+
+std::string RPAResolver::toString() const noexcept {
+    return "RPAResolver[irks "+std::to_string(identities.size())+
+           ", cache "+std::to_string(cache.size())+"/"+std::to_string(cache_capacity)+
+           ", hits "+std::to_string(cache_hits)+", misses "+std::to_string(cache_misses)+
+           ", evals "+std::to_string(evaluations)+"]";
+}
@@ -32,7 +32,10 @@
  */
 #include <memory>
 #include <cstdint>
+#include <cstring>
+#include <atomic>
 
+#include <jau/basic_types.hpp>
 #include <jau/debug.hpp>
 
 #include "SMPCrypto.hpp"
@@ -54,6 +57,33 @@ inline constexpr const bool USE_SMP_CRYPTO_F5 = false;
     #include <tinycrypt/cmac_mode.h>
 #endif
 
+/**
+ * Hardware AES-128 backends, compiled via function target attributes w/o raising the baseline ISA
+ * and selected at runtime, see SMPAESBackend.
+ */
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+    #define SMP_CRYPTO_AESNI_ 1
+    #include <cpuid.h>
+    #include <wmmintrin.h>
+    #define SMP_CRYPTO_TARGET_AESNI __attribute__((target("aes,sse2")))
+#else
+    #define SMP_CRYPTO_AESNI_ 0
+#endif
+
+#if defined(__GNUC__) && defined(__aarch64__) && defined(__linux__)
+    #define SMP_CRYPTO_ARMV8_CE_ 1
+    #include <sys/auxv.h>
+    #include <asm/hwcap.h>
+    #include <arm_neon.h>
+    #if defined(__clang__)
+        #define SMP_CRYPTO_TARGET_ARMV8_CE __attribute__((target("crypto")))
+    #else
+        #define SMP_CRYPTO_TARGET_ARMV8_CE __attribute__((target("+crypto")))
+    #endif
+#else
+    #define SMP_CRYPTO_ARMV8_CE_ 0
+#endif
+
 namespace direct_bt {
 
 /**
@@ -108,24 +138,213 @@ static inline void sys_mem_swap(void *buf, size_t length)
     }
 }
 
+std::string to_string(const SMPAESBackend b) noexcept {
+    switch(b) {
+        case SMPAESBackend::TINYCRYPT: return "TINYCRYPT";
+        case SMPAESBackend::AESNI: return "AESNI";
+        case SMPAESBackend::ARMV8_CE: return "ARMV8_CE";
+    }
+    return "Unknown SMPAESBackend "+std::to_string(static_cast<int>(b));
+}
+
+bool smp_crypto_aes_supported(const SMPAESBackend b) noexcept {
+    switch(b) {
+        case SMPAESBackend::TINYCRYPT:
+            return true;
+#if SMP_CRYPTO_AESNI_
+        case SMPAESBackend::AESNI: {
+            unsigned int eax, ebx, ecx, edx;
+            return 0 != __get_cpuid(1, &eax, &ebx, &ecx, &edx) && 0 != ( ecx & bit_AES );
+        }
+#endif
+#if SMP_CRYPTO_ARMV8_CE_
+        case SMPAESBackend::ARMV8_CE:
+            return 0 != ( getauxval(AT_HWCAP) & HWCAP_AES );
+#endif
+        default:
+            return false;
+    }
+}
+
+static SMPAESBackend aes_detect_backend() noexcept {
+    if( smp_crypto_aes_supported(SMPAESBackend::AESNI) ) {
+        return SMPAESBackend::AESNI;
+    }
+    if( smp_crypto_aes_supported(SMPAESBackend::ARMV8_CE) ) {
+        return SMPAESBackend::ARMV8_CE;
+    }
+    return SMPAESBackend::TINYCRYPT;
+}
+
+static std::atomic<SMPAESBackend>& aes_active_backend() noexcept {
+    static std::atomic<SMPAESBackend> backend( aes_detect_backend() );
+    return backend;
+}
+
+SMPAESBackend smp_crypto_aes_backend() noexcept {
+    return aes_active_backend().load();
+}
+
+bool smp_crypto_set_aes_backend(const SMPAESBackend b) noexcept {
+    if( !smp_crypto_aes_supported(b) ) {
+        DBG_PRINT("SMPCrypto: AES backend %s not supported", to_string(b).c_str());
+        return false;
+    }
+    aes_active_backend().store(b);
+    return true;
+}
+
+#if SMP_CRYPTO_AESNI_
+
+SMP_CRYPTO_TARGET_AESNI
+static void aes_encrypt_aesni(const uint8_t rk[176], const uint8_t in[16], uint8_t out[16]) noexcept {
+    __m128i m = _mm_xor_si128( _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)),
+                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(rk)) );
+    for(int r=1; r<10; ++r) {
+        m = _mm_aesenc_si128(m, _mm_loadu_si128(reinterpret_cast<const __m128i*>(rk + 16*r)));
+    }
+    m = _mm_aesenclast_si128(m, _mm_loadu_si128(reinterpret_cast<const __m128i*>(rk + 160)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), m);
+}
+
+/** Encrypts one block with four key schedules, interleaved to hide the AESENC latency. */
+SMP_CRYPTO_TARGET_AESNI
+static void aes_encrypt4_aesni(const uint8_t* const rk[4], const uint8_t in[16], uint8_t out[4][16]) noexcept {
+    const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    __m128i m[4];
+    for(int j=0; j<4; ++j) {
+        m[j] = _mm_xor_si128(p, _mm_loadu_si128(reinterpret_cast<const __m128i*>(rk[j])));
+    }
+    for(int r=1; r<10; ++r) {
+        for(int j=0; j<4; ++j) {
+            m[j] = _mm_aesenc_si128(m[j], _mm_loadu_si128(reinterpret_cast<const __m128i*>(rk[j] + 16*r)));
+        }
+    }
+    for(int j=0; j<4; ++j) {
+        m[j] = _mm_aesenclast_si128(m[j], _mm_loadu_si128(reinterpret_cast<const __m128i*>(rk[j] + 160)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out[j]), m[j]);
+    }
+}
+
+#endif /* SMP_CRYPTO_AESNI_ */
+
+#if SMP_CRYPTO_ARMV8_CE_
+
+SMP_CRYPTO_TARGET_ARMV8_CE
+static void aes_encrypt_armce(const uint8_t rk[176], const uint8_t in[16], uint8_t out[16]) noexcept {
+    // AESE: AddRoundKey, SubBytes and ShiftRows, AESMC: MixColumns
+    uint8x16_t m = vld1q_u8(in);
+    for(int r=0; r<9; ++r) {
+        m = vaesmcq_u8( vaeseq_u8(m, vld1q_u8(rk + 16*r)) );
+    }
+    m = veorq_u8( vaeseq_u8(m, vld1q_u8(rk + 144)), vld1q_u8(rk + 160) );
+    vst1q_u8(out, m);
+}
+
+/** Encrypts one block with four key schedules, interleaved to hide the AESE/AESMC latency. */
+SMP_CRYPTO_TARGET_ARMV8_CE
+static void aes_encrypt4_armce(const uint8_t* const rk[4], const uint8_t in[16], uint8_t out[4][16]) noexcept {
+    const uint8x16_t p = vld1q_u8(in);
+    uint8x16_t m[4] = { p, p, p, p };
+    for(int r=0; r<9; ++r) {
+        for(int j=0; j<4; ++j) {
+            m[j] = vaesmcq_u8( vaeseq_u8(m[j], vld1q_u8(rk[j] + 16*r)) );
+        }
+    }
+    for(int j=0; j<4; ++j) {
+        m[j] = veorq_u8( vaeseq_u8(m[j], vld1q_u8(rk[j] + 144)), vld1q_u8(rk[j] + 160) );
+        vst1q_u8(out[j], m[j]);
+    }
+}
+
+#endif /* SMP_CRYPTO_ARMV8_CE_ */
+
+/**
+ * Expands the given key into the given backend's key schedule layout:
+ * - SMPAESBackend::TINYCRYPT: struct tc_aes_key_sched_struct, i.e. big endian words
+ * - hardware backends: the FIPS-197 round key byte sequence
+ */
+static bool aes_set_key(const SMPAESBackend b, uint8_t sched[176], const uint8_t key[16]) noexcept {
+    static_assert( sizeof(struct tc_aes_key_sched_struct) == 176, "Unexpected AES key schedule size" );
+    struct tc_aes_key_sched_struct s;
+    if( TC_CRYPTO_FAIL == tc_aes128_set_encrypt_key(&s, key) ) {
+        return false;
+    }
+    if( SMPAESBackend::TINYCRYPT == b ) {
+        std::memcpy(sched, &s, sizeof(s));
+    } else {
+        for(int i=0; i<44; ++i) {
+            const unsigned int w = s.words[i];
+            sched[4*i+0] = static_cast<uint8_t>( w >> 24 );
+            sched[4*i+1] = static_cast<uint8_t>( w >> 16 );
+            sched[4*i+2] = static_cast<uint8_t>( w >>  8 );
+            sched[4*i+3] = static_cast<uint8_t>( w       );
+        }
+    }
+    jau::zero_bytes_sec(&s, sizeof(s));
+    return true;
+}
+
+/** Encrypts one block using the given backend's key schedule, see aes_set_key(). */
+static bool aes_encrypt(const SMPAESBackend b, const uint8_t sched[176], const uint8_t in[16], uint8_t out[16]) noexcept {
+    switch(b) {
+#if SMP_CRYPTO_AESNI_
+        case SMPAESBackend::AESNI:
+            aes_encrypt_aesni(sched, in, out);
+            return true;
+#endif
+#if SMP_CRYPTO_ARMV8_CE_
+        case SMPAESBackend::ARMV8_CE:
+            aes_encrypt_armce(sched, in, out);
+            return true;
+#endif
+        default:
+            return TC_CRYPTO_FAIL != tc_aes_encrypt(out, in, reinterpret_cast<const struct tc_aes_key_sched_struct*>(sched));
+    }
+}
+
+/** Encrypts one block with four key schedules of the given backend, see aes_set_key(). */
+static bool aes_encrypt4(const SMPAESBackend b, const uint8_t* const sched[4], const uint8_t in[16], uint8_t out[4][16]) noexcept {
+    switch(b) {
+#if SMP_CRYPTO_AESNI_
+        case SMPAESBackend::AESNI:
+            aes_encrypt4_aesni(sched, in, out);
+            return true;
+#endif
+#if SMP_CRYPTO_ARMV8_CE_
+        case SMPAESBackend::ARMV8_CE:
+            aes_encrypt4_armce(sched, in, out);
+            return true;
+#endif
+        default:
+            for(int j=0; j<4; ++j) {
+                if( !aes_encrypt(b, sched[j], in, out[j]) ) {
+                    return false;
+                }
+            }
+            return true;
+    }
+}
+
 static int bt_encrypt_le(const uint8_t key[16], const uint8_t plaintext[16],
                          uint8_t enc_data[16])
 {
-    struct tc_aes_key_sched_struct s;
+    alignas(16) uint8_t sched[176];
     uint8_t tmp[16];
+    const SMPAESBackend backend = smp_crypto_aes_backend();
 
     // BT_DBG("key %s", bt_hex(key, 16));
     // BT_DBG("plaintext %s", bt_hex(plaintext, 16));
 
     sys_memcpy_swap(tmp, key, 16);
 
-    if (tc_aes128_set_encrypt_key(&s, tmp) == TC_CRYPTO_FAIL) {
+    if ( !aes_set_key(backend, sched, tmp) ) {
         return -EINVAL;
     }
 
     sys_memcpy_swap(tmp, plaintext, 16);
 
-    if (tc_aes_encrypt(enc_data, tmp, &s) == TC_CRYPTO_FAIL) {
+    if ( !aes_encrypt(backend, sched, tmp, enc_data) ) {
         return -EINVAL;
     }
 
@@ -177,6 +396,88 @@ bool smp_crypto_rpa_irk_matches(const jau::uint128dp_t irk, const EUI48& rpa) no
     return !memcmp(rpa.b, hash, 3);
 }
 
+bool smp_crypto_e(const jau::uint128dp_t& key, const jau::uint128dp_t& plaintext, jau::uint128dp_t& enc) noexcept {
+    return 0 == bt_encrypt_le(key.data, plaintext.data, enc.data);
+}
+
+SMPIRKSchedule::SMPIRKSchedule(const jau::uint128dp_t& irk) noexcept
+: sched(), backend(smp_crypto_aes_backend()), valid(false)
+{
+    static_assert( sizeof(struct tc_aes_key_sched_struct) <= sizeof(sched), "AES key schedule exceeds SMPIRKSchedule" );
+    uint8_t tmp[16];
+    sys_memcpy_swap(tmp, irk.data, 16);
+    valid = aes_set_key(backend, sched, tmp);
+}
+
+/** Swapped ah() plaintext block r' = padding || r, with r being the RPA's prand, see smp_crypto_ah(). */
+static inline void rpa_plaintext(const EUI48& rpa, uint8_t tmp[16]) noexcept {
+    std::memset(tmp, 0, 13);
+    tmp[13] = rpa.b[5];
+    tmp[14] = rpa.b[4];
+    tmp[15] = rpa.b[3];
+}
+
+/** Compares the RPA's hash with the least significant 24 bits of the unswapped cipher block, see smp_crypto_ah(). */
+static inline bool rpa_hash_matches(const EUI48& rpa, const uint8_t enc[16]) noexcept {
+    return enc[15] == rpa.b[0] && enc[14] == rpa.b[1] && enc[13] == rpa.b[2];
+}
+
+bool SMPIRKSchedule::matches(const EUI48& rpa) const noexcept {
+    if constexpr ( !USE_SMP_CRYPTO_IRK ) {
+        return false;
+    }
+    if( !valid ) {
+        return false;
+    }
+    uint8_t tmp[16], enc[16];
+    rpa_plaintext(rpa, tmp);
+    if( !aes_encrypt(backend, sched, tmp, enc) ) {
+        return false;
+    }
+    return rpa_hash_matches(rpa, enc);
+}
+
+jau::snsize_t SMPIRKSchedule::find(const SMPIRKSchedule* scheds, const jau::nsize_t count, const EUI48& rpa) noexcept {
+    if constexpr ( !USE_SMP_CRYPTO_IRK ) {
+        return -1;
+    }
+    uint8_t tmp[16], enc[16];
+    rpa_plaintext(rpa, tmp);
+    jau::nsize_t i=0;
+    // four schedules at once on hardware backends
+    for(; i+4 <= count; i+=4) {
+        const SMPIRKSchedule* s = scheds + i;
+        const SMPAESBackend b = s[0].backend;
+        if( SMPAESBackend::TINYCRYPT != b &&
+            b == s[1].backend && b == s[2].backend && b == s[3].backend &&
+            s[0].valid && s[1].valid && s[2].valid && s[3].valid )
+        {
+            const uint8_t* const rk[4] = { s[0].sched, s[1].sched, s[2].sched, s[3].sched };
+            uint8_t enc4[4][16];
+            if( aes_encrypt4(b, rk, tmp, enc4) ) {
+                for(jau::nsize_t j=0; j<4; ++j) {
+                    if( rpa_hash_matches(rpa, enc4[j]) ) {
+                        return static_cast<jau::snsize_t>(i+j);
+                    }
+                }
+            }
+        } else {
+            for(jau::nsize_t j=0; j<4; ++j) {
+                if( s[j].valid && aes_encrypt(s[j].backend, s[j].sched, tmp, enc) && rpa_hash_matches(rpa, enc) ) {
+                    return static_cast<jau::snsize_t>(i+j);
+                }
+            }
+        }
+    }
+    for(; i<count; ++i) {
+        const SMPIRKSchedule& s = scheds[i];
+        if( s.valid && aes_encrypt(s.backend, s.sched, tmp, enc) && rpa_hash_matches(rpa, enc) ) {
+            return static_cast<jau::snsize_t>(i);
+        }
+    }
+    return -1;
+}
+
 #if USE_SMP_CRYPTO_F5_
 
 /**
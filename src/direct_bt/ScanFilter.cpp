@@ -0,0 +1,444 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+#include <jau/debug.hpp>
+#include <jau/byte_util.hpp>
+
+#include "ScanFilter.hpp"
+#include "UUIDPool.hpp"
+
+using namespace direct_bt;
+
+/** Bluetooth base UUID 00000000-0000-1000-8000-00805F9B34FB in little endian, the 32 bit value at octet index 12. */
+static const uint8_t bt_base_uuid_le[12] = { 0xFB, 0x34, 0x9B, 0x5F, 0x80, 0x00, 0x00, 0x80, 0x00, 0x10, 0x00, 0x00 };
+
+ScanFilterRule& ScanFilterRule::address(const jau::EUI48& address_, const jau::nsize_t prefix_len) noexcept {
+    const jau::nsize_t n = std::max<jau::nsize_t>(1, std::min<jau::nsize_t>(6, prefix_len));
+    for(jau::nsize_t i=0; i<6; ++i) {
+        // little endian, i.e. the most significant byte b[5] first
+        addr_mask[i] = i >= 6 - n ? 0xff : 0x00;
+        addr_value[i] = address_.b[i] & addr_mask[i];
+    }
+    criteria |= CRIT_ADDRESS;
+    return *this;
+}
+
+ScanFilterRule& ScanFilterRule::addressType(const BDAddressType type) noexcept {
+    address_type = type;
+    criteria |= CRIT_ADDRESS_TYPE;
+    return *this;
+}
+
+ScanFilterRule& ScanFilterRule::minRSSI(const int8_t rssi) noexcept {
+    min_rssi = rssi;
+    criteria |= CRIT_MIN_RSSI;
+    return *this;
+}
+
+ScanFilterRule& ScanFilterRule::service(const jau::uuid_t& uuid) noexcept {
+    service_uuid = UUIDPool::get(uuid);
+    uuid.toUUID128().put(svc_le128, jau::lb_endian_t::little);
+    const bool base = 0 == memcmp(svc_le128, bt_base_uuid_le, sizeof(bt_base_uuid_le));
+    svc_has32 = base;
+    svc_has16 = base && 0 == svc_le128[14] && 0 == svc_le128[15];
+    criteria |= CRIT_SERVICE;
+    return *this;
+}
+
+ScanFilterRule& ScanFilterRule::manufacturer(const uint16_t company, const uint8_t* value, const uint8_t* mask, const jau::nsize_t len) noexcept {
+    msd_company = company;
+    msd_len = static_cast<uint8_t>( nullptr != value ? std::min<jau::nsize_t>(MSD_MAX_SIZE, len) : 0 );
+    if( len > MSD_MAX_SIZE ) {
+        WARN_PRINT("ScanFilterRule: MSD match length %zu truncated to %zu", (size_t)len, (size_t)MSD_MAX_SIZE);
+    }
+    for(jau::nsize_t i=0; i<msd_len; ++i) {
+        msd_mask[i] = nullptr != mask ? mask[i] : 0xff;
+        msd_value[i] = value[i] & msd_mask[i];
+    }
+    criteria |= CRIT_MSD;
+    return *this;
+}
+
+ScanFilterRule& ScanFilterRule::namePrefix(const std::string& prefix) noexcept {
+    name_len = static_cast<uint8_t>( std::min<jau::nsize_t>(sizeof(name_prefix), prefix.size()) );
+    if( prefix.size() > sizeof(name_prefix) ) {
+        WARN_PRINT("ScanFilterRule: Name prefix length %zu truncated to %zu", prefix.size(), sizeof(name_prefix));
+    }
+    memcpy(name_prefix, prefix.data(), name_len);
+    criteria |= CRIT_NAME_PREFIX;
+    return *this;
+}
+
+ScanFilterRule& ScanFilterRule::hasADType(const GAP_T type) noexcept {
+    const uint8_t t = direct_bt::number(type);
+    ad_types[t >> 5] |= 1U << ( t & 31 );
+    criteria |= CRIT_AD_TYPES;
+    return *this;
+}
+
+void ScanFilterRule::initState(State& state) const noexcept {
+    state.pending = criteria & CRIT_AD_DATA;
+}
+
+void ScanFilterRule::matchesADData(const ADStructIndex& index, uint16_t& pending) const noexcept {
+    // single pass over the indexed AD structures, dropping satisfied criteria
+    index.for_each([&](const uint8_t t, uint8_t const * d, const uint8_t dlen) -> bool {
+        switch( static_cast<GAP_T>(t) ) {
+            case GAP_T::UUID16_INCOMPLETE:
+                [[fallthrough]];
+            case GAP_T::UUID16_COMPLETE:
+                if( 0 != ( pending & CRIT_SERVICE ) && svc_has16 ) {
+                    for(jau::nsize_t j=0; j+2<=dlen; j+=2) {
+                        if( d[j] == svc_le128[12] && d[j+1] == svc_le128[13] ) {
+                            pending &= ~CRIT_SERVICE;
+                            break;
+                        }
+                    }
+                }
+                break;
+            case GAP_T::UUID32_INCOMPLETE:
+                [[fallthrough]];
+            case GAP_T::UUID32_COMPLETE:
+                if( 0 != ( pending & CRIT_SERVICE ) && svc_has32 ) {
+                    for(jau::nsize_t j=0; j+4<=dlen; j+=4) {
+                        if( 0 == memcmp(d + j, svc_le128 + 12, 4) ) {
+                            pending &= ~CRIT_SERVICE;
+                            break;
+                        }
+                    }
+                }
+                break;
+            case GAP_T::UUID128_INCOMPLETE:
+                [[fallthrough]];
+            case GAP_T::UUID128_COMPLETE:
+                if( 0 != ( pending & CRIT_SERVICE ) ) {
+                    for(jau::nsize_t j=0; j+16<=dlen; j+=16) {
+                        if( 0 == memcmp(d + j, svc_le128, 16) ) {
+                            pending &= ~CRIT_SERVICE;
+                            break;
+                        }
+                    }
+                }
+                break;
+            case GAP_T::NAME_LOCAL_SHORT:
+                [[fallthrough]];
+            case GAP_T::NAME_LOCAL_COMPLETE:
+                if( 0 != ( pending & CRIT_NAME_PREFIX ) && dlen >= name_len && 0 == memcmp(d, name_prefix, name_len) ) {
+                    pending &= ~CRIT_NAME_PREFIX;
+                }
+                break;
+            case GAP_T::MANUFACTURE_SPECIFIC:
+                if( 0 != ( pending & CRIT_MSD ) && dlen >= 2 + msd_len &&
+                    msd_company == jau::get_uint16(d, jau::lb_endian_t::little) )
+                {
+                    bool ok = true;
+                    for(jau::nsize_t i=0; ok && i<msd_len; ++i) {
+                        ok = msd_value[i] == ( d[2+i] & msd_mask[i] );
+                    }
+                    if( ok ) {
+                        pending &= ~CRIT_MSD;
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+        return 0 != pending; // early termination
+    });
+}
+
+bool ScanFilterRule::matchesReport(const EInfoReportView& report) const noexcept {
+    if( 0 != ( criteria & CRIT_MIN_RSSI ) && report.getRSSI() < min_rssi ) {
+        return false;
+    }
+    if( 0 != ( criteria & CRIT_ADDRESS_TYPE ) && report.getAddressType() != address_type ) {
+        return false;
+    }
+    if( 0 != ( criteria & CRIT_ADDRESS ) ) {
+        const uint8_t * const b = report.getAddress().b;
+        for(jau::nsize_t i=0; i<6; ++i) {
+            if( addr_value[i] != ( b[i] & addr_mask[i] ) ) {
+                return false;
+            }
+        }
+    }
+    if( 0 != ( criteria & CRIT_AD_TYPES ) ) {
+        // via the index's type presence set
+        const ADStructIndex& index = report.getADIndex();
+        for(jau::nsize_t i=0; i<8; ++i) {
+            const uint32_t present = static_cast<uint32_t>( index.getTypeSet(i >> 1) >> ( 32 * ( i & 1 ) ) );
+            if( ad_types[i] != ( ad_types[i] & present ) ) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool ScanFilterRule::matches(const EInfoReportView& report) const noexcept {
+    if( !matchesReport(report) ) {
+        return false;
+    }
+    uint16_t pending = criteria & CRIT_AD_DATA;
+    if( 0 != pending ) {
+        matchesADData(report.getADIndex(), pending);
+    }
+    return 0 == pending;
+}
+
+bool ScanFilterRule::matches(const EInfoReportView& report, State& state) const noexcept {
+    if( !matchesReport(report) ) {
+        return false;
+    }
+    if( 0 != state.pending ) {
+        matchesADData(report.getADIndex(), state.pending);
+    }
+    return 0 == state.pending;
+}
+
+std::string ScanFilterRule::toString() const noexcept {
+    std::string out("ScanFilterRule[");
+    if( 0 != ( criteria & CRIT_ADDRESS ) ) {
+        jau::nsize_t n = 0;
+        while( n < 6 && 0 != addr_mask[5-n] ) { ++n; }
+        out.append("address ").append(jau::EUI48(addr_value, jau::lb_endian_t::little).toString())
+           .append("/").append(std::to_string(n)).append(", ");
+    }
+    if( 0 != ( criteria & CRIT_ADDRESS_TYPE ) ) {
+        out.append("type ").append(to_string(address_type)).append(", ");
+    }
+    if( 0 != ( criteria & CRIT_MIN_RSSI ) ) {
+        out.append("rssi >= ").append(std::to_string(min_rssi)).append(", ");
+    }
+    if( 0 != ( criteria & CRIT_SERVICE ) ) {
+        out.append("service ").append(service_uuid->toString()).append(", ");
+    }
+    if( 0 != ( criteria & CRIT_MSD ) ) {
+        out.append("msd ").append(jau::to_hexstring(msd_company))
+           .append(" ").append(jau::bytesHexString(msd_value, 0, msd_len, true /* lsbFirst */))
+           .append("/").append(jau::bytesHexString(msd_mask, 0, msd_len, true /* lsbFirst */)).append(", ");
+    }
+    if( 0 != ( criteria & CRIT_NAME_PREFIX ) ) {
+        out.append("name '").append(name_prefix, name_len).append("*', ");
+    }
+    if( 0 != ( criteria & CRIT_AD_TYPES ) ) {
+        out.append("ad_types [");
+        for(int t=0; t<256; ++t) {
+            if( 0 != ( ad_types[t >> 5] & ( 1U << ( t & 31 ) ) ) ) {
+                out.append(jau::to_hexstring(static_cast<uint8_t>(t))).append(" ");
+            }
+        }
+        out.append("], ");
+    }
+    out.append("criteria ").append(jau::to_hexstring(criteria)).append("]");
+    return out;
+}
+
+ScanFilter& ScanFilter::add(const ScanFilterRule& rule) noexcept {
+    if( !rule.isEmpty() ) {
+        rules.push_back(rule);
+    }
+    return *this;
+}
+
+ScanFilter::ReportMatch ScanFilter::matchesReport(const EInfoReportView& report) const noexcept {
+    if( rules.empty() ) {
+        return ReportMatch::MATCH;
+    }
+    ReportMatch res = ReportMatch::NONE;
+    for(const ScanFilterRule& r : rules) {
+        if( r.matchesReport(report) ) {
+            if( !r.hasADDataCriteria() ) {
+                return ReportMatch::MATCH;
+            }
+            res = ReportMatch::PENDING;
+        }
+    }
+    return res;
+}
+
+void ScanFilter::initStates(ScanFilterRule::State* states) const noexcept {
+    for(jau::nsize_t i=0; i<rules.size(); ++i) {
+        rules[i].initState(states[i]);
+    }
+}
+
+bool ScanFilter::matches(const EInfoReportView& report, ScanFilterRule::State* states) const noexcept {
+    if( rules.empty() ) {
+        return true;
+    }
+    bool res = false;
+    for(jau::nsize_t i=0; i<rules.size(); ++i) {
+        // no early exit, accumulating all rules' states
+        res = rules[i].matches(report, states[i]) || res;
+    }
+    return res;
+}
+
+std::string ScanFilter::toString() const noexcept {
+    std::string out("ScanFilter[rules "+std::to_string(rules.size()));
+    for(const ScanFilterRule& r : rules) {
+        out.append(", ").append(r.toString());
+    }
+    out.append("]");
+    return out;
+}
+
+/** Returns the power of two table size holding `capacity` entries at a load factor of at most 1/2. */
+static jau::nsize_t scan_filter_table_size(const jau::nsize_t capacity) noexcept {
+    jau::nsize_t n = 2;
+    while( n < 2 * capacity ) {
+        n <<= 1;
+    }
+    return n;
+}
+
+ScanFilterTracker::ScanFilterTracker(const jau::fraction_i64& timeout, const jau::nsize_t capacity_) noexcept
+: timeout_ms( static_cast<uint64_t>( timeout.to_ms() ) ), capacity( std::max<jau::nsize_t>(1, capacity_) ),
+  mask( scan_filter_table_size( capacity ) - 1 ),
+  filter(nullptr), rule_count(0), slots(), states(), used_count(0), count_accepted(0), count_passed(0)
+{
+    slots.resize(mask + 1, Slot{ jau::EUI48(), BDAddressType::BDADDR_UNDEFINED, false, false, 0, 0 });
+}
+
+jau::nsize_t ScanFilterTracker::find(const jau::EUI48& address, const BDAddressType type, const std::size_t hash) const noexcept {
+    jau::nsize_t i = hash & mask;
+    // linear probing, terminates since at most half of the slots are used
+    while( slots[i].used && !( slots[i].hash == hash && slots[i].type == type && slots[i].address == address ) ) {
+        i = ( i + 1 ) & mask;
+    }
+    return i;
+}
+
+void ScanFilterTracker::erase(jau::nsize_t i) noexcept {
+    // backward shift deletion, keeping all probe sequences free of holes
+    jau::nsize_t j = i;
+    for(;;) {
+        j = ( j + 1 ) & mask;
+        if( !slots[j].used ) {
+            break;
+        }
+        const jau::nsize_t h = slots[j].hash & mask;
+        const bool h_in_ij = i <= j ? ( i < h && h <= j ) : ( i < h || h <= j );
+        if( !h_in_ij ) {
+            slots[i] = slots[j];
+            if( 0 < rule_count ) {
+                memcpy(&states[i * rule_count], &states[j * rule_count], rule_count * sizeof(ScanFilterRule::State));
+            }
+            i = j;
+        }
+    }
+    slots[i].used = false;
+    --used_count;
+}
+
+bool ScanFilterTracker::purge(const uint64_t now) noexcept {
+    // erase() may shift a following slot into the current one, hence re-test it
+    for(jau::nsize_t i=0; i<=mask; ) {
+        if( slots[i].used && now > slots[i].ts_last + timeout_ms ) {
+            erase(i);
+        } else {
+            ++i;
+        }
+    }
+    if( used_count >= capacity ) {
+        for(jau::nsize_t i=0; i<=mask; ) {
+            if( slots[i].used && !slots[i].accepted ) {
+                erase(i);
+            } else {
+                ++i;
+            }
+        }
+    }
+    return used_count < capacity;
+}
+
+bool ScanFilterTracker::matches(const std::shared_ptr<const ScanFilter>& filter_, const EInfoReportView& report, const uint64_t now) noexcept {
+    if( filter_ != filter ) {
+        clear();
+        filter = filter_;
+        rule_count = filter->size();
+        states.resize( ( mask + 1 ) * rule_count ); // once per filter
+    }
+    // stateless per report criteria first
+    switch( filter->matchesReport(report) ) {
+        case ScanFilter::ReportMatch::NONE:
+            return false;
+        case ScanFilter::ReportMatch::MATCH:
+            return true;
+        default:
+            break;
+    }
+    const jau::EUI48& address = report.getAddress();
+    const BDAddressType type = report.getAddressType();
+    const std::size_t hash = BDAddressAndType(address, type).hash_code();
+    jau::nsize_t i = find(address, type, hash);
+    if( slots[i].used && now > slots[i].ts_last + timeout_ms ) {
+        erase(i); // expired
+        i = find(address, type, hash);
+    }
+    if( !slots[i].used ) {
+        if( used_count >= capacity ) {
+            if( !purge(now) ) {
+                return filter->matches(report); // untracked
+            }
+            i = find(address, type, hash);
+        }
+        slots[i] = Slot{ address, type, true, false, hash, now };
+        filter->initStates(&states[i * rule_count]);
+        ++used_count;
+    }
+    Slot& e = slots[i];
+    e.ts_last = now;
+    if( filter->matches(report, &states[i * rule_count]) ) {
+        if( e.accepted ) {
+            ++count_passed;
+        } else {
+            e.accepted = true;
+            ++count_accepted;
+        }
+        return true;
+    }
+    return false;
+}
+
+void ScanFilterTracker::clear() noexcept {
+    for(Slot& e : slots) {
+        e.used = false;
+    }
+    used_count = 0;
+    filter = nullptr;
+    rule_count = 0;
+}
+
+std::string ScanFilterTracker::toString() const noexcept {
+    return "ScanFilterTracker[tracked "+std::to_string(used_count)+"/"+std::to_string(capacity)+
+           ", accepted "+std::to_string(count_accepted)+", passed "+std::to_string(count_passed)+
+           ", timeout "+std::to_string(timeout_ms)+" ms]";
+}
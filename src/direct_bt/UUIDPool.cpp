@@ -0,0 +1,103 @@
+/*
+ * Author: Sven Gothel <sgothel@jausoft.com>
+ * Copyright (c) 2026 Gothel Software e.K.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <cstring>
+#include <cstdint>
+
+#include <jau/debug.hpp>
+
+#include "UUIDPool.hpp"
+
+using namespace direct_bt;
+
+std::atomic<UUIDPool::Node*> UUIDPool::slots[UUIDPool::CAPACITY];
+std::atomic<jau::nsize_t> UUIDPool::count(0);
+std::atomic<uint64_t> UUIDPool::overflow_count(0);
+
+std::shared_ptr<const jau::uuid_t> UUIDPool::create(const uint8_t* le_data, const jau::nsize_t size) noexcept {
+    switch( size ) {
+        case 2: return std::make_shared<const jau::uuid16_t>(le_data, jau::lb_endian_t::little);
+        case 4: return std::make_shared<const jau::uuid32_t>(le_data, jau::lb_endian_t::little);
+        default: return std::make_shared<const jau::uuid128_t>(le_data, jau::lb_endian_t::little);
+    }
+}
+
+bool UUIDPool::isInternable(const uint8_t* le_data, const jau::uuid_t::TypeSize type_size) noexcept {
+    // Bluetooth Base UUID 00000000-0000-1000-8000-00805F9B34FB, little endian w/o its leading 32 bit value
+    static const uint8_t base_le[12] = { 0xfb, 0x34, 0x9b, 0x5f, 0x80, 0x00, 0x00, 0x80, 0x00, 0x10, 0x00, 0x00 };
+    return jau::uuid_t::TypeSize::UUID128_SZ != type_size || 0 == memcmp(le_data, base_le, sizeof(base_le));
+}
+
+std::shared_ptr<const jau::uuid_t> UUIDPool::get(const uint8_t* le_data, const jau::uuid_t::TypeSize type_size) noexcept {
+    const jau::nsize_t size = jau::uuid_t::number(type_size);
+    if( !isInternable(le_data, type_size) ) {
+        return create(le_data, size); // vendor specific
+    }
+    // FNV-1a
+    uint32_t h = 2166136261U;
+    h = ( h ^ size ) * 16777619U;
+    for(jau::nsize_t i=0; i<size; ++i) {
+        h = ( h ^ le_data[i] ) * 16777619U;
+    }
+    Node* created = nullptr;
+    for(jau::nsize_t i=0; i<MAX_PROBES; ++i) {
+        std::atomic<Node*>& slot = slots[ ( h + i ) & ( CAPACITY - 1 ) ];
+        Node* n = slot.load(std::memory_order_acquire);
+        if( nullptr == n ) {
+            // not interned: reserve capacity before claiming the slot
+            if( count.fetch_add(1) >= MAX_SIZE ) {
+                --count;
+                break;
+            }
+            if( nullptr == created ) {
+                created = new Node { static_cast<uint8_t>(size), { 0 }, create(le_data, size) };
+                memcpy(created->key, le_data, size);
+            }
+            if( slot.compare_exchange_strong(n, created, std::memory_order_acq_rel, std::memory_order_acquire) ) {
+                return created->uuid;
+            } // else n holds the concurrently inserted node
+            --count;
+        }
+        if( n->size == size && 0 == memcmp(n->key, le_data, size) ) {
+            if( nullptr != created ) {
+                delete created; // lost the race to an equal node
+            }
+            return n->uuid;
+        }
+    }
+    ++overflow_count;
+    if( nullptr != created ) {
+        std::shared_ptr<const jau::uuid_t> res = created->uuid;
+        delete created;
+        return res;
+    }
+    return create(le_data, size);
+}
+
+std::shared_ptr<const jau::uuid_t> UUIDPool::get(const jau::uuid_t& uuid) noexcept {
+    uint8_t buffer[16];
+    uuid.put(buffer, jau::lb_endian_t::little);
+    return get(buffer, uuid.getTypeSize());
+}
@@ -0,0 +1,282 @@
+#include <iostream>
+#include <cassert>
+#include <cinttypes>
+#include <cstring>
+#include <cstdlib>
+#include <atomic>
+#include <new>
+
+#include <jau/test/catch2_ext.hpp>
+
+#include <jau/basic_types.hpp>
+#include <jau/byte_util.hpp>
+#include <direct_bt/HCITypes.hpp>
+#include <direct_bt/BTTypes0.hpp>
+#include <direct_bt/UUIDPool.hpp>
+
+using namespace direct_bt;
+
+/**
+ * Counting global allocator, replacing the default for this test executable.
+ */
+static std::atomic<uint64_t> alloc_count(0);
+
+void* operator new(std::size_t size) {
+    ++alloc_count;
+    void* p = std::malloc(0 < size ? size : 1);
+    if( nullptr == p ) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+/** Typical advertising payload: flags, complete name exceeding std::string's small buffer and MSD. */
+static const uint8_t ad_msd[] = { 0x02, 0x01, 0x06,
+                                  0x14, 0x09, 'T', 'e', 's', 't', 'T', 'e', 'm', 'p', 'S', 'e', 'n', 's', 'o', 'r', '-', '0', '0', '0', '1',
+                                  0x07, 0xff, 0x01, 0x00, 0x01, 0x02, 0x03, 0x04 };
+
+/** Typical beacon payload without MSD: flags, short name and tx power. */
+static const uint8_t ad_plain[] = { 0x02, 0x01, 0x06,
+                                    0x12, 0x08, 'T', 'e', 's', 't', 'T', 'e', 'm', 'p', 'S', 'e', 'n', 's', 'o', 'r', '-', '0', '1',
+                                    0x02, 0x0a, 0xf4 };
+
+/** Payload with flags and a complete list of three 16 bit service UUIDs. */
+static const uint8_t ad_services[] = { 0x02, 0x01, 0x06,
+                                       0x07, 0x03, 0x0f, 0x18, 0x0a, 0x18, 0x1a, 0x18 };
+
+/** LE Advertising Report event, an ADV_IND w/ the MSD payload and a SCAN_RSP w/ the plain payload. */
+static const uint8_t adv_report_pkt[] = {
+    0x04, // HCIPacketType::EVENT
+    0x3e, // HCIEventType::LE_META
+    2 + 2*(1+1+6+1+1) + sizeof(ad_msd) + sizeof(ad_plain), // param size
+    0x02, // HCIMetaEventType::LE_ADVERTISING_REPORT
+    0x02, // num_reports
+    0x00, // ADV_IND
+    0x00, // public address
+    0x06, 0x05, 0x04, 0x03, 0x02, 0x01, // address 01:02:03:04:05:06
+    sizeof(ad_msd),
+    0x02, 0x01, 0x06,
+    0x14, 0x09, 'T', 'e', 's', 't', 'T', 'e', 'm', 'p', 'S', 'e', 'n', 's', 'o', 'r', '-', '0', '0', '0', '1',
+    0x07, 0xff, 0x01, 0x00, 0x01, 0x02, 0x03, 0x04,
+    0xc4, // rssi -60
+    0x04, // SCAN_RSP
+    0x00, // public address
+    0x06, 0x05, 0x04, 0x03, 0x02, 0x01, // address 01:02:03:04:05:06
+    sizeof(ad_plain),
+    0x02, 0x01, 0x06,
+    0x12, 0x08, 'T', 'e', 's', 't', 'T', 'e', 'm', 'p', 'S', 'e', 'n', 's', 'o', 'r', '-', '0', '1',
+    0x02, 0x0a, 0xf4,
+    0xb0 // rssi -80
+};
+
+static uint64_t count_read_data(const uint8_t* data, const uint8_t size, const int loops) {
+    const uint64_t c0 = alloc_count;
+    for(int i=0; i<loops; ++i) {
+        EInfoReport eir;
+        eir.read_data(data, size);
+    }
+    return alloc_count - c0;
+}
+
+TEST_CASE( "AD EIR Allocation Test 01", "[datatype][AD][EIR][alloc]" ) {
+    const int loops = 100000;
+    {
+        EInfoReport eir;
+        eir.read_data(ad_msd, sizeof(ad_msd));
+        std::cout << "eir: " << eir.toString(true) << std::endl;
+        REQUIRE( "TestTempSensor-0001" == eir.getName() );
+        REQUIRE( nullptr != eir.getManufactureSpecificData() );
+        REQUIRE( 4 == eir.getManufactureSpecificData()->getData().size() );
+    }
+    {
+        const uint64_t allocs = count_read_data(ad_plain, sizeof(ad_plain), 1);
+        std::cout << "EInfoReport::read_data w/o MSD: allocations per report " << allocs << std::endl;
+        REQUIRE( 0 == allocs );
+    }
+    {
+        // one allocation for the shared ManufactureSpecificData
+        const uint64_t allocs = count_read_data(ad_msd, sizeof(ad_msd), 1);
+        std::cout << "EInfoReport::read_data w/ MSD: allocations per report " << allocs << std::endl;
+        REQUIRE( 1 >= allocs );
+    }
+    {
+        const uint64_t c0 = alloc_count;
+        EInfoReport eir0;
+        eir0.read_data(ad_msd, sizeof(ad_msd));
+        EInfoReport eir1 = eir0;
+        EInfoReport eir2;
+        eir2.set(eir1);
+        const uint64_t allocs = alloc_count - c0;
+        // one shared ManufactureSpecificData each for eir0 and eir2, eir1 shares eir0's
+        std::cout << "EInfoReport read, copy and merge: allocations " << allocs << std::endl;
+        REQUIRE( 2 >= allocs );
+        REQUIRE( eir0 == eir2 );
+    }
+    {
+        const jau::fraction_timespec t0 = jau::getMonotonicTime();
+        const uint64_t allocs = count_read_data(ad_msd, sizeof(ad_msd), loops);
+        const jau::fraction_timespec t1 = jau::getMonotonicTime();
+        const double ns = double( ( t1 - t0 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) / double(loops);
+        std::cout << "EInfoReport::read_data: " << loops << " reports, " << ns << " ns/report, "
+                  << ( double(allocs) / double(loops) ) << " allocations/report" << std::endl;
+    }
+}
+
+TEST_CASE( "AD EIR Allocation Test 02: Interned UUIDs", "[datatype][AD][EIR][alloc][uuid]" ) {
+    const jau::uuid16_t uuid_01(0x180f);
+    {
+        std::shared_ptr<const jau::uuid_t> a = UUIDPool::get(uuid_01);
+        std::shared_ptr<const jau::uuid_t> b = UUIDPool::get(uuid_01);
+        REQUIRE( a == b );
+        REQUIRE( uuid_01 == *a );
+    }
+    EInfoReport eir0, eir1;
+    eir0.read_data(ad_services, sizeof(ad_services));
+    eir1.read_data(ad_services, sizeof(ad_services));
+    REQUIRE( 3 == eir0.getServices().size() );
+    for(jau::nsize_t i=0; i<3; ++i) {
+        REQUIRE( eir0.getServices()[i] == eir1.getServices()[i] ); // canonical instances
+    }
+    REQUIRE( 0 <= eir0.findService(uuid_01) );
+    REQUIRE( EIRDataType::NONE == eir0.set(eir1) ); // merge finds all by pointer
+
+    // warm pool: only the services array is (re)allocated, no UUID instance
+    const uint64_t allocs = count_read_data(ad_services, sizeof(ad_services), 1);
+    std::cout << "EInfoReport::read_data w/ 3 services: allocations per report " << allocs
+              << ", pool size " << UUIDPool::size() << ", overflow " << UUIDPool::getOverflowCount() << std::endl;
+    REQUIRE( 3 >= allocs );
+}
+
+TEST_CASE( "AD EIR Allocation Test 03: UUID Pool Capacity", "[datatype][AD][EIR][alloc][uuid]" ) {
+    const jau::uuid16_t uuid_01(0x180f);
+    const std::shared_ptr<const jau::uuid_t> interned = UUIDPool::get(uuid_01);
+    const jau::nsize_t count = UUIDPool::MAX_SIZE + 64;
+
+    // flood with distinct vendor specific 128 bit UUIDs, not interned
+    uint8_t le_data[16] = { 0 };
+    le_data[15] = 0xa5;
+    {
+        const jau::nsize_t size0 = UUIDPool::size();
+        const uint64_t overflow0 = UUIDPool::getOverflowCount();
+        for(jau::nsize_t i=0; i<count; ++i) {
+            jau::put_uint32(le_data, i, jau::lb_endian_t::little);
+            REQUIRE( false == UUIDPool::isInternable(le_data, jau::uuid_t::TypeSize::UUID128_SZ) );
+            std::shared_ptr<const jau::uuid_t> u = UUIDPool::get(le_data, jau::uuid_t::TypeSize::UUID128_SZ);
+            REQUIRE( nullptr != u );
+            REQUIRE( jau::uuid_t::TypeSize::UUID128_SZ == u->getTypeSize() );
+            REQUIRE( jau::uuid128_t(le_data, jau::lb_endian_t::little) == *u );
+        }
+        REQUIRE( size0 == UUIDPool::size() );
+        REQUIRE( overflow0 == UUIDPool::getOverflowCount() );
+    }
+    // a fresh 16 bit UUID still interns
+    {
+        const jau::uuid16_t uuid_02(0x2a6e);
+        const jau::nsize_t size0 = UUIDPool::size();
+        std::shared_ptr<const jau::uuid_t> a = UUIDPool::get(uuid_02);
+        std::shared_ptr<const jau::uuid_t> b = UUIDPool::get(uuid_02);
+        REQUIRE( a == b );
+        REQUIRE( uuid_02 == *a );
+        REQUIRE( size0 + 1 == UUIDPool::size() );
+    }
+    // non-interned vendor UUIDs: equal but distinct instances
+    {
+        std::shared_ptr<const jau::uuid_t> a = UUIDPool::get(le_data, jau::uuid_t::TypeSize::UUID128_SZ);
+        std::shared_ptr<const jau::uuid_t> b = UUIDPool::get(le_data, jau::uuid_t::TypeSize::UUID128_SZ);
+        REQUIRE( a != b );
+        REQUIRE( *a == *b );
+        EInfoReport eir;
+        REQUIRE( true == eir.addService(a) );
+        REQUIRE( false == eir.addService(b) ); // found by value
+        REQUIRE( a == eir.getServices()[0] ); // kept as passed
+    }
+    // exceed the capacity with distinct UUIDs derived from the Bluetooth Base UUID
+    {
+        // 00000000-0000-1000-8000-00805F9B34FB, little endian
+        const uint8_t base_le[16] = { 0xfb, 0x34, 0x9b, 0x5f, 0x80, 0x00, 0x00, 0x80, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+        memcpy(le_data, base_le, sizeof(le_data));
+        const uint64_t overflow0 = UUIDPool::getOverflowCount();
+        for(jau::nsize_t i=0; i<count; ++i) {
+            jau::put_uint32(le_data + 12, 0x10000 + i, jau::lb_endian_t::little);
+            REQUIRE( true == UUIDPool::isInternable(le_data, jau::uuid_t::TypeSize::UUID128_SZ) );
+            std::shared_ptr<const jau::uuid_t> u = UUIDPool::get(le_data, jau::uuid_t::TypeSize::UUID128_SZ);
+            REQUIRE( nullptr != u );
+            REQUIRE( jau::uuid128_t(le_data, jau::lb_endian_t::little) == *u );
+        }
+        REQUIRE( UUIDPool::MAX_SIZE >= UUIDPool::size() );
+        REQUIRE( overflow0 + 64 <= UUIDPool::getOverflowCount() );
+    }
+    // interned UUIDs remain canonical
+    REQUIRE( interned == UUIDPool::get(uuid_01) );
+    std::cout << "UUIDPool: size " << UUIDPool::size() << " / " << UUIDPool::MAX_SIZE << ", overflow " << UUIDPool::getOverflowCount() << std::endl;
+}
+
+TEST_CASE( "AD EIR Allocation Test 04: Report Views", "[datatype][AD][EIR][alloc][hci]" ) {
+    const int loops = 100000;
+    // reused per event like HCIHandler's view buffer, cleared w/o releasing its storage
+    jau::darray<EInfoReportView> views;
+    {
+        const HCIPacketView pkt(adv_report_pkt, sizeof(adv_report_pkt));
+        REQUIRE( true == pkt.isValidEvent() );
+        REQUIRE( HCIMetaEventType::LE_ADVERTISING_REPORT == pkt.getMetaEventType() );
+        REQUIRE( 2 == EInfoReportView::read_ad_reports(pkt.getMetaEventParam(), pkt.getMetaEventParamSize(), views) );
+        REQUIRE( jau::EUI48("01:02:03:04:05:06") == views[0].getAddress() );
+        REQUIRE( -60 == views[0].getRSSI() );
+        REQUIRE( EInfoReport::Source::AD_SCAN_RSP == views[1].getSource() );
+        REQUIRE( -80 == views[1].getRSSI() );
+        REQUIRE( views[0].isSet(EIRDataType::MANUF_DATA) );
+        REQUIRE( views[1].isSet(EIRDataType::NAME_SHORT) );
+    }
+    const uint64_t c0 = alloc_count;
+    const jau::fraction_timespec t0 = jau::getMonotonicTime();
+    jau::nsize_t count = 0, msd_count = 0;
+    for(int i=0; i<loops; ++i) {
+        views.erase(views.cbegin(), views.cend());
+        const HCIPacketView pkt(adv_report_pkt, sizeof(adv_report_pkt));
+        if( HCIMetaEventType::LE_ADVERTISING_REPORT == pkt.getMetaEventType() ) {
+            count += EInfoReportView::read_ad_reports(pkt.getMetaEventParam(), pkt.getMetaEventParamSize(), views);
+        }
+        for(const EInfoReportView& v : views) {
+            uint16_t company; uint8_t const * msd_data; jau::nsize_t msd_len;
+            if( v.getManufactureSpecificData(company, &msd_data, msd_len) ) {
+                ++msd_count;
+            }
+        }
+    }
+    const jau::fraction_timespec t1 = jau::getMonotonicTime();
+    const uint64_t allocs = alloc_count - c0;
+    const double ns = double( ( t1 - t0 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) / double(loops);
+    std::cout << "HCIPacketView + EInfoReportView::read_ad_reports: " << loops << " events, " << ns << " ns/event, "
+              << allocs << " allocations" << std::endl;
+    REQUIRE( jau::nsize_t(2*loops) == count );
+    REQUIRE( jau::nsize_t(loops) == msd_count );
+    REQUIRE( 0 == allocs );
+}
+
+TEST_CASE( "AD EIR Allocation Test 05: Name Accessors", "[datatype][AD][EIR][alloc]" ) {
+    const int loops = 1000;
+    EInfoReport eir;
+    eir.read_data(ad_msd, sizeof(ad_msd));
+    jau::darray<EInfoReportView> views;
+    REQUIRE( 2 == EInfoReportView::read_ad_reports(adv_report_pkt + 4, sizeof(adv_report_pkt) - 4, views) );
+    // names exceed std::string's small buffer
+    REQUIRE( "TestTempSensor-0001" == eir.getName() );
+    REQUIRE( "TestTempSensor-0001" == views[0].getName() );
+    REQUIRE( "TestTempSensor-01" == views[1].getShortName() );
+    REQUIRE( views[1].getName().empty() );
+
+    const uint64_t c0 = alloc_count;
+    jau::nsize_t len = 0;
+    for(int i=0; i<loops; ++i) {
+        len += eir.getName().size() + eir.getShortName().size();
+        for(const EInfoReportView& v : views) {
+            len += v.getName().size() + v.getShortName().size();
+        }
+    }
+    const uint64_t allocs = alloc_count - c0;
+    std::cout << "EInfoReport and EInfoReportView name accessors: " << loops << " loops, " << allocs << " allocations" << std::endl;
+    REQUIRE( jau::nsize_t(loops * ( 19 + 19 + 17 )) == len );
+    REQUIRE( 0 == allocs );
+}
@@ -0,0 +1,130 @@
+#include <iostream>
+#include <cassert>
+#include <cinttypes>
+#include <cstring>
+
+#include <jau/test/catch2_ext.hpp>
+
+#include <direct_bt/BTAddress.hpp>
+
+#include "BTAdapterUtil.hpp"
+
+using namespace direct_bt;
+
+/** Stand-in for BTDevice indexed by its identity and visible address */
+struct IndexedDev {
+    BDAddressAndType identity;
+    BDAddressAndType visible;
+    uint8_t lists;
+};
+
+TEST_CASE( "Device Index Test 01", "[datatype][device][index]" ) {
+    const BDAddressAndType id1( EUI48( std::string("C0:26:DA:01:DA:B1") ), BDAddressType::BDADDR_LE_PUBLIC );
+    const BDAddressAndType id2( EUI48( std::string("C0:26:DA:01:DA:B2") ), BDAddressType::BDADDR_LE_PUBLIC );
+    const BDAddressAndType rpa1( EUI48( std::string("70:81:94:0D:FB:AA") ), BDAddressType::BDADDR_LE_RANDOM );
+    const BDAddressAndType rpa2( EUI48( std::string("70:81:94:0D:FB:AB") ), BDAddressType::BDADDR_LE_RANDOM );
+    auto any = [](const IndexedDev&) -> bool { return true; };
+
+    BDAddressIndex<IndexedDev> index;
+    // device A only known via its RPA so far, device B via its identity
+    std::shared_ptr<IndexedDev> a = std::make_shared<IndexedDev>( IndexedDev{ rpa1, rpa1, 0x01 } );
+    std::shared_ptr<IndexedDev> b = std::make_shared<IndexedDev>( IndexedDev{ id1, id1, 0x02 } );
+    REQUIRE( 0 == index.add(rpa1, a) );
+    REQUIRE( -1 == index.add(rpa1, a) );
+    REQUIRE( 0 == index.add(id1, b) );
+    REQUIRE( a == index.find(rpa1, any) );
+    REQUIRE( b == index.find(id1, any) );
+
+    // re-keying A to the identity address of B keeps B indexed
+    a->identity = id1;
+    REQUIRE( a == index.get(rpa1, a.get()) );
+    REQUIRE( 1 == index.add(id1, a) );
+    REQUIRE( 2 == index.count(id1) );
+    REQUIRE( b == index.find(id1, any) ); // order of insertion
+    REQUIRE( a == index.find(id1, [](const IndexedDev& d) -> bool { return 0 != ( d.lists & 0x01 ); }) );
+    REQUIRE( nullptr == index.find(id1, [](const IndexedDev& d) -> bool { return 0 != ( d.lists & 0x04 ); }) );
+    REQUIRE( a == index.find(id1.address, [](const IndexedDev& d) -> bool { return 0 != ( d.lists & 0x01 ); }) );
+
+    // new visible address of A drops its old one
+    a->visible = rpa2;
+    REQUIRE( true == index.remove(rpa1, a.get()) );
+    REQUIRE( false == index.remove(rpa1, a.get()) );
+    REQUIRE( 0 == index.add(rpa2, a) );
+    REQUIRE( nullptr == index.find(rpa1, any) );
+    REQUIRE( a == index.find(rpa2, any) );
+
+    // removing B leaves A indexed by the shared identity
+    REQUIRE( true == index.remove(id1, b.get()) );
+    REQUIRE( 1 == index.count(id1) );
+    REQUIRE( a == index.find(id1, any) );
+
+    // expired references are dropped
+    REQUIRE( 0 == index.add(id2, b) );
+    b.reset();
+    REQUIRE( 0 == index.count(id2) );
+    REQUIRE( nullptr == index.find(id2, any) );
+    REQUIRE( 3 == index.size() );
+    index.remove_if([](IndexedDev&) -> bool { return false; });
+    REQUIRE( 2 == index.size() );
+
+    // clearing a list bit drops unlisted devices from all their keys
+    index.remove_if([](IndexedDev& d) -> bool { d.lists &= static_cast<uint8_t>( ~0x01 ); return 0 == d.lists; });
+    REQUIRE( 0 == index.size() );
+}
+
+/**
+ * Colliding addresses of devices in different lists, see BTAdapter::findIndexedDevices()
+ */
+TEST_CASE( "Device Index Test 02: Per List Lookup", "[datatype][device][index]" ) {
+    const BDAddressAndType id1( EUI48( std::string("C0:26:DA:01:DA:B1") ), BDAddressType::BDADDR_LE_PUBLIC );
+    const BDAddressAndType id2( EUI48( std::string("C0:26:DA:01:DA:B2") ), BDAddressType::BDADDR_LE_PUBLIC );
+    auto bits = [](const IndexedDev& d) -> uint8_t { return d.lists; };
+
+    BDAddressIndex<IndexedDev> index;
+    // discovered device indexed ahead of a connected device with the same key
+    std::shared_ptr<IndexedDev> discovered = std::make_shared<IndexedDev>( IndexedDev{ id1, id1, 0x01 } );
+    std::shared_ptr<IndexedDev> connected = std::make_shared<IndexedDev>( IndexedDev{ id1, id1, 0x02 | 0x04 } );
+    REQUIRE( 0 == index.add(id1, discovered) );
+    REQUIRE( 1 == index.add(id1, connected) );
+
+    // a single any-list lookup masks the connected device
+    REQUIRE( discovered == index.find(id1, [](const IndexedDev& d) -> bool { return 0 != ( d.lists & 0x07 ); }) );
+
+    {
+        std::shared_ptr<IndexedDev> res[3] = { nullptr, nullptr, nullptr };
+        REQUIRE( 0x07 == index.find_each(id1, bits, res) );
+        REQUIRE( discovered == res[0] );
+        REQUIRE( connected == res[1] );
+        REQUIRE( connected == res[2] );
+    }
+    {
+        std::shared_ptr<IndexedDev> res[3] = { nullptr, nullptr, nullptr };
+        REQUIRE( 0x07 == index.find_each(id1.address, bits, res) );
+        REQUIRE( discovered == res[0] );
+        REQUIRE( connected == res[2] );
+    }
+    {
+        // first device per list in order of insertion
+        std::shared_ptr<IndexedDev> discovered2 = std::make_shared<IndexedDev>( IndexedDev{ id1, id1, 0x01 } );
+        REQUIRE( 2 == index.add(id1, discovered2) );
+        std::shared_ptr<IndexedDev> res[3] = { nullptr, nullptr, nullptr };
+        REQUIRE( 0x07 == index.find_each(id1, bits, res) );
+        REQUIRE( discovered == res[0] );
+        REQUIRE( true == index.remove(id1, discovered.get()) );
+        res[0] = res[1] = res[2] = nullptr;
+        REQUIRE( 0x07 == index.find_each(id1, bits, res) );
+        REQUIRE( discovered2 == res[0] );
+        REQUIRE( connected == res[2] );
+    }
+    {
+        // expired and unknown
+        connected.reset();
+        std::shared_ptr<IndexedDev> res[3] = { nullptr, nullptr, nullptr };
+        REQUIRE( 0x01 == index.find_each(id1, bits, res) );
+        REQUIRE( nullptr == res[1] );
+        REQUIRE( nullptr == res[2] );
+        res[0] = nullptr;
+        REQUIRE( 0 == index.find_each(id2, bits, res) );
+        REQUIRE( nullptr == res[0] );
+    }
+}
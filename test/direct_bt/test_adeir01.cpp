@@ -2,6 +2,7 @@
 #include <cassert>
 #include <cinttypes>
 #include <cstring>
+#include <vector>
 
 #include <jau/test/catch2_ext.hpp>
 
@@ -10,10 +11,14 @@
 // #include <direct_bt/BTTypes1.hpp>
 #include <direct_bt/ATTPDUTypes.hpp>
 #include "direct_bt/BTTypes0.hpp"
+#include "direct_bt/MgmtTypes.hpp"
+#include "direct_bt/ScanFilter.hpp"
+#include "direct_bt/EADReassembly.hpp"
 // #include <direct_bt/GATTHandler.hpp>
 // #include <direct_bt/GATTIoctl.hpp>
 
 using namespace direct_bt;
+using namespace jau::fractions_i64_literals;
 
 /**
  * EIR AD Test: Squeezing all-at-once .. fits in 31 bytes
@@ -170,3 +175,590 @@ TEST_CASE( "AD EIR PDU Test 02", "[datatype][AD][EIR]" ) {
         REQUIRE(eir0a == eir1);
     }
 }
+
+/**
+ * EIR AD Test: Lazy EInfoReportView over a raw LE Advertising Report event vs eager EInfoReport
+ */
+TEST_CASE( "AD EIR View Test 03", "[datatype][AD][EIR][view]" ) {
+    const std::vector<uint8_t> msd_data = { 0x01, 0x02 };
+    ManufactureSpecificData msd(0x0001, msd_data.data(), msd_data.size());
+    const jau::uuid16_t uuid_01(0x1234);
+    const jau::uuid16_t uuid_02(0x0a0b);
+    const jau::uuid16_t uuid_03(0x0c0d);
+    const uint8_t addr_b[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0xc0 };
+    const jau::EUI48 addr(addr_b, jau::lb_endian_t::little);
+
+    EInfoReport eir0;
+    eir0.setFlags(GAPFlags::LE_Gen_Disc);
+    eir0.setName("TestTempDev03");
+    eir0.setManufactureSpecificData(msd);
+    eir0.addService(uuid_01);
+    eir0.addService(uuid_02);
+
+    uint8_t ad[31];
+    const jau::nsize_t ad_sz = eir0.write_data(EIRDataType::ALL, ad, sizeof(ad));
+
+    // LE Advertising Report event parameter: two reports, the second without AD data
+    std::vector<uint8_t> param;
+    param.push_back(2); // num_reports
+    for(int i=0; i<2; ++i) {
+        param.push_back(number(AD_PDU_Type::ADV_IND));
+        param.push_back(0x00); // public
+        param.insert(param.end(), addr_b, addr_b+6);
+        const uint8_t sz = 0 == i ? static_cast<uint8_t>(ad_sz) : 0;
+        param.push_back(sz);
+        param.insert(param.end(), ad, ad+sz);
+        param.push_back(static_cast<uint8_t>(-42 - i)); // rssi
+    }
+
+    jau::darray<EInfoReportView> views;
+    REQUIRE( 2 == EInfoReportView::read_ad_reports(param.data(), param.size(), views) );
+    REQUIRE( 2 == views.size() );
+
+    const EInfoReportView& v0 = views[0];
+    REQUIRE( addr == v0.getAddress() );
+    REQUIRE( BDAddressType::BDADDR_LE_PUBLIC == v0.getAddressType() );
+    REQUIRE( -42 == v0.getRSSI() );
+    REQUIRE( GAPFlags::LE_Gen_Disc == v0.getFlags() );
+    REQUIRE( "TestTempDev03" == v0.getName() );
+    REQUIRE( true == v0.hasService(uuid_01) );
+    REQUIRE( true == v0.hasService(uuid_02) );
+    REQUIRE( false == v0.hasService(uuid_03) );
+    {
+        uint16_t company = 0;
+        uint8_t const * msd_p = nullptr;
+        jau::nsize_t msd_len = 0;
+        REQUIRE( true == v0.getManufactureSpecificData(company, &msd_p, msd_len) );
+        REQUIRE( 0x0001 == company );
+        REQUIRE( msd_data.size() == msd_len );
+        REQUIRE( 0 == ::memcmp(msd_data.data(), msd_p, msd_len) );
+    }
+
+    // eager decoding of the same event
+    jau::darray<std::unique_ptr<EInfoReport>> eirs = EInfoReport::read_ad_reports(param.data(), param.size());
+    REQUIRE( 2 == eirs.size() );
+    for(jau::nsize_t i=0; i<2; ++i) {
+        std::unique_ptr<EInfoReport> eir1 = views[i].materialize();
+        std::cout << "view[" << i << "]: " << views[i].toString() << std::endl;
+        std::cout << "eir1[" << i << "]: " << eir1->toString(true) << std::endl;
+        REQUIRE( *eirs[i] == *eir1 );
+        REQUIRE( eir1->getEIRDataMask() == views[i].getEIRDataMask() );
+    }
+    {
+        EInfoReport eir2;
+        eir2.setEvtType(AD_PDU_Type::ADV_IND);
+        eir2.setAddressType(BDAddressType::BDADDR_LE_PUBLIC);
+        eir2.setAddress(addr);
+        eir2.setRSSI(-42);
+        eir2.read_data(ad, ad_sz);
+        REQUIRE( eir2 == *views[0].materialize() );
+    }
+    // fingerprint covers the raw AD payload, not the RSSI
+    REQUIRE( views[0].getFingerprint() != views[1].getFingerprint() );
+    {
+        jau::darray<EInfoReportView> views2;
+        param[param.size()-1] = static_cast<uint8_t>(-60); // rssi of 2nd report
+        param[1 + 1 + 1 + 6 + 1 + ad_sz] = static_cast<uint8_t>(-61); // rssi of 1st report
+        REQUIRE( 2 == EInfoReportView::read_ad_reports(param.data(), param.size(), views2) );
+        REQUIRE( -61 == views2[0].getRSSI() );
+        REQUIRE( views[0].getFingerprint() == views2[0].getFingerprint() );
+        REQUIRE( views[1].getFingerprint() == views2[1].getFingerprint() );
+    }
+    REQUIRE( GAPFlags::NONE == views[1].getFlags() );
+    REQUIRE( views[1].getName().empty() );
+    REQUIRE( false == views[1].hasService(uuid_01) );
+}
+
+TEST_CASE( "AD EIR Scan Filter Test 04", "[datatype][AD][EIR][filter]" ) {
+    const uint8_t msd_data[] = { 0x01, 0x02, 0x03 };
+    ManufactureSpecificData msd(0x0059, msd_data, sizeof(msd_data));
+    const jau::uuid16_t uuid_01(0x181a);
+    const jau::uuid16_t uuid_02(0x0a0b);
+    const uint8_t addr_b[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0xc0 };
+    const uint8_t addr_oui_b[] = { 0x00, 0x00, 0x00, 0x04, 0x05, 0xc0 };
+
+    EInfoReport eir0;
+    eir0.setFlags(GAPFlags::LE_Gen_Disc);
+    eir0.setName("TestTempDev04");
+    eir0.setManufactureSpecificData(msd);
+    eir0.addService(uuid_01);
+
+    uint8_t ad[31];
+    const jau::nsize_t ad_sz = eir0.write_data(EIRDataType::ALL, ad, sizeof(ad));
+
+    std::vector<uint8_t> param;
+    param.push_back(1); // num_reports
+    param.push_back(number(AD_PDU_Type::ADV_IND));
+    param.push_back(0x00); // public
+    param.insert(param.end(), addr_b, addr_b+6);
+    param.push_back(static_cast<uint8_t>(ad_sz));
+    param.insert(param.end(), ad, ad+ad_sz);
+    param.push_back(static_cast<uint8_t>(-60)); // rssi
+
+    jau::darray<EInfoReportView> views;
+    REQUIRE( 1 == EInfoReportView::read_ad_reports(param.data(), param.size(), views) );
+    const EInfoReportView& v0 = views[0];
+
+    REQUIRE( true == ScanFilter().matches(v0) );
+    REQUIRE( true == ScanFilter().add(ScanFilterRule()).isEmpty() );
+
+    REQUIRE( true == ScanFilterRule().address(jau::EUI48(addr_b, jau::lb_endian_t::little)).matches(v0) );
+    REQUIRE( true == ScanFilterRule().address(jau::EUI48(addr_oui_b, jau::lb_endian_t::little), 3).matches(v0) );
+    REQUIRE( false == ScanFilterRule().address(jau::EUI48(addr_oui_b, jau::lb_endian_t::little), 4).matches(v0) );
+    REQUIRE( true == ScanFilterRule().addressType(BDAddressType::BDADDR_LE_PUBLIC).matches(v0) );
+    REQUIRE( false == ScanFilterRule().addressType(BDAddressType::BDADDR_LE_RANDOM).matches(v0) );
+    REQUIRE( true == ScanFilterRule().minRSSI(-70).matches(v0) );
+    REQUIRE( false == ScanFilterRule().minRSSI(-50).matches(v0) );
+
+    REQUIRE( true == ScanFilterRule().service(uuid_01).matches(v0) );
+    REQUIRE( true == ScanFilterRule().service(jau::uuid32_t(0x181a)).matches(v0) );
+    REQUIRE( true == ScanFilterRule().service(uuid_01.toUUID128()).matches(v0) );
+    REQUIRE( false == ScanFilterRule().service(uuid_02).matches(v0) );
+
+    REQUIRE( true == ScanFilterRule().manufacturer(0x0059).matches(v0) );
+    REQUIRE( false == ScanFilterRule().manufacturer(0x0001).matches(v0) );
+    {
+        const uint8_t value[] = { 0x01, 0xf2 };
+        const uint8_t mask0[] = { 0xff, 0x0f };
+        const uint8_t mask1[] = { 0xff, 0xff };
+        REQUIRE( true == ScanFilterRule().manufacturer(0x0059, value, mask0, sizeof(value)).matches(v0) );
+        REQUIRE( false == ScanFilterRule().manufacturer(0x0059, value, mask1, sizeof(value)).matches(v0) );
+        uint8_t value_long[ScanFilterRule::MSD_MAX_SIZE] = { 0 };
+        memcpy(value_long, msd_data, sizeof(msd_data));
+        REQUIRE( true == ScanFilterRule().manufacturer(0x0059, value_long, nullptr, sizeof(msd_data)).matches(v0) );
+        REQUIRE( false == ScanFilterRule().manufacturer(0x0059, value_long, nullptr, sizeof(value_long)).matches(v0) ); // exceeds MSD
+    }
+
+    REQUIRE( true == ScanFilterRule().namePrefix("TestTemp").matches(v0) );
+    REQUIRE( true == ScanFilterRule().namePrefix("TestTempDev04").matches(v0) );
+    REQUIRE( false == ScanFilterRule().namePrefix("TestTempDev04-").matches(v0) );
+    REQUIRE( true == ScanFilterRule().hasADType(GAP_T::FLAGS).hasADType(GAP_T::MANUFACTURE_SPECIFIC).matches(v0) );
+    REQUIRE( false == ScanFilterRule().hasADType(GAP_T::TX_POWER_LEVEL).matches(v0) );
+
+    // rule criteria are AND'ed, rules are OR'ed
+    const ScanFilterRule r0 = ScanFilterRule().service(uuid_01).namePrefix("TestTemp").minRSSI(-70);
+    const ScanFilterRule r1 = ScanFilterRule().service(uuid_01).namePrefix("Other");
+    REQUIRE( true == r0.matches(v0) );
+    REQUIRE( false == r1.matches(v0) );
+    REQUIRE( true == ScanFilter().add(r1).add(r0).matches(v0) );
+    REQUIRE( false == ScanFilter().add(r1).matches(v0) );
+    std::cout << "filter: " << ScanFilter().add(r1).add(r0).toString() << std::endl;
+}
+
+/** LE Extended Advertising Report event parameter of one report. */
+static std::vector<uint8_t> ead_report(const uint8_t* addr_b, const uint8_t sid, const EAD_Event_Type type, const uint8_t* data, const uint8_t data_len) {
+    std::vector<uint8_t> param;
+    param.push_back(1); // num_reports
+    param.push_back(static_cast<uint8_t>(number(type)));
+    param.push_back(static_cast<uint8_t>(number(type) >> 8));
+    param.push_back(0x00); // public
+    param.insert(param.end(), addr_b, addr_b+6);
+    param.push_back(0x01); // primary phy
+    param.push_back(0x02); // secondary phy
+    param.push_back(sid);
+    param.push_back(0x7f); // tx_power n/a
+    param.push_back(static_cast<uint8_t>(-55)); // rssi
+    param.push_back(0x00); param.push_back(0x00); // periodic adv interval
+    param.push_back(0x00); // direct address type
+    for(int i=0; i<6; ++i) { param.push_back(0x00); } // direct address
+    param.push_back(data_len);
+    param.insert(param.end(), data, data+data_len);
+    return param;
+}
+
+static jau::nsize_t ead_process(EADReassembly& r, const std::vector<uint8_t>& param, jau::darray<EInfoReportView>& views, const uint64_t now) {
+    views.clear();
+    REQUIRE( 1 == EInfoReportView::read_ext_ad_reports(param.data(), param.size(), views) );
+    r.process(views, 0, now);
+    return views.size();
+}
+
+TEST_CASE( "AD EIR EAD Reassembly Test 05", "[datatype][AD][EIR][EAD]" ) {
+    const uint8_t addr_b[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0xc0 };
+    const EAD_Event_Type more = EAD_Event_Type::SCAN_ADV | EAD_Event_Type::DATA_B0;
+    const EAD_Event_Type truncated = EAD_Event_Type::SCAN_ADV | EAD_Event_Type::DATA_B1;
+    const EAD_Event_Type complete = EAD_Event_Type::SCAN_ADV;
+
+    // payload of 272 bytes: flags, MSD with 250 data bytes and complete name
+    std::vector<uint8_t> ad = { 0x02, 0x01, 0x06, 253, 0xff, 0x59, 0x00 };
+    for(int i=0; i<250; ++i) { ad.push_back(static_cast<uint8_t>(i)); }
+    const std::string name("LongEADDevice");
+    ad.push_back(static_cast<uint8_t>(1 + name.size()));
+    ad.push_back(direct_bt::number(GAP_T::NAME_LOCAL_COMPLETE));
+    ad.insert(ad.end(), name.begin(), name.end());
+    REQUIRE( 272 == ad.size() );
+
+    EADReassembly r(2_s, 4096);
+    jau::darray<EInfoReportView> views;
+    uint64_t now = 1000;
+    {
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 1, more, ad.data(), 100), views, now) );
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 1, more, ad.data()+100, 100), views, now) );
+        REQUIRE( 1 == r.getPendingCount() );
+        REQUIRE( 200 == r.getPendingBytes() );
+        REQUIRE( 1 == ead_process(r, ead_report(addr_b, 1, complete, ad.data()+200, 72), views, now) );
+        REQUIRE( 0 == r.getPendingCount() );
+        REQUIRE( 0 == r.getPendingBytes() );
+        REQUIRE( 272 == views[0].getDataSize() );
+        REQUIRE( EAD_DataStatus::COMPLETE == views[0].getDataStatus() );
+        REQUIRE( 1 == views[0].getAdvSID() );
+        REQUIRE( 0 == memcmp(ad.data(), views[0].getData(), ad.size()) );
+
+        std::unique_ptr<EInfoReport> eir = views[0].materialize();
+        REQUIRE( name == eir->getName() );
+        REQUIRE( nullptr != eir->getManufactureSpecificData() );
+        REQUIRE( 250 == eir->getManufactureSpecificData()->getData().size() );
+        REQUIRE( 1 == r.getCompletedCount() );
+        REQUIRE( 3 == r.getFragmentCount() );
+    }
+    {
+        // unchained complete report passes without copy
+        const std::vector<uint8_t> param = ead_report(addr_b, 2, complete, ad.data(), 3);
+        views.clear();
+        REQUIRE( 1 == EInfoReportView::read_ext_ad_reports(param.data(), param.size(), views) );
+        const uint8_t* d0 = views[0].getData();
+        r.process(views, 0, now);
+        REQUIRE( 1 == views.size() );
+        REQUIRE( d0 == views[0].getData() );
+    }
+    {
+        // truncated chain keeps its data status
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 3, more, ad.data(), 100), views, now) );
+        REQUIRE( 1 == ead_process(r, ead_report(addr_b, 3, truncated, ad.data()+100, 50), views, now) );
+        REQUIRE( 150 == views[0].getDataSize() );
+        REQUIRE( EAD_DataStatus::INCOMPLETE_TRUNCATED == views[0].getDataStatus() );
+        REQUIRE( 1 == r.getTruncatedCount() );
+    }
+    {
+        // interleaved chains per SID, one timing out
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 4, more, ad.data(), 100), views, now) );
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 5, more, ad.data(), 100), views, now + 1500) );
+        REQUIRE( 2 == r.getPendingCount() );
+        REQUIRE( 1 == ead_process(r, ead_report(addr_b, 5, complete, ad.data()+100, 172), views, now + 3500) );
+        REQUIRE( 5 == views[0].getAdvSID() );
+        REQUIRE( 272 == views[0].getDataSize() );
+        REQUIRE( 0 == r.getPendingCount() );
+        REQUIRE( 1 == r.getDroppedCount() ); // SID 4 expired
+    }
+    {
+        // memory budget evicts the oldest chain
+        EADReassembly r2(2_s, 0 /* min MAX_DATA_SIZE */);
+        for(uint8_t sid=0; sid<7; ++sid) {
+            REQUIRE( 0 == ead_process(r2, ead_report(addr_b, sid, more, ad.data(), 250), views, now) );
+        }
+        REQUIRE( EADReassembly::MAX_DATA_SIZE >= r2.getPendingBytes() );
+        REQUIRE( 6 == r2.getPendingCount() );
+        REQUIRE( 1 == r2.getDroppedCount() );
+    }
+    std::cout << r.toString() << std::endl;
+}
+
+/** LE Advertising Report event parameter of one report. */
+static std::vector<uint8_t> ad_report(const uint8_t* addr_b, const AD_PDU_Type type, const uint8_t* data, const uint8_t data_len, const int8_t rssi) {
+    std::vector<uint8_t> param;
+    param.push_back(1); // num_reports
+    param.push_back(number(type));
+    param.push_back(0x00); // public
+    param.insert(param.end(), addr_b, addr_b+6);
+    param.push_back(data_len);
+    param.insert(param.end(), data, data+data_len);
+    param.push_back(static_cast<uint8_t>(rssi));
+    return param;
+}
+
+/**
+ * EIR AD Test: Unchanged AD payload only updates RSSI and TX power, without materializing an EInfoReport as BTDevice::updateUnchanged()
+ */
+TEST_CASE( "AD EIR Fingerprint Test 06", "[datatype][AD][EIR][view]" ) {
+    const uint8_t addr_b[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0xc0 };
+    EInfoReport eir0;
+    eir0.setFlags(GAPFlags::LE_Gen_Disc);
+    eir0.setName("TestTempDev06");
+    uint8_t ad[31];
+    const jau::nsize_t ad_sz = eir0.write_data(EIRDataType::ALL, ad, sizeof(ad));
+    eir0.setName("TestTempDev06b");
+    uint8_t ad_b[31];
+    const jau::nsize_t ad_b_sz = eir0.write_data(EIRDataType::ALL, ad_b, sizeof(ad_b));
+
+    ADFingerprint fp;
+    int8_t rssi = 127, tx_power = 127;
+    EIRDataType res = EIRDataType::NONE;
+    jau::darray<EInfoReportView> views;
+    {
+        // first report: payload unknown, materialized as with BTDevice::update()
+        const std::vector<uint8_t> param = ad_report(addr_b, AD_PDU_Type::ADV_IND, ad, ad_sz, -42);
+        REQUIRE( 1 == EInfoReportView::read_ad_reports(param.data(), param.size(), views) );
+        MgmtEvtDeviceFound ev(0, views[0]);
+        REQUIRE( false == fp.updateUnchanged(*ev.getEIRView(), rssi, tx_power, res) );
+        REQUIRE( false == ev.isEIRMaterialized() );
+        REQUIRE( nullptr != ev.getEIR() );
+        REQUIRE( true == ev.isEIRMaterialized() );
+        rssi = ev.getEIR()->getRSSI();
+        fp.set(views[0]);
+    }
+    {
+        // identical payload, different RSSI
+        const std::vector<uint8_t> param = ad_report(addr_b, AD_PDU_Type::ADV_IND, ad, ad_sz, -50);
+        views.clear();
+        REQUIRE( 1 == EInfoReportView::read_ad_reports(param.data(), param.size(), views) );
+        MgmtEvtDeviceFound ev(0, views[0]);
+        REQUIRE( true == fp.updateUnchanged(*ev.getEIRView(), rssi, tx_power, res) );
+        REQUIRE( EIRDataType::RSSI == res );
+        REQUIRE( -50 == rssi );
+        REQUIRE( 127 == tx_power );
+        REQUIRE( false == ev.isEIRMaterialized() );
+
+        // identical payload and RSSI
+        REQUIRE( true == fp.updateUnchanged(*ev.getEIRView(), rssi, tx_power, res) );
+        REQUIRE( EIRDataType::NONE == res );
+        REQUIRE( false == ev.isEIRMaterialized() );
+    }
+    {
+        // identical payload of the other source
+        const std::vector<uint8_t> param = ad_report(addr_b, AD_PDU_Type::SCAN_RSP, ad, ad_sz, -60);
+        views.clear();
+        REQUIRE( 1 == EInfoReportView::read_ad_reports(param.data(), param.size(), views) );
+        REQUIRE( false == fp.updateUnchanged(views[0], rssi, tx_power, res) );
+        REQUIRE( -50 == rssi );
+    }
+    {
+        // changed payload
+        const std::vector<uint8_t> param = ad_report(addr_b, AD_PDU_Type::ADV_IND, ad_b, ad_b_sz, -60);
+        views.clear();
+        REQUIRE( 1 == EInfoReportView::read_ad_reports(param.data(), param.size(), views) );
+        REQUIRE( false == fp.updateUnchanged(views[0], rssi, tx_power, res) );
+        REQUIRE( -50 == rssi );
+    }
+    {
+        // EAD header TX power is not part of the payload
+        std::vector<uint8_t> param = ead_report(addr_b, 1, EAD_Event_Type::SCAN_ADV, ad, ad_sz);
+        views.clear();
+        REQUIRE( 1 == EInfoReportView::read_ext_ad_reports(param.data(), param.size(), views) );
+        fp.set(views[0]);
+        param[1 + 2 + 1 + 6 + 1 + 1 + 1] = static_cast<uint8_t>(-8); // tx_power
+        views.clear();
+        REQUIRE( 1 == EInfoReportView::read_ext_ad_reports(param.data(), param.size(), views) );
+        REQUIRE( true == fp.updateUnchanged(views[0], rssi, tx_power, res) );
+        REQUIRE( ( EIRDataType::RSSI | EIRDataType::TX_POWER ) == res );
+        REQUIRE( -55 == rssi );
+        REQUIRE( -8 == tx_power );
+
+        // reset by a full update
+        fp.reset(EInfoReport::Source::AD_IND);
+        REQUIRE( false == fp.updateUnchanged(views[0], rssi, tx_power, res) );
+    }
+}
+
+/**
+ * EIR AD Test: Scan filter per address state, passing an accepted address' scan response and matching criteria split across reports,
+ * per report criteria evaluated on every report
+ */
+TEST_CASE( "AD EIR Scan Filter Test 07", "[datatype][AD][EIR][filter]" ) {
+    const uint8_t addr1_b[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0xc0 };
+    const uint8_t addr2_b[] = { 0x02, 0x02, 0x03, 0x04, 0x05, 0xc0 };
+    const jau::uuid16_t uuid_01(0x1234);
+
+    uint8_t ad_ind[31], ad_rsp[31];
+    jau::nsize_t ad_ind_sz, ad_rsp_sz;
+    {
+        EInfoReport eir;
+        eir.setFlags(GAPFlags::LE_Gen_Disc);
+        eir.addService(uuid_01);
+        ad_ind_sz = eir.write_data(EIRDataType::ALL, ad_ind, sizeof(ad_ind));
+    }
+    {
+        EInfoReport eir;
+        eir.setName("TestTempDev07");
+        ad_rsp_sz = eir.write_data(EIRDataType::ALL, ad_rsp, sizeof(ad_rsp));
+    }
+    const std::vector<uint8_t> ind1 = ad_report(addr1_b, AD_PDU_Type::ADV_IND, ad_ind, ad_ind_sz, -50);
+    const std::vector<uint8_t> rsp1 = ad_report(addr1_b, AD_PDU_Type::SCAN_RSP, ad_rsp, ad_rsp_sz, -50);
+    const std::vector<uint8_t> ind2 = ad_report(addr2_b, AD_PDU_Type::ADV_IND, ad_ind, ad_ind_sz, -50);
+    const std::vector<uint8_t> rsp2 = ad_report(addr2_b, AD_PDU_Type::SCAN_RSP, ad_rsp, ad_rsp_sz, -90);
+    const std::vector<uint8_t> ind1_weak = ad_report(addr1_b, AD_PDU_Type::ADV_IND, ad_ind, ad_ind_sz, -90);
+    jau::darray<EInfoReportView> views;
+    auto view = [&](const std::vector<uint8_t>& param) -> const EInfoReportView& {
+        views.clear();
+        REQUIRE( 1 == EInfoReportView::read_ad_reports(param.data(), param.size(), views) );
+        return views[0];
+    };
+    uint64_t now = 1000;
+
+    {
+        // accepted address passes its scan response
+        std::shared_ptr<const ScanFilter> filter = std::make_shared<const ScanFilter>( ScanFilter().add( ScanFilterRule().service(uuid_01) ) );
+        ScanFilterTracker t(30_s, 16);
+        REQUIRE( false == filter->matches(view(rsp1)) );
+        REQUIRE( true == t.matches(filter, view(ind1), now) );
+        REQUIRE( true == t.matches(filter, view(rsp1), now) );
+        REQUIRE( 1 == t.getAcceptedCount() );
+        REQUIRE( 1 == t.getPassedCount() );
+        REQUIRE( false == t.matches(filter, view(rsp2), now) );
+        REQUIRE( 2 == t.size() );
+
+        // expired address state
+        REQUIRE( false == t.matches(filter, view(rsp1), now + 30001) );
+        REQUIRE( 1 == t.getPassedCount() );
+
+        // new filter drops all state
+        std::shared_ptr<const ScanFilter> filter2 = std::make_shared<const ScanFilter>( *filter );
+        REQUIRE( true == t.matches(filter, view(ind1), now) );
+        REQUIRE( false == t.matches(filter2, view(rsp1), now) );
+        REQUIRE( 1 == t.size() );
+        std::cout << t.toString() << std::endl;
+    }
+    {
+        // AND'ed criteria split across advertising report and scan response
+        const ScanFilterRule rule = ScanFilterRule().service(uuid_01).namePrefix("TestTemp").minRSSI(-70);
+        std::shared_ptr<const ScanFilter> filter = std::make_shared<const ScanFilter>( ScanFilter().add(rule) );
+        REQUIRE( false == rule.matches(view(ind1)) );
+        REQUIRE( false == rule.matches(view(rsp1)) );
+
+        ScanFilterTracker t(30_s, 16);
+        REQUIRE( false == t.matches(filter, view(ind1), now) );
+        REQUIRE( true == t.matches(filter, view(rsp1), now) );
+        REQUIRE( 1 == t.getAcceptedCount() );
+        // per report criteria apply to each report, also of an accepted address
+        REQUIRE( false == t.matches(filter, view(ind1_weak), now) );
+        REQUIRE( true == t.matches(filter, view(ind1), now) );
+        REQUIRE( 1 == t.getPassedCount() );
+        REQUIRE( false == t.matches(filter, view(ind2), now) );
+        REQUIRE( 2 == t.size() );
+        // not tracked if failing all per report criteria
+        REQUIRE( false == t.matches(filter, view(rsp2), now) );
+        REQUIRE( 2 == t.size() );
+        REQUIRE( 1 == t.getAcceptedCount() );
+    }
+    {
+        // rules w/o AD data criteria need no state
+        std::shared_ptr<const ScanFilter> filter = std::make_shared<const ScanFilter>( ScanFilter().add( ScanFilterRule().minRSSI(-70) ) );
+        ScanFilterTracker t(30_s, 16);
+        REQUIRE( true == t.matches(filter, view(ind1), now) );
+        REQUIRE( true == t.matches(filter, view(rsp1), now) );
+        REQUIRE( false == t.matches(filter, view(rsp2), now) );
+        REQUIRE( 0 == t.size() );
+    }
+    {
+        // exhausted capacity drops unaccepted addresses first, then matches untracked
+        std::shared_ptr<const ScanFilter> filter = std::make_shared<const ScanFilter>( ScanFilter().add( ScanFilterRule().service(uuid_01) ) );
+        ScanFilterTracker t(30_s, 1);
+        REQUIRE( false == t.matches(filter, view(rsp2), now) );
+        REQUIRE( 1 == t.size() );
+        REQUIRE( true == t.matches(filter, view(ind1), now) );
+        REQUIRE( 1 == t.size() );
+        REQUIRE( false == t.matches(filter, view(rsp2), now) );
+        REQUIRE( true == t.matches(filter, view(ind2), now) );
+        REQUIRE( true == t.matches(filter, view(rsp1), now) );
+        REQUIRE( 1 == t.size() );
+    }
+    {
+        // expired addresses dropped from the full table, keeping all others reachable
+        std::shared_ptr<const ScanFilter> filter = std::make_shared<const ScanFilter>( ScanFilter().add( ScanFilterRule().service(uuid_01) ) );
+        const jau::nsize_t count = 64;
+        ScanFilterTracker t(30_s, count);
+        auto report = [&](const jau::nsize_t k, const bool ind) -> std::vector<uint8_t> {
+            const uint8_t addr_k[] = { static_cast<uint8_t>(k), static_cast<uint8_t>(k * 7), 0x03, 0x04, 0x05, 0xc0 };
+            return ind ? ad_report(addr_k, AD_PDU_Type::ADV_IND, ad_ind, ad_ind_sz, -50)
+                       : ad_report(addr_k, AD_PDU_Type::SCAN_RSP, ad_rsp, ad_rsp_sz, -50);
+        };
+        for(jau::nsize_t k=0; k<count; ++k) {
+            REQUIRE( true == t.matches(filter, view(report(k, true)), now) );
+        }
+        REQUIRE( count == t.size() );
+        for(jau::nsize_t k=0; k<count; k+=2) {
+            REQUIRE( true == t.matches(filter, view(report(k, false)), now + 20000) );
+        }
+        REQUIRE( true == t.matches(filter, view(report(count, true)), now + 40000) );
+        REQUIRE( count / 2 + 1 == t.size() );
+        for(jau::nsize_t k=0; k<count; k+=2) {
+            REQUIRE( true == t.matches(filter, view(report(k, false)), now + 40000) );
+        }
+        REQUIRE( false == t.matches(filter, view(report(1, false)), now + 40000) );
+        REQUIRE( count / 2 + 2 == t.size() );
+        REQUIRE( count + 1 == t.getAcceptedCount() );
+        REQUIRE( count / 2 + count / 2 == t.getPassedCount() );
+    }
+}
+
+/**
+ * EIR AD Test: Remaining fragments of a dropped chain are discarded up to its finishing fragment, per drop cause
+ */
+TEST_CASE( "AD EIR EAD Reassembly Test 08", "[datatype][AD][EIR][EAD]" ) {
+    const uint8_t addr_b[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0xc0 };
+    const EAD_Event_Type more = EAD_Event_Type::SCAN_ADV | EAD_Event_Type::DATA_B0;
+    const EAD_Event_Type complete = EAD_Event_Type::SCAN_ADV;
+    std::vector<uint8_t> ad(255);
+    for(jau::nsize_t i=0; i<ad.size(); ++i) { ad[i] = static_cast<uint8_t>(i); }
+    jau::darray<EInfoReportView> views;
+    const uint64_t now = 1000;
+
+    SECTION("expired") {
+        EADReassembly r(2_s, 4096);
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 1, more, ad.data(), 100), views, now) );
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 1, more, ad.data(), 100), views, now + 2500) );
+        REQUIRE( 1 == r.getDroppedCount() );
+        REQUIRE( 0 == r.getPendingCount() );
+        REQUIRE( 1 == r.getTombstoneCount() );
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 1, complete, ad.data(), 72), views, now + 2600) );
+        REQUIRE( 0 == r.getTombstoneCount() );
+        REQUIRE( 2 == r.getDiscardedCount() );
+
+        // a new chain after the finishing fragment
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 1, more, ad.data(), 100), views, now + 2700) );
+        REQUIRE( 1 == ead_process(r, ead_report(addr_b, 1, complete, ad.data(), 72), views, now + 2700) );
+        REQUIRE( 172 == views[0].getDataSize() );
+
+        // tombstone expires without continuation
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 1, more, ad.data(), 100), views, now + 3000) );
+        REQUIRE( 1 == ead_process(r, ead_report(addr_b, 2, complete, ad.data(), 3), views, now + 5500) );
+        REQUIRE( 2 == r.getDroppedCount() );
+        REQUIRE( 1 == r.getTombstoneCount() );
+        REQUIRE( 1 == ead_process(r, ead_report(addr_b, 1, complete, ad.data(), 3), views, now + 8000) );
+        REQUIRE( 3 == views[0].getDataSize() );
+        REQUIRE( 2 == r.getDiscardedCount() );
+        REQUIRE( 0 == r.getTombstoneCount() );
+    }
+    SECTION("evicted by memory budget") {
+        EADReassembly r(2_s, 0 /* min MAX_DATA_SIZE */);
+        for(uint8_t sid=0; sid<7; ++sid) {
+            REQUIRE( 0 == ead_process(r, ead_report(addr_b, sid, more, ad.data(), 250), views, now) );
+        }
+        REQUIRE( 1 == r.getDroppedCount() );
+        REQUIRE( 6 == r.getPendingCount() );
+        REQUIRE( 1 == r.getTombstoneCount() );
+        // SID 0 got evicted, its finishing fragment is not emitted as a partial payload
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 0, more, ad.data(), 100), views, now) );
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 0, complete, ad.data(), 50), views, now) );
+        REQUIRE( 2 == r.getDiscardedCount() );
+        REQUIRE( 0 == r.getTombstoneCount() );
+        REQUIRE( 6 == r.getPendingCount() );
+        REQUIRE( 1 == ead_process(r, ead_report(addr_b, 1, complete, ad.data(), 50), views, now) );
+        REQUIRE( 300 == views[0].getDataSize() );
+    }
+    SECTION("exceeding MAX_DATA_SIZE") {
+        EADReassembly r(2_s, 4096);
+        for(int i=0; i<6; ++i) {
+            REQUIRE( 0 == ead_process(r, ead_report(addr_b, 2, more, ad.data(), 250), views, now) );
+        }
+        REQUIRE( 1500 == r.getPendingBytes() );
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 2, more, ad.data(), 250), views, now) );
+        REQUIRE( 1 == r.getDroppedCount() );
+        REQUIRE( 0 == r.getPendingBytes() );
+        REQUIRE( 1 == r.getTombstoneCount() );
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 2, more, ad.data(), 10), views, now) );
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 2, complete, ad.data(), 10), views, now) );
+        REQUIRE( 2 == r.getDiscardedCount() );
+        REQUIRE( 0 == r.getTombstoneCount() );
+
+        // exceeding with the finishing fragment itself leaves no tombstone
+        for(int i=0; i<6; ++i) {
+            REQUIRE( 0 == ead_process(r, ead_report(addr_b, 3, more, ad.data(), 250), views, now) );
+        }
+        REQUIRE( 0 == ead_process(r, ead_report(addr_b, 3, complete, ad.data(), 200), views, now) );
+        REQUIRE( 2 == r.getDroppedCount() );
+        REQUIRE( 0 == r.getTombstoneCount() );
+        REQUIRE( 1 == ead_process(r, ead_report(addr_b, 3, complete, ad.data(), 3), views, now) );
+        REQUIRE( 3 == views[0].getDataSize() );
+        std::cout << r.toString() << std::endl;
+    }
+}
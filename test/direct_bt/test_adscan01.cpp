@@ -0,0 +1,281 @@
+#include <iostream>
+#include <cassert>
+#include <cinttypes>
+#include <cstring>
+#include <vector>
+
+#include <jau/test/catch2_ext.hpp>
+
+#include <jau/basic_types.hpp>
+#include <direct_bt/BTTypes0.hpp>
+
+using namespace direct_bt;
+
+/** iBeacon: flags and Apple MSD with proximity UUID, major, minor and measured power. */
+static const uint8_t ad_ibeacon[] = { 0x02, 0x01, 0x06,
+                                      0x1a, 0xff, 0x4c, 0x00, 0x02, 0x15,
+                                      0xe2, 0xc5, 0x6d, 0xb5, 0xdf, 0xfb, 0x48, 0xd2, 0xb0, 0x60, 0xd0, 0xf5, 0xa7, 0x10, 0x96, 0xe0,
+                                      0x00, 0x01, 0x00, 0x02, 0xc5 };
+
+/** Eddystone-URL: flags, 16 bit service UUID 0xfeaa and its service data. */
+static const uint8_t ad_eddystone[] = { 0x02, 0x01, 0x06,
+                                        0x03, 0x03, 0xaa, 0xfe,
+                                        0x0d, 0x16, 0xaa, 0xfe, 0x10, 0xf4, 0x03, 'g', 'o', 'o', 'g', 'l', 'e', 0x07 };
+
+/** Apple continuity nearby info: flags, short MSD and tx power. */
+static const uint8_t ad_continuity[] = { 0x02, 0x01, 0x1a,
+                                         0x0a, 0xff, 0x4c, 0x00, 0x10, 0x05, 0x01, 0x18, 0x1c, 0x4e, 0x8a,
+                                         0x02, 0x0a, 0x0c };
+
+/** Microsoft CDP beacon: a single MSD filling the legacy payload. */
+static const uint8_t ad_cdp[] = { 0x1e, 0xff, 0x06, 0x00, 0x01, 0x09, 0x20, 0x02,
+                                  0x5b, 0x1f, 0xa3, 0x7c, 0x44, 0x02, 0x11, 0x9e, 0xd3, 0x6a, 0x08, 0x7f, 0x21,
+                                  0xe0, 0x5c, 0x93, 0x4b, 0x17, 0xc8, 0x2d, 0x66, 0xf1, 0x30 };
+
+/** Sensor scan response: complete name, tx power and slave connection interval range. */
+static const uint8_t ad_sensor_rsp[] = { 0x11, 0x09, 'C', 'C', '2', '6', '5', '0', ' ', 'S', 'e', 'n', 's', 'o', 'r', 'T', 'a', 'g',
+                                         0x02, 0x0a, 0x00,
+                                         0x05, 0x12, 0x50, 0x00, 0x20, 0x03 };
+
+/** Thermometer: flags, 16 bit service data and complete name. */
+static const uint8_t ad_thermo[] = { 0x02, 0x01, 0x06,
+                                     0x0f, 0x16, 0x95, 0xfe, 0x30, 0x58, 0x5b, 0x05, 0x01, 0x2e, 0x6b, 0x4d, 0x38, 0xc1, 0xa4, 0x08,
+                                     0x09, 0x09, 'L', 'Y', 'W', 'S', 'D', '0', '3', 'M' };
+
+/** UART peripheral scan response: 128 bit service UUID and complete name. */
+static const uint8_t ad_uart_rsp[] = { 0x11, 0x07, 0x9e, 0xca, 0xdc, 0x24, 0x0e, 0xe5, 0xa9, 0xe0, 0x93, 0xf3, 0xa3, 0xb5, 0x01, 0x00, 0x40, 0x6e,
+                                       0x0c, 0x09, 'N', 'o', 'r', 'd', 'i', 'c', '_', 'U', 'A', 'R', 'T' };
+
+/**
+ * Hand-made AD payloads modeled after common beacon and scan response formats,
+ * not captured over the air, i.e. the benchmark only indicates relative costs.
+ */
+struct ADPayload {
+    const char* name;
+    const uint8_t* data;
+    jau::nsize_t size;
+};
+
+static const ADPayload corpus[] = {
+    { "ibeacon", ad_ibeacon, sizeof(ad_ibeacon) },
+    { "eddystone", ad_eddystone, sizeof(ad_eddystone) },
+    { "continuity", ad_continuity, sizeof(ad_continuity) },
+    { "cdp", ad_cdp, sizeof(ad_cdp) },
+    { "sensor_rsp", ad_sensor_rsp, sizeof(ad_sensor_rsp) },
+    { "thermo", ad_thermo, sizeof(ad_thermo) },
+    { "uart_rsp", ad_uart_rsp, sizeof(ad_uart_rsp) } };
+
+static const jau::nsize_t corpus_size = sizeof(corpus) / sizeof(ADPayload);
+
+TEST_CASE( "AD Structure Index Test 01", "[datatype][AD][EIR][index]" ) {
+    for(jau::nsize_t i=0; i<corpus_size; ++i) {
+        const ADPayload& p = corpus[i];
+        EInfoReport eir0;
+        const int count0 = eir0.read_data(p.data, p.size);
+
+        ADStructIndex index(p.data, p.size);
+        std::cout << p.name << ": " << index.toString() << std::endl;
+        REQUIRE( false == index.isTruncated() );
+        REQUIRE( static_cast<jau::nsize_t>(count0) == index.size() );
+
+        EInfoReport eir1;
+        REQUIRE( count0 == eir1.read_data(index, EIRDataType::ALL) );
+        REQUIRE( eir0 == eir1 );
+        REQUIRE( ( eir0.getEIRDataMask() & index.getEIRDataMask() ) == index.getEIRDataMask() );
+    }
+    {
+        ADStructIndex index(ad_sensor_rsp, sizeof(ad_sensor_rsp));
+        REQUIRE( true == index.has(GAP_T::NAME_LOCAL_COMPLETE) );
+        REQUIRE( true == index.has(GAP_T::SLAVE_CONN_IVAL_RANGE) );
+        REQUIRE( false == index.has(GAP_T::MANUFACTURE_SPECIFIC) );
+        REQUIRE( ( EIRDataType::NAME | EIRDataType::TX_POWER | EIRDataType::CONN_IVAL ) == index.getEIRDataMask() );
+
+        uint8_t const * d;
+        uint8_t len;
+        REQUIRE( true == index.find(GAP_T::TX_POWER_LEVEL, &d, &len) );
+        REQUIRE( 1 == len );
+        REQUIRE( 0x00 == d[0] );
+        REQUIRE( false == index.find(GAP_T::FLAGS, &d, &len) );
+
+        // selective decoding
+        EInfoReport eir;
+        REQUIRE( 1 == eir.read_data(index, EIRDataType::NAME) );
+        REQUIRE( "CC2650 SensorTag" == eir.getName() );
+        REQUIRE( false == eir.isSet(EIRDataType::TX_POWER) );
+        REQUIRE( false == eir.isSet(EIRDataType::CONN_IVAL) );
+    }
+    {
+        ADStructIndex index(ad_ibeacon, sizeof(ad_ibeacon));
+        EInfoReport eir;
+        REQUIRE( 1 == eir.read_data(index, EIRDataType::MANUF_DATA | EIRDataType::NAME) );
+        REQUIRE( nullptr != eir.getManufactureSpecificData() );
+        REQUIRE( 0x004c == eir.getManufactureSpecificData()->getCompany() );
+        REQUIRE( false == eir.isSet(EIRDataType::FLAGS) );
+    }
+    {
+        // significant part ends at zero length, malformed trailing structure is dropped
+        const uint8_t ad_short[] = { 0x02, 0x01, 0x06, 0x00, 0x05, 0x09, 'X' };
+        ADStructIndex index(ad_short, sizeof(ad_short));
+        REQUIRE( 1 == index.size() );
+        REQUIRE( false == index.has(GAP_T::NAME_LOCAL_COMPLETE) );
+
+        const uint8_t ad_oob[] = { 0x02, 0x01, 0x06, 0x05, 0x09, 'X' };
+        index.scan(ad_oob, sizeof(ad_oob));
+        REQUIRE( 1 == index.size() );
+        REQUIRE( false == index.has(GAP_T::NAME_LOCAL_COMPLETE) );
+    }
+}
+
+TEST_CASE( "AD Structure Index Test 02: Truncated", "[datatype][AD][EIR][index]" ) {
+    // extended AD payload exceeding ADStructIndex::MAX_ELEMS: service data structures followed by the name
+    std::vector<uint8_t> ad;
+    const jau::nsize_t sd_count = ADStructIndex::MAX_ELEMS + 8;
+    for(jau::nsize_t i=0; i<sd_count; ++i) {
+        const uint8_t sd[] = { 0x04, 0x16, 0x0f, 0x18, static_cast<uint8_t>(i) };
+        ad.insert(ad.end(), sd, sd + sizeof(sd));
+    }
+    const uint8_t name[] = { 0x05, 0x09, 'E', 'x', 't', '1' };
+    ad.insert(ad.end(), name, name + sizeof(name));
+
+    ADStructIndex index(ad.data(), ad.size());
+    std::cout << index.toString() << std::endl;
+    REQUIRE( true == index.isTruncated() );
+    REQUIRE( ADStructIndex::MAX_ELEMS == index.size() );
+    REQUIRE( true == index.has(GAP_T::NAME_LOCAL_COMPLETE) );
+    REQUIRE( EIRDataType::NAME == index.getEIRDataMask() );
+
+    uint8_t const * d;
+    uint8_t len;
+    REQUIRE( true == index.find(GAP_T::NAME_LOCAL_COMPLETE, &d, &len) );
+    REQUIRE( 4 == len );
+    REQUIRE( 0 == ::memcmp(d, "Ext1", 4) );
+
+    EInfoReport eir0, eir1;
+    const int count0 = eir0.read_data(ad.data(), ad.size());
+    REQUIRE( static_cast<jau::nsize_t>(count0) == sd_count + 1 );
+    REQUIRE( count0 == eir1.read_data(index, EIRDataType::ALL) );
+    REQUIRE( eir0 == eir1 );
+
+    EInfoReport eir2;
+    REQUIRE( 1 == eir2.read_data(index, EIRDataType::NAME) );
+    REQUIRE( "Ext1" == eir2.getName() );
+}
+
+/** Returns a single legacy LE advertising report event parameter of an ADV_IND with the given AD data. */
+static std::vector<uint8_t> ad_report(const uint8_t* data, const jau::nsize_t size) {
+    std::vector<uint8_t> ev = { 0x01, 0x00 /* ADV_IND */, 0x00 /* public */, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 };
+    ev.push_back( static_cast<uint8_t>(size) );
+    ev.insert(ev.end(), data, data + size);
+    ev.push_back( static_cast<uint8_t>(-60) );
+    return ev;
+}
+
+TEST_CASE( "AD Structure Index Test 03: Report View", "[datatype][AD][EIR][index][view]" ) {
+    for(jau::nsize_t i=0; i<corpus_size; ++i) {
+        const ADPayload& p = corpus[i];
+        const std::vector<uint8_t> ev = ad_report(p.data, p.size);
+        jau::darray<EInfoReportView> views;
+        REQUIRE( 1 == EInfoReportView::read_ad_reports(ev.data(), ev.size(), views) );
+        const EInfoReportView& v = views[0];
+        const ADStructIndex& index = v.getADIndex();
+        REQUIRE( v.getData() == index.getData() );
+        REQUIRE( ADStructIndex(p.data, p.size).size() == index.size() );
+
+        // materialize() decodes via the view's index
+        std::unique_ptr<EInfoReport> eir = v.materialize();
+        EInfoReport eir0;
+        eir0.read_data(p.data, p.size);
+        REQUIRE( ( eir->getEIRDataMask() & EIR_DATA_TYPE_MASK ) == ( eir0.getEIRDataMask() & EIR_DATA_TYPE_MASK ) );
+        REQUIRE( eir->getEIRDataMask() == v.getEIRDataMask() );
+        REQUIRE( eir0.getName() == v.getName() );
+    }
+    {
+        const std::vector<uint8_t> ev = ad_report(ad_eddystone, sizeof(ad_eddystone));
+        jau::darray<EInfoReportView> views;
+        REQUIRE( 1 == EInfoReportView::read_ad_reports(ev.data(), ev.size(), views) );
+        REQUIRE( true == views[0].hasService(jau::uuid16_t(0xfeaa)) );
+        REQUIRE( false == views[0].hasService(jau::uuid16_t(0x180f)) );
+        REQUIRE( GAPFlags::NONE != views[0].getFlags() );
+    }
+    {
+        // w/o any service UUID list, decided by the type presence set
+        const std::vector<uint8_t> ev = ad_report(ad_ibeacon, sizeof(ad_ibeacon));
+        jau::darray<EInfoReportView> views;
+        REQUIRE( 1 == EInfoReportView::read_ad_reports(ev.data(), ev.size(), views) );
+        REQUIRE( false == views[0].hasService(jau::uuid16_t(0xfeaa)) );
+        uint16_t company = 0;
+        uint8_t const * msd_data = nullptr;
+        jau::nsize_t msd_len = 0;
+        REQUIRE( true == views[0].getManufactureSpecificData(company, &msd_data, msd_len) );
+        REQUIRE( 0x004c == company );
+        REQUIRE( 23 == msd_len );
+    }
+    {
+        // for_each continues beyond a truncated index and stops early
+        std::vector<uint8_t> ad;
+        const jau::nsize_t sd_count = ADStructIndex::MAX_ELEMS + 4;
+        for(jau::nsize_t i=0; i<sd_count; ++i) {
+            const uint8_t sd[] = { 0x02, 0x0a, static_cast<uint8_t>(i) };
+            ad.insert(ad.end(), sd, sd + sizeof(sd));
+        }
+        const uint8_t svc[] = { 0x03, 0x03, 0xaa, 0xfe };
+        ad.insert(ad.end(), svc, svc + sizeof(svc));
+        ADStructIndex index(ad.data(), ad.size());
+        REQUIRE( true == index.isTruncated() );
+        jau::nsize_t n = 0;
+        index.for_each([&](const uint8_t t, uint8_t const * d, const uint8_t len) -> bool {
+            if( n < sd_count ) {
+                REQUIRE( number(GAP_T::TX_POWER_LEVEL) == t );
+                REQUIRE( 1 == len );
+                REQUIRE( n == d[0] );
+            } else {
+                REQUIRE( number(GAP_T::UUID16_COMPLETE) == t );
+            }
+            ++n;
+            return true;
+        });
+        REQUIRE( sd_count + 1 == n );
+        n = 0;
+        index.for_each([&](const uint8_t, uint8_t const *, const uint8_t) -> bool {
+            return ++n < 3;
+        });
+        REQUIRE( 3 == n );
+    }
+}
+
+TEST_CASE( "AD Structure Index Test 10: Benchmark", "[datatype][AD][EIR][index][benchmark]" ) {
+    const int loops = 100000;
+    const EIRDataType select = EIRDataType::NAME | EIRDataType::MANUF_DATA;
+    uint64_t sink = 0;
+
+    const jau::fraction_timespec t0 = jau::getMonotonicTime();
+    for(int l=0; l<loops; ++l) {
+        const ADPayload& p = corpus[l % corpus_size];
+        EInfoReport eir;
+        eir.read_data(p.data, p.size);
+        sink += number(eir.getEIRDataMask());
+    }
+    const jau::fraction_timespec t1 = jau::getMonotonicTime();
+    for(int l=0; l<loops; ++l) {
+        const ADPayload& p = corpus[l % corpus_size];
+        ADStructIndex index(p.data, p.size);
+        EInfoReport eir;
+        eir.read_data(index, select);
+        sink += number(eir.getEIRDataMask());
+    }
+    const jau::fraction_timespec t2 = jau::getMonotonicTime();
+    for(int l=0; l<loops; ++l) {
+        const ADPayload& p = corpus[l % corpus_size];
+        ADStructIndex index(p.data, p.size);
+        sink += index.has(GAP_T::MANUFACTURE_SPECIFIC) ? 1 : 0;
+    }
+    const jau::fraction_timespec t3 = jau::getMonotonicTime();
+
+    const double ns_full = double( ( t1 - t0 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) / double(loops);
+    const double ns_select = double( ( t2 - t1 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) / double(loops);
+    const double ns_scan = double( ( t3 - t2 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) / double(loops);
+    std::cout << "AD corpus of " << corpus_size << " payloads, " << loops << " reports each (sink " << sink << ")" << std::endl;
+    std::cout << "- EInfoReport::read_data:                " << ns_full << " ns/report" << std::endl;
+    std::cout << "- ADStructIndex + read_data(NAME|MANUF): " << ns_select << " ns/report" << std::endl;
+    std::cout << "- ADStructIndex + has(MSD):              " << ns_scan << " ns/report" << std::endl;
+}
@@ -0,0 +1,145 @@
+#include <iostream>
+#include <cassert>
+#include <cinttypes>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+#include <jau/test/catch2_ext.hpp>
+
+#include "BTAdapterUtil.hpp"
+
+using namespace direct_bt;
+
+TEST_CASE( "Deferred Unpair Test 01", "[datatype][device][unpair]" ) {
+    const BDAddressAndType id1( EUI48( std::string("C0:26:DA:01:DA:B1") ), BDAddressType::BDADDR_LE_PUBLIC );
+    const BDAddressAndType id2( EUI48( std::string("C0:26:DA:01:DA:B2") ), BDAddressType::BDADDR_LE_PUBLIC );
+    const BDAddressAndType id3( EUI48( std::string("C0:26:DA:01:DA:B3") ), BDAddressType::BDADDR_LE_PUBLIC );
+    const BDAddressAndType rpa( EUI48( std::string("70:81:94:0D:FB:AA") ), BDAddressType::BDADDR_LE_RANDOM );
+    std::vector<BDAddressAndType> issued;
+    std::mutex mtx_issued;
+    auto unpair = [&](const BDAddressAndType& a) -> bool {
+        const std::lock_guard<std::mutex> lock(mtx_issued);
+        issued.push_back(a);
+        return true;
+    };
+    auto no_stop = []() -> bool { return false; };
+
+    SECTION("scheduling and skipping") {
+        DeferredUnpair u(2);
+        REQUIRE( false == u.schedule(rpa, true) );
+        REQUIRE( true == u.schedule(id1, true) );
+        REQUIRE( false == u.schedule(id1, true) ); // de-duplicated
+        REQUIRE( true == u.schedule(id2, true) );
+        REQUIRE( 2 == u.getPendingCount() );
+        REQUIRE( 2 == u.getDeferred() );
+        REQUIRE( 2 == u.getSkipped() );
+
+        REQUIRE( false == u.schedule(id3, false) ); // w/o stored keys
+        REQUIRE( 2 == u.getPendingCount() );
+        REQUIRE( 2 == u.getDeferred() );
+        REQUIRE( 3 == u.getSkipped() );
+
+        REQUIRE( 0 == u.process(unpair, []() -> bool { return true; }) ); // stopped
+        REQUIRE( 2 == u.process(unpair, no_stop) );
+        REQUIRE( 2 == issued.size() );
+        REQUIRE( 0 == u.getPendingCount() );
+        REQUIRE( true == u.isClean(id1) );
+        REQUIRE( true == u.isClean(id2) );
+
+        REQUIRE( false == u.schedule(id1, true) ); // clean
+        REQUIRE( 4 == u.getSkipped() );
+        REQUIRE( 0 == u.process(unpair, no_stop) );
+
+        // failed unpair isn't clean
+        REQUIRE( true == u.schedule(id3, true) );
+        REQUIRE( 1 == u.process([](const BDAddressAndType&) -> bool { return false; }, no_stop) );
+        REQUIRE( false == u.isClean(id3) );
+        REQUIRE( true == u.schedule(id3, true) );
+        REQUIRE( 4 == u.getDeferred() );
+    }
+    SECTION("clean capacity") {
+        DeferredUnpair u(2);
+        REQUIRE( true == u.schedule(id1, true) );
+        REQUIRE( 1 == u.process(unpair, no_stop) );
+        REQUIRE( true == u.schedule(id2, true) );
+        REQUIRE( 1 == u.process(unpair, no_stop) );
+        REQUIRE( true == u.schedule(id3, true) );
+        REQUIRE( 1 == u.process(unpair, no_stop) );
+        // least recently unpaired evicted, others kept
+        REQUIRE( 2 == u.getCleanCount() );
+        REQUIRE( false == u.isClean(id1) );
+        REQUIRE( true == u.isClean(id2) );
+        REQUIRE( true == u.isClean(id3) );
+        REQUIRE( false == u.schedule(id2, true) );
+        REQUIRE( true == u.schedule(id1, true) );
+    }
+    SECTION("flush") {
+        DeferredUnpair u(2);
+        REQUIRE( false == u.flush(id1, unpair) );
+        REQUIRE( 0 == issued.size() );
+
+        REQUIRE( true == u.schedule(id1, true) );
+        REQUIRE( true == u.schedule(id2, true) );
+        REQUIRE( true == u.flush(id1, unpair) ); // issued immediately
+        REQUIRE( ( std::vector<BDAddressAndType>{ id1 } ) == issued );
+        REQUIRE( 1 == u.getPendingCount() );
+        REQUIRE( false == u.isClean(id1) ); // may receive keys
+        REQUIRE( 1 == u.process(unpair, no_stop) );
+        REQUIRE( ( std::vector<BDAddressAndType>{ id1, id2 } ) == issued );
+
+        // flush marks a clean address as potentially holding keys
+        REQUIRE( true == u.isClean(id2) );
+        REQUIRE( false == u.flush(id2, unpair) );
+        REQUIRE( false == u.isClean(id2) );
+        REQUIRE( true == u.schedule(id2, true) );
+    }
+    SECTION("flush waits only for its own address") {
+        DeferredUnpair u(2);
+        std::mutex mtx_block;
+        std::condition_variable cv_block;
+        bool blocked = false, released = false;
+        auto blocking_unpair = [&](const BDAddressAndType& a) -> bool {
+            std::unique_lock<std::mutex> lock(mtx_block);
+            blocked = true;
+            cv_block.notify_all();
+            while( !released ) {
+                cv_block.wait(lock);
+            }
+            return unpair(a);
+        };
+        REQUIRE( true == u.schedule(id1, true) );
+        std::thread timer([&]() { u.process(blocking_unpair, no_stop); });
+        {
+            std::unique_lock<std::mutex> lock(mtx_block);
+            while( !blocked ) {
+                cv_block.wait(lock);
+            }
+        }
+        // id1 in flight: flushing id2 doesn't wait
+        REQUIRE( true == u.schedule(id2, true) );
+        REQUIRE( false == u.schedule(id1, true) );
+        REQUIRE( true == u.flush(id2, unpair) );
+        REQUIRE( ( std::vector<BDAddressAndType>{ id2 } ) == issued );
+
+        std::atomic<bool> flushed(false);
+        std::thread connect([&]() { u.flush(id1, unpair); flushed = true; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        REQUIRE( false == flushed.load() );
+        {
+            const std::lock_guard<std::mutex> lock(mtx_block);
+            released = true;
+        }
+        cv_block.notify_all();
+        connect.join();
+        timer.join();
+        REQUIRE( true == flushed.load() );
+        // flushed after the in-flight unpair completed, no further unpair command
+        REQUIRE( ( std::vector<BDAddressAndType>{ id2, id1 } ) == issued );
+        REQUIRE( false == u.isClean(id1) );
+        REQUIRE( 0 == u.getPendingCount() );
+    }
+}
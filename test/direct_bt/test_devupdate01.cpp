@@ -0,0 +1,92 @@
+#include <iostream>
+#include <cassert>
+#include <cinttypes>
+#include <cstring>
+
+#include <jau/test/catch2_ext.hpp>
+
+#include <direct_bt/BTTypes0.hpp>
+
+#include "BTAdapterUtil.hpp"
+
+using namespace direct_bt;
+
+/**
+ * Coalescing of advertising caused BTDevice updates within a window, see BTAdapter::setDeviceUpdateWindow()
+ */
+TEST_CASE( "Device Update Coalescing Test 01", "[datatype][device][update]" ) {
+    const uint64_t window = 100;
+    uint64_t ts = 0;
+    SECTION("disabled") {
+        DeviceUpdateCoalescer c;
+        EIRDataType mask = EIRDataType::RSSI;
+        REQUIRE( DeviceUpdateCoalescer::Result::SEND == c.update(1000, 0, mask) );
+        REQUIRE( EIRDataType::RSSI == mask );
+        mask = EIRDataType::NAME;
+        REQUIRE( DeviceUpdateCoalescer::Result::SEND == c.update(1001, 0, mask) );
+        REQUIRE( EIRDataType::NAME == mask );
+        mask = EIRDataType::NONE;
+        REQUIRE( DeviceUpdateCoalescer::Result::NONE == c.update(1002, 0, mask) );
+        REQUIRE( false == c.hasPending() );
+    }
+    SECTION("window and merging") {
+        DeviceUpdateCoalescer c;
+        EIRDataType mask = EIRDataType::RSSI;
+        REQUIRE( DeviceUpdateCoalescer::Result::SEND == c.update(1000, window, mask) );
+        REQUIRE( EIRDataType::RSSI == mask );
+
+        mask = EIRDataType::NAME;
+        REQUIRE( DeviceUpdateCoalescer::Result::PENDING == c.update(1010, window, mask) );
+        mask = EIRDataType::RSSI;
+        REQUIRE( DeviceUpdateCoalescer::Result::MERGED == c.update(1020, window, mask) );
+        REQUIRE( true == c.hasPending() );
+        // unchanged report within the window
+        mask = EIRDataType::NONE;
+        REQUIRE( DeviceUpdateCoalescer::Result::NONE == c.update(1050, window, mask) );
+
+        // unchanged report past the window delivers the merged pending update
+        mask = EIRDataType::NONE;
+        REQUIRE( DeviceUpdateCoalescer::Result::SEND == c.update(1100, window, mask) );
+        REQUIRE( ( EIRDataType::NAME | EIRDataType::RSSI ) == mask );
+        REQUIRE( false == c.hasPending() );
+
+        // new window started at 1100
+        mask = EIRDataType::TX_POWER;
+        REQUIRE( DeviceUpdateCoalescer::Result::PENDING == c.update(1150, window, mask) );
+        mask = EIRDataType::RSSI;
+        REQUIRE( DeviceUpdateCoalescer::Result::SEND == c.update(1200, window, mask) );
+        REQUIRE( ( EIRDataType::TX_POWER | EIRDataType::RSSI ) == mask );
+
+        c.clear();
+        mask = EIRDataType::RSSI;
+        REQUIRE( DeviceUpdateCoalescer::Result::SEND == c.update(1210, window, mask) );
+    }
+    SECTION("flushing") {
+        DeviceUpdateCoalescer c;
+        REQUIRE( EIRDataType::NONE == c.flush(1000, window, true, ts) );
+
+        EIRDataType mask = EIRDataType::RSSI;
+        REQUIRE( DeviceUpdateCoalescer::Result::SEND == c.update(1000, window, mask) );
+        mask = EIRDataType::NAME;
+        REQUIRE( DeviceUpdateCoalescer::Result::PENDING == c.update(1030, window, mask) );
+
+        // timer flush respects the window
+        REQUIRE( EIRDataType::NONE == c.flush(1050, window, false, ts) );
+        REQUIRE( true == c.hasPending() );
+        REQUIRE( EIRDataType::NAME == c.flush(1100, window, false, ts) );
+        REQUIRE( 1030 == ts );
+        REQUIRE( false == c.hasPending() );
+        REQUIRE( EIRDataType::NONE == c.flush(1300, window, false, ts) );
+
+        // flush starts a new window
+        mask = EIRDataType::RSSI;
+        REQUIRE( DeviceUpdateCoalescer::Result::PENDING == c.update(1150, window, mask) );
+
+        // forced flush, e.g. discovery stop or device removal
+        REQUIRE( EIRDataType::RSSI == c.flush(1160, window, true, ts) );
+        REQUIRE( 1150 == ts );
+        REQUIRE( false == c.hasPending() );
+        mask = EIRDataType::NAME;
+        REQUIRE( DeviceUpdateCoalescer::Result::PENDING == c.update(1170, window, mask) );
+    }
+}
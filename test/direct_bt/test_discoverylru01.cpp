@@ -0,0 +1,98 @@
+#include <iostream>
+#include <cassert>
+#include <cinttypes>
+#include <cstring>
+#include <vector>
+#include <memory>
+
+#include <jau/test/catch2_ext.hpp>
+
+#include "BTAdapterUtil.hpp"
+
+using namespace direct_bt;
+
+/** Stand-in for a discovered BTDevice */
+struct DiscoveredDev {
+    int id;
+    bool pinned;
+    uint64_t ts_last_discovery;
+};
+
+TEST_CASE( "Discovery LRU Test 01", "[datatype][device][lru]" ) {
+    std::vector<std::unique_ptr<DiscoveredDev>> devs;
+    for(int i=0; i<6; ++i) {
+        devs.push_back( std::make_unique<DiscoveredDev>( DiscoveredDev{ i, false, 1000 + uint64_t(i) * 100 } ) );
+    }
+    DiscoveryLRU<DiscoveredDev> lru;
+    std::vector<int> erased; // owner's list, e.g. BTAdapter::discoveredDevices
+    auto pinned = [](const DiscoveredDev& d) -> bool { return d.pinned; };
+    auto erase = [&](DiscoveredDev& d) { erased.push_back(d.id); lru.remove(&d); };
+    auto touch = [&](DiscoveredDev& d, const uint64_t ts) { d.ts_last_discovery = ts; lru.touch(&d); };
+
+    for(int i=0; i<4; ++i) {
+        lru.touch(devs[i].get());
+    }
+    REQUIRE( 4 == lru.size() );
+    REQUIRE( true == lru.contains(devs[3].get()) );
+    REQUIRE( false == lru.contains(devs[4].get()) );
+    REQUIRE( 0 == lru.evict(4, nullptr, pinned, erase) );
+
+    SECTION("capacity") {
+        // rediscovered 0 becomes most recent
+        touch(*devs[0], 1500);
+        lru.touch(devs[4].get());
+        REQUIRE( 1 == lru.evict(4, devs[4].get(), pinned, erase) );
+        REQUIRE( std::vector<int>{ 1 } == erased );
+
+        // keep protects the new device itself
+        REQUIRE( 3 == lru.evict(1, devs[4].get(), pinned, erase) );
+        REQUIRE( ( std::vector<int>{ 1, 2, 3, 0 } ) == erased );
+        REQUIRE( 1 == lru.size() );
+        REQUIRE( true == lru.contains(devs[4].get()) );
+    }
+    SECTION("pinned") {
+        devs[0]->pinned = true;
+        devs[1]->pinned = true;
+        REQUIRE( 2 == lru.evict(1, nullptr, pinned, erase) );
+        REQUIRE( ( std::vector<int>{ 2, 3 } ) == erased );
+        // all pinned may exceed the capacity
+        REQUIRE( 0 == lru.evict(1, nullptr, pinned, erase) );
+        REQUIRE( 2 == lru.size() );
+
+        devs[1]->pinned = false;
+        REQUIRE( 1 == lru.evict(1, nullptr, pinned, erase) );
+        REQUIRE( ( std::vector<int>{ 2, 3, 1 } ) == erased );
+        REQUIRE( true == lru.contains(devs[0].get()) );
+    }
+    SECTION("ttl") {
+        const uint64_t ttl = 150;
+        uint64_t now = 0;
+        auto expired = [&](const DiscoveredDev& d) -> bool { return now > d.ts_last_discovery + ttl; };
+
+        now = 1150;
+        REQUIRE( 0 == lru.expire(pinned, expired, erase) );
+        now = 1200;
+        REQUIRE( 1 == lru.expire(pinned, expired, erase) );
+        REQUIRE( std::vector<int>{ 0 } == erased );
+
+        // rediscovered and pinned devices don't expire
+        touch(*devs[1], 1300);
+        devs[2]->pinned = true;
+        now = 1440;
+        REQUIRE( 0 == lru.expire(pinned, expired, erase) );
+        now = 1460;
+        REQUIRE( 2 == lru.expire(pinned, expired, erase) );
+        REQUIRE( ( std::vector<int>{ 0, 3, 1 } ) == erased );
+        REQUIRE( 1 == lru.size() );
+        REQUIRE( true == lru.contains(devs[2].get()) );
+    }
+    SECTION("removal") {
+        REQUIRE( true == lru.remove(devs[1].get()) );
+        REQUIRE( false == lru.remove(devs[1].get()) );
+        REQUIRE( 1 == lru.evict(2, nullptr, pinned, erase) );
+        REQUIRE( std::vector<int>{ 0 } == erased );
+        lru.clear();
+        REQUIRE( 0 == lru.size() );
+        REQUIRE( 0 == lru.evict(0, nullptr, pinned, erase) );
+    }
+}
@@ -0,0 +1,149 @@
+#include <iostream>
+#include <cassert>
+#include <cinttypes>
+#include <cstring>
+#include <cstdio>
+
+#include <jau/test/catch2_ext.hpp>
+
+#include <jau/basic_types.hpp>
+#include <direct_bt/HCITypes.hpp>
+#include <direct_bt/HCISnoop.hpp>
+#include <direct_bt/BTTypes0.hpp>
+
+using namespace direct_bt;
+
+/** LE Advertising Report event, one report w/ flags and complete name 'Test01' */
+static const std::vector<uint8_t> adv_report_pkt = {
+    0x04, // HCIPacketType::EVENT
+    0x3e, // HCIEventType::LE_META
+    0x17, // param size 23
+    0x02, // HCIMetaEventType::LE_ADVERTISING_REPORT
+    0x01, // num_reports
+    0x00, // ADV_IND
+    0x00, // public address
+    0x06, 0x05, 0x04, 0x03, 0x02, 0x01, // address 01:02:03:04:05:06
+    0x0b, // data size 11
+    0x02, 0x01, 0x06, // flags
+    0x07, 0x09, 'T', 'e', 's', 't', '0', '1', // complete name
+    0xc4 // rssi -60
+};
+
+/** ACL data w/ SMP Pairing Failed PDU on handle 0x0040 */
+static const std::vector<uint8_t> acl_smp_pkt = {
+    0x02, // HCIPacketType::ACLDATA
+    0x40, 0x20, // handle 0x0040, PB COMPLETE_L2CAP_AUTOFLUSH
+    0x06, 0x00, // param size 6
+    0x02, 0x00, // l2cap len 2
+    0x06, 0x00, // l2cap cid SMP
+    0x05, 0x08  // SMP Pairing Failed, reason
+};
+
+TEST_CASE( "HCI Packet View Test 01", "[datatype][hci]" ) {
+    {
+        const HCIPacketView pkt(adv_report_pkt.data(), adv_report_pkt.size());
+        REQUIRE( HCIPacketType::EVENT == pkt.getPacketType() );
+        REQUIRE( true == pkt.isValidEvent() );
+        REQUIRE( false == pkt.isValidACLData() );
+        REQUIRE( HCIEventType::LE_META == pkt.getEventType() );
+        REQUIRE( HCIMetaEventType::LE_ADVERTISING_REPORT == pkt.getMetaEventType() );
+
+        std::unique_ptr<HCIEvent> ev = HCIEvent::getSpecialized(adv_report_pkt.data(), adv_report_pkt.size());
+        REQUIRE( nullptr != ev );
+        REQUIRE( ev->getMetaEventType() == pkt.getMetaEventType() );
+        REQUIRE( ev->getParamSize() == pkt.getMetaEventParamSize() );
+        REQUIRE( 0 == ::memcmp(ev->getParam(), pkt.getMetaEventParam(), pkt.getMetaEventParamSize()) );
+
+        jau::darray<std::unique_ptr<EInfoReport>> eirlist = EInfoReport::read_ad_reports(pkt.getMetaEventParam(), pkt.getMetaEventParamSize());
+        REQUIRE( 1 == eirlist.size() );
+        REQUIRE( "Test01" == eirlist[0]->getName() );
+        REQUIRE( -60 == eirlist[0]->getRSSI() );
+    }
+    {
+        // truncated
+        const HCIPacketView pkt(adv_report_pkt.data(), adv_report_pkt.size()-1);
+        REQUIRE( false == pkt.isValidEvent() );
+        REQUIRE( HCIMetaEventType::INVALID == pkt.getMetaEventType() );
+    }
+    {
+        const HCIPacketView pkt(acl_smp_pkt.data(), acl_smp_pkt.size());
+        REQUIRE( true == pkt.isValidACLData() );
+        REQUIRE( false == pkt.isValidEvent() );
+
+        const uint8_t* l2cap_data0 = nullptr;
+        const HCIACLData::l2cap_frame l2cap0 = HCIACLData::getL2CAPFrame(pkt.getACLHandleAndFlags(), pkt.getACLParam(), pkt.getACLParamSize(), l2cap_data0);
+
+        std::unique_ptr<HCIACLData> acl = HCIACLData::getSpecialized(acl_smp_pkt.data(), acl_smp_pkt.size());
+        REQUIRE( nullptr != acl );
+        const uint8_t* l2cap_data1 = nullptr;
+        const HCIACLData::l2cap_frame l2cap1 = acl->getL2CAPFrame(l2cap_data1);
+
+        REQUIRE( 0x0040 == l2cap0.handle );
+        REQUIRE( true == l2cap0.isSMP() );
+        REQUIRE( l2cap1.handle == l2cap0.handle );
+        REQUIRE( l2cap1.cid == l2cap0.cid );
+        REQUIRE( l2cap1.len == l2cap0.len );
+        REQUIRE( nullptr != l2cap_data0 );
+        REQUIRE( 0 == ::memcmp(l2cap_data0, l2cap_data1, l2cap0.len) );
+    }
+}
+
+TEST_CASE( "HCI Packet View Test 02 Perf", "[datatype][hci][perf]" ) {
+    const size_t loops = 100000;
+    size_t sum0 = 0, sum1 = 0;
+
+    const jau::fraction_timespec t0 = jau::getMonotonicTime();
+    for(size_t i=0; i<loops; ++i) {
+        std::unique_ptr<HCIEvent> ev = HCIEvent::getSpecialized(adv_report_pkt.data(), adv_report_pkt.size());
+        if( ev->isMetaEvent(HCIMetaEventType::LE_ADVERTISING_REPORT) ) {
+            sum0 += ev->getParamSize();
+        }
+    }
+    const jau::fraction_timespec t1 = jau::getMonotonicTime();
+    for(size_t i=0; i<loops; ++i) {
+        const HCIPacketView pkt(adv_report_pkt.data(), adv_report_pkt.size());
+        if( HCIMetaEventType::LE_ADVERTISING_REPORT == pkt.getMetaEventType() ) {
+            sum1 += pkt.getMetaEventParamSize();
+        }
+    }
+    const jau::fraction_timespec t2 = jau::getMonotonicTime();
+    REQUIRE( sum0 == sum1 );
+
+    const double ns0 = double( ( t1 - t0 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) / double(loops);
+    const double ns1 = double( ( t2 - t1 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) / double(loops);
+    std::cout << "HCIEvent::getSpecialized: " << ns0 << " ns/packet" << std::endl;
+    std::cout << "HCIPacketView:            " << ns1 << " ns/packet" << std::endl;
+}
+
+TEST_CASE( "BTSnoop Capture Test 03", "[datatype][hci][snoop]" ) {
+    const std::string fname = "test_hcitypes01_03.btsnoop";
+    {
+        BTSnoopWriter writer(fname);
+        REQUIRE( true == writer.is_open() );
+        REQUIRE( true == writer.write(adv_report_pkt.data(), adv_report_pkt.size(), true /* received */, BTSnoop::EPOCH_DELTA_US + 1000) );
+        REQUIRE( true == writer.write(acl_smp_pkt.data(), acl_smp_pkt.size(), false /* received */, BTSnoop::EPOCH_DELTA_US + 2000) );
+        REQUIRE( 2 == writer.getRecordCount() );
+    }
+    {
+        BTSnoopReader reader(fname);
+        REQUIRE( true == reader.is_open() );
+        BTSnoopRecord record;
+
+        REQUIRE( true == reader.next(record) );
+        REQUIRE( true == record.isReceived() );
+        REQUIRE( 0 != ( record.flags & BTSnoop::FLAG_CMD_EVT ) );
+        REQUIRE( BTSnoop::EPOCH_DELTA_US + 1000 == record.timestamp_us );
+        REQUIRE( adv_report_pkt == record.data );
+
+        REQUIRE( true == reader.next(record) );
+        REQUIRE( false == record.isReceived() );
+        REQUIRE( 0 == ( record.flags & BTSnoop::FLAG_CMD_EVT ) );
+        REQUIRE( BTSnoop::EPOCH_DELTA_US + 2000 == record.timestamp_us );
+        REQUIRE( acl_smp_pkt == record.data );
+
+        REQUIRE( false == reader.next(record) );
+        REQUIRE( true == reader.at_end() );
+        REQUIRE( 2 == reader.getRecordCount() );
+    }
+    ::remove(fname.c_str());
+}
@@ -0,0 +1,535 @@
+#include <iostream>
+#include <cassert>
+#include <cinttypes>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdio>
+
+#include <jau/test/catch2_ext.hpp>
+
+#include <jau/basic_types.hpp>
+#include <jau/byte_util.hpp>
+#include <direct_bt/HCIHandler.hpp>
+#include <direct_bt/HCIVirtualController.hpp>
+#include <direct_bt/HCISnoop.hpp>
+#include <direct_bt/L2CAPComm.hpp>
+
+using namespace direct_bt;
+using namespace jau::fractions_i64_literals;
+
+static const uint8_t addrA_b[] = { 0x01, 0x00, 0x00, 0x00, 0xc0, 0xc0 };
+static const uint8_t addrB_b[] = { 0x02, 0x00, 0x00, 0x00, 0xc0, 0xc0 };
+
+class VirtualEventCounter {
+    public:
+        std::atomic<int> found;
+        std::atomic<int> connected;
+        std::atomic<int> disconnected;
+        std::atomic<int> remote_features;
+        std::atomic<uint16_t> conn_handle;
+
+        VirtualEventCounter() : found(0), connected(0), disconnected(0), remote_features(0), conn_handle(0) {}
+
+        void deviceFound(const MgmtEvent& e) { (void)e; ++found; }
+        void deviceConnected(const MgmtEvent& e) {
+            conn_handle = static_cast<const MgmtEvtDeviceConnected&>(e).getHCIHandle();
+            ++connected;
+        }
+        void deviceDisconnected(const MgmtEvent& e) { (void)e; ++disconnected; }
+        void remoteFeatures(const MgmtEvent& e) { (void)e; ++remote_features; }
+
+        void attach(HCIHandler& hci) {
+            hci.addMgmtEventCallback(MgmtEvent::Opcode::DEVICE_FOUND, jau::bind_member(this, &VirtualEventCounter::deviceFound));
+            hci.addMgmtEventCallback(MgmtEvent::Opcode::DEVICE_CONNECTED, jau::bind_member(this, &VirtualEventCounter::deviceConnected));
+            hci.addMgmtEventCallback(MgmtEvent::Opcode::DEVICE_DISCONNECTED, jau::bind_member(this, &VirtualEventCounter::deviceDisconnected));
+            hci.addMgmtEventCallback(MgmtEvent::Opcode::HCI_LE_REMOTE_FEATURES, jau::bind_member(this, &VirtualEventCounter::remoteFeatures));
+        }
+};
+
+static bool waitFor(const std::atomic<int>& v, const int min) {
+    for(int i=0; i<200 && v < min; ++i) { // max 2s
+        jau::sleep_for( 10_ms );
+    }
+    return v >= min;
+}
+
+TEST_CASE( "HCI Virtual Controller Test 01", "[hci][virtual]" ) {
+    const jau::EUI48 addrA(addrA_b, jau::lb_endian_t::little);
+    const jau::EUI48 addrB(addrB_b, jau::lb_endian_t::little);
+    HCIVirtualController ctrlA(addrA), ctrlB(addrB);
+    REQUIRE( true == ctrlA.is_open() );
+    REQUIRE( true == ctrlB.is_open() );
+    HCIVirtualController::link(ctrlA, ctrlB);
+
+    HCIHandler hciA(0, ctrlA);
+    HCIHandler hciB(1, ctrlB);
+    REQUIRE( true == hciA.isOpen() );
+    REQUIRE( true == hciA.isVirtual() );
+    REQUIRE( true == hciB.isOpen() );
+
+    VirtualEventCounter evA, evB;
+    evA.attach(hciA);
+    evB.attach(hciB);
+
+    // kernel socket filter passes advertising reports only while scanning
+    const uint32_t adv_report_bit = 1U << ( number(HCIMetaEventType::LE_ADVERTISING_REPORT) - 1 );
+    REQUIRE( 0 == ( hciA.getKernelMetaEventFilter() & adv_report_bit ) );
+    // connection related events pass ahead of any connection, e.g. one initiated via the whitelist
+    const uint32_t remote_feat_bit = 1U << ( number(HCIMetaEventType::LE_REMOTE_FEAT_COMPLETE) - 1 );
+    REQUIRE( 0 != ( hciA.getKernelMetaEventFilter() & remote_feat_bit ) );
+    REQUIRE( 0 != ( hciB.getKernelMetaEventFilter() & remote_feat_bit ) );
+
+    // peripheral B advertises, central A scans and finds B
+    EInfoReport eir;
+    eir.setName("VirtualB");
+    REQUIRE( HCIStatusCode::SUCCESS == hciB.le_start_adv(eir) );
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.le_start_scan() );
+    REQUIRE( 0 != ( hciA.getKernelMetaEventFilter() & adv_report_bit ) );
+    REQUIRE( true == waitFor(evA.found, 1) );
+
+    // crowded environment throughput
+    {
+        const int count = 1000;
+        const int found0 = evA.found;
+        const uint8_t ad[] = { 0x02, 0x01, 0x06, 0x05, 0x09, 'T', 'e', 's', 't' };
+        uint8_t addr_b[6] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0xd0 };
+        const jau::fraction_timespec t0 = jau::getMonotonicTime();
+        for(int i=0; i<count; ++i) {
+            jau::put_uint16(addr_b, static_cast<uint16_t>(i), jau::lb_endian_t::little);
+            REQUIRE( true == ctrlA.injectAdvertisingReport(AD_PDU_Type::ADV_IND, jau::EUI48(addr_b, jau::lb_endian_t::little), ad, sizeof(ad), -50) );
+        }
+        REQUIRE( true == waitFor(evA.found, found0 + count) );
+        const jau::fraction_timespec t1 = jau::getMonotonicTime();
+        const double ms = double( ( t1 - t0 ).to_fraction_i64().to_num_of(jau::fractions_i64::micro) ) / 1000.0;
+        std::cout << "Virtual advertising reports: " << count << " in " << ms << " ms, " << ( double(count) * 1000.0 / ms ) << " reports/s" << std::endl;
+    }
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.le_enable_scan(false) );
+    REQUIRE( 0 == ( hciA.getKernelMetaEventFilter() & adv_report_bit ) );
+
+    // central A connects to B
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.le_create_conn(addrB) );
+    REQUIRE( true == waitFor(evA.connected, 1) );
+    REQUIRE( true == waitFor(evB.connected, 1) );
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.le_read_remote_features(evA.conn_handle, BDAddressAndType(addrB, BDAddressType::BDADDR_LE_PUBLIC)) );
+    REQUIRE( true == waitFor(evA.remote_features, 1) );
+    REQUIRE( 0 != ( hciA.getKernelMetaEventFilter() & remote_feat_bit ) );
+
+    std::cout << ctrlA.toString() << std::endl;
+    std::cout << ctrlB.toString() << std::endl;
+
+    hciA.close();
+    hciB.close();
+    ctrlA.close();
+    ctrlB.close();
+}
+
+class PeriodicAdvCounter {
+    public:
+        std::atomic<int> synced;
+        std::atomic<int> lost;
+        std::atomic<int> reports;
+        std::atomic<uint16_t> sync_handle;
+
+        PeriodicAdvCounter() : synced(0), lost(0), reports(0), sync_handle(0) {}
+
+        void syncChanged(const PeriodicAdvSync& s) {
+            if( s.lost ) {
+                ++lost;
+            } else if( HCIStatusCode::SUCCESS == s.status ) {
+                sync_handle = s.sync_handle;
+                ++synced;
+            }
+        }
+        void report(const PeriodicAdvReport& r) {
+            if( r.sync_handle == sync_handle && 9 == r.data_len && EAD_DataStatus::COMPLETE == r.data_status ) {
+                ++reports;
+            }
+        }
+};
+
+TEST_CASE( "HCI Virtual Controller Test 02: Periodic Advertising Sync", "[hci][virtual][periodic]" ) {
+    const jau::EUI48 addrA(addrA_b, jau::lb_endian_t::little);
+    const jau::EUI48 addrB(addrB_b, jau::lb_endian_t::little);
+    HCIVirtualController ctrlA(addrA);
+    HCIHandler hciA(0, ctrlA);
+    REQUIRE( true == hciA.isOpen() );
+    REQUIRE( true == hciA.use_periodic_adv_sync() );
+
+    PeriodicAdvCounter pa;
+    hciA.addPeriodicAdvSyncCallback(jau::bind_member(&pa, &PeriodicAdvCounter::syncChanged));
+    hciA.addPeriodicAdvReportCallback(jau::bind_member(&pa, &PeriodicAdvCounter::report));
+
+    const uint32_t periodic_report_bit = 1U << ( number(HCIMetaEventType::LE_PERIODIC_ADV_REPORT) - 1 );
+    REQUIRE( 0 == ( hciA.getKernelMetaEventFilter() & periodic_report_bit ) );
+
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.le_start_scan() );
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.le_create_periodic_adv_sync(BDAddressAndType(addrB, BDAddressType::BDADDR_LE_PUBLIC), 0x03) );
+    REQUIRE( true == waitFor(pa.synced, 1) );
+    REQUIRE( 1 == hciA.getPeriodicAdvSyncs().size() );
+    REQUIRE( 0x03 == hciA.getPeriodicAdvSyncs()[0].adv_sid );
+    REQUIRE( addrB == hciA.getPeriodicAdvSyncs()[0].address.address );
+    REQUIRE( 0 != ( hciA.getKernelMetaEventFilter() & periodic_report_bit ) );
+
+    {
+        const int count = 1000;
+        const uint8_t ad[] = { 0x02, 0x01, 0x06, 0x05, 0xff, 0x01, 0x00, 0x01, 0x02 };
+        const jau::fraction_timespec t0 = jau::getMonotonicTime();
+        for(int i=0; i<count; ++i) {
+            REQUIRE( true == ctrlA.injectPeriodicAdvReport(pa.sync_handle, ad, sizeof(ad), -50) );
+        }
+        REQUIRE( true == waitFor(pa.reports, count) );
+        const jau::fraction_timespec t1 = jau::getMonotonicTime();
+        const double ms = double( ( t1 - t0 ).to_fraction_i64().to_num_of(jau::fractions_i64::micro) ) / 1000.0;
+        std::cout << "Virtual periodic advertising reports: " << count << " in " << ms << " ms, " << ( double(count) * 1000.0 / ms ) << " reports/s" << std::endl;
+        REQUIRE( static_cast<uint64_t>(count) == hciA.getPeriodicAdvReports() );
+    }
+
+    // terminate by host, then establish another and lose it
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.le_terminate_periodic_adv_sync(pa.sync_handle) );
+    REQUIRE( 1 == pa.lost );
+    REQUIRE( 0 == hciA.getPeriodicAdvSyncs().size() );
+    REQUIRE( 0 == ( hciA.getKernelMetaEventFilter() & periodic_report_bit ) );
+
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.le_create_periodic_adv_sync(BDAddressAndType(addrB, BDAddressType::BDADDR_LE_PUBLIC), 0x04) );
+    REQUIRE( true == waitFor(pa.synced, 2) );
+    REQUIRE( true == ctrlA.injectPeriodicAdvSyncLost(pa.sync_handle) );
+    REQUIRE( true == waitFor(pa.lost, 2) );
+    REQUIRE( 0 == hciA.getPeriodicAdvSyncs().size() );
+
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.le_enable_scan(false) );
+    hciA.close();
+    ctrlA.close();
+}
+
+TEST_CASE( "HCI Virtual Controller Test 03: Advertising Sets", "[hci][virtual][advertising]" ) {
+    {
+        ExtAdvSet s0;
+        REQUIRE( HCIStatusCode::SUCCESS == s0.validate() );
+        REQUIRE( number(AD_PDU_Type::ADV_IND2) == s0.getEventProperties() );
+        REQUIRE( true == s0.isConnectable() );
+        REQUIRE( true == s0.isScannable() );
+
+        ExtAdvSet s1;
+        s1.legacy_pdu = false;
+        s1.secondary_phy = LE_PHYs::LE_2M;
+        REQUIRE( HCIStatusCode::SUCCESS == s1.validate() );
+        REQUIRE( 0x0001 == s1.getEventProperties() ); // connectable only
+        REQUIRE( false == s1.isScannable() );
+        s1.adv_type = AD_PDU_Type::ADV_SCAN_IND;
+        REQUIRE( 0x0002 == s1.getEventProperties() ); // scannable only
+        s1.adv_type = AD_PDU_Type::ADV_NONCONN_IND;
+        REQUIRE( 0x0000 == s1.getEventProperties() );
+        s1.primary_phy = LE_PHYs::LE_CODED;
+        REQUIRE( HCIStatusCode::SUCCESS == s1.validate() );
+        s1.primary_phy = LE_PHYs::LE_2M; // never primary
+        REQUIRE( HCIStatusCode::INVALID_PARAMS == s1.validate() );
+
+        s0.primary_phy = LE_PHYs::LE_CODED; // legacy PDUs on LE_1M only
+        REQUIRE( HCIStatusCode::INVALID_PARAMS == s0.validate() );
+        s0.primary_phy = LE_PHYs::LE_1M;
+        s0.handle = ExtAdvSet::MAX_HANDLE + 1;
+        REQUIRE( HCIStatusCode::INVALID_PARAMS == s0.validate() );
+    }
+    const jau::EUI48 addrA(addrA_b, jau::lb_endian_t::little);
+    const jau::EUI48 addrB(addrB_b, jau::lb_endian_t::little);
+    HCIVirtualController ctrlA(addrA), ctrlB(addrB);
+    HCIVirtualController::link(ctrlA, ctrlB);
+    HCIHandler hciA(0, ctrlA);
+    HCIHandler hciB(1, ctrlB);
+    REQUIRE( true == hciB.isOpen() );
+
+    VirtualEventCounter evA;
+    evA.attach(hciA);
+
+    // legacy only controller: falls back to legacy advertising of the first set
+    REQUIRE( false == hciB.use_ext_adv() );
+    REQUIRE( 1 == hciB.getExtAdvMaxSets() );
+    jau::darray<ExtAdvSet> sets;
+    {
+        ExtAdvSet s0;
+        s0.eir.setName("VirtualB0");
+        sets.push_back(s0);
+        ExtAdvSet s1;
+        s1.handle = 1;
+        s1.legacy_pdu = false;
+        s1.eir.setName("VirtualB1");
+        sets.push_back(s1);
+        ExtAdvSet s2 = s1; // duplicate handle
+        sets.push_back(s2);
+    }
+    REQUIRE( HCIStatusCode::INVALID_PARAMS == hciB.le_start_ext_adv(sets) );
+    sets.erase(sets.cbegin()+2, sets.cend());
+    REQUIRE( HCIStatusCode::SUCCESS == hciB.le_start_ext_adv(sets) );
+    REQUIRE( true == hciB.isAdvertising() );
+
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.le_start_scan() );
+    REQUIRE( true == waitFor(evA.found, 1) );
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.le_enable_scan(false) );
+    REQUIRE( HCIStatusCode::SUCCESS == hciB.le_enable_adv(false) );
+    REQUIRE( false == hciB.isAdvertising() );
+
+    hciA.close();
+    hciB.close();
+    ctrlA.close();
+    ctrlB.close();
+}
+
+/** Returns an H4 LE advertising report event of a single ADV_IND report with a complete local name */
+static std::vector<uint8_t> make_adv_report_event(const jau::EUI48& address, const int8_t rssi) {
+    const uint8_t ad[] = { 0x02, 0x01, 0x06, 0x05, 0x09, 'T', 'e', 's', 't' };
+    std::vector<uint8_t> pkt = { number(HCIPacketType::EVENT), number(HCIEventType::LE_META), 0,
+                                 number(HCIMetaEventType::LE_ADVERTISING_REPORT), 1 /* num_reports */,
+                                 number(AD_PDU_Type::ADV_IND), 0x00 /* public address */ };
+    uint8_t addr_b[6];
+    address.put(addr_b, jau::lb_endian_t::little);
+    pkt.insert(pkt.end(), addr_b, addr_b + sizeof(addr_b));
+    pkt.push_back( sizeof(ad) );
+    pkt.insert(pkt.end(), ad, ad + sizeof(ad));
+    pkt.push_back( static_cast<uint8_t>(rssi) );
+    pkt[2] = static_cast<uint8_t>( pkt.size() - number(HCIConstSizeT::EVENT_HDR_SIZE) );
+    return pkt;
+}
+
+TEST_CASE( "HCI Virtual Controller Test 04: Replay", "[hci][virtual][replay]" ) {
+    const std::string fname = "test_hcivirtual01_replay.btsnoop";
+    const int adv_count = 5;
+    {
+        BTSnoopWriter snoop(fname);
+        REQUIRE( true == snoop.is_open() );
+        uint64_t ts = BTSnoopWriter::getTimestamp();
+        // sent LE_SET_SCAN_ENABLE command, skipped
+        const uint8_t cmd[] = { number(HCIPacketType::COMMAND), 0x0c, 0x20, 0x02, 0x01, 0x00 };
+        REQUIRE( true == snoop.write(cmd, sizeof(cmd), false /* received */, ts) );
+        // its unrouted command complete reply
+        const uint8_t cc[] = { number(HCIPacketType::EVENT), number(HCIEventType::CMD_COMPLETE), 0x04, 0x01, 0x0c, 0x20, 0x00 };
+        REQUIRE( true == snoop.write(cc, sizeof(cc), true /* received */, ts += 1000) );
+        uint8_t addr_b[6] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0xd1 };
+        for(int i=0; i<adv_count; ++i) {
+            addr_b[0] = static_cast<uint8_t>(i);
+            const std::vector<uint8_t> pkt = make_adv_report_event(jau::EUI48(addr_b, jau::lb_endian_t::little), -50);
+            REQUIRE( true == snoop.write(pkt.data(), pkt.size(), true /* received */, ts += 1000) );
+        }
+        REQUIRE( static_cast<uint64_t>(2 + adv_count) == snoop.getRecordCount() );
+    }
+
+    const jau::EUI48 addrA(addrA_b, jau::lb_endian_t::little);
+    HCIVirtualController ctrlA(addrA);
+    HCIHandler hciA(0, ctrlA);
+    REQUIRE( true == hciA.isOpen() );
+    HCIReplayStats stats;
+    {
+        // not allowed while the reader is running
+        BTSnoopReader reader(fname);
+        REQUIRE( true == reader.is_open() );
+        REQUIRE( false == hciA.replay(reader, false, stats) );
+    }
+    hciA.close();
+    REQUIRE( false == hciA.isOpen() );
+
+    VirtualEventCounter evA;
+    evA.attach(hciA);
+    const uint64_t unrouted0 = hciA.getCommandRepliesUnrouted();
+    {
+        BTSnoopReader reader(fname);
+        REQUIRE( true == reader.is_open() );
+        REQUIRE( true == hciA.replay(reader, false, stats) );
+        REQUIRE( true == reader.at_end() );
+        REQUIRE( static_cast<uint64_t>(2 + adv_count) == reader.getRecordCount() );
+    }
+    std::cout << "Replay: " << stats.toString() << std::endl;
+    REQUIRE( adv_count == evA.found );
+    REQUIRE( 0 == evA.connected );
+    REQUIRE( unrouted0 + 1 == hciA.getCommandRepliesUnrouted() );
+
+    REQUIRE( static_cast<uint64_t>(1 + adv_count) == stats.packets );
+    REQUIRE( 1 == stats.skipped );
+    REQUIRE( static_cast<uint64_t>(adv_count) == stats.adv_reports );
+    REQUIRE( static_cast<uint64_t>(1 + adv_count) == stats.process.count );
+    REQUIRE( static_cast<uint64_t>(adv_count) == stats.adv_parse.count );
+    REQUIRE( static_cast<uint64_t>(adv_count) == stats.adv_dispatch.count );
+    REQUIRE( stats.process.min_ns <= stats.process.max_ns );
+    REQUIRE( 0 < stats.duration_ns );
+    REQUIRE( 0 < stats.getEventsPerSecond() );
+
+    ctrlA.close();
+    std::remove(fname.c_str());
+}
+
+TEST_CASE( "HCI Virtual Controller Test 05: L2CAP Client and Server", "[hci][virtual][l2cap]" ) {
+    const jau::EUI48 addrA(addrA_b, jau::lb_endian_t::little);
+    const jau::EUI48 addrB(addrB_b, jau::lb_endian_t::little);
+    const BDAddressAndType addrTypeA(addrA, BDAddressType::BDADDR_LE_PUBLIC);
+    const BDAddressAndType addrTypeB(addrB, BDAddressType::BDADDR_LE_PUBLIC);
+    HCIVirtualController ctrlA(addrA), ctrlB(addrB);
+    HCIVirtualController::link(ctrlA, ctrlB);
+    HCIHandler hciA(0, ctrlA);
+    HCIHandler hciB(1, ctrlB);
+    REQUIRE( true == hciA.isOpen() );
+    REQUIRE( true == hciB.isOpen() );
+
+    VirtualEventCounter evA, evB;
+    evA.attach(hciA);
+    evB.attach(hciB);
+
+    // peripheral B serves the ATT channel
+    L2CAPServer server(1, addrTypeB, L2CAP_PSM::UNDEFINED, L2CAP_CID::ATT);
+    REQUIRE( true == server.open(ctrlB) );
+
+    // not connected
+    L2CAPClient client(0, addrTypeA, L2CAP_PSM::UNDEFINED, L2CAP_CID::ATT);
+    REQUIRE( false == client.open(ctrlA, addrTypeB) );
+    REQUIRE( false == client.is_open() );
+
+    EInfoReport eir;
+    eir.setName("VirtualB");
+    REQUIRE( HCIStatusCode::SUCCESS == hciB.le_start_adv(eir) );
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.le_create_conn(addrB) );
+    REQUIRE( true == waitFor(evA.connected, 1) );
+    REQUIRE( true == waitFor(evB.connected, 1) );
+
+    // not listening
+    {
+        L2CAPClient smp(0, addrTypeA, L2CAP_PSM::UNDEFINED, L2CAP_CID::SMP);
+        REQUIRE( false == smp.open(ctrlA, addrTypeB) );
+    }
+    REQUIRE( true == client.open(ctrlA, addrTypeB) );
+    REQUIRE( true == client.is_open() );
+    std::unique_ptr<L2CAPClient> conn = server.accept();
+    REQUIRE( nullptr != conn );
+    REQUIRE( true == conn->is_open() );
+    REQUIRE( addrTypeA == conn->getRemoteAddressAndType() );
+    REQUIRE( L2CAP_CID::ATT == conn->cid );
+
+    uint8_t rbuf[L2CAPClient::URING_SLOT_SIZE];
+    const uint8_t req[] = { 0x02, 0x00, 0x02 }; // ATT_EXCHANGE_MTU_REQ, client rx mtu 512
+    const uint8_t rsp[] = { 0x03, 0x00, 0x02 }; // ATT_EXCHANGE_MTU_RSP, server rx mtu 512
+    const uint64_t aclA0 = ctrlA.getACLCount();
+    REQUIRE( jau::snsize_t(sizeof(req)) == client.write(req, sizeof(req)) );
+    REQUIRE( jau::snsize_t(sizeof(req)) == conn->read(rbuf, sizeof(rbuf)) );
+    REQUIRE( 0 == ::memcmp(req, rbuf, sizeof(req)) );
+    REQUIRE( jau::snsize_t(sizeof(rsp)) == conn->write(rsp, sizeof(rsp)) );
+    REQUIRE( jau::snsize_t(sizeof(rsp)) == client.read(rbuf, sizeof(rbuf)) );
+    REQUIRE( 0 == ::memcmp(rsp, rbuf, sizeof(rsp)) );
+    REQUIRE( aclA0 + 1 == ctrlA.getACLCount() );
+
+    // maximum ATT PDU, segmented into three ACL data packets and reassembled
+    {
+        std::vector<uint8_t> ntf(517);
+        for(size_t i=0; i<ntf.size(); ++i) {
+            ntf[i] = static_cast<uint8_t>(i);
+        }
+        ntf[0] = 0x1b; // ATT_HANDLE_VALUE_NTF
+        const uint64_t aclB0 = ctrlB.getACLCount();
+        REQUIRE( static_cast<jau::snsize_t>(ntf.size()) == conn->write(ntf.data(), ntf.size()) );
+        REQUIRE( static_cast<jau::snsize_t>(ntf.size()) == client.read(rbuf, sizeof(rbuf)) );
+        REQUIRE( 0 == ::memcmp(ntf.data(), rbuf, ntf.size()) );
+        REQUIRE( aclB0 + 3 == ctrlB.getACLCount() );
+    }
+
+    // batched writes retain order and boundaries
+    {
+        const uint8_t* bufs[] = { req, rsp };
+        const jau::nsize_t lens[] = { sizeof(req), sizeof(rsp) };
+        REQUIRE( 2 == client.write_batch(bufs, lens, 2) );
+        REQUIRE( jau::snsize_t(sizeof(req)) == conn->read(rbuf, sizeof(rbuf)) );
+        REQUIRE( 0 == ::memcmp(req, rbuf, sizeof(req)) );
+        REQUIRE( jau::snsize_t(sizeof(rsp)) == conn->read(rbuf, sizeof(rbuf)) );
+        REQUIRE( 0 == ::memcmp(rsp, rbuf, sizeof(rsp)) );
+    }
+
+    // request/response round trips
+    {
+        const int count = 1000;
+        const jau::fraction_timespec t0 = jau::getMonotonicTime();
+        for(int i=0; i<count; ++i) {
+            REQUIRE( jau::snsize_t(sizeof(req)) == client.write(req, sizeof(req)) );
+            REQUIRE( jau::snsize_t(sizeof(req)) == conn->read(rbuf, sizeof(rbuf)) );
+            REQUIRE( jau::snsize_t(sizeof(rsp)) == conn->write(rsp, sizeof(rsp)) );
+            REQUIRE( jau::snsize_t(sizeof(rsp)) == client.read(rbuf, sizeof(rbuf)) );
+        }
+        const jau::fraction_timespec t1 = jau::getMonotonicTime();
+        const double ms = double( ( t1 - t0 ).to_fraction_i64().to_num_of(jau::fractions_i64::micro) ) / 1000.0;
+        std::cout << "Virtual L2CAP round trips: " << count << " in " << ms << " ms, " << ( double(count) * 1000.0 / ms ) << " rt/s" << std::endl;
+    }
+
+    // disconnect closes the channels, i.e. both hosts read end-of-file
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.disconnect(evA.conn_handle, addrTypeB) );
+    REQUIRE( true == waitFor(evA.disconnected, 1) );
+    REQUIRE( true == waitFor(evB.disconnected, 1) );
+    REQUIRE( 0 == client.read(rbuf, sizeof(rbuf)) );
+    REQUIRE( 0 == conn->read(rbuf, sizeof(rbuf)) );
+    REQUIRE( false == client.hasIOError() );
+
+    client.close();
+    REQUIRE( false == client.open(ctrlA, addrTypeB) );
+    conn->close();
+    server.close();
+
+    std::cout << ctrlA.toString() << std::endl;
+    std::cout << ctrlB.toString() << std::endl;
+
+    hciA.close();
+    hciB.close();
+    ctrlA.close();
+    ctrlB.close();
+}
+
+TEST_CASE( "HCI Virtual Controller Test 06: Advertising Set Terminated", "[hci][virtual][advertising]" ) {
+    const jau::EUI48 addrA(addrA_b, jau::lb_endian_t::little);
+    const jau::EUI48 addrB(addrB_b, jau::lb_endian_t::little);
+    HCIVirtualController ctrlA(addrA), ctrlB(addrB, true /* ext_adv */);
+    HCIVirtualController::link(ctrlA, ctrlB);
+    HCIHandler hciA(0, ctrlA);
+    HCIHandler hciB(1, ctrlB);
+    REQUIRE( true == hciB.isOpen() );
+    REQUIRE( true == hciB.use_ext_adv() );
+    REQUIRE( HCIVirtualController::EXT_ADV_MAX_SETS == hciB.getExtAdvMaxSets() );
+
+    // kernel socket filter passes the advertising set termination regardless of advertising
+    const uint32_t adv_set_term_bit = 1U << ( number(HCIMetaEventType::LE_ADV_SET_TERMINATED) - 1 );
+    REQUIRE( 0 != ( hciB.getKernelMetaEventFilter() & adv_set_term_bit ) );
+
+    VirtualEventCounter evA, evB;
+    evA.attach(hciA);
+    evB.attach(hciB);
+
+    jau::darray<ExtAdvSet> sets;
+    for(uint8_t h=0; h<2; ++h) {
+        ExtAdvSet s;
+        s.handle = h;
+        s.eir.setName("VirtualB"+std::to_string(h));
+        sets.push_back(s);
+    }
+    REQUIRE( HCIStatusCode::SUCCESS == hciB.le_start_ext_adv(sets) );
+    REQUIRE( true == hciB.isAdvertising() );
+    REQUIRE( true == hciB.isAdvertisingSet(0) );
+    REQUIRE( true == hciB.isAdvertisingSet(1) );
+    REQUIRE( false == hciB.isAdvertisingSet(2) );
+
+    // the connection ends the connected set 0 only
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.le_create_conn(addrB) );
+    REQUIRE( true == waitFor(evA.connected, 1) );
+    REQUIRE( true == waitFor(evB.connected, 1) );
+    for(int i=0; i<200 && hciB.isAdvertisingSet(0); ++i) { // max 2s
+        jau::sleep_for( 10_ms );
+    }
+    REQUIRE( false == hciB.isAdvertisingSet(0) );
+    REQUIRE( true == hciB.isAdvertisingSet(1) );
+    REQUIRE( true == hciB.isAdvertising() );
+
+    // extended advertising may be re-enabled while connected
+    REQUIRE( HCIStatusCode::SUCCESS == hciB.le_enable_adv(true) );
+    REQUIRE( true == hciB.isAdvertisingSet(0) );
+
+    REQUIRE( HCIStatusCode::SUCCESS == hciB.le_enable_adv(false) );
+    REQUIRE( false == hciB.isAdvertising() );
+    REQUIRE( false == hciB.isAdvertisingSet(0) );
+    REQUIRE( false == hciB.isAdvertisingSet(1) );
+
+    hciA.close();
+    hciB.close();
+    ctrlA.close();
+    ctrlB.close();
+}
@@ -0,0 +1,269 @@
+#include <iostream>
+#include <cassert>
+#include <cinttypes>
+#include <cstring>
+#include <cstdlib>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <jau/test/catch2_ext.hpp>
+
+#include <jau/basic_types.hpp>
+#include <direct_bt/HCIHandler.hpp>
+#include <direct_bt/HCIVirtualController.hpp>
+#include <direct_bt/IOReactor.hpp>
+#include <direct_bt/L2CAPComm.hpp>
+
+extern "C" {
+    #include <unistd.h>
+    #include <sys/socket.h>
+}
+
+using namespace direct_bt;
+using namespace jau::fractions_i64_literals;
+
+static const uint8_t addrA_b[] = { 0x01, 0x00, 0x00, 0x00, 0xc0, 0xc0 };
+static const uint8_t addrB_b[] = { 0x02, 0x00, 0x00, 0x00, 0xc0, 0xc0 };
+
+class ConnCounter {
+    public:
+        std::atomic<int> connected;
+        std::atomic<uint16_t> conn_handle;
+
+        ConnCounter() : connected(0), conn_handle(0) {}
+
+        void deviceConnected(const MgmtEvent& e) {
+            conn_handle = static_cast<const MgmtEvtDeviceConnected&>(e).getHCIHandle();
+            ++connected;
+        }
+};
+
+/** GATT like reader dispatched by the IOReactor, issuing a blocking HCI command per received PDU. */
+class ReactorReader {
+    public:
+        HCIHandler& hci;
+        L2CAPClient& client;
+        const BDAddressAndType peer;
+        std::atomic<uint16_t> conn_handle;
+        std::atomic<int> pdus;
+        std::atomic<int> cmd_success;
+        std::atomic<int64_t> cmd_max_ms;
+
+        ReactorReader(HCIHandler& hci_, L2CAPClient& client_, const BDAddressAndType& peer_)
+        : hci(hci_), client(client_), peer(peer_), conn_handle(0), pdus(0), cmd_success(0), cmd_max_ms(0) {}
+
+        bool ready() {
+            uint8_t buf[L2CAPClient::URING_SLOT_SIZE];
+            const jau::snsize_t len = client.read(buf, sizeof(buf));
+            if( 0 >= len ) {
+                return false;
+            }
+            const jau::fraction_timespec t0 = jau::getMonotonicTime();
+            const HCIStatusCode status = hci.le_read_remote_features(conn_handle, peer);
+            const int64_t ms = ( jau::getMonotonicTime() - t0 ).to_fraction_i64().to_ms();
+            if( ms > cmd_max_ms ) {
+                cmd_max_ms = ms;
+            }
+            if( HCIStatusCode::SUCCESS == status ) {
+                ++cmd_success;
+            }
+            ++pdus;
+            return true;
+        }
+};
+
+static bool waitFor(const std::atomic<int>& v, const int min) {
+    for(int i=0; i<500 && v < min; ++i) { // max 5s
+        jau::sleep_for( 10_ms );
+    }
+    return v >= min;
+}
+
+TEST_CASE( "IOReactor Test 01: HCI Command from Reactor Callback", "[reactor][hci][virtual]" ) {
+    // before the first IOReactorEnv::get()
+    ::setenv("direct_bt.reactor", "true", 1);
+    ::setenv("direct_bt.reactor.threads", "1", 1);
+    REQUIRE( true == IOReactor::isEnabled() );
+    REQUIRE( 1 == IOReactorEnv::get().REACTOR_THREADS );
+
+    const jau::EUI48 addrA(addrA_b, jau::lb_endian_t::little);
+    const jau::EUI48 addrB(addrB_b, jau::lb_endian_t::little);
+    const BDAddressAndType addrTypeA(addrA, BDAddressType::BDADDR_LE_PUBLIC);
+    const BDAddressAndType addrTypeB(addrB, BDAddressType::BDADDR_LE_PUBLIC);
+    HCIVirtualController ctrlA(addrA), ctrlB(addrB);
+    HCIVirtualController::link(ctrlA, ctrlB);
+
+    // the HCI reader keeps its own thread
+    const jau::nsize_t reactor_size0 = IOReactor::get().size();
+    HCIHandler hciA(0, ctrlA);
+    HCIHandler hciB(1, ctrlB);
+    REQUIRE( true == hciA.isOpen() );
+    REQUIRE( true == hciB.isOpen() );
+    REQUIRE( reactor_size0 == IOReactor::get().size() );
+
+    ConnCounter evA, evB;
+    hciA.addMgmtEventCallback(MgmtEvent::Opcode::DEVICE_CONNECTED, jau::bind_member(&evA, &ConnCounter::deviceConnected));
+    hciB.addMgmtEventCallback(MgmtEvent::Opcode::DEVICE_CONNECTED, jau::bind_member(&evB, &ConnCounter::deviceConnected));
+
+    L2CAPServer server(1, addrTypeB, L2CAP_PSM::UNDEFINED, L2CAP_CID::ATT);
+    REQUIRE( true == server.open(ctrlB) );
+
+    EInfoReport eir;
+    eir.setName("VirtualB");
+    REQUIRE( HCIStatusCode::SUCCESS == hciB.le_start_adv(eir) );
+    REQUIRE( HCIStatusCode::SUCCESS == hciA.le_create_conn(addrB) );
+    REQUIRE( true == waitFor(evA.connected, 1) );
+    REQUIRE( true == waitFor(evB.connected, 1) );
+
+    L2CAPClient client(0, addrTypeA, L2CAP_PSM::UNDEFINED, L2CAP_CID::ATT);
+    REQUIRE( true == client.open(ctrlA, addrTypeB) );
+    std::unique_ptr<L2CAPClient> conn = server.accept();
+    REQUIRE( nullptr != conn );
+
+    // central A's ATT reader issues an HCI command from its reactor callback,
+    // which must not wait for the HCI command reply timeout.
+    ReactorReader reader(hciA, client, addrTypeB);
+    reader.conn_handle = evA.conn_handle;
+    const uint64_t id = IOReactor::get().add(client.socket(), "test.reader", jau::bind_member(&reader, &ReactorReader::ready));
+    REQUIRE( 0 != id );
+
+    const int count = 10;
+    const uint8_t ntf[] = { 0x1b, 0x03, 0x00, 0x01 }; // ATT_HANDLE_VALUE_NTF
+    for(int i=0; i<count; ++i) {
+        REQUIRE( jau::snsize_t(sizeof(ntf)) == conn->write(ntf, sizeof(ntf)) );
+        REQUIRE( true == waitFor(reader.pdus, i + 1) );
+    }
+    REQUIRE( count == reader.cmd_success );
+    std::cout << "Reactor callback HCI command: max " << reader.cmd_max_ms << " ms" << std::endl;
+    REQUIRE( 1000 > reader.cmd_max_ms );
+
+    REQUIRE( true == IOReactor::get().remove(id) );
+    std::cout << IOReactor::get().toString() << std::endl;
+
+    client.close();
+    conn->close();
+    server.close();
+    hciA.close();
+    hciB.close();
+    ctrlA.close();
+    ctrlB.close();
+}
+
+/**
+ * Two GATT like readers dispatched by the IOReactor: The notification callback of device A
+ * issues a nested blocking request to device B, whose reply is dispatched by the IOReactor as well.
+ */
+class NestedReaders {
+    public:
+        int fdA = -1, fdB = -1;
+        uint64_t idA = 0, idB = 0;
+        std::mutex mtx;
+        std::condition_variable cv;
+        int replies = 0;
+        std::atomic<int> notifications {0};
+        std::atomic<int> nested_success {0};
+        std::atomic<int> own_dispatch {0};
+        std::atomic<int64_t> nested_max_ms {0};
+
+        /** Device A: notification received, issuing a request to device B and awaiting its reply. */
+        bool readyA() {
+            uint8_t buf[32];
+            if( 0 >= ::read(fdA, buf, sizeof(buf)) ) {
+                return false;
+            }
+            // a request to device A itself would be failed fast, see BTGattHandler::sendWithReply()
+            if( IOReactor::isDispatching(idA) && !IOReactor::isDispatching(idB) ) {
+                ++own_dispatch;
+            }
+            const jau::fraction_timespec t0 = jau::getMonotonicTime();
+            int replies0;
+            {
+                const std::lock_guard<std::mutex> lock(mtx);
+                replies0 = replies;
+            }
+            const uint8_t req[] = { 0x0a, 0x03, 0x00 }; // ATT_READ_REQ
+            if( jau::snsize_t(sizeof(req)) != ::write(fdB, req, sizeof(req)) ) {
+                return false;
+            }
+            {
+                const IOReactor::BlockingScope blocking;
+                std::unique_lock<std::mutex> lock(mtx);
+                if( cv.wait_for(lock, std::chrono::seconds(2), [&]{ return replies > replies0; }) ) {
+                    ++nested_success;
+                }
+            }
+            const int64_t ms = ( jau::getMonotonicTime() - t0 ).to_fraction_i64().to_ms();
+            if( ms > nested_max_ms ) {
+                nested_max_ms = ms;
+            }
+            ++notifications;
+            return true;
+        }
+
+        /** Device B: reply received. */
+        bool readyB() {
+            uint8_t buf[32];
+            if( 0 >= ::read(fdB, buf, sizeof(buf)) ) {
+                return false;
+            }
+            {
+                const std::lock_guard<std::mutex> lock(mtx);
+                ++replies;
+            }
+            cv.notify_all();
+            return true;
+        }
+};
+
+TEST_CASE( "IOReactor Test 02: Nested GATT Request from Notification Callback", "[reactor][gatt]" ) {
+    // before the first IOReactorEnv::get(), if run alone
+    ::setenv("direct_bt.reactor", "true", 1);
+    ::setenv("direct_bt.reactor.threads", "1", 1);
+    REQUIRE( true == IOReactor::isEnabled() );
+
+    int pairA[2], pairB[2]; // [0] local reader, [1] remote device
+    REQUIRE( 0 == ::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, pairA) );
+    REQUIRE( 0 == ::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, pairB) );
+
+    NestedReaders readers;
+    readers.fdA = pairA[0];
+    readers.fdB = pairB[0];
+    readers.idA = IOReactor::get().add(pairA[0], "test.readerA", jau::bind_member(&readers, &NestedReaders::readyA));
+    readers.idB = IOReactor::get().add(pairB[0], "test.readerB", jau::bind_member(&readers, &NestedReaders::readyB));
+    REQUIRE( 0 != readers.idA );
+    REQUIRE( 0 != readers.idB );
+
+    // remote device B, replying to each request
+    std::thread remoteB([&]() {
+        uint8_t buf[32];
+        while( 0 < ::read(pairB[1], buf, sizeof(buf)) ) {
+            const uint8_t rsp[] = { 0x0b, 0x01 }; // ATT_READ_RSP
+            if( jau::snsize_t(sizeof(rsp)) != ::write(pairB[1], rsp, sizeof(rsp)) ) {
+                break;
+            }
+        }
+    });
+
+    const int count = 10;
+    const uint8_t ntf[] = { 0x1b, 0x03, 0x00, 0x01 }; // ATT_HANDLE_VALUE_NTF
+    for(int i=0; i<count; ++i) {
+        REQUIRE( jau::snsize_t(sizeof(ntf)) == ::write(pairA[1], ntf, sizeof(ntf)) );
+        REQUIRE( true == waitFor(readers.notifications, i + 1) );
+    }
+    REQUIRE( count == readers.nested_success.load() );
+    REQUIRE( count == readers.own_dispatch.load() );
+    std::cout << "Reactor notification callback nested request: max " << readers.nested_max_ms.load() << " ms" << std::endl;
+    REQUIRE( 1000 > readers.nested_max_ms.load() );
+    REQUIRE( 1 <= IOReactor::get().getExtraThreadsStarted() );
+
+    REQUIRE( true == IOReactor::get().remove(readers.idA) );
+    REQUIRE( true == IOReactor::get().remove(readers.idB) );
+    std::cout << IOReactor::get().toString() << std::endl;
+
+    ::shutdown(pairB[0], SHUT_RDWR); // ends remoteB
+    remoteB.join();
+    ::close(pairA[0]); ::close(pairA[1]);
+    ::close(pairB[0]); ::close(pairB[1]);
+}
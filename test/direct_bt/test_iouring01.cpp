@@ -0,0 +1,257 @@
+#include <iostream>
+#include <cassert>
+#include <cinttypes>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <algorithm>
+
+#include <jau/test/catch2_ext.hpp>
+
+#include <jau/basic_types.hpp>
+#include <jau/byte_util.hpp>
+#include <jau/service_runner.hpp>
+#include <direct_bt/IOUring.hpp>
+#include <direct_bt/HCIComm.hpp>
+#include <direct_bt/L2CAPComm.hpp>
+
+extern "C" {
+    #include <unistd.h>
+    #include <errno.h>
+    #include <sys/socket.h>
+}
+
+using namespace direct_bt;
+using namespace jau::fractions_i64_literals;
+
+static constexpr const jau::nsize_t packet_size = 64;
+static constexpr const int packet_count = 100000;
+static constexpr const jau::nsize_t batch_size = 32;
+
+static double durationMS(const jau::fraction_timespec& t0) {
+    const jau::fraction_timespec t1 = jau::getMonotonicTime();
+    return double( ( t1 - t0 ).to_fraction_i64().to_num_of(jau::fractions_i64::micro) ) / 1000.0;
+}
+
+static void printResult(const std::string& name, const double ms) {
+    std::cout << name << ": " << packet_count << " packets of " << packet_size << " bytes in " << ms << " ms, "
+              << ( double(packet_count) * 1000.0 / ms ) << " packets/s" << std::endl;
+}
+
+/** Fills the packet with its sequence number and a derived pattern. */
+static void fillPacket(uint8_t* packet, const jau::nsize_t size, const uint32_t seq) {
+    for(jau::nsize_t i=0; i<size; ++i) {
+        packet[i] = static_cast<uint8_t>( seq + i );
+    }
+    jau::put_uint32(packet, seq, jau::lb_endian_t::little);
+}
+
+/** Returns true if the packet carries the given sequence number and its pattern. */
+static bool checkPacket(const uint8_t* packet, const jau::nsize_t size, const uint32_t seq) {
+    if( 4 > size || seq != jau::get_uint32(packet, jau::lb_endian_t::little) ) {
+        return false;
+    }
+    for(jau::nsize_t i=4; i<size; ++i) {
+        if( static_cast<uint8_t>( seq + i ) != packet[i] ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Baseline: blocking write() and read() per packet */
+static double runBlocking(const int sd_tx, const int sd_rx) {
+    int received = 0;
+    int corrupt = 0;
+    const jau::fraction_timespec t0 = jau::getMonotonicTime();
+    std::thread reader([&]() {
+        uint8_t buffer[packet_size];
+        while( received < packet_count && ::read(sd_rx, buffer, sizeof(buffer)) == packet_size ) {
+            if( !checkPacket(buffer, packet_size, static_cast<uint32_t>(received)) ) {
+                ++corrupt;
+            }
+            ++received;
+        }
+    });
+    uint8_t packet[packet_size];
+    for(int i=0; i<packet_count; ++i) {
+        fillPacket(packet, packet_size, static_cast<uint32_t>(i));
+        REQUIRE( packet_size == ::write(sd_tx, packet, sizeof(packet)) );
+    }
+    reader.join();
+    REQUIRE( packet_count == received );
+    REQUIRE( 0 == corrupt );
+    return durationMS(t0);
+}
+
+/** io_uring: batched linked writes and multishot receive */
+static double runIOUring(IOUringChannel& tx, IOUringChannel& rx) {
+    int received = 0;
+    int corrupt = 0;
+    const jau::fraction_timespec t0 = jau::getMonotonicTime();
+    std::thread reader([&]() {
+        uint8_t buffer[packet_size];
+        while( received < packet_count && rx.read(buffer, sizeof(buffer), jau::fractions_i64::zero) == packet_size ) {
+            if( !checkPacket(buffer, packet_size, static_cast<uint32_t>(received)) ) {
+                ++corrupt;
+            }
+            ++received;
+        }
+    });
+    uint8_t packets[batch_size][packet_size];
+    const uint8_t* buffers[batch_size];
+    jau::nsize_t lengths[batch_size];
+    for(int sent=0; sent<packet_count; ) {
+        const jau::nsize_t count = std::min<jau::nsize_t>(batch_size, static_cast<jau::nsize_t>(packet_count - sent));
+        for(jau::nsize_t i=0; i<count; ++i) {
+            fillPacket(packets[i], packet_size, static_cast<uint32_t>(sent) + i);
+            buffers[i] = packets[i];
+            lengths[i] = packet_size;
+        }
+        const jau::snsize_t n = tx.write_batch(buffers, lengths, count);
+        REQUIRE( jau::snsize_t(count) == n );
+        sent += n;
+    }
+    reader.join();
+    REQUIRE( packet_count == received );
+    REQUIRE( 0 == corrupt );
+    return durationMS(t0);
+}
+
+TEST_CASE( "IOUring A/B Benchmark 01", "[io_uring][benchmark]" ) {
+    int sv[2];
+    REQUIRE( 0 == ::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sv) );
+
+    printResult("blocking read/write", runBlocking(sv[0], sv[1]));
+
+    std::unique_ptr<IOUringChannel> tx = IOUringChannel::create(sv[0], packet_size);
+    std::unique_ptr<IOUringChannel> rx = IOUringChannel::create(sv[1], packet_size);
+    if( nullptr == tx || nullptr == rx ) {
+        std::cout << "io_uring backend n/a: Not built in or not supported by the running kernel" << std::endl;
+    } else {
+        printResult("io_uring batched", runIOUring(*tx, *rx));
+        std::cout << tx->toString() << std::endl;
+        std::cout << rx->toString() << std::endl;
+    }
+    tx = nullptr;
+    rx = nullptr;
+    ::close(sv[0]);
+    ::close(sv[1]);
+}
+
+/** Runs the given test with the io_uring backend, if available, and the blocking fallback path. */
+template<typename T>
+static void forEachBackend(T test) {
+    const bool enabled0 = IOUringChannel::isEnabled();
+    for(const bool uring : { true, false }) {
+        if( !IOUringChannel::setEnabled(uring) ) {
+            std::cout << "io_uring backend n/a: Not built in" << std::endl;
+            continue;
+        }
+        std::cout << "Backend " << ( uring ? "io_uring" : "blocking" ) << std::endl;
+        test(uring);
+    }
+    IOUringChannel::setEnabled(enabled0);
+}
+
+TEST_CASE( "IOUring Test 02: HCIComm Batched Read", "[io_uring][hci]" ) {
+    forEachBackend([](const bool uring) {
+        (void)uring;
+        int sv[2];
+        REQUIRE( 0 == ::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sv) );
+        HCIComm comm(0, HCI_CHANNEL_RAW, sv[1]); // owns sv[1]
+        REQUIRE( true == comm.is_open() );
+
+        const jau::nsize_t slot_count = 8;
+        uint8_t buffer[slot_count * packet_size];
+        jau::nsize_t lengths[slot_count];
+
+        // nothing queued
+        REQUIRE( 0 == comm.read_batch(buffer, packet_size, slot_count, lengths, jau::fractions_i64::zero) );
+        REQUIRE( -1 == comm.read_batch(buffer, packet_size, slot_count, lengths, 20_ms) );
+        REQUIRE( ETIMEDOUT == errno );
+
+        // a burst larger than the slots is drained in order over multiple calls
+        const int count = 20;
+        uint8_t packet[packet_size];
+        for(int i=0; i<count; ++i) {
+            fillPacket(packet, packet_size, static_cast<uint32_t>(i));
+            REQUIRE( jau::snsize_t(packet_size) == ::write(sv[0], packet, packet_size) );
+        }
+        int received = 0;
+        for(int calls=0; received < count && calls < count; ++calls) {
+            const jau::snsize_t n = comm.read_batch(buffer, packet_size, slot_count, lengths, 100_ms);
+            REQUIRE( 0 < n );
+            REQUIRE( jau::snsize_t(slot_count) >= n );
+            for(jau::snsize_t i=0; i<n; ++i) {
+                REQUIRE( packet_size == lengths[i] );
+                REQUIRE( true == checkPacket(buffer + i * packet_size, lengths[i], static_cast<uint32_t>(received)) );
+                ++received;
+            }
+        }
+        REQUIRE( count == received );
+
+        // peer shutdown ends a pending read w/o waiting for the timeout
+        std::thread closer([&]() {
+            jau::sleep_for( 50_ms );
+            ::close(sv[0]);
+        });
+        const jau::fraction_timespec t0 = jau::getMonotonicTime();
+        REQUIRE( 0 == comm.read_batch(buffer, packet_size, slot_count, lengths, 5_s) );
+        REQUIRE( 2000.0 > durationMS(t0) );
+        closer.join();
+
+        comm.close();
+        REQUIRE( false == comm.is_open() );
+        REQUIRE( -1 == comm.read_batch(buffer, packet_size, slot_count, lengths, jau::fractions_i64::zero) );
+    });
+}
+
+TEST_CASE( "IOUring Test 03: L2CAPClient Batched Write and Close", "[io_uring][l2cap]" ) {
+    // close() interrupts a blocked read() via SIGALRM
+    REQUIRE( true == jau::service_runner::singleton_sighandler() );
+
+    forEachBackend([](const bool uring) {
+        (void)uring;
+        int sv[2];
+        REQUIRE( 0 == ::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sv) );
+        const BDAddressAndType local(jau::EUI48::ANY_DEVICE, BDAddressType::BDADDR_LE_PUBLIC);
+        L2CAPClient tx(0, local, L2CAP_PSM::UNDEFINED, L2CAP_CID::ATT, local, sv[0]); // owns sv[0]
+        L2CAPClient rx(0, local, L2CAP_PSM::UNDEFINED, L2CAP_CID::ATT, local, sv[1]); // owns sv[1]
+        REQUIRE( true == tx.is_open() );
+        REQUIRE( true == rx.is_open() );
+
+        // batched writes retain order, boundaries and payload
+        const jau::nsize_t count = 16;
+        uint8_t packets[count][packet_size];
+        const uint8_t* buffers[count];
+        jau::nsize_t lengths[count];
+        for(jau::nsize_t i=0; i<count; ++i) {
+            fillPacket(packets[i], packet_size - i, static_cast<uint32_t>(i));
+            buffers[i] = packets[i];
+            lengths[i] = packet_size - i;
+        }
+        REQUIRE( jau::snsize_t(count) == tx.write_batch(buffers, lengths, count) );
+        uint8_t buffer[L2CAPClient::URING_SLOT_SIZE];
+        for(jau::nsize_t i=0; i<count; ++i) {
+            REQUIRE( jau::snsize_t(lengths[i]) == rx.read(buffer, sizeof(buffer)) );
+            REQUIRE( true == checkPacket(buffer, lengths[i], static_cast<uint32_t>(i)) );
+        }
+
+        // close() ends a blocked read() w/o waiting for the poll timeout
+        jau::snsize_t res = 0;
+        std::thread reader([&]() {
+            res = rx.read(buffer, sizeof(buffer));
+        });
+        jau::sleep_for( 100_ms );
+        const jau::fraction_timespec t0 = jau::getMonotonicTime();
+        rx.close();
+        reader.join();
+        REQUIRE( 2000.0 > durationMS(t0) );
+        REQUIRE( 0 > res );
+        REQUIRE( false == rx.is_open() );
+
+        tx.close();
+        REQUIRE( 0 > tx.write_batch(buffers, lengths, count) );
+    });
+}
@@ -0,0 +1,225 @@
+#include <iostream>
+#include <cassert>
+#include <cinttypes>
+#include <cstring>
+#include <vector>
+
+#include <jau/test/catch2_ext.hpp>
+
+#include <jau/basic_types.hpp>
+#include <direct_bt/SMPCrypto.hpp>
+#include <direct_bt/RPAResolver.hpp>
+#include <direct_bt/BTTypes0.hpp>
+
+#include "BTAdapterUtil.hpp"
+
+using namespace direct_bt;
+
+/** BT Core Spec v5.2: Vol 3, Part H, D.7 Random address hash function ah: IRK in MSB first order. */
+static const uint8_t irk_msb[] = { 0xec, 0x02, 0x34, 0xa3, 0x57, 0xc8, 0xad, 0x05, 0x34, 0x10, 0x10, 0xa6, 0x0a, 0x39, 0x7d, 0x9b };
+
+/** prand 0x708194 and its hash 0x0dfbaa */
+static const EUI48 rpa_sample( std::string("70:81:94:0D:FB:AA") );
+
+static jau::uint128dp_t make_irk(const uint8_t variant) {
+    jau::uint128dp_t irk;
+    for(int i=0; i<16; ++i) {
+        irk.data[i] = irk_msb[15-i]; // little endian
+    }
+    irk.data[0] ^= variant;
+    return irk;
+}
+
+TEST_CASE( "RPA Resolver Test 01: Key Schedule", "[SMP][RPA][IRK]" ) {
+    const jau::uint128dp_t irk = make_irk(0);
+    const jau::uint128dp_t irk_x = make_irk(1);
+    const EUI48 rpa_x( std::string("70:81:94:0D:FB:AB") );
+
+    REQUIRE( true == smp_crypto_rpa_irk_matches(irk, rpa_sample) );
+    REQUIRE( false == smp_crypto_rpa_irk_matches(irk, rpa_x) );
+    REQUIRE( false == smp_crypto_rpa_irk_matches(irk_x, rpa_sample) );
+
+    const SMPIRKSchedule sched(irk);
+    const SMPIRKSchedule sched_x(irk_x);
+    REQUIRE( true == sched.isValid() );
+    REQUIRE( true == sched.matches(rpa_sample) );
+    REQUIRE( false == sched.matches(rpa_x) );
+    REQUIRE( false == sched_x.matches(rpa_sample) );
+    REQUIRE( false == SMPIRKSchedule().matches(rpa_sample) );
+
+    const SMPIRKSchedule scheds[] = { sched_x, sched_x, sched, sched_x };
+    REQUIRE( 2 == SMPIRKSchedule::find(scheds, 4, rpa_sample) );
+    REQUIRE( -1 == SMPIRKSchedule::find(scheds, 2, rpa_sample) );
+    REQUIRE( -1 == SMPIRKSchedule::find(scheds, 4, rpa_x) );
+}
+
+TEST_CASE( "RPA Resolver Test 02: Resolution and Cache", "[SMP][RPA][IRK]" ) {
+    const BDAddressAndType id1( EUI48( std::string("C0:26:DA:01:DA:B1") ), BDAddressType::BDADDR_LE_PUBLIC );
+    const BDAddressAndType id2( EUI48( std::string("C0:26:DA:01:DA:B2") ), BDAddressType::BDADDR_LE_PUBLIC );
+    const EUI48 nrpa1( std::string("40:00:00:00:00:01") );
+    const EUI48 nrpa2( std::string("40:00:00:00:00:02") );
+    BDAddressAndType identity;
+
+    RPAResolver resolver(2);
+    REQUIRE( false == resolver.resolve(rpa_sample, identity) );
+    REQUIRE( 0 == resolver.getEvaluations() );
+
+    resolver.add(id1, make_irk(0));
+    REQUIRE( 1 == resolver.size() );
+    // cached negative dropped by add()
+    REQUIRE( true == resolver.resolve(rpa_sample, identity) );
+    REQUIRE( id1 == identity );
+    REQUIRE( 2 == resolver.getCacheMisses() );
+    REQUIRE( 1 == resolver.getEvaluations() );
+
+    REQUIRE( true == resolver.resolve(rpa_sample, identity) );
+    REQUIRE( 1 == resolver.getCacheHits() );
+
+    REQUIRE( false == resolver.resolve(nrpa1, identity) );
+    REQUIRE( false == resolver.resolve(nrpa1, identity) ); // cached negative
+    REQUIRE( 2 == resolver.getCacheHits() );
+    REQUIRE( 2 == resolver.getEvaluations() );
+
+    // evicts least recently used rpa_sample
+    REQUIRE( false == resolver.resolve(nrpa2, identity) );
+    REQUIRE( true == resolver.resolve(rpa_sample, identity) );
+    REQUIRE( id1 == identity );
+    REQUIRE( 5 == resolver.getCacheMisses() );
+    REQUIRE( 4 == resolver.getEvaluations() );
+
+    // new IRK invalidates cached negatives
+    resolver.add(id2, make_irk(1));
+    REQUIRE( 2 == resolver.size() );
+    REQUIRE( false == resolver.resolve(nrpa1, identity) );
+    REQUIRE( 6 == resolver.getEvaluations() );
+
+    // replaced IRK invalidates its resolutions
+    resolver.add(id1, make_irk(2));
+    REQUIRE( 2 == resolver.size() );
+    REQUIRE( false == resolver.resolve(rpa_sample, identity) );
+    resolver.add(id1, make_irk(0));
+    REQUIRE( true == resolver.resolve(rpa_sample, identity) );
+    REQUIRE( id1 == identity );
+
+    REQUIRE( true == resolver.remove(id1) );
+    REQUIRE( false == resolver.remove(id1) );
+    REQUIRE( 1 == resolver.size() );
+    REQUIRE( false == resolver.resolve(rpa_sample, identity) );
+    std::cout << resolver.toString() << std::endl;
+
+    resolver.clear();
+    REQUIRE( 0 == resolver.size() );
+}
+
+/** Stand-in for BTDevice with its role dependent remote IRK, see BTDevice::getRemoteIRK() */
+struct ResolvedDev {
+    BDAddressAndType identity;
+    bool self_is_responder;
+    bool irk_init_has;
+    bool irk_resp_has;
+
+    bool hasRemoteIRK() const noexcept { return self_is_responder ? irk_resp_has : irk_init_has; }
+};
+
+TEST_CASE( "RPA Resolver Test 03: Indexed Lookup", "[SMP][RPA][IRK][index]" ) {
+    const BDAddressAndType id1( EUI48( std::string("C0:26:DA:01:DA:B1") ), BDAddressType::BDADDR_LE_PUBLIC );
+    const BDAddressAndType rpa_key( rpa_sample, BDAddressType::BDADDR_LE_RANDOM );
+    const EUI48 nrpa( std::string("40:00:00:00:00:01") );
+
+    BDAddressIndex<ResolvedDev> index;
+    RPAResolver resolver;
+    // see BTAdapter::findIndexedDevice()
+    auto lookup = [&](const BDAddressAndType& identity) -> std::shared_ptr<ResolvedDev> {
+        std::shared_ptr<ResolvedDev> r = index.find(identity, [&](const ResolvedDev& d) -> bool { return identity == d.identity; });
+        return nullptr != r ? r : index.find(identity, [](const ResolvedDev&) -> bool { return true; });
+    };
+    auto valid = [](const ResolvedDev& d, const BDAddressAndType& identity) -> bool {
+        return d.hasRemoteIRK() && identity == d.identity;
+    };
+
+    // local initiator, i.e. the remote responder's IRK
+    std::shared_ptr<ResolvedDev> dev = std::make_shared<ResolvedDev>( ResolvedDev{ id1, false, false, true } );
+    index.add(id1, dev);
+    resolver.add(id1, make_irk(0));
+    REQUIRE( nullptr == resolver.resolve(nrpa, lookup, valid) );
+    REQUIRE( nullptr == resolver.resolve(rpa_sample, lookup, valid) ); // role mismatch: stale
+    REQUIRE( 0 == resolver.size() );
+
+    dev->self_is_responder = true;
+    resolver.add(id1, make_irk(0));
+    REQUIRE( dev == resolver.resolve(rpa_sample, lookup, valid) );
+    REQUIRE( 1 == resolver.size() );
+
+    // another device sharing the identity as its visible address
+    std::shared_ptr<ResolvedDev> other = std::make_shared<ResolvedDev>( ResolvedDev{ rpa_key, true, false, false } );
+    std::shared_ptr<ResolvedDev> dev2 = std::make_shared<ResolvedDev>( *dev );
+    index.remove(id1, dev.get());
+    index.add(id1, other);
+    index.add(id1, dev2);
+    REQUIRE( dev2 == resolver.resolve(rpa_sample, lookup, valid) );
+    REQUIRE( 1 == resolver.size() );
+
+    // unpaired, i.e. IRK removed from the device but not from the resolver
+    dev2->irk_resp_has = false;
+    REQUIRE( nullptr == resolver.resolve(rpa_sample, lookup, valid) );
+    REQUIRE( 0 == resolver.size() );
+
+    // unpaired w/ IRK removed from the resolver, see BTDevice::unpair()
+    dev2->irk_resp_has = true;
+    resolver.add(id1, make_irk(0));
+    REQUIRE( dev2 == resolver.resolve(rpa_sample, lookup, valid) );
+    REQUIRE( true == resolver.remove(id1) );
+    REQUIRE( nullptr == resolver.resolve(rpa_sample, lookup, valid) );
+
+    // resolved identity not indexed keeps the IRK
+    resolver.add(id1, make_irk(0));
+    index.clear();
+    REQUIRE( nullptr == resolver.resolve(rpa_sample, lookup, valid) );
+    REQUIRE( 1 == resolver.size() );
+}
+
+TEST_CASE( "RPA Resolver Test 10: Benchmark", "[SMP][RPA][IRK][benchmark]" ) {
+    const int loops = 10000;
+    const uint8_t irk_count = 16;
+    std::vector<jau::uint128dp_t> irks;
+    std::vector<SMPIRKSchedule> scheds;
+    RPAResolver resolver;
+    for(uint8_t i=irk_count; i>0; --i) { // matching IRK last
+        const jau::uint128dp_t irk = make_irk(i-1);
+        irks.push_back(irk);
+        scheds.push_back(SMPIRKSchedule(irk));
+        EUI48 id( std::string("C0:26:DA:01:DA:00") );
+        id.b[0] = i;
+        resolver.add(BDAddressAndType(id, BDAddressType::BDADDR_LE_PUBLIC), irk);
+    }
+    uint64_t sink = 0;
+
+    const jau::fraction_timespec t0 = jau::getMonotonicTime();
+    for(int l=0; l<loops; ++l) {
+        for(uint8_t i=0; i<irk_count; ++i) {
+            if( smp_crypto_rpa_irk_matches(irks[i], rpa_sample) ) {
+                sink += i;
+                break;
+            }
+        }
+    }
+    const jau::fraction_timespec t1 = jau::getMonotonicTime();
+    for(int l=0; l<loops; ++l) {
+        sink += SMPIRKSchedule::find(scheds.data(), scheds.size(), rpa_sample);
+    }
+    const jau::fraction_timespec t2 = jau::getMonotonicTime();
+    BDAddressAndType identity;
+    for(int l=0; l<loops; ++l) {
+        sink += resolver.resolve(rpa_sample, identity) ? identity.address.b[0] : 0;
+    }
+    const jau::fraction_timespec t3 = jau::getMonotonicTime();
+    REQUIRE( 1 == resolver.getCacheMisses() );
+
+    const double ns_plain = double( ( t1 - t0 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) / double(loops);
+    const double ns_sched = double( ( t2 - t1 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) / double(loops);
+    const double ns_cache = double( ( t3 - t2 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) / double(loops);
+    std::cout << "RPA resolution against " << int(irk_count) << " IRKs, " << loops << " loops (sink " << sink << ")" << std::endl;
+    std::cout << "- smp_crypto_rpa_irk_matches: " << ns_plain << " ns/rpa" << std::endl;
+    std::cout << "- SMPIRKSchedule::find:       " << ns_sched << " ns/rpa" << std::endl;
+    std::cout << "- RPAResolver (cached):       " << ns_cache << " ns/rpa" << std::endl;
+}
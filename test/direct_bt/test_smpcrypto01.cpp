@@ -0,0 +1,169 @@
+#include <iostream>
+#include <cassert>
+#include <cinttypes>
+#include <cstring>
+#include <vector>
+
+#include <jau/test/catch2_ext.hpp>
+
+#include <jau/basic_types.hpp>
+#include <direct_bt/SMPCrypto.hpp>
+
+using namespace direct_bt;
+
+static const SMPAESBackend all_backends[] = { SMPAESBackend::TINYCRYPT, SMPAESBackend::AESNI, SMPAESBackend::ARMV8_CE };
+
+static jau::uint128dp_t from_msb(const uint8_t msb[16]) {
+    jau::uint128dp_t v;
+    for(int i=0; i<16; ++i) {
+        v.data[i] = msb[15-i]; // little endian
+    }
+    return v;
+}
+
+/** Deterministic xorshift pseudo random bytes */
+static void fill_random(uint32_t& state, uint8_t* data, const jau::nsize_t len) {
+    for(jau::nsize_t i=0; i<len; ++i) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        data[i] = static_cast<uint8_t>( state );
+    }
+}
+
+/** Returns an RPA of the given IRK with the given prand via security function e, i.e. ah(). */
+static EUI48 make_rpa(const jau::uint128dp_t& irk, const uint8_t prand[3]) {
+    jau::uint128dp_t r, enc;
+    r.data[0] = prand[0];
+    r.data[1] = prand[1];
+    r.data[2] = ( prand[2] & 0x3f ) | 0x40; // resolvable private address
+    EUI48 rpa;
+    rpa.b[3] = r.data[0];
+    rpa.b[4] = r.data[1];
+    rpa.b[5] = r.data[2];
+    REQUIRE( true == smp_crypto_e(irk, r, enc) );
+    rpa.b[0] = enc.data[0];
+    rpa.b[1] = enc.data[1];
+    rpa.b[2] = enc.data[2];
+    return rpa;
+}
+
+TEST_CASE( "SMP Crypto Test 01: AES Backends", "[SMP][crypto][AES]" ) {
+    const SMPAESBackend default_backend = smp_crypto_aes_backend();
+    std::cout << "Default AES backend " << to_string(default_backend) << std::endl;
+    REQUIRE( true == smp_crypto_aes_supported(SMPAESBackend::TINYCRYPT) );
+    REQUIRE( true == smp_crypto_aes_supported(default_backend) );
+
+    // FIPS-197 Appendix C.1
+    const uint8_t key_msb[] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+    const uint8_t plain_msb[] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+    const uint8_t cipher_msb[] = { 0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a };
+
+    // BT Core Spec v5.2: Vol 3, Part H, D.7 Random address hash function ah
+    const uint8_t irk_msb[] = { 0xec, 0x02, 0x34, 0xa3, 0x57, 0xc8, 0xad, 0x05, 0x34, 0x10, 0x10, 0xa6, 0x0a, 0x39, 0x7d, 0x9b };
+    const EUI48 rpa_sample( std::string("70:81:94:0D:FB:AA") );
+
+    // reference results of tinycrypt for random keys and plaintexts
+    const int count = 256;
+    std::vector<jau::uint128dp_t> keys(count), plains(count), ciphers(count);
+    std::vector<EUI48> rpas(count);
+    REQUIRE( true == smp_crypto_set_aes_backend(SMPAESBackend::TINYCRYPT) );
+    {
+        uint32_t state = 0x2545F491;
+        for(int i=0; i<count; ++i) {
+            fill_random(state, keys[i].data, 16);
+            fill_random(state, plains[i].data, 16);
+            REQUIRE( true == smp_crypto_e(keys[i], plains[i], ciphers[i]) );
+            rpas[i] = make_rpa(keys[i], plains[i].data);
+        }
+    }
+
+    for(const SMPAESBackend b : all_backends) {
+        if( !smp_crypto_aes_supported(b) ) {
+            std::cout << "AES backend " << to_string(b) << ": not supported" << std::endl;
+            REQUIRE( false == smp_crypto_set_aes_backend(b) );
+            continue;
+        }
+        std::cout << "AES backend " << to_string(b) << ": cross-checking" << std::endl;
+        REQUIRE( true == smp_crypto_set_aes_backend(b) );
+        REQUIRE( b == smp_crypto_aes_backend() );
+
+        jau::uint128dp_t enc;
+        REQUIRE( true == smp_crypto_e(from_msb(key_msb), from_msb(plain_msb), enc) );
+        REQUIRE( from_msb(cipher_msb) == enc );
+
+        const jau::uint128dp_t irk = from_msb(irk_msb);
+        const SMPIRKSchedule sched(irk);
+        REQUIRE( b == sched.getBackend() );
+        REQUIRE( true == smp_crypto_rpa_irk_matches(irk, rpa_sample) );
+        REQUIRE( true == sched.matches(rpa_sample) );
+
+        std::vector<SMPIRKSchedule> scheds;
+        for(int i=0; i<count; ++i) {
+            REQUIRE( true == smp_crypto_e(keys[i], plains[i], enc) );
+            REQUIRE( ciphers[i] == enc );
+            REQUIRE( true == smp_crypto_rpa_irk_matches(keys[i], rpas[i]) );
+            REQUIRE( false == smp_crypto_rpa_irk_matches(keys[( i + 1 ) % count], rpas[i]) );
+            scheds.push_back(SMPIRKSchedule(keys[i]));
+            REQUIRE( true == scheds[i].matches(rpas[i]) );
+        }
+        // batched evaluation incl. the trailing non-multiple of four
+        for(int i=0; i<count; ++i) {
+            REQUIRE( i == SMPIRKSchedule::find(scheds.data(), scheds.size(), rpas[i]) );
+            REQUIRE( ( i < count - 3 ? i : -1 ) == SMPIRKSchedule::find(scheds.data(), count - 3, rpas[i]) );
+        }
+        // schedules of different backends
+        REQUIRE( true == smp_crypto_set_aes_backend(SMPAESBackend::TINYCRYPT) );
+        scheds[5] = SMPIRKSchedule(keys[5]);
+        REQUIRE( 5 == SMPIRKSchedule::find(scheds.data(), scheds.size(), rpas[5]) );
+        REQUIRE( 6 == SMPIRKSchedule::find(scheds.data(), scheds.size(), rpas[6]) );
+    }
+    REQUIRE( true == smp_crypto_set_aes_backend(default_backend) );
+}
+
+TEST_CASE( "SMP Crypto Test 10: RPA Match Benchmark", "[SMP][crypto][AES][benchmark]" ) {
+    const SMPAESBackend default_backend = smp_crypto_aes_backend();
+    const int loops = 2000;
+    const int irk_count = 64;
+    uint32_t state = 0x1b873593;
+    std::vector<jau::uint128dp_t> irks(irk_count);
+    for(int i=0; i<irk_count; ++i) {
+        fill_random(state, irks[i].data, 16);
+    }
+    uint8_t prand[3];
+    fill_random(state, prand, 3);
+    const EUI48 rpa = make_rpa(irks[irk_count-1], prand); // matching IRK last
+    uint64_t sink = 0;
+
+    std::cout << "RPA resolution against " << irk_count << " IRKs, " << loops << " loops" << std::endl;
+    for(const SMPAESBackend b : all_backends) {
+        if( !smp_crypto_set_aes_backend(b) ) {
+            continue;
+        }
+        std::vector<SMPIRKSchedule> scheds;
+        for(int i=0; i<irk_count; ++i) {
+            scheds.push_back(SMPIRKSchedule(irks[i]));
+        }
+        const jau::fraction_timespec t0 = jau::getMonotonicTime();
+        for(int l=0; l<loops; ++l) {
+            for(int i=0; i<irk_count; ++i) {
+                if( smp_crypto_rpa_irk_matches(irks[i], rpa) ) {
+                    sink += i;
+                    break;
+                }
+            }
+        }
+        const jau::fraction_timespec t1 = jau::getMonotonicTime();
+        for(int l=0; l<loops; ++l) {
+            sink += SMPIRKSchedule::find(scheds.data(), scheds.size(), rpa);
+        }
+        const jau::fraction_timespec t2 = jau::getMonotonicTime();
+
+        const double ns_plain = double( ( t1 - t0 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) / double(loops * irk_count);
+        const double ns_sched = double( ( t2 - t1 ).to_fraction_i64().to_num_of(jau::fractions_i64::nano) ) / double(loops * irk_count);
+        std::cout << "- " << to_string(b) << ": smp_crypto_rpa_irk_matches " << ns_plain << " ns/irk, "
+                  << "SMPIRKSchedule::find " << ns_sched << " ns/irk (" << ( 1000.0 / ns_sched ) << " M irk/s)" << std::endl;
+    }
+    std::cout << "(sink " << sink << ")" << std::endl;
+    smp_crypto_set_aes_backend(default_backend);
+}